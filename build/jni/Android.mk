@@ -26,6 +26,7 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/animators/Scale.cpp \
     ../../ouzel/animators/Sequence.cpp \
     ../../ouzel/animators/Shake.cpp \
+    ../../ouzel/animators/TweenSystem.cpp \
     ../../ouzel/assets/Cache.cpp \
     ../../ouzel/assets/Loader.cpp \
     ../../ouzel/assets/LoaderBMF.cpp \
@@ -78,6 +79,12 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/graphics/opengl/RenderDeviceOGL.cpp \
     ../../ouzel/graphics/opengl/ShaderResourceOGL.cpp \
     ../../ouzel/graphics/opengl/TextureResourceOGL.cpp \
+    ../../ouzel/graphics/software/BlendStateResourceSoftware.cpp \
+    ../../ouzel/graphics/software/BufferResourceSoftware.cpp \
+    ../../ouzel/graphics/software/MeshBufferResourceSoftware.cpp \
+    ../../ouzel/graphics/software/RenderDeviceSoftware.cpp \
+    ../../ouzel/graphics/software/ShaderResourceSoftware.cpp \
+    ../../ouzel/graphics/software/TextureResourceSoftware.cpp \
     ../../ouzel/graphics/BlendState.cpp \
     ../../ouzel/graphics/BlendStateResource.cpp \
     ../../ouzel/graphics/Buffer.cpp \
@@ -89,6 +96,7 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/graphics/MeshBufferResource.cpp \
     ../../ouzel/graphics/Renderer.cpp \
     ../../ouzel/graphics/RenderDevice.cpp \
+    ../../ouzel/graphics/RenderGraph.cpp \
     ../../ouzel/graphics/Shader.cpp \
     ../../ouzel/graphics/ShaderResource.cpp \
     ../../ouzel/graphics/Texture.cpp \
@@ -96,6 +104,7 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/graphics/Vertex.cpp \
     ../../ouzel/gui/BMFont.cpp \
     ../../ouzel/gui/TTFont.cpp \
+    ../../ouzel/gui/TextLayout.cpp \
     ../../ouzel/gui/Button.cpp \
     ../../ouzel/gui/CheckBox.cpp \
     ../../ouzel/gui/ComboBox.cpp \
@@ -109,6 +118,7 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/gui/ScrollBar.cpp \
     ../../ouzel/gui/SlideBar.cpp \
     ../../ouzel/gui/Widget.cpp \
+    ../../ouzel/gui/WidgetCache.cpp \
     ../../ouzel/input/android/GamepadAndroid.cpp \
     ../../ouzel/input/android/InputAndroid.cpp \
     ../../ouzel/input/Cursor.cpp \
@@ -119,6 +129,7 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/localization/Localization.cpp \
     ../../ouzel/math/Box2.cpp \
     ../../ouzel/math/Box3.cpp \
+    ../../ouzel/math/Box3Array.cpp \
     ../../ouzel/math/Color.cpp \
     ../../ouzel/math/ConvexVolume.cpp \
     ../../ouzel/math/MathUtils.cpp \
@@ -133,12 +144,15 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/math/Vector3.cpp \
     ../../ouzel/math/Vector4.cpp \
     ../../ouzel/network/Client.cpp \
+    ../../ouzel/network/Channel.cpp \
     ../../ouzel/network/Network.cpp \
+    ../../ouzel/network/Replication.cpp \
     ../../ouzel/scene/Actor.cpp \
     ../../ouzel/scene/ActorContainer.cpp \
     ../../ouzel/scene/Camera.cpp \
     ../../ouzel/scene/Component.cpp \
     ../../ouzel/scene/Layer.cpp \
+    ../../ouzel/scene/InstanceBatcher.cpp \
     ../../ouzel/scene/Light.cpp \
     ../../ouzel/scene/ModelData.cpp \
     ../../ouzel/scene/ModelRenderer.cpp \
@@ -154,6 +168,8 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/utils/INI.cpp \
     ../../ouzel/utils/Log.cpp \
     ../../ouzel/utils/OBF.cpp \
+    ../../ouzel/utils/OBFWriter.cpp \
+    ../../ouzel/utils/OBFView.cpp \
     ../../ouzel/utils/Utils.cpp
 
 include $(BUILD_STATIC_LIBRARY)
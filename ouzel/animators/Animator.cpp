@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "Animator.hpp"
 #include "core/Engine.hpp"
+#include "TweenSystem.hpp"
 #include "scene/Actor.hpp"
 
 namespace ouzel
@@ -13,11 +14,12 @@ namespace ouzel
         Animator::Animator(float aLength):
             Component(Component::ANIMATOR), length(aLength)
         {
-            updateCallback.callback = std::bind(&Animator::update, this, std::placeholders::_1);
         }
 
         Animator::~Animator()
         {
+            if (tweenSystem) tweenSystem->removeAnimator(this);
+            if (trackSystem) trackSystem->removeTrack(this);
             if (parent) parent->removeAnimator(this);
 
             for (const auto& animator : animators)
@@ -28,42 +30,49 @@ namespace ouzel
 
         void Animator::update(float delta)
         {
-            if (running)
+            if (step(delta))
             {
-                if (length == 0.0f) // never-ending action
-                {
-                    currentTime += delta;
-                    progress = 0.0f;
-                }
-                else if (currentTime + delta >= length)
-                {
-                    done = true;
-                    running = false;
-                    progress = 1.0f;
-                    currentTime = length;
-
-                    Event finishEvent;
-                    finishEvent.type = Event::Type::ANIMATION_FINISH;
-                    finishEvent.animationEvent.component = this;
-                    sharedEngine->getEventDispatcher()->postEvent(finishEvent);
-                }
-                else
-                {
-                    currentTime += delta;
-                    progress = currentTime / length;
-                }
-
                 updateProgress();
             }
+            else if (tweenSystem)
+            {
+                tweenSystem->removeAnimator(this);
+            }
+        }
+
+        bool Animator::step(float delta)
+        {
+            if (!running) return false;
+
+            if (length == 0.0f) // never-ending action
+            {
+                currentTime += delta;
+                progress = 0.0f;
+            }
+            else if (currentTime + delta >= length)
+            {
+                done = true;
+                running = false;
+                progress = 1.0f;
+                currentTime = length;
+
+                Event finishEvent;
+                finishEvent.type = Event::Type::ANIMATION_FINISH;
+                finishEvent.animationEvent.component = this;
+                sharedEngine->getEventDispatcher()->postEvent(finishEvent);
+            }
             else
             {
-                updateCallback.remove();
+                currentTime += delta;
+                progress = currentTime / length;
             }
+
+            return true;
         }
 
         void Animator::start()
         {
-            sharedEngine->scheduleUpdate(&updateCallback);
+            sharedEngine->getSceneManager()->getTweenSystem()->addAnimator(this);
             play();
 
             Event startEvent;
@@ -88,6 +97,9 @@ namespace ouzel
                 }
             }
 
+            // apply the values of the current frame, so that the animators start from the actual state of the actor
+            sharedEngine->getSceneManager()->getTweenSystem()->flush();
+
             for (const auto& animator : animators)
             {
                 animator->play();
@@ -132,6 +144,7 @@ namespace ouzel
 
         void Animator::updateProgress()
         {
+            if (trackSystem) trackSystem->setTrackProgress(this, progress);
         }
 
         void Animator::addChildAnimator(Animator* animator)
@@ -6,7 +6,7 @@
 #include <memory>
 #include <functional>
 #include "scene/Component.hpp"
-#include "core/UpdateCallback.hpp"
+#include "animators/TweenSystem.hpp"
 
 namespace ouzel
 {
@@ -17,6 +17,7 @@ namespace ouzel
         class Animator: public Component
         {
             friend Actor;
+            friend TweenSystem;
         public:
             Animator(float aLength);
             virtual ~Animator();
@@ -72,6 +73,8 @@ namespace ouzel
             virtual void addChildAnimator(Animator* animator);
             virtual bool removeChildAnimator(Animator* animator);
 
+            // advances the time, returns false if the animator is not running
+            bool step(float delta);
             virtual void updateProgress();
 
             float length = 0.0f;
@@ -83,7 +86,16 @@ namespace ouzel
             Animator* parent = nullptr;
             Actor* targetActor = nullptr;
 
-            UpdateCallback updateCallback;
+            // set by animators whose progress is only applied to their track and that do not override
+            // update or updateProgress, the tween system then advances them without virtual calls
+            bool batched = false;
+
+            TweenSystem* tweenSystem = nullptr;
+            size_t tweenSystemIndex = 0;
+
+            TweenSystem* trackSystem = nullptr;
+            TweenSystem::Property trackProperty = TweenSystem::Property::POSITION;
+            size_t trackIndex = 0;
 
             std::vector<Animator*> animators;
             std::vector<std::unique_ptr<Animator>> ownedAnimators;
@@ -298,7 +298,7 @@ namespace ouzel
                         case Func::QUAD: progress = quadOut(progress); break;
                         case Func::CUBIC: progress = cubicOut(progress); break;
                         case Func::QUART: progress = quartOut(progress); break;
-                        case Func::QUINT: quintOut(progress); break;
+                        case Func::QUINT: progress = quintOut(progress); break;
                         case Func::EXPO: progress = expoOut(progress); break;
                         case Func::CIRC: progress = circOut(progress); break;
                         case Func::BACK: progress = backOut(progress); break;
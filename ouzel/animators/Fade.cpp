@@ -2,6 +2,7 @@
 // This file is part of the Ouzel engine.
 
 #include "Fade.hpp"
+#include "core/Engine.hpp"
 #include "scene/Actor.hpp"
 
 namespace ouzel
@@ -11,6 +12,7 @@ namespace ouzel
         Fade::Fade(float aLength, float aOpacity, bool aRelative):
             Animator(aLength), opacity(aOpacity), relative(aRelative)
         {
+            batched = true;
         }
 
         void Fade::play()
@@ -23,16 +25,8 @@ namespace ouzel
                 targetOpacity = relative ? startOpacity + opacity : opacity;
 
                 diff = targetOpacity - startOpacity;
-            }
-        }
-
-        void Fade::updateProgress()
-        {
-            Animator::updateProgress();
 
-            if (targetActor)
-            {
-                targetActor->setOpacity(startOpacity + (diff * progress));
+                sharedEngine->getSceneManager()->getTweenSystem()->setTrack(this, TweenSystem::Property::OPACITY, Vector3(startOpacity, 0.0f, 0.0f), Vector3(diff, 0.0f, 0.0f));
             }
         }
     } // namespace scene
@@ -17,8 +17,6 @@ namespace ouzel
             virtual void play() override;
 
         protected:
-            virtual void updateProgress() override;
-
             float opacity;
             float startOpacity = 0.0f;
             float targetOpacity = 0.0f;
@@ -2,6 +2,7 @@
 // This file is part of the Ouzel engine.
 
 #include "Move.hpp"
+#include "core/Engine.hpp"
 #include "scene/Actor.hpp"
 
 namespace ouzel
@@ -11,6 +12,7 @@ namespace ouzel
         Move::Move(float aLength, const Vector3& aPosition, bool aRelative):
             Animator(aLength), position(aPosition), relative(aRelative)
         {
+            batched = true;
         }
 
         void Move::play()
@@ -23,16 +25,8 @@ namespace ouzel
                 targetPosition = relative ? startPosition + position : position;
 
                 diff = targetPosition - startPosition;
-            }
-        }
-
-        void Move::updateProgress()
-        {
-            Animator::updateProgress();
 
-            if (targetActor)
-            {
-                targetActor->setPosition(startPosition + (diff * progress));
+                sharedEngine->getSceneManager()->getTweenSystem()->setTrack(this, TweenSystem::Property::POSITION, startPosition, diff);
             }
         }
     } // namespace scene
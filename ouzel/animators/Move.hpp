@@ -18,8 +18,6 @@ namespace ouzel
             virtual void play() override;
 
         protected:
-            virtual void updateProgress() override;
-
             Vector3 position;
             Vector3 startPosition;
             Vector3 targetPosition;
@@ -2,6 +2,7 @@
 // This file is part of the Ouzel engine.
 
 #include "Rotate.hpp"
+#include "core/Engine.hpp"
 #include "scene/Actor.hpp"
 
 namespace ouzel
@@ -11,6 +12,7 @@ namespace ouzel
         Rotate::Rotate(float aLength, const Vector3& aRotation, bool aRelative):
             Animator(aLength), rotation(aRotation), relative(aRelative)
         {
+            batched = true;
         }
 
         void Rotate::play()
@@ -24,16 +26,8 @@ namespace ouzel
                 targetRotation = relative ? startRotation + rotation : rotation;
 
                 diff = targetRotation - startRotation;
-            }
-        }
-
-        void Rotate::updateProgress()
-        {
-            Animator::updateProgress();
 
-            if (targetActor)
-            {
-                targetActor->setRotation(startRotation + diff * progress);
+                sharedEngine->getSceneManager()->getTweenSystem()->setTrack(this, TweenSystem::Property::ROTATION, startRotation, diff);
             }
         }
     } // namespace scene
@@ -18,8 +18,6 @@ namespace ouzel
             virtual void play() override;
 
         protected:
-            virtual void updateProgress() override;
-
             Vector3 rotation;
             Vector3 startRotation;
             Vector3 targetRotation;
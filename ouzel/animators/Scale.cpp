@@ -2,6 +2,7 @@
 // This file is part of the Ouzel engine.
 
 #include "Scale.hpp"
+#include "core/Engine.hpp"
 #include "scene/Actor.hpp"
 
 namespace ouzel
@@ -11,6 +12,7 @@ namespace ouzel
         Scale::Scale(float aLength, const Vector3& aScale, bool aRelative):
             Animator(aLength), scale(aScale), relative(aRelative)
         {
+            batched = true;
         }
 
         void Scale::play()
@@ -23,16 +25,8 @@ namespace ouzel
                 targetScale = relative ? startScale + scale : scale;
 
                 diff = targetScale - startScale;
-            }
-        }
-
-        void Scale::updateProgress()
-        {
-            Animator::updateProgress();
 
-            if (targetActor)
-            {
-                targetActor->setScale(startScale + (diff * progress));
+                sharedEngine->getSceneManager()->getTweenSystem()->setTrack(this, TweenSystem::Property::SCALE, startScale, diff);
             }
         }
     } // namespace scene
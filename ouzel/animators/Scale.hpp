@@ -18,8 +18,6 @@ namespace ouzel
             virtual void play() override;
 
         protected:
-            virtual void updateProgress() override;
-
             Vector3 scale;
             Vector3 startScale;
             Vector3 targetScale;
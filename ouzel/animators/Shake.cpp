@@ -3,6 +3,7 @@
 
 #include <limits>
 #include "Shake.hpp"
+#include "core/Engine.hpp"
 #include "scene/Actor.hpp"
 #include "math/MathUtils.hpp"
 #include "utils/Utils.hpp"
@@ -26,14 +27,15 @@ namespace ouzel
             if (targetActor)
             {
                 startPosition = targetActor->getPosition();
+
+                sharedEngine->getSceneManager()->getTweenSystem()->setTrack(this, TweenSystem::Property::POSITION, startPosition, Vector3());
             }
         }
 
         void Shake::updateProgress()
         {
-            Animator::updateProgress();
-
-            if (targetActor)
+            // the noise is not a linear function of the progress, so the track is replaced every update
+            if (trackSystem)
             {
                 float x = length * progress * timeScale;
 
@@ -62,7 +64,7 @@ namespace ouzel
                               smoothStep(previousPosition.y, nextPosition.y, t),
                               smoothStep(previousPosition.z, nextPosition.z, t));
 
-                targetActor->setPosition(startPosition + noise);
+                trackSystem->setTrack(this, TweenSystem::Property::POSITION, startPosition + noise, Vector3());
             }
         }
     } // namespace scene
@@ -0,0 +1,348 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "TweenSystem.hpp"
+#include "Animator.hpp"
+#include "core/Engine.hpp"
+#include "math/MathUtils.hpp"
+#include "scene/Actor.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        void TweenSystem::Tracks::evaluate()
+        {
+            // separate loops over contiguous arrays, so that they can be vectorized
+            const size_t count = animators.size();
+            const float* const p = progress.data();
+
+            float* const vx = valueX.data();
+            const float* const sx = startX.data();
+            const float* const dx = diffX.data();
+            for (size_t i = 0; i < count; ++i) vx[i] = sx[i] + dx[i] * p[i];
+
+            float* const vy = valueY.data();
+            const float* const sy = startY.data();
+            const float* const dy = diffY.data();
+            for (size_t i = 0; i < count; ++i) vy[i] = sy[i] + dy[i] * p[i];
+
+            float* const vz = valueZ.data();
+            const float* const sz = startZ.data();
+            const float* const dz = diffZ.data();
+            for (size_t i = 0; i < count; ++i) vz[i] = sz[i] + dz[i] * p[i];
+        }
+
+        TweenSystem::TweenSystem()
+        {
+            updateCallback.callback = std::bind(&TweenSystem::update, this, std::placeholders::_1);
+        }
+
+        TweenSystem::~TweenSystem()
+        {
+            for (Animator* animator : animators)
+            {
+                if (animator) animator->tweenSystem = nullptr;
+            }
+
+            for (const Tracks& propertyTracks : tracks)
+            {
+                for (Animator* animator : propertyTracks.animators)
+                {
+                    animator->trackSystem = nullptr;
+                }
+            }
+        }
+
+        void TweenSystem::addAnimator(Animator* animator)
+        {
+            if (animator->tweenSystem == this) return;
+            if (animator->tweenSystem) animator->tweenSystem->removeAnimator(animator);
+
+            animator->tweenSystem = this;
+            animator->tweenSystemIndex = animators.size();
+            animators.push_back(animator);
+
+            // during the update the callback is already scheduled
+            if (!updating && animators.size() == 1) sharedEngine->scheduleUpdate(&updateCallback);
+        }
+
+        void TweenSystem::removeAnimator(Animator* animator)
+        {
+            if (animator->tweenSystem != this) return;
+
+            animator->tweenSystem = nullptr;
+            removeTracks(animator);
+
+            if (updating)
+            {
+                // the slot is reclaimed after the update, because the array is being iterated
+                animators[animator->tweenSystemIndex] = nullptr;
+                animatorsRemoved = true;
+            }
+            else
+            {
+                Animator* lastAnimator = animators.back();
+                animators[animator->tweenSystemIndex] = lastAnimator;
+                lastAnimator->tweenSystemIndex = animator->tweenSystemIndex;
+                animators.pop_back();
+
+                if (animators.empty()) updateCallback.remove();
+            }
+        }
+
+        void TweenSystem::setTrack(Animator* animator, Property property, const Vector3& start, const Vector3& diff)
+        {
+            if (animator->trackSystem != this || animator->trackProperty != property)
+            {
+                if (animator->trackSystem) animator->trackSystem->removeTrack(animator);
+
+                Tracks& propertyTracks = tracks[static_cast<size_t>(property)];
+
+                animator->trackSystem = this;
+                animator->trackProperty = property;
+                animator->trackIndex = propertyTracks.animators.size();
+
+                propertyTracks.animators.push_back(animator);
+                propertyTracks.actors.push_back(nullptr);
+                propertyTracks.startX.push_back(0.0f);
+                propertyTracks.startY.push_back(0.0f);
+                propertyTracks.startZ.push_back(0.0f);
+                propertyTracks.diffX.push_back(0.0f);
+                propertyTracks.diffY.push_back(0.0f);
+                propertyTracks.diffZ.push_back(0.0f);
+                propertyTracks.progress.push_back(animator->progress);
+                propertyTracks.valueX.push_back(0.0f);
+                propertyTracks.valueY.push_back(0.0f);
+                propertyTracks.valueZ.push_back(0.0f);
+                propertyTracks.changed.push_back(0);
+            }
+
+            Tracks& propertyTracks = tracks[static_cast<size_t>(property)];
+            const size_t index = animator->trackIndex;
+
+            propertyTracks.actors[index] = animator->targetActor;
+            propertyTracks.startX[index] = start.x;
+            propertyTracks.startY[index] = start.y;
+            propertyTracks.startZ[index] = start.z;
+            propertyTracks.diffX[index] = diff.x;
+            propertyTracks.diffY[index] = diff.y;
+            propertyTracks.diffZ[index] = diff.z;
+
+            trackChanged(property, index);
+        }
+
+        void TweenSystem::removeTrack(Animator* animator)
+        {
+            if (animator->trackSystem != this) return;
+
+            animator->trackSystem = nullptr;
+
+            Tracks& propertyTracks = tracks[static_cast<size_t>(animator->trackProperty)];
+            const size_t index = animator->trackIndex;
+            const size_t last = propertyTracks.animators.size() - 1;
+
+            // move the last track into the freed slot
+            propertyTracks.animators[index] = propertyTracks.animators[last];
+            propertyTracks.animators[index]->trackIndex = index;
+            propertyTracks.actors[index] = propertyTracks.actors[last];
+            propertyTracks.startX[index] = propertyTracks.startX[last];
+            propertyTracks.startY[index] = propertyTracks.startY[last];
+            propertyTracks.startZ[index] = propertyTracks.startZ[last];
+            propertyTracks.diffX[index] = propertyTracks.diffX[last];
+            propertyTracks.diffY[index] = propertyTracks.diffY[last];
+            propertyTracks.diffZ[index] = propertyTracks.diffZ[last];
+            propertyTracks.progress[index] = propertyTracks.progress[last];
+            propertyTracks.changed[index] = propertyTracks.changed[last];
+
+            propertyTracks.animators.pop_back();
+            propertyTracks.actors.pop_back();
+            propertyTracks.startX.pop_back();
+            propertyTracks.startY.pop_back();
+            propertyTracks.startZ.pop_back();
+            propertyTracks.diffX.pop_back();
+            propertyTracks.diffY.pop_back();
+            propertyTracks.diffZ.pop_back();
+            propertyTracks.progress.pop_back();
+            propertyTracks.valueX.pop_back();
+            propertyTracks.valueY.pop_back();
+            propertyTracks.valueZ.pop_back();
+            propertyTracks.changed.pop_back();
+        }
+
+        void TweenSystem::removeTracks(Animator* animator)
+        {
+            removeTrack(animator);
+
+            for (Animator* child : animator->animators)
+            {
+                removeTracks(child);
+            }
+        }
+
+        void TweenSystem::setTrackProgress(Animator* animator, float progress)
+        {
+            if (animator->trackSystem != this) return;
+
+            tracks[static_cast<size_t>(animator->trackProperty)].progress[animator->trackIndex] = progress;
+
+            trackChanged(animator->trackProperty, animator->trackIndex);
+        }
+
+        void TweenSystem::trackChanged(Property property, size_t index)
+        {
+            Tracks& propertyTracks = tracks[static_cast<size_t>(property)];
+
+            if (updating)
+            {
+                propertyTracks.changed[index] = 1;
+                propertyTracks.anyChanged = true;
+            }
+            else if (Actor* actor = propertyTracks.actors[index])
+            {
+                // outside of the update (setProgress, reset) the value is applied at once
+                const float p = propertyTracks.progress[index];
+
+                writeValue(property, actor,
+                           propertyTracks.startX[index] + propertyTracks.diffX[index] * p,
+                           propertyTracks.startY[index] + propertyTracks.diffY[index] * p,
+                           propertyTracks.startZ[index] + propertyTracks.diffZ[index] * p);
+
+                if (property == Property::OPACITY)
+                    actor->markDirty();
+                else
+                    actor->updateLocalTransform();
+            }
+        }
+
+        void TweenSystem::writeValue(Property property, Actor* actor, float x, float y, float z)
+        {
+            switch (property)
+            {
+                case Property::POSITION:
+                    actor->position = Vector3(x, y, z);
+                    break;
+                case Property::ROTATION:
+                {
+                    Quaternion rotationQuaternion;
+                    rotationQuaternion.setEulerAngles(Vector3(x, y, z));
+                    actor->rotation = rotationQuaternion;
+                    break;
+                }
+                case Property::SCALE:
+                    actor->scale = Vector3(x, y, z);
+                    break;
+                case Property::OPACITY:
+                    actor->opacity = clamp(x, 0.0f, 1.0f);
+                    break;
+            }
+        }
+
+        void TweenSystem::flush()
+        {
+            for (size_t propertyIndex = 0; propertyIndex < PROPERTY_COUNT; ++propertyIndex)
+            {
+                Tracks& propertyTracks = tracks[propertyIndex];
+                if (!propertyTracks.anyChanged) continue;
+
+                const Property property = static_cast<Property>(propertyIndex);
+                std::vector<Actor*>& changedActors = (property == Property::OPACITY) ? fadedActors : transformedActors;
+
+                propertyTracks.evaluate();
+
+                // the fields are written directly, the actors are invalidated once below
+                for (size_t i = 0; i < propertyTracks.animators.size(); ++i)
+                {
+                    if (!propertyTracks.changed[i]) continue;
+
+                    propertyTracks.changed[i] = 0;
+
+                    if (Actor* actor = propertyTracks.actors[i])
+                    {
+                        writeValue(property, actor, propertyTracks.valueX[i], propertyTracks.valueY[i], propertyTracks.valueZ[i]);
+                        changedActors.push_back(actor);
+                    }
+                }
+
+                propertyTracks.anyChanged = false;
+            }
+
+            if (!transformedActors.empty())
+            {
+                std::sort(transformedActors.begin(), transformedActors.end());
+                transformedActors.erase(std::unique(transformedActors.begin(), transformedActors.end()), transformedActors.end());
+
+                for (Actor* actor : transformedActors)
+                {
+                    actor->updateLocalTransform();
+                }
+
+                transformedActors.clear();
+            }
+
+            if (!fadedActors.empty())
+            {
+                std::sort(fadedActors.begin(), fadedActors.end());
+                fadedActors.erase(std::unique(fadedActors.begin(), fadedActors.end()), fadedActors.end());
+
+                for (Actor* actor : fadedActors)
+                {
+                    actor->markDirty();
+                }
+
+                fadedActors.clear();
+            }
+        }
+
+        void TweenSystem::update(float delta)
+        {
+            updating = true;
+
+            // animators started during the update are updated from the next frame
+            const size_t count = animators.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                Animator* animator = animators[i];
+                if (!animator) continue;
+
+                if (animator->batched)
+                {
+                    // the time is advanced without virtual calls and the progress is stored in the track
+                    if (animator->step(delta))
+                    {
+                        if (animator->trackSystem == this)
+                        {
+                            Tracks& propertyTracks = tracks[static_cast<size_t>(animator->trackProperty)];
+                            propertyTracks.progress[animator->trackIndex] = animator->progress;
+                            propertyTracks.changed[animator->trackIndex] = 1;
+                            propertyTracks.anyChanged = true;
+                        }
+                    }
+                    else
+                        removeAnimator(animator);
+                }
+                else
+                    animator->update(delta);
+            }
+
+            updating = false;
+
+            if (animatorsRemoved)
+            {
+                animators.erase(std::remove(animators.begin(), animators.end(), nullptr), animators.end());
+
+                for (size_t i = 0; i < animators.size(); ++i)
+                {
+                    animators[i]->tweenSystemIndex = i;
+                }
+
+                animatorsRemoved = false;
+
+                if (animators.empty()) updateCallback.remove();
+            }
+
+            flush();
+        }
+    } // namespace scene
+} // namespace ouzel
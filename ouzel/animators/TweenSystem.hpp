@@ -0,0 +1,91 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "utils/Noncopyable.hpp"
+#include "core/UpdateCallback.hpp"
+#include "math/Vector3.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        class Actor;
+        class Animator;
+        class SceneManager;
+
+        // updates all the running animators from a single callback, keeps the tweened values in
+        // per-property structure-of-arrays tracks and writes them to the actors in batches
+        class TweenSystem: public Noncopyable
+        {
+            friend SceneManager;
+        public:
+            enum class Property
+            {
+                POSITION,
+                ROTATION,
+                SCALE,
+                OPACITY
+            };
+
+            ~TweenSystem();
+
+            void addAnimator(Animator* animator);
+            // also removes the tracks of the animator and its children (when it finishes, stops or is destroyed),
+            // they are created again when it is played
+            void removeAnimator(Animator* animator);
+
+            // creates or updates the track of the animator, the value is start + diff * progress
+            void setTrack(Animator* animator, Property property, const Vector3& start, const Vector3& diff);
+            void removeTrack(Animator* animator);
+            void removeTracks(Animator* animator);
+            void setTrackProgress(Animator* animator, float progress);
+
+            // during the update changed values are written at the end of it, otherwise immediately
+            void flush();
+
+        protected:
+            TweenSystem();
+
+            void update(float delta);
+
+            void trackChanged(Property property, size_t index);
+            void writeValue(Property property, Actor* actor, float x, float y, float z);
+
+            struct Tracks
+            {
+                void evaluate();
+
+                std::vector<Animator*> animators;
+                std::vector<Actor*> actors;
+                std::vector<float> startX;
+                std::vector<float> startY;
+                std::vector<float> startZ;
+                std::vector<float> diffX;
+                std::vector<float> diffY;
+                std::vector<float> diffZ;
+                std::vector<float> progress;
+                std::vector<float> valueX;
+                std::vector<float> valueY;
+                std::vector<float> valueZ;
+                std::vector<uint8_t> changed;
+                bool anyChanged = false;
+            };
+
+            UpdateCallback updateCallback;
+            bool updating = false;
+            bool animatorsRemoved = false;
+
+            std::vector<Animator*> animators;
+
+            static const size_t PROPERTY_COUNT = 4;
+            Tracks tracks[PROPERTY_COUNT];
+
+            std::vector<Actor*> transformedActors;
+            std::vector<Actor*> fadedActors;
+        };
+    } // namespace scene
+} // namespace ouzel
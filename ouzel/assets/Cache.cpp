@@ -23,6 +23,9 @@ namespace ouzel
     {
         Cache::Cache()
         {
+            hotReloadUpdateCallback.callback = std::bind(&Cache::reloadChangedAssets, this, std::placeholders::_1);
+            hotReloadUpdateCallback.interval = 0.5f;
+
             addLoader(&loaderBMF);
             addLoader(&loaderImage);
             addLoader(&loaderMTL);
@@ -108,6 +111,71 @@ namespace ouzel
             return true;
         }
 
+        static size_t getTextureMemorySize(const graphics::Texture& texture)
+        {
+            const Size2& size = texture.getSize();
+
+            size_t result = static_cast<size_t>(size.width) *
+                static_cast<size_t>(size.height) *
+                graphics::getPixelSize(texture.getPixelFormat());
+
+            // mip chain adds up to a third of the top level
+            if (texture.getMipmaps() != 1) result += result / 3;
+
+            return result;
+        }
+
+        bool Cache::reloadAsset(const std::string& filename)
+        {
+            if (textures.find(filename) == textures.end() &&
+                spriteData.find(filename) == spriteData.end() &&
+                particleSystemData.find(filename) == particleSystemData.end() &&
+                soundData.find(filename) == soundData.end())
+            {
+                return false;
+            }
+
+            reloading = true;
+            bool result = loadAsset(filename);
+            reloading = false;
+
+            if (result) Log(Log::Level::INFO) << "Reloaded asset " << filename;
+
+            return result;
+        }
+
+        bool Cache::setHotReload(bool enable)
+        {
+            if (enable == hotReload) return true;
+
+            if (enable)
+            {
+                if (!sharedEngine->getFileSystem()->watchResourcePaths())
+                {
+                    Log(Log::Level::ERR) << "Hot reload is not supported on this platform";
+                    return false;
+                }
+
+                sharedEngine->scheduleUpdate(&hotReloadUpdateCallback);
+            }
+            else
+            {
+                hotReloadUpdateCallback.remove();
+            }
+
+            hotReload = enable;
+
+            return true;
+        }
+
+        void Cache::reloadChangedAssets(float)
+        {
+            for (const std::string& filename : sharedEngine->getFileSystem()->getChangedResources())
+            {
+                reloadAsset(filename);
+            }
+        }
+
         bool Cache::preloadTexture(const std::string& filename, bool dynamic, bool mipmaps)
         {
             std::shared_ptr<graphics::Texture> texture = std::make_shared<graphics::Texture>();
@@ -116,33 +184,44 @@ namespace ouzel
                 return false;
             }
 
-            textures[filename] = texture;
+            addTexture(filename, texture);
 
             return true;
         }
 
-        const std::shared_ptr<graphics::Texture>& Cache::getTexture(const std::string& filename, bool dynamic, bool mipmaps) const
+        std::shared_ptr<graphics::Texture> Cache::getTexture(const std::string& filename, bool dynamic, bool mipmaps) const
         {
             auto i = textures.find(filename);
 
             if (i != textures.end())
             {
-                return i->second;
+                textureLRU.splice(textureLRU.begin(), textureLRU, i->second.lruIterator);
+
+                return i->second.texture;
             }
             else
             {
                 std::shared_ptr<graphics::Texture> result = std::make_shared<graphics::Texture>();
                 result->init(filename, dynamic ? graphics::Texture::DYNAMIC : 0, mipmaps ? 0 : 1);
 
-                i = textures.insert(std::make_pair(filename, result)).first;
-
-                return i->second;
+                return addTexture(filename, result);
             }
         }
 
         void Cache::setTexture(const std::string& filename, const std::shared_ptr<graphics::Texture>& texture)
         {
-            textures[filename] = texture;
+            auto i = textures.find(filename);
+
+            if (reloading && i != textures.end() && i->second.texture && texture)
+            {
+                // keep the existing texture object alive and move the new render resource into it
+                i->second.texture->swap(*texture);
+                addTexture(filename, i->second.texture);
+            }
+            else
+            {
+                addTexture(filename, texture);
+            }
         }
 
         void Cache::releaseTextures()
@@ -156,11 +235,92 @@ namespace ouzel
                 }
                 else
                 {
+                    textureMemoryUsage -= i->second.size;
+                    textureLRU.erase(i->second.lruIterator);
                     i = textures.erase(i);
                 }
             }
         }
 
+        void Cache::setTextureMemoryBudget(size_t newTextureMemoryBudget)
+        {
+            textureMemoryBudget = newTextureMemoryBudget;
+
+            evictTextures();
+        }
+
+        std::vector<Cache::ResidentAsset> Cache::getResidentTextures() const
+        {
+            std::vector<ResidentAsset> result;
+            result.reserve(textureLRU.size());
+
+            for (const std::string& filename : textureLRU)
+            {
+                const TextureEntry& entry = textures.find(filename)->second;
+
+                ResidentAsset residentAsset;
+                residentAsset.filename = filename;
+                residentAsset.size = entry.size;
+                residentAsset.references = entry.texture ? static_cast<uint32_t>(entry.texture.use_count() - 1) : 0;
+                result.push_back(residentAsset);
+            }
+
+            return result;
+        }
+
+        std::shared_ptr<graphics::Texture> Cache::addTexture(const std::string& filename, const std::shared_ptr<graphics::Texture>& texture) const
+        {
+            auto i = textures.find(filename);
+
+            if (i == textures.end())
+            {
+                i = textures.insert(std::make_pair(filename, TextureEntry())).first;
+                textureLRU.push_front(filename);
+                i->second.lruIterator = textureLRU.begin();
+            }
+            else
+            {
+                textureMemoryUsage -= i->second.size;
+                textureLRU.splice(textureLRU.begin(), textureLRU, i->second.lruIterator);
+            }
+
+            i->second.texture = texture;
+            i->second.size = texture ? getTextureMemorySize(*texture) : 0;
+            textureMemoryUsage += i->second.size;
+
+            // the result is copied before evicting, so it stays valid even if the entry is removed
+            std::shared_ptr<graphics::Texture> result = texture;
+
+            evictTextures();
+
+            return result;
+        }
+
+        void Cache::evictTextures() const
+        {
+            if (textureMemoryBudget == 0) return;
+
+            auto lruIterator = textureLRU.end();
+
+            while (textureMemoryUsage > textureMemoryBudget && lruIterator != textureLRU.begin())
+            {
+                --lruIterator;
+
+                // never evict the most recently used texture, it has just been requested
+                if (lruIterator == textureLRU.begin()) break;
+
+                auto textureIterator = textures.find(*lruIterator);
+
+                if (*lruIterator != graphics::TEXTURE_WHITE_PIXEL &&
+                    textureIterator->second.texture.use_count() <= 1)
+                {
+                    textureMemoryUsage -= textureIterator->second.size;
+                    textures.erase(textureIterator);
+                    lruIterator = textureLRU.erase(lruIterator);
+                }
+            }
+        }
+
         const std::shared_ptr<graphics::Shader>& Cache::getShader(const std::string& shaderName) const
         {
             auto i = shaders.find(shaderName);
@@ -171,9 +331,9 @@ namespace ouzel
             }
             else
             {
-                i = shaders.insert(std::make_pair(shaderName, nullptr)).first;
-
-                return i->second;
+                // nothing is inserted on a miss, so that lookups can be done while layers are drawn in parallel
+                static const std::shared_ptr<graphics::Shader> empty;
+                return empty;
             }
         }
 
@@ -188,7 +348,9 @@ namespace ouzel
             {
                 // don't delete default shaders
                 if (i->first == graphics::SHADER_COLOR ||
-                    i->first == graphics::SHADER_TEXTURE)
+                    i->first == graphics::SHADER_TEXTURE ||
+                    i->first == graphics::SHADER_TEXTURE_SDF ||
+                    i->first == graphics::SHADER_TEXTURE_INSTANCED)
                 {
                     ++i;
                 }
@@ -209,9 +371,8 @@ namespace ouzel
             }
             else
             {
-                i = blendStates.insert(std::make_pair(blendStateName, nullptr)).first;
-
-                return i->second;
+                static const std::shared_ptr<graphics::BlendState> empty;
+                return empty;
             }
         }
 
@@ -247,7 +408,7 @@ namespace ouzel
 
             scene::SpriteData newSpriteData;
 
-            if (extension == "json")
+            if (extension == "json" || extension == "sprite")
             {
                 if (!newSpriteData.init(filename, mipmaps))
                 {
@@ -258,7 +419,7 @@ namespace ouzel
             {
                 newSpriteData.texture = sharedEngine->getCache()->getTexture(filename, false, mipmaps);
 
-                if (newSpriteData.texture)
+                if (!newSpriteData.texture)
                 {
                     return false;
                 }
@@ -302,7 +463,7 @@ namespace ouzel
 
                 scene::SpriteData newSpriteData;
 
-                if (extension == "json")
+                if (extension == "json" || extension == "sprite")
                 {
                     newSpriteData.init(filename, mipmaps);
                 }
@@ -351,7 +512,7 @@ namespace ouzel
         {
             std::string extension = sharedEngine->getFileSystem()->getExtensionPart(filename);
 
-            if (extension == "json")
+            if (extension == "json" || extension == "particle")
             {
                 scene::ParticleSystemData newParticleSystemData;
                 if (!newParticleSystemData.init(filename, mipmaps))
@@ -379,7 +540,7 @@ namespace ouzel
 
                 std::string extension = sharedEngine->getFileSystem()->getExtensionPart(filename);
 
-                if (extension == "json")
+                if (extension == "json" || extension == "particle")
                 {
                     newParticleSystemData.init(filename, mipmaps);
 
@@ -400,9 +561,14 @@ namespace ouzel
             particleSystemData.clear();
         }
 
-        bool Cache::preloadFont(const std::string& filename, bool mipmaps)
+        static std::string getFontKey(const std::string& filename, bool sdf)
+        {
+            return sdf ? filename + "#sdf" : filename;
+        }
+
+        bool Cache::preloadFont(const std::string& filename, bool mipmaps, bool sdf)
         {
-            auto i = fonts.find(filename);
+            auto i = fonts.find(getFontKey(filename, sdf));
 
             if (i == fonts.end())
             {
@@ -410,6 +576,12 @@ namespace ouzel
 
                 if (extension == "fnt")
                 {
+                    if (sdf)
+                    {
+                        Log(Log::Level::ERR) << "Bitmap font " << filename << " can not be loaded as a signed distance field font";
+                        return false;
+                    }
+
                     std::shared_ptr<BMFont> font = std::make_shared<BMFont>();
                     if (!font->init(filename, mipmaps))
                     {
@@ -421,21 +593,22 @@ namespace ouzel
                 else if (extension == "ttf")
                 {
                     std::shared_ptr<TTFont> font = std::make_shared<TTFont>();
-                    if (!font->init(filename))
+                    if (!font->init(filename, mipmaps, sdf))
                     {
                         return false;
                     }
 
-                    fonts[filename] = font;
+                    fonts[getFontKey(filename, sdf)] = font;
                 }
             }
 
             return true;
         }
 
-        const std::shared_ptr<Font>& Cache::getFont(const std::string& filename, bool mipmaps) const
+        const std::shared_ptr<Font>& Cache::getFont(const std::string& filename, bool mipmaps, bool sdf) const
         {
-            auto i = fonts.find(filename);
+            std::string key = getFontKey(filename, sdf);
+            auto i = fonts.find(key);
 
             if (i != fonts.end())
             {
@@ -449,14 +622,14 @@ namespace ouzel
 
                 if (extension == "fnt")
                 {
-                    font = std::make_shared<BMFont>(filename, mipmaps);
+                    if (!sdf) font = std::make_shared<BMFont>(filename, mipmaps);
                 }
                 else if (extension == "ttf")
                 {
-                    font = std::make_shared<TTFont>(filename, mipmaps);
+                    font = std::make_shared<TTFont>(filename, mipmaps, sdf);
                 }
 
-                i = fonts.insert(std::make_pair(filename, font)).first;
+                i = fonts.insert(std::make_pair(key, font)).first;
 
                 return i->second;
             }
@@ -464,7 +637,7 @@ namespace ouzel
 
         void Cache::setFont(const std::string& filename, const std::shared_ptr<Font>& font)
         {
-            fonts[filename] = font;
+            fonts[getFontKey(filename, font && font->isSDF())] = font;
         }
 
         void Cache::releaseFonts()
@@ -533,7 +706,27 @@ namespace ouzel
 
         void Cache::setSoundData(const std::string& filename, const std::shared_ptr<audio::SoundData>& newSoundData)
         {
-            soundData[filename] = newSoundData;
+            auto i = soundData.find(filename);
+
+            if (reloading && i != soundData.end() && i->second && newSoundData)
+            {
+                std::shared_ptr<audio::SoundData> oldSoundData = i->second;
+
+                // the sample data is being read on the audio thread, so swap it there
+                sharedEngine->getAudio()->executeOnAudioThread([this, filename, oldSoundData, newSoundData]() {
+                    if (!oldSoundData->swap(*newSoundData))
+                    {
+                        // playing sounds keep the old data, new ones will use the reloaded data
+                        sharedEngine->executeOnUpdateThread([this, filename, newSoundData]() {
+                            soundData[filename] = newSoundData;
+                        });
+                    }
+                });
+            }
+            else
+            {
+                soundData[filename] = newSoundData;
+            }
         }
 
         void Cache::releaseSoundData()
@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <string>
-#include <map>
+#include <unordered_map>
 #include "utils/Noncopyable.hpp"
+#include "core/UpdateCallback.hpp"
 #include "assets/LoaderBMF.hpp"
 #include "assets/LoaderImage.hpp"
 #include "assets/LoaderMTL.hpp"
@@ -35,6 +37,13 @@ namespace ouzel
         class Cache: public Noncopyable
         {
         public:
+            struct ResidentAsset
+            {
+                std::string filename;
+                size_t size;
+                uint32_t references; // references held outside of the cache
+            };
+
             Cache();
             ~Cache();
 
@@ -44,13 +53,29 @@ namespace ouzel
             bool loadAsset(const std::string& filename);
             bool loadAssets(const std::vector<std::string>& filenames);
 
+            // reloads a resident asset through its loader, replacing the contents of the
+            // existing textures and sound data so that the objects using them pick up the change
+            bool reloadAsset(const std::string& filename);
+            // development mode that watches the resource directories and reloads changed assets
+            bool isHotReloadEnabled() const { return hotReload; }
+            bool setHotReload(bool enable);
+
             void clear();
 
             bool preloadTexture(const std::string& filename, bool dynamic = false, bool mipmaps = true);
-            const std::shared_ptr<graphics::Texture>& getTexture(const std::string& filename, bool dynamic = false, bool mipmaps = true) const;
+            // returned by value, because looking up a texture can evict others from the cache
+            std::shared_ptr<graphics::Texture> getTexture(const std::string& filename, bool dynamic = false, bool mipmaps = true) const;
             void setTexture(const std::string& filename, const std::shared_ptr<graphics::Texture>& texture);
             void releaseTextures();
 
+            // least recently used textures that are not referenced outside of the cache are evicted when
+            // the memory used by textures exceeds the budget (0 means no limit), other assets are not counted
+            size_t getTextureMemoryBudget() const { return textureMemoryBudget; }
+            void setTextureMemoryBudget(size_t newTextureMemoryBudget);
+            size_t getTextureMemoryUsage() const { return textureMemoryUsage; }
+            // resident textures ordered from the most to the least recently used
+            std::vector<ResidentAsset> getResidentTextures() const;
+
             const std::shared_ptr<graphics::Shader>& getShader(const std::string& shaderName) const;
             void setShader(const std::string& shaderName, const std::shared_ptr<graphics::Shader>& shader);
             void releaseShaders();
@@ -73,8 +98,9 @@ namespace ouzel
             void setParticleSystemData(const std::string& filename, const scene::ParticleSystemData& newParticleSystemData);
             void releaseParticleSystemData();
 
-            bool preloadFont(const std::string& filename, bool mipmaps = true);
-            const std::shared_ptr<Font>& getFont(const std::string& filename, bool mipmaps = true) const;
+            // signed distance field fonts are cached separately from the bitmap fonts of the same file
+            bool preloadFont(const std::string& filename, bool mipmaps = true, bool sdf = false);
+            const std::shared_ptr<Font>& getFont(const std::string& filename, bool mipmaps = true, bool sdf = false) const;
             void setFont(const std::string& filename, const std::shared_ptr<Font>& font);
             void releaseFonts();
 
@@ -104,15 +130,35 @@ namespace ouzel
             LoaderVorbis loaderVorbis;
             LoaderWave loaderWave;
             std::vector<Loader*> loaders;
-            mutable std::map<std::string, std::shared_ptr<graphics::Texture>> textures;
-            mutable std::map<std::string, std::shared_ptr<graphics::Shader>> shaders;
-            mutable std::map<std::string, scene::ParticleSystemData> particleSystemData;
-            mutable std::map<std::string, std::shared_ptr<graphics::BlendState>> blendStates;
-            mutable std::map<std::string, scene::SpriteData> spriteData;
-            mutable std::map<std::string, std::shared_ptr<Font>> fonts;
-            mutable std::map<std::string, std::shared_ptr<audio::SoundData>> soundData;
-            mutable std::map<std::string, std::shared_ptr<graphics::Material>> materials;
-            mutable std::map<std::string, scene::ModelData> modelData;
+
+            struct TextureEntry
+            {
+                std::shared_ptr<graphics::Texture> texture;
+                size_t size = 0;
+                std::list<std::string>::iterator lruIterator;
+            };
+
+            void reloadChangedAssets(float);
+
+            bool hotReload = false;
+            bool reloading = false;
+            UpdateCallback hotReloadUpdateCallback;
+
+            std::shared_ptr<graphics::Texture> addTexture(const std::string& filename, const std::shared_ptr<graphics::Texture>& texture) const;
+            void evictTextures() const;
+
+            mutable std::unordered_map<std::string, TextureEntry> textures;
+            mutable std::list<std::string> textureLRU;
+            mutable size_t textureMemoryUsage = 0;
+            size_t textureMemoryBudget = 0;
+            mutable std::unordered_map<std::string, std::shared_ptr<graphics::Shader>> shaders;
+            mutable std::unordered_map<std::string, scene::ParticleSystemData> particleSystemData;
+            mutable std::unordered_map<std::string, std::shared_ptr<graphics::BlendState>> blendStates;
+            mutable std::unordered_map<std::string, scene::SpriteData> spriteData;
+            mutable std::unordered_map<std::string, std::shared_ptr<Font>> fonts;
+            mutable std::unordered_map<std::string, std::shared_ptr<audio::SoundData>> soundData;
+            mutable std::unordered_map<std::string, std::shared_ptr<graphics::Material>> materials;
+            mutable std::unordered_map<std::string, scene::ModelData> modelData;
         };
     } // namespace assets
 } // namespace ouzel
@@ -32,7 +32,7 @@ namespace ouzel
 
             std::shared_ptr<graphics::Texture> texture(new graphics::Texture());
 
-            if (texture->init(image.getData(), image.getSize(), 0, 0, image.getPixelFormat()))
+            if (!texture->init(image.getData(), image.getSize(), 0, 0, image.getPixelFormat()))
             {
                 return false;
             }
@@ -10,7 +10,7 @@ namespace ouzel
     namespace assets
     {
         LoaderParticleSystem::LoaderParticleSystem():
-            Loader({"json"})
+            Loader({"json", "particle"})
         {
         }
 
@@ -9,15 +9,15 @@ namespace ouzel
 {
     namespace assets
     {
-        LoaderTTF::LoaderTTF():
-            Loader({"ttf"})
+        LoaderTTF::LoaderTTF(bool aMipmaps, bool aSDF):
+            Loader({"ttf"}), mipmaps(aMipmaps), sdf(aSDF)
         {
         }
 
         bool LoaderTTF::loadAsset(const std::string& filename, const std::vector<uint8_t>& data)
         {
             std::shared_ptr<TTFont> font = std::make_shared<TTFont>();
-            if (!font->init(data))
+            if (!font->init(data, mipmaps, sdf))
             {
                 return false;
             }
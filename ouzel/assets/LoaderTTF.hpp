@@ -12,8 +12,13 @@ namespace ouzel
         class LoaderTTF: public Loader
         {
         public:
-            LoaderTTF();
+            // a loader with SDF enabled can be added to the cache to load the fonts as signed distance fields
+            LoaderTTF(bool aMipmaps = true, bool aSDF = false);
             virtual bool loadAsset(const std::string& filename, const std::vector<uint8_t>& data) override;
+
+        protected:
+            bool mipmaps = true;
+            bool sdf = false;
         };
     } // namespace assets
 } // namespace ouzel
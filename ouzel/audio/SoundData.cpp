@@ -33,6 +33,11 @@ namespace ouzel
             return true;
         }
 
+        bool SoundData::swap(SoundData&)
+        {
+            return false;
+        }
+
         bool SoundData::getData(Stream* stream, uint32_t frames, uint32_t neededChannels, uint32_t neededSampleRate, float pitch, std::vector<float>& result)
         {
             uint32_t neededFrames = static_cast<uint32_t>(frames * pitch * sampleRate / neededSampleRate);
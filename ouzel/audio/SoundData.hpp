@@ -26,6 +26,10 @@ namespace ouzel
             virtual bool init(const std::string& filename);
             virtual bool init(const std::vector<uint8_t>& newData);
 
+            // exchanges the sample data with other sound data of the same type, must be called on the audio thread
+            // returns false if the data can't be replaced while streams are playing it
+            virtual bool swap(SoundData& other);
+
             virtual std::shared_ptr<Stream> createStream() = 0;
             bool getData(Stream* stream, uint32_t frames, uint32_t neededChannels, uint32_t neededSampleRate, float pitch, std::vector<float>& result);
 
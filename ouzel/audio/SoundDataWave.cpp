@@ -1,6 +1,7 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include <iterator>
 #include "SoundDataWave.hpp"
 #include "StreamWave.hpp"
@@ -212,6 +213,17 @@ namespace ouzel
             return true;
         }
 
+        bool SoundDataWave::swap(SoundData& other)
+        {
+            SoundDataWave& otherWave = static_cast<SoundDataWave&>(other);
+
+            std::swap(channels, otherWave.channels);
+            std::swap(sampleRate, otherWave.sampleRate);
+            data.swap(otherWave.data);
+
+            return true;
+        }
+
         std::shared_ptr<Stream> SoundDataWave::createStream()
         {
             return std::make_shared<StreamWave>();
@@ -226,6 +238,9 @@ namespace ouzel
 
             result.resize(neededSize);
 
+            // data could have been replaced by a shorter one while the stream was playing
+            if (streamWave->getOffset() > data.size()) streamWave->reset();
+
             while (neededSize > 0)
             {
                 if (stream->isRepeating() && (data.size() - streamWave->getOffset()) == 0) streamWave->reset();
@@ -19,6 +19,8 @@ namespace ouzel
 
             virtual bool init(const std::vector<uint8_t>& newData) override;
 
+            virtual bool swap(SoundData& other) override;
+
             virtual std::shared_ptr<Stream> createStream() override;
 
         protected:
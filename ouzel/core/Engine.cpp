@@ -75,15 +75,22 @@ namespace ouzel
         }
 #endif
 
-        for (UpdateCallback* updateCallback : updateCallbackAddSet)
+        // the network thread uses sharedEngine, so it has to be stopped before sharedEngine is cleared
+        network.disconnect();
+
+        while (UpdateCallback* updateCallback = newUpdateCallbacks.getFirst())
         {
+            newUpdateCallbacks.erase(updateCallback);
             updateCallback->engine = nullptr;
         }
 
-        for (UpdateCallback* updateCallback : updateCallbacks)
+        for (auto& updateCallbackList : updateCallbackLists)
         {
-            auto i = std::find(updateCallbackDeleteSet.begin(), updateCallbackDeleteSet.end(), updateCallback);
-            if (i == updateCallbackDeleteSet.end()) updateCallback->engine = nullptr;
+            while (UpdateCallback* updateCallback = updateCallbackList.second.getFirst())
+            {
+                updateCallbackList.second.erase(updateCallback);
+                updateCallback->engine = nullptr;
+            }
         }
 
         sharedEngine = nullptr;
@@ -131,6 +138,15 @@ namespace ouzel
 
         std::string graphicsDriverValue = userSettings.getValue("engine", "graphicsDriver", defaultSettings.getValue("engine", "graphicsDriver"));
 
+        // e.g. "-graphicsDriver software" for headless runs on machines without a GPU
+        for (auto arg = args.begin(); arg != args.end(); ++arg)
+        {
+            if (*arg == "-graphicsDriver" && arg + 1 != args.end())
+            {
+                graphicsDriverValue = *(arg + 1);
+            }
+        }
+
         if (!graphicsDriverValue.empty())
         {
             if (graphicsDriverValue == "default")
@@ -141,6 +157,10 @@ namespace ouzel
             {
                 graphicsDriver = ouzel::graphics::Renderer::Driver::EMPTY;
             }
+            else if (graphicsDriverValue == "software")
+            {
+                graphicsDriver = ouzel::graphics::Renderer::Driver::SOFTWARE;
+            }
             else if (graphicsDriverValue == "opengl")
             {
                 graphicsDriver = ouzel::graphics::Renderer::Driver::OPENGL;
@@ -265,6 +285,9 @@ namespace ouzel
         std::string debugAudioValue = userSettings.getValue("engine", "debugAudio", defaultSettings.getValue("engine", "debugAudio"));
         if (!debugAudioValue.empty()) debugAudio = (debugAudioValue == "true" || debugAudioValue == "1" || debugAudioValue == "yes");
 
+        std::string coalesceEventsValue = userSettings.getValue("engine", "coalesceEvents", defaultSettings.getValue("engine", "coalesceEvents"));
+        if (!coalesceEventsValue.empty()) eventDispatcher.setCoalesceEvents(coalesceEventsValue == "true" || coalesceEventsValue == "1" || coalesceEventsValue == "yes");
+
         if (graphicsDriver == graphics::Renderer::Driver::DEFAULT)
         {
             auto availableDrivers = graphics::Renderer::getAvailableRenderDrivers();
@@ -443,12 +466,14 @@ namespace ouzel
         }
     }
 
-    void Engine::exit()
+    void Engine::exit(int newExitCode)
     {
         paused = true;
 
         if (active)
         {
+            exitCode = newExitCode;
+
             Event event;
             event.type = Event::Type::ENGINE_STOP;
             eventDispatcher.postEvent(event);
@@ -485,50 +510,23 @@ namespace ouzel
             eventDispatcher.dispatchEvents();
             timer.update(delta);
 
-            for (UpdateCallback* updateCallback : updateCallbackDeleteSet)
+            while (UpdateCallback* updateCallback = newUpdateCallbacks.getFirst())
             {
-                auto i = std::find(updateCallbacks.begin(), updateCallbacks.end(), updateCallback);
-
-                if (i != updateCallbacks.end())
-                {
-                    updateCallbacks.erase(i);
-                }
+                newUpdateCallbacks.erase(updateCallback);
+                updateCallbackLists[updateCallback->priority].pushBack(updateCallback);
             }
 
-            updateCallbackDeleteSet.clear();
-
-            for (UpdateCallback* updateCallback : updateCallbackAddSet)
+            for (auto& updateCallbackList : updateCallbackLists)
             {
-                auto i = std::find(updateCallbacks.begin(), updateCallbacks.end(), updateCallback);
-
-                if (i == updateCallbacks.end())
+                for (UpdateCallback* updateCallback = updateCallbackList.second.getFirst(); updateCallback; updateCallback = nextUpdateCallback)
                 {
-                    auto upperBound = std::upper_bound(updateCallbacks.begin(), updateCallbacks.end(), updateCallback,
-                                                       [](const UpdateCallback* a, const UpdateCallback* b) {
-                                                           return a->priority > b->priority;
-                                                       });
-
-                    updateCallbacks.insert(upperBound, updateCallback);
+                    // unscheduleUpdate advances nextUpdateCallback if the callback removes the next one
+                    nextUpdateCallback = updateCallback->next;
+                    if (updateCallback->callback) updateCallback->callback(delta);
                 }
             }
 
-            updateCallbackAddSet.clear();
-
-            for (UpdateCallback* updateCallback : updateCallbacks)
-            {
-                auto i = std::find(updateCallbackDeleteSet.begin(), updateCallbackDeleteSet.end(), updateCallback);
-
-                if (i == updateCallbackDeleteSet.end())
-                {
-                    updateCallback->timeSinceLastUpdate += delta;
-
-                    if (updateCallback->timeSinceLastUpdate >= updateCallback->interval)
-                    {
-                        updateCallback->timeSinceLastUpdate = (updateCallback->interval > 0.0f) ? fmodf(updateCallback->timeSinceLastUpdate, updateCallback->interval) : 0.0f;
-                        if (updateCallback->callback) updateCallback->callback(delta);
-                    }
-                }
-            }
+            nextUpdateCallback = nullptr;
 
             if (renderer->getDevice()->getRefillQueue())
             {
@@ -568,37 +566,34 @@ namespace ouzel
 
     void Engine::scheduleUpdate(UpdateCallback* callback)
     {
-        if (callback->engine)
+        if (callback->interval > 0.0f)
         {
-            callback->engine->unscheduleUpdate(callback);
+            timer.scheduleRepeat(callback, callback->interval);
+            return;
         }
 
+        callback->remove();
         callback->engine = this;
 
-        updateCallbackAddSet.insert(callback);
-
-        auto setIterator = updateCallbackDeleteSet.find(callback);
-
-        if (setIterator != updateCallbackDeleteSet.end())
-        {
-            updateCallbackDeleteSet.erase(setIterator);
-        }
+        newUpdateCallbacks.pushBack(callback);
     }
 
     void Engine::unscheduleUpdate(UpdateCallback* callback)
     {
-        if (callback->engine == this)
+        if (callback->timer)
         {
-            callback->engine = nullptr;
+            callback->timer->unschedule(callback);
         }
 
-        updateCallbackDeleteSet.insert(callback);
-
-        auto setIterator = updateCallbackAddSet.find(callback);
-
-        if (setIterator != updateCallbackAddSet.end())
+        if (callback->engine == this)
         {
-            updateCallbackAddSet.erase(setIterator);
+            if (callback == nextUpdateCallback)
+            {
+                nextUpdateCallback = callback->next;
+            }
+
+            if (callback->list) callback->list->erase(callback);
+            callback->engine = nullptr;
         }
     }
 
@@ -3,13 +3,14 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
-#include <set>
 #include <vector>
 #include <functional>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include "Setup.h"
 #include "utils/Noncopyable.hpp"
 #include "core/UpdateCallback.hpp"
@@ -60,7 +61,8 @@ namespace ouzel
         void start();
         void pause();
         void resume();
-        void exit();
+        // the exit code is returned from run on the desktop platforms, the first call sets it
+        void exit(int newExitCode = EXIT_SUCCESS);
 
         bool isPaused() const { return paused; }
         bool isActive() const { return active; }
@@ -102,9 +104,11 @@ namespace ouzel
 
         std::chrono::steady_clock::time_point previousUpdateTime;
 
-        std::vector<UpdateCallback*> updateCallbacks;
-        std::set<UpdateCallback*> updateCallbackAddSet;
-        std::set<UpdateCallback*> updateCallbackDeleteSet;
+        // callbacks grouped by priority, highest priority first
+        std::map<int32_t, UpdateCallbackList, std::greater<int32_t>> updateCallbackLists;
+        // callbacks scheduled during this frame, they start receiving updates from the next frame
+        UpdateCallbackList newUpdateCallbacks;
+        UpdateCallback* nextUpdateCallback = nullptr;
 
 #if OUZEL_MULTITHREADED
         std::thread updateThread;
@@ -119,6 +123,7 @@ namespace ouzel
         std::atomic<bool> paused;
 
         std::atomic<bool> screenSaverEnabled;
+        int exitCode = EXIT_SUCCESS;
         std::vector<std::string> args;
     };
 
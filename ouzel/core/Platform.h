@@ -70,6 +70,7 @@
     #define OUZEL_OPENGL_INTERFACE_EGL 1
     #define OUZEL_SUPPORTS_OPENSL 1
     #define OUZEL_SUPPORTS_OPENSLES 1
+    #define OUZEL_SUPPORTS_EPOLL 1
     #define OUZEL_MULTITHREADED 1
 
     #if defined(__x86_64__)
@@ -93,6 +94,7 @@
     #define OUZEL_OPENGL_INTERFACE_EGL 1
     #define OUZEL_SUPPORTS_OPENAL 1
     #define OUZEL_SUPPORTS_ALSA 1
+    #define OUZEL_SUPPORTS_EPOLL 1
     #define OUZEL_MULTITHREADED 1
 
     #if defined(__x86_64__)
@@ -117,6 +119,7 @@
     #define OUZEL_OPENGL_INTERFACE_GLX 1
     #define OUZEL_SUPPORTS_OPENAL 1
     #define OUZEL_SUPPORTS_ALSA 1
+    #define OUZEL_SUPPORTS_EPOLL 1
     #define OUZEL_MULTITHREADED 1
 
     #if defined(__x86_64__)
@@ -1,15 +1,156 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <cmath>
 #include "Timer.hpp"
 
 namespace ouzel
 {
+    static uint64_t secondsToTicks(float seconds)
+    {
+        float ticks = roundf(seconds * Timer::TICKS_PER_SECOND);
+        return (ticks < 1.0f) ? 1 : static_cast<uint64_t>(ticks);
+    }
+
     Timer::Timer()
     {
     }
 
-    void Timer::update(float)
+    Timer::~Timer()
+    {
+        for (uint32_t level = 0; level < WHEEL_LEVELS; ++level)
+        {
+            for (uint32_t slot = 0; slot < WHEEL_SIZE; ++slot)
+            {
+                UpdateCallbackList& list = wheels[level][slot];
+
+                while (UpdateCallback* callback = list.getFirst())
+                {
+                    list.erase(callback);
+                    callback->timer = nullptr;
+                }
+            }
+        }
+    }
+
+    void Timer::scheduleOnce(UpdateCallback* callback, float delay)
+    {
+        callback->intervalTicks = 0;
+        schedule(callback, secondsToTicks(delay));
+    }
+
+    void Timer::scheduleRepeat(UpdateCallback* callback, float interval)
+    {
+        callback->intervalTicks = secondsToTicks(interval);
+        schedule(callback, callback->intervalTicks);
+    }
+
+    void Timer::unschedule(UpdateCallback* callback)
+    {
+        if (callback->timer == this)
+        {
+            if (callback->list) callback->list->erase(callback);
+            callback->timer = nullptr;
+        }
+    }
+
+    void Timer::schedule(UpdateCallback* callback, uint64_t ticks)
+    {
+        callback->remove();
+
+        callback->timer = this;
+        callback->lastTick = currentTick;
+        callback->expirationTick = currentTick + ticks;
+
+        insert(callback);
+    }
+
+    void Timer::insert(UpdateCallback* callback)
+    {
+        uint64_t ticks = callback->expirationTick - currentTick;
+        uint64_t expirationTick = callback->expirationTick;
+
+        // timers too far in the future are put in the last slot and reinserted when it is reached
+        if (ticks > MAX_TICKS)
+        {
+            ticks = MAX_TICKS;
+            expirationTick = currentTick + MAX_TICKS;
+        }
+
+        uint32_t level = 0;
+        while (level < WHEEL_LEVELS - 1 && ticks >= (1ULL << (WHEEL_BITS * (level + 1))))
+        {
+            ++level;
+        }
+
+        uint32_t slot = static_cast<uint32_t>(expirationTick >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1);
+        wheels[level][slot].pushBack(callback);
+    }
+
+    void Timer::processSlot(uint32_t level, uint32_t slot)
+    {
+        // move the callbacks out of the slot, because repeating timers can be put back into the same slot
+        UpdateCallbackList pending;
+
+        while (UpdateCallback* callback = wheels[level][slot].getFirst())
+        {
+            wheels[level][slot].erase(callback);
+            pending.pushBack(callback);
+        }
+
+        while (UpdateCallback* callback = pending.getFirst())
+        {
+            pending.erase(callback);
+
+            if (callback->expirationTick > currentTick)
+            {
+                // cascade to a lower level
+                insert(callback);
+                continue;
+            }
+
+            float delta = static_cast<float>(currentTick - callback->lastTick) / TICKS_PER_SECOND;
+            callback->lastTick = currentTick;
+
+            if (callback->intervalTicks)
+            {
+                callback->expirationTick = currentTick + callback->intervalTicks;
+                insert(callback);
+            }
+            else
+            {
+                callback->timer = nullptr;
+            }
+
+            if (callback->callback) callback->callback(delta);
+        }
+    }
+
+    void Timer::update(float delta)
     {
+        tickRemainder += delta * TICKS_PER_SECOND;
+        float ticks = floorf(tickRemainder);
+        tickRemainder -= ticks;
+
+        for (uint64_t tick = static_cast<uint64_t>(ticks); tick > 0; --tick)
+        {
+            ++currentTick;
+
+            // when a lower level wraps around, move the timers of the next slot of the upper level down
+            uint32_t wrappedLevels = 0;
+            while (wrappedLevels < WHEEL_LEVELS - 1 &&
+                   !(currentTick & ((1ULL << (WHEEL_BITS * (wrappedLevels + 1))) - 1)))
+            {
+                ++wrappedLevels;
+            }
+
+            // start from the highest level, so that the cascaded timers end up in slots that are processed after
+            for (uint32_t level = wrappedLevels; level > 0; --level)
+            {
+                processSlot(level, static_cast<uint32_t>(currentTick >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1));
+            }
+
+            processSlot(0, static_cast<uint32_t>(currentTick) & (WHEEL_SIZE - 1));
+        }
     }
 }
@@ -3,19 +3,47 @@
 
 #pragma once
 
+#include <cstdint>
 #include "utils/Noncopyable.hpp"
+#include "core/UpdateCallback.hpp"
 
 namespace ouzel
 {
     class Engine;
 
+    // hierarchical timer wheel with millisecond resolution
     class Timer: public Noncopyable
     {
         friend Engine;
     public:
+        static const uint32_t TICKS_PER_SECOND = 1000;
+
+        ~Timer();
+
+        // calls the callback once after the delay (in seconds)
+        void scheduleOnce(UpdateCallback* callback, float delay);
+        // calls the callback every interval (in seconds), the callback receives the time since the previous call
+        void scheduleRepeat(UpdateCallback* callback, float interval);
+        void unschedule(UpdateCallback* callback);
+
+        uint64_t getTicks() const { return currentTick; }
+
         void update(float delta);
 
     protected:
         Timer();
+
+        static const uint32_t WHEEL_BITS = 6;
+        static const uint32_t WHEEL_SIZE = 1 << WHEEL_BITS;
+        static const uint32_t WHEEL_LEVELS = 4;
+        static const uint64_t MAX_TICKS = (1ULL << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+
+        void schedule(UpdateCallback* callback, uint64_t ticks);
+        void insert(UpdateCallback* callback);
+        void processSlot(uint32_t level, uint32_t slot);
+
+        UpdateCallbackList wheels[WHEEL_LEVELS][WHEEL_SIZE];
+        uint64_t currentTick = 0;
+        float tickRemainder = 0.0f;
     };
 }
@@ -8,7 +8,7 @@ namespace ouzel
 {
     UpdateCallback::~UpdateCallback()
     {
-        if (engine) engine->unscheduleUpdate(this);
+        remove();
     }
 
     void UpdateCallback::remove()
@@ -18,5 +18,56 @@ namespace ouzel
             engine->unscheduleUpdate(this);
             engine = nullptr;
         }
+
+        if (timer)
+        {
+            timer->unschedule(this);
+            timer = nullptr;
+        }
+    }
+
+    void UpdateCallbackList::pushBack(UpdateCallback* callback)
+    {
+        callback->list = this;
+        callback->previous = last;
+        callback->next = nullptr;
+
+        if (last)
+        {
+            last->next = callback;
+        }
+        else
+        {
+            first = callback;
+        }
+
+        last = callback;
+    }
+
+    void UpdateCallbackList::erase(UpdateCallback* callback)
+    {
+        if (callback->list != this) return;
+
+        if (callback->previous)
+        {
+            callback->previous->next = callback->next;
+        }
+        else
+        {
+            first = callback->next;
+        }
+
+        if (callback->next)
+        {
+            callback->next->previous = callback->previous;
+        }
+        else
+        {
+            last = callback->previous;
+        }
+
+        callback->list = nullptr;
+        callback->previous = nullptr;
+        callback->next = nullptr;
     }
 }
@@ -9,10 +9,14 @@
 namespace ouzel
 {
     class Engine;
+    class Timer;
+    class UpdateCallbackList;
 
     class UpdateCallback
     {
         friend Engine;
+        friend Timer;
+        friend UpdateCallbackList;
     public:
         static const int32_t PRIORITY_MAX = 0x1000;
 
@@ -22,11 +26,37 @@ namespace ouzel
         void remove();
 
         std::function<void(float)> callback;
+        // callbacks with an interval are handled by the timer, the interval is read when the callback is scheduled
         float interval = 0.0f;
 
     protected:
         int32_t priority;
         Engine* engine = nullptr;
-        float timeSinceLastUpdate = 0.0f;
+        Timer* timer = nullptr;
+
+        // intrusive list links
+        UpdateCallbackList* list = nullptr;
+        UpdateCallback* previous = nullptr;
+        UpdateCallback* next = nullptr;
+
+        // timer state in ticks, interval of 0 means a one-shot timer
+        uint64_t expirationTick = 0;
+        uint64_t intervalTicks = 0;
+        uint64_t lastTick = 0;
+    };
+
+    // doubly linked list of callbacks, allowing constant time insertion and removal
+    class UpdateCallbackList
+    {
+    public:
+        UpdateCallback* getFirst() const { return first; }
+        bool isEmpty() const { return first == nullptr; }
+
+        void pushBack(UpdateCallback* callback);
+        void erase(UpdateCallback* callback);
+
+    private:
+        UpdateCallback* first = nullptr;
+        UpdateCallback* last = nullptr;
     };
 }
@@ -151,6 +151,7 @@ namespace ouzel
         switch (sharedEngine->getRenderer()->getDevice()->getDriver())
         {
             case graphics::Renderer::Driver::EMPTY:
+            case graphics::Renderer::Driver::SOFTWARE:
                 view = [[ViewIOS alloc] initWithFrame:windowFrame];
                 break;
 #if OUZEL_COMPILE_OPENGL
@@ -58,6 +58,9 @@ namespace ouzel
         {
             executeAll();
 
+            // there are no window events without an X server (software renderer)
+            if (!windowLinux->getDisplay()) continue;
+
             // XNextEvent will block if there is no event pending, so don't call it if engine is not paused
             if (paused || XPending(windowLinux->getDisplay()))
             {
@@ -169,7 +172,7 @@ namespace ouzel
 
         exit();
 
-        return EXIT_SUCCESS;
+        return exitCode;
     }
 
     void EngineLinux::executeOnMainThread(const std::function<void(void)>& func)
@@ -193,7 +196,7 @@ namespace ouzel
         executeOnMainThread([this, newScreenSaverEnabled]() {
             WindowResourceLinux* windowLinux = static_cast<WindowResourceLinux*>(window.getResource());
 
-            XScreenSaverSuspend(windowLinux->getDisplay(), !newScreenSaverEnabled);
+            if (windowLinux->getDisplay()) XScreenSaverSuspend(windowLinux->getDisplay(), !newScreenSaverEnabled);
         });
     }
 
@@ -45,11 +45,11 @@ namespace ouzel
         void handleResize(const Size2& newSize);
 
         XVisualInfo* visualInfo = nullptr;
-        Display* display = nullptr;
+        Display* display = nullptr; // null when no X server is used (software renderer)
         ::Window window = 0;
-        Atom deleteMessage;
-        Atom protocols;
-        Atom state;
-        Atom stateFullscreen;
+        Atom deleteMessage = None;
+        Atom protocols = None;
+        Atom state = None;
+        Atom stateFullscreen = None;
     };
 }
@@ -37,7 +37,7 @@ namespace ouzel
 
         exit();
 
-        return EXIT_SUCCESS;
+        return exitCode;
     }
 
     void EngineRasp::executeOnMainThread(const std::function<void(void)>& func)
@@ -90,6 +90,7 @@ namespace ouzel
         switch (sharedEngine->getRenderer()->getDevice()->getDriver())
         {
             case graphics::Renderer::Driver::EMPTY:
+            case graphics::Renderer::Driver::SOFTWARE:
                 view = [[ViewTVOS alloc] initWithFrame:windowFrame];
                 break;
 #if OUZEL_COMPILE_OPENGL
@@ -136,7 +136,7 @@ namespace ouzel
 
         exit();
 
-        return EXIT_SUCCESS;
+        return exitCode;
     }
 
     void EngineWin::executeOnMainThread(const std::function<void(void)>& func)
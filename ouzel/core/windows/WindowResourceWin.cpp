@@ -270,8 +270,9 @@ static LRESULT CALLBACK windowProc(HWND window, UINT msg, WPARAM wParam, LPARAM
         }
         case WM_ERASEBKGND:
         {
-            // Erase background only for the Empty renderer
-            if (ouzel::sharedEngine->getRenderer()->getDevice()->getDriver() != ouzel::graphics::Renderer::Driver::EMPTY)
+            // Erase background only for the Empty and Software renderers, which don't draw to the window
+            if (ouzel::sharedEngine->getRenderer()->getDevice()->getDriver() != ouzel::graphics::Renderer::Driver::EMPTY &&
+                ouzel::sharedEngine->getRenderer()->getDevice()->getDriver() != ouzel::graphics::Renderer::Driver::SOFTWARE)
             {
                 return TRUE;
             }
@@ -375,7 +376,8 @@ namespace ouzel
         // Application icon should be the first resource
         wc.hIcon = LoadIconW(instance, MAKEINTRESOURCEW(101));
         wc.hCursor = LoadCursor(nullptr, IDC_ARROW);
-        if (sharedEngine->getRenderer()->getDevice()->getDriver() == graphics::Renderer::Driver::EMPTY)
+        if (sharedEngine->getRenderer()->getDevice()->getDriver() == graphics::Renderer::Driver::EMPTY ||
+            sharedEngine->getRenderer()->getDevice()->getDriver() == graphics::Renderer::Driver::SOFTWARE)
         {
             wc.hbrBackground = static_cast<HBRUSH>(GetStockObject(COLOR_WINDOW));
         }
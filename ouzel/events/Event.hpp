@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include "audio/Sound.hpp"
@@ -106,6 +107,18 @@ namespace ouzel
         audio::Sound* sound;
     };
 
+    namespace network
+    {
+        class Client;
+    }
+
+    struct NetworkEvent
+    {
+        std::shared_ptr<network::Client> client;
+        bool datagram = false; // received over UDP
+        std::vector<uint8_t> data;
+    };
+
     struct UserEvent
     {
         std::vector<std::string> parameters;
@@ -172,6 +185,11 @@ namespace ouzel
             SOUND_RESET,
             SOUND_FINISH,
 
+            // network events
+            NETWORK_CONNECT, // connection with the client established
+            NETWORK_DISCONNECT, // connection with the client closed
+            NETWORK_RECEIVE, // message or datagram received from the client
+
             USER // user defined event
         };
 
@@ -186,6 +204,7 @@ namespace ouzel
         UIEvent uiEvent;
         AnimationEvent animationEvent;
         SoundEvent soundEvent;
+        NetworkEvent networkEvent;
         UserEvent userEvent;
     };
 }
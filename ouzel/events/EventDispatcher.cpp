@@ -7,7 +7,9 @@
 
 namespace ouzel
 {
-    EventDispatcher::EventDispatcher()
+    EventDispatcher::EventDispatcher():
+        coalesceEvents(false),
+        previousDispatchTime(std::chrono::steady_clock::now())
     {
     }
 
@@ -56,6 +58,24 @@ namespace ouzel
 
         eventHandlerAddSet.clear();
 
+        {
+            std::lock_guard<std::mutex> lock(eventQueueMutex);
+
+            statistics.postedEvents = postedEvents;
+            statistics.coalescedEvents = coalescedEvents;
+            postedEvents = 0;
+            coalescedEvents = 0;
+        }
+
+        std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+        auto diff = std::chrono::duration_cast<std::chrono::microseconds>(currentTime - previousDispatchTime);
+        previousDispatchTime = currentTime;
+
+        statistics.totalPostedEvents += statistics.postedEvents;
+        statistics.totalCoalescedEvents += statistics.coalescedEvents;
+        statistics.dispatchedEvents = 0;
+        if (diff.count() > 0) statistics.postedEventRate = statistics.postedEvents * 1000000.0f / diff.count();
+
         Event event;
 
         for (;;)
@@ -68,6 +88,8 @@ namespace ouzel
                 eventQueue.pop();
             }
 
+            ++statistics.dispatchedEvents;
+
             bool propagate = true;
 
             for (const EventHandler* eventHandler : eventHandlers)
@@ -163,6 +185,14 @@ namespace ouzel
                                 propagate = eventHandler->soundHandler(event.type, event.soundEvent);
                             }
                             break;
+                        case Event::Type::NETWORK_CONNECT:
+                        case Event::Type::NETWORK_DISCONNECT:
+                        case Event::Type::NETWORK_RECEIVE:
+                            if (eventHandler->networkHandler)
+                            {
+                                propagate = eventHandler->networkHandler(event.type, event.networkEvent);
+                            }
+                            break;
                         case Event::Type::USER:
                             if (eventHandler->userHandler)
                             {
@@ -220,6 +250,71 @@ namespace ouzel
     {
         std::lock_guard<std::mutex> lock(eventQueueMutex);
 
+        ++postedEvents;
+
+        if (coalesceEvents && coalesceEvent(event))
+        {
+            ++coalescedEvents;
+            return;
+        }
+
         eventQueue.push(event);
     }
+
+    void EventDispatcher::postEvents(std::vector<Event>& events)
+    {
+        std::lock_guard<std::mutex> lock(eventQueueMutex);
+
+        bool coalesce = coalesceEvents;
+
+        for (Event& event : events)
+        {
+            ++postedEvents;
+
+            if (coalesce && coalesceEvent(event))
+            {
+                ++coalescedEvents;
+                continue;
+            }
+
+            eventQueue.push(std::move(event));
+        }
+
+        events.clear();
+    }
+
+    bool EventDispatcher::coalesceEvent(const Event& event)
+    {
+        // only the last queued event is merged, so the order of presses, releases and moves is kept
+        if (eventQueue.empty()) return false;
+
+        Event& previousEvent = eventQueue.back();
+
+        if (previousEvent.type != event.type) return false;
+
+        switch (event.type)
+        {
+            case Event::Type::MOUSE_MOVE:
+                if (previousEvent.mouseEvent.modifiers != event.mouseEvent.modifiers) return false;
+
+                previousEvent.mouseEvent.difference += event.mouseEvent.difference;
+                previousEvent.mouseEvent.position = event.mouseEvent.position;
+                return true;
+            case Event::Type::MOUSE_SCROLL:
+                if (previousEvent.mouseEvent.modifiers != event.mouseEvent.modifiers) return false;
+
+                previousEvent.mouseEvent.scroll += event.mouseEvent.scroll;
+                previousEvent.mouseEvent.position = event.mouseEvent.position;
+                return true;
+            case Event::Type::TOUCH_MOVE:
+                if (previousEvent.touchEvent.touchId != event.touchEvent.touchId) return false;
+
+                previousEvent.touchEvent.difference += event.touchEvent.difference;
+                previousEvent.touchEvent.position = event.touchEvent.position;
+                previousEvent.touchEvent.force = event.touchEvent.force;
+                return true;
+            default:
+                return false;
+        }
+    }
 }
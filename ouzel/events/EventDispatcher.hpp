@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <mutex>
 #include <queue>
@@ -26,15 +28,43 @@ namespace ouzel
         void removeEventHandler(EventHandler* eventHandler);
 
         void postEvent(const Event& event);
+        // posts all the events under a single lock and clears the vector
+        void postEvents(std::vector<Event>& events);
+
+        struct Statistics
+        {
+            uint32_t postedEvents = 0; // since the previous dispatch
+            uint32_t coalescedEvents = 0; // posted events that were merged into the previous event
+            uint32_t dispatchedEvents = 0;
+            uint64_t totalPostedEvents = 0;
+            uint64_t totalCoalescedEvents = 0;
+            float postedEventRate = 0.0f; // posted events per second
+        };
+
+        // merges mouse move, mouse scroll and touch move events with the previous queued event of the same kind,
+        // the differences and scroll amounts are accumulated and the last position is kept
+        void setCoalesceEvents(bool coalesce) { coalesceEvents = coalesce; }
+        bool getCoalesceEvents() const { return coalesceEvents; }
+
+        const Statistics& getStatistics() const { return statistics; }
 
     protected:
         EventDispatcher();
 
+        bool coalesceEvent(const Event& event);
+
         std::vector<EventHandler*> eventHandlers;
         std::set<EventHandler*> eventHandlerAddSet;
         std::set<EventHandler*> eventHandlerDeleteSet;
 
         std::mutex eventQueueMutex;
         std::queue<Event> eventQueue;
+
+        std::atomic<bool> coalesceEvents;
+        uint32_t postedEvents = 0;
+        uint32_t coalescedEvents = 0;
+
+        Statistics statistics;
+        std::chrono::steady_clock::time_point previousDispatchTime;
     };
 }
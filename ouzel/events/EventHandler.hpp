@@ -31,6 +31,7 @@ namespace ouzel
         std::function<bool(Event::Type, const UIEvent&)> uiHandler;
         std::function<bool(Event::Type, const AnimationEvent&)> animationHandler;
         std::function<bool(Event::Type, const SoundEvent&)> soundHandler;
+        std::function<bool(Event::Type, const NetworkEvent&)> networkHandler;
         std::function<bool(Event::Type, const UserEvent&)> userHandler;
 
     protected:
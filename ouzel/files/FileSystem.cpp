@@ -22,6 +22,10 @@ namespace ouzel
     {
     }
 
+    FileSystem::~FileSystem()
+    {
+    }
+
     std::string FileSystem::getStorageDirectory(bool) const
     {
         return "";
@@ -79,45 +83,15 @@ namespace ouzel
 
         file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
 
+        // the file could have been cached as missing
+        clearPathCache();
+
         return true;
     }
 
     bool FileSystem::resourceFileExists(const std::string& filename) const
     {
-        if (isAbsolutePath(filename))
-        {
-            return fileExists(filename);
-        }
-        else
-        {
-            std::string str = appPath + DIRECTORY_SEPARATOR + filename;
-
-            if (fileExists(str))
-            {
-                return true;
-            }
-            else
-            {
-                for (const std::string& path : resourcePaths)
-                {
-                    if (isAbsolutePath(path)) // if resource path is absolute
-                    {
-                        str = path + DIRECTORY_SEPARATOR + filename;
-                    }
-                    else
-                    {
-                        str = appPath + DIRECTORY_SEPARATOR + path + DIRECTORY_SEPARATOR + filename;
-                    }
-
-                    if (fileExists(str))
-                    {
-                        return true;
-                    }
-                }
-            }
-
-            return false;
-        }
+        return !getPath(filename).empty();
     }
 
     bool FileSystem::directoryExists(const std::string& dirname) const
@@ -150,33 +124,74 @@ namespace ouzel
             {
                 return filename;
             }
+
+            return "";
         }
-        else
+
+        std::lock_guard<std::mutex> lock(pathCacheMutex);
+
+        auto i = pathCache.find(filename);
+
+        if (i != pathCache.end())
         {
-            std::string str = appPath + DIRECTORY_SEPARATOR + filename;
+            savedFileChecks += i->second.fileChecks;
+            return i->second.path;
+        }
 
-            if (fileExists(str))
+        ResolvedPath resolvedPath;
+        resolvedPath.fileChecks = 0;
+        resolvedPath.path = resolvePath(filename, resolvedPath.fileChecks);
+
+        // without a watcher nothing would notice the file being created later
+        if (!resolvedPath.path.empty() ||
+            (resourcePathsWatched && !isInApplicationSubdirectory(filename)))
+        {
+            pathCache[filename] = resolvedPath;
+        }
+
+        return resolvedPath.path;
+    }
+
+    uint64_t FileSystem::getSavedFileChecks() const
+    {
+        std::lock_guard<std::mutex> lock(pathCacheMutex);
+
+        return savedFileChecks;
+    }
+
+    bool FileSystem::isInApplicationSubdirectory(const std::string& filename) const
+    {
+        size_t pos = filename.find_first_of("/\\");
+
+        return pos != std::string::npos &&
+            directoryExists(appPath + DIRECTORY_SEPARATOR + filename.substr(0, pos));
+    }
+
+    std::string FileSystem::resolvePath(const std::string& filename, uint32_t& fileChecks) const
+    {
+        std::string str = appPath + DIRECTORY_SEPARATOR + filename;
+
+        ++fileChecks;
+        if (fileExists(str))
+        {
+            return str;
+        }
+
+        for (const std::string& path : resourcePaths)
+        {
+            if (isAbsolutePath(path)) // if resource path is absolute
             {
-                return str;
+                str = path + DIRECTORY_SEPARATOR + filename;
             }
             else
             {
-                for (const std::string& path : resourcePaths)
-                {
-                    if (isAbsolutePath(path)) // if resource path is absolute
-                    {
-                        str = path + DIRECTORY_SEPARATOR + filename;
-                    }
-                    else
-                    {
-                        str = appPath + DIRECTORY_SEPARATOR + path + DIRECTORY_SEPARATOR + filename;
-                    }
-
-                    if (fileExists(str))
-                    {
-                        return str;
-                    }
-                }
+                str = appPath + DIRECTORY_SEPARATOR + path + DIRECTORY_SEPARATOR + filename;
+            }
+
+            ++fileChecks;
+            if (fileExists(str))
+            {
+                return str;
             }
         }
 
@@ -190,9 +205,27 @@ namespace ouzel
         if (i == resourcePaths.end())
         {
             resourcePaths.push_back(path);
+            clearPathCache();
         }
     }
 
+    void FileSystem::clearPathCache() const
+    {
+        std::lock_guard<std::mutex> lock(pathCacheMutex);
+
+        pathCache.clear();
+    }
+
+    bool FileSystem::watchResourcePaths()
+    {
+        return false;
+    }
+
+    std::vector<std::string> FileSystem::getChangedResources()
+    {
+        return std::vector<std::string>();
+    }
+
     void FileSystem::addArchive(std::shared_ptr<Archive>& archive)
     {
         auto i = std::find(archives.begin(), archives.end(), archive);
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cstdint>
 #include "utils/Noncopyable.hpp"
@@ -20,6 +22,8 @@ namespace ouzel
     public:
         static const std::string DIRECTORY_SEPARATOR;
 
+        virtual ~FileSystem();
+
         virtual std::string getStorageDirectory(bool user = true) const;
         virtual std::string getTempDirectory() const;
 
@@ -31,6 +35,16 @@ namespace ouzel
         void addResourcePath(const std::string& path);
         void addArchive(std::shared_ptr<Archive>& archive);
 
+        // resolved resource paths are cached until the cache is cleared or a resource path is added,
+        // missing files are only cached while the resource paths are watched
+        void clearPathCache() const;
+        uint64_t getSavedFileChecks() const;
+        // invalidate the path cache automatically when files in resource directories change,
+        // the subdirectories of the application directory are not watched
+        virtual bool watchResourcePaths();
+        // paths (relative to the resource directory) of the watched files that were rewritten since the last call
+        virtual std::vector<std::string> getChangedResources();
+
         static std::string getExtensionPart(const std::string& path);
         static std::string getFilenamePart(const std::string& path);
         static std::string getDirectoryPart(const std::string& path);
@@ -42,8 +56,22 @@ namespace ouzel
     protected:
         FileSystem();
 
+        std::string resolvePath(const std::string& filename, uint32_t& fileChecks) const;
+        bool isInApplicationSubdirectory(const std::string& filename) const;
+
         std::string appPath;
         std::vector<std::string> resourcePaths;
         std::vector<std::shared_ptr<Archive>> archives;
+
+        struct ResolvedPath
+        {
+            std::string path;
+            uint32_t fileChecks;
+        };
+
+        mutable std::mutex pathCacheMutex;
+        mutable std::unordered_map<std::string, ResolvedPath> pathCache;
+        mutable uint64_t savedFileChecks = 0; // guarded by pathCacheMutex
+        bool resourcePathsWatched = false; // guarded by pathCacheMutex
     };
 }
@@ -1,10 +1,14 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <dirent.h>
 #include <unistd.h>
 #include <pwd.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
 #include "FileSystemLinux.hpp"
+#include "core/Engine.hpp"
 #include "utils/Log.hpp"
 
 extern std::string DEVELOPER_NAME;
@@ -15,6 +19,8 @@ namespace ouzel
 {
     FileSystemLinux::FileSystemLinux()
     {
+        updateCallback.callback = std::bind(&FileSystemLinux::update, this, std::placeholders::_1);
+
         if (readlink("/proc/self/exe", TEMP_BUFFER, sizeof(TEMP_BUFFER)) != -1)
         {
             appPath = getDirectoryPart(TEMP_BUFFER);
@@ -25,6 +31,174 @@ namespace ouzel
         }
     }
 
+    FileSystemLinux::~FileSystemLinux()
+    {
+        if (notifyFd != -1) close(notifyFd);
+    }
+
+    bool FileSystemLinux::watchResourcePaths()
+    {
+        if (notifyFd != -1) close(notifyFd);
+
+        notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        watchDirectories.clear();
+
+        if (notifyFd == -1)
+        {
+            Log(Log::Level::ERR) << "Failed to initialize inotify";
+
+            std::lock_guard<std::mutex> lock(pathCacheMutex);
+            pathCache.clear();
+            resourcePathsWatched = false;
+
+            return false;
+        }
+
+        // only the files directly in the application directory are searched without a resource path,
+        // so its subdirectories are not watched
+        addWatch(appPath, "", false);
+
+        for (const std::string& path : resourcePaths)
+        {
+            if (isAbsolutePath(path)) // if resource path is absolute
+            {
+                addWatch(path, "", true);
+            }
+            else
+            {
+                addWatch(appPath + DIRECTORY_SEPARATOR + path, "", true);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pathCacheMutex);
+            pathCache.clear();
+            resourcePathsWatched = true;
+        }
+
+        sharedEngine->scheduleUpdate(&updateCallback);
+
+        return true;
+    }
+
+    void FileSystemLinux::addWatch(const std::string& directory, const std::string& relativePath, bool recursive) const
+    {
+        int watchDescriptor = inotify_add_watch(notifyFd, directory.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE);
+
+        if (watchDescriptor == -1)
+        {
+            Log(Log::Level::WARN) << "Failed to watch directory " << directory;
+            return;
+        }
+
+        WatchDirectory& watchDirectory = watchDirectories[watchDescriptor];
+        watchDirectory.path = directory;
+        watchDirectory.relativePath = relativePath;
+        watchDirectory.recursive = recursive;
+
+        if (!recursive) return;
+
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) return;
+
+        while (dirent* entry = readdir(dir))
+        {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..") continue;
+
+            std::string path = directory + DIRECTORY_SEPARATOR + name;
+
+            if (directoryExists(path))
+            {
+                addWatch(path, relativePath.empty() ? name : relativePath + DIRECTORY_SEPARATOR + name, true);
+            }
+        }
+
+        closedir(dir);
+    }
+
+    void FileSystemLinux::update(float)
+    {
+        std::lock_guard<std::mutex> lock(pathCacheMutex);
+
+        readNotifyEvents();
+
+        if (directoriesChanged)
+        {
+            pathCache.clear();
+            directoriesChanged = false;
+        }
+    }
+
+    std::vector<std::string> FileSystemLinux::getChangedResources()
+    {
+        std::lock_guard<std::mutex> lock(pathCacheMutex);
+
+        readNotifyEvents();
+
+        std::vector<std::string> result;
+        result.swap(changedFiles);
+
+        if (directoriesChanged)
+        {
+            pathCache.clear();
+            directoriesChanged = false;
+        }
+
+        return result;
+    }
+
+    void FileSystemLinux::readNotifyEvents() const
+    {
+        if (notifyFd == -1) return;
+
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+
+        while ((length = read(notifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                if (event->mask & IN_IGNORED)
+                {
+                    watchDirectories.erase(event->wd);
+                    continue;
+                }
+
+                auto directoryIterator = watchDirectories.find(event->wd);
+                if (directoryIterator == watchDirectories.end() || event->len == 0) continue;
+
+                std::string name = directoryIterator->second.relativePath.empty() ?
+                    std::string(event->name) :
+                    directoryIterator->second.relativePath + DIRECTORY_SEPARATOR + event->name;
+
+                if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO))
+                {
+                    directoriesChanged = true;
+                }
+
+                // new subdirectories of recursive watches are watched too, the watches of removed ones are dropped by the kernel
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) && (event->mask & IN_ISDIR))
+                {
+                    if (directoryIterator->second.recursive)
+                    {
+                        addWatch(directoryIterator->second.path + DIRECTORY_SEPARATOR + event->name, name, true);
+                    }
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    if (std::find(changedFiles.begin(), changedFiles.end(), name) == changedFiles.end())
+                    {
+                        changedFiles.push_back(name);
+                    }
+                }
+            }
+        }
+    }
+
     std::string FileSystemLinux::getStorageDirectory(bool user) const
     {
         std::string path;
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <map>
 #include "files/FileSystem.hpp"
+#include "core/UpdateCallback.hpp"
 
 namespace ouzel
 {
@@ -13,10 +15,34 @@ namespace ouzel
     {
         friend Engine;
     public:
+        virtual ~FileSystemLinux();
+
         virtual std::string getStorageDirectory(bool user = true) const override;
         virtual std::string getTempDirectory() const override;
 
+        virtual bool watchResourcePaths() override;
+        virtual std::vector<std::string> getChangedResources() override;
+
     protected:
         FileSystemLinux();
+
+        // drains the notifications once per frame and invalidates the path cache if files were added or removed
+        void update(float);
+        // watches the directory and, if recursive, its subdirectories, the changed files are reported relative to the watched root
+        void addWatch(const std::string& directory, const std::string& relativePath, bool recursive) const;
+        void readNotifyEvents() const;
+
+        struct WatchDirectory
+        {
+            std::string path;
+            std::string relativePath;
+            bool recursive;
+        };
+
+        UpdateCallback updateCallback;
+        int notifyFd = -1;
+        mutable std::map<int, WatchDirectory> watchDirectories;
+        mutable bool directoriesChanged = false;
+        mutable std::vector<std::string> changedFiles;
     };
 }
@@ -2,7 +2,9 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include <iterator>
 #include "RenderDevice.hpp"
+#include "RenderGraph.hpp"
 #include "utils/Log.hpp"
 
 namespace ouzel
@@ -13,6 +15,10 @@ namespace ouzel
             driver(aDriver),
             projectionTransform(Matrix4::IDENTITY),
             renderTargetProjectionTransform(Matrix4::IDENTITY),
+            shaderConstantUploadCount(0),
+            skippedShaderConstantUploadCount(0),
+            stateChangeCount(0),
+            renderGraph(new RenderGraph(this)),
             refillQueue(true),
             currentFPS(0.0f),
             accumulatedFPS(0.0f)
@@ -96,6 +102,11 @@ namespace ouzel
 
             ++currentFrame;
 
+            if (!renderGraph->compile(drawCommands, currentFrame))
+            {
+                return false;
+            }
+
             if (!draw(drawCommands))
             {
                 return false;
@@ -134,6 +145,15 @@ namespace ouzel
             return std::vector<Size2>();
         }
 
+        TextureResource* RenderDevice::createTransientTexture()
+        {
+            std::lock_guard<std::mutex> lock(resourceMutex);
+
+            TextureResource* texture = new TransientTextureResource();
+            resources.push_back(std::unique_ptr<RenderResource>(texture));
+            return texture;
+        }
+
         void RenderDevice::deleteResource(RenderResource* resource)
         {
             std::lock_guard<std::mutex> lock(resourceMutex);
@@ -151,6 +171,12 @@ namespace ouzel
 
         bool RenderDevice::addDrawCommand(const DrawCommand& drawCommand)
         {
+            if (CommandList* commandList = getCommandList())
+            {
+                commandList->push_back(drawCommand);
+                return true;
+            }
+
             std::lock_guard<std::mutex> lock(drawQueueMutex);
 
             drawQueue.push_back(drawCommand);
@@ -158,6 +184,76 @@ namespace ouzel
             return true;
         }
 
+        void RenderDevice::addRecordingThread(std::thread::id threadId)
+        {
+            for (const Recorder& recorder : recorders)
+            {
+                if (recorder.threadId == threadId) return;
+            }
+
+            Recorder recorder;
+            recorder.threadId = threadId;
+            recorder.commandList = nullptr;
+            recorders.push_back(recorder);
+        }
+
+        void RenderDevice::beginCommandList(CommandList& commandList)
+        {
+            std::thread::id threadId = std::this_thread::get_id();
+
+            for (Recorder& recorder : recorders)
+            {
+                if (recorder.threadId == threadId)
+                {
+                    recorder.commandList = &commandList;
+                    return;
+                }
+            }
+
+            Log(Log::Level::ERR) << "Command list can not be recorded on an unregistered thread";
+        }
+
+        void RenderDevice::endCommandList()
+        {
+            std::thread::id threadId = std::this_thread::get_id();
+
+            for (Recorder& recorder : recorders)
+            {
+                if (recorder.threadId == threadId)
+                {
+                    recorder.commandList = nullptr;
+                    return;
+                }
+            }
+        }
+
+        void RenderDevice::submitCommandList(CommandList& commandList)
+        {
+            if (commandList.empty()) return;
+
+            std::lock_guard<std::mutex> lock(drawQueueMutex);
+
+            drawQueue.insert(drawQueue.end(),
+                             std::make_move_iterator(commandList.begin()),
+                             std::make_move_iterator(commandList.end()));
+            commandList.clear();
+        }
+
+        RenderDevice::CommandList* RenderDevice::getCommandList()
+        {
+            if (recorders.empty()) return nullptr;
+
+            // each thread only changes its own recorder, so no lock is needed
+            std::thread::id threadId = std::this_thread::get_id();
+
+            for (const Recorder& recorder : recorders)
+            {
+                if (recorder.threadId == threadId) return recorder.commandList;
+            }
+
+            return nullptr;
+        }
+
         void RenderDevice::flushCommands()
         {
             std::lock_guard<std::mutex> lock(drawQueueMutex);
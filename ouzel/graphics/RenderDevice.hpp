@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <thread>
 #include "utils/Noncopyable.hpp"
 #include "graphics/Renderer.hpp"
 #include "graphics/Vertex.hpp"
@@ -19,6 +20,7 @@ namespace ouzel
         class BlendStateResource;
         class BufferResource;
         class MeshBufferResource;
+        class RenderGraph;
         class ShaderResource;
         class TextureResource;
 
@@ -28,6 +30,7 @@ namespace ouzel
             friend BlendState;
             friend Buffer;
             friend MeshBuffer;
+            friend RenderGraph;
             friend Shader;
             friend Texture;
         public:
@@ -77,11 +80,24 @@ namespace ouzel
                 bool scissorTest;
                 Rectangle scissorRectangle;
                 Renderer::CullMode cullMode;
+                BufferResource* instanceBuffer; // per-instance data, see InstanceData
+                uint32_t instanceCount; // 0 for draws without instancing
+                bool clearRenderTarget; // set by the render graph on the first command that draws to the target in a frame
             };
 
+            typedef std::vector<DrawCommand> CommandList;
+
             bool addDrawCommand(const DrawCommand& drawCommand);
             void flushCommands();
 
+            // commands added on a registered thread between beginCommandList and endCommandList are recorded
+            // into the command list without locking the draw queue, the threads have to be registered before any of them records
+            void addRecordingThread(std::thread::id threadId);
+            void beginCommandList(CommandList& commandList);
+            void endCommandList();
+            // appends the recorded commands to the draw queue and clears the command list
+            void submitCommandList(CommandList& commandList);
+
             Vector2 convertScreenToNormalizedLocation(const Vector2& position)
             {
                 return Vector2(position.x / size.width,
@@ -96,6 +112,12 @@ namespace ouzel
 
             uint32_t getDrawCallCount() const { return drawCallCount; }
 
+            // shader constant uploads in the last frame and the ones skipped because the values had not changed
+            uint32_t getShaderConstantUploadCount() const { return shaderConstantUploadCount; }
+            uint32_t getSkippedShaderConstantUploadCount() const { return skippedShaderConstantUploadCount; }
+            // pipeline state changes in the last frame
+            uint32_t getStateChangeCount() const { return stateChangeCount; }
+
             uint16_t getAPIMajorVersion() const { return apiMajorVersion; }
             uint16_t getAPIMinorVersion() const { return apiMinorVersion; }
 
@@ -103,6 +125,7 @@ namespace ouzel
             bool isMultisamplingSupported() const { return multisamplingSupported; }
             bool isAnisotropicFilteringSupported() const { return anisotropicFilteringSupported; }
             bool isRenderTargetsSupported() const { return renderTargetsSupported; }
+            bool isInstancingSupported() const { return instancingSupported; }
 
             const Matrix4& getProjectionTransform(bool renderTarget) const
             {
@@ -134,6 +157,7 @@ namespace ouzel
             virtual ShaderResource* createShader() = 0;
             virtual MeshBufferResource* createMeshBuffer() = 0;
             virtual BufferResource* createBuffer() = 0;
+            TextureResource* createTransientTexture();
             virtual void deleteResource(RenderResource* resource);
 
             virtual bool draw(const std::vector<DrawCommand>& drawCommands) = 0;
@@ -147,7 +171,6 @@ namespace ouzel
             uint16_t apiMinorVersion = 0;
 
             uint32_t currentFrame = 0;
-            uint32_t frameBufferClearedFrame = 0;
             uint32_t sampleCount = 1; // MSAA sample count
             Texture::Filter textureFilter = Texture::Filter::POINT;
             uint32_t maxAnisotropy = 1;
@@ -160,6 +183,7 @@ namespace ouzel
             bool multisamplingSupported = true;
             bool anisotropicFilteringSupported = true;
             bool renderTargetsSupported = true;
+            bool instancingSupported = false;
 
             Matrix4 projectionTransform;
             Matrix4 renderTargetProjectionTransform;
@@ -175,6 +199,21 @@ namespace ouzel
             std::vector<std::unique_ptr<RenderResource>> resourceDeleteSet;
 
             uint32_t drawCallCount = 0;
+            std::atomic<uint32_t> shaderConstantUploadCount;
+            std::atomic<uint32_t> skippedShaderConstantUploadCount;
+            std::atomic<uint32_t> stateChangeCount;
+
+            std::unique_ptr<RenderGraph> renderGraph;
+
+            struct Recorder
+            {
+                std::thread::id threadId;
+                CommandList* commandList;
+            };
+
+            CommandList* getCommandList();
+
+            std::vector<Recorder> recorders;
 
             std::vector<DrawCommand> drawQueue;
             std::mutex drawQueueMutex;
@@ -0,0 +1,410 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "RenderGraph.hpp"
+#include "utils/Log.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        bool TransientTextureResource::init(const Size2& newSize,
+                                            uint32_t newFlags,
+                                            uint32_t newMipmaps,
+                                            uint32_t newSampleCount,
+                                            PixelFormat newPixelFormat)
+        {
+            size = newSize;
+            flags = newFlags;
+            mipmaps = newMipmaps;
+            sampleCount = newSampleCount;
+            pixelFormat = newPixelFormat;
+
+            return true;
+        }
+
+        bool TransientTextureResource::setSize(const Size2& newSize)
+        {
+            if (!(flags & Texture::DYNAMIC))
+            {
+                return false;
+            }
+
+            if (newSize.width <= 0.0f || newSize.height <= 0.0f)
+            {
+                return false;
+            }
+
+            size = newSize;
+
+            return true;
+        }
+
+        RenderGraph::RenderGraph(RenderDevice* aRenderDevice):
+            renderDevice(aRenderDevice)
+        {
+        }
+
+        bool RenderGraph::compile(std::vector<RenderDevice::DrawCommand>& drawCommands, uint32_t frame)
+        {
+            passes.clear();
+            order.clear();
+            transients.clear();
+            transientIndices.clear();
+
+            // consecutive commands that draw to the same render target form a pass
+            for (uint32_t commandIndex = 0; commandIndex < drawCommands.size(); ++commandIndex)
+            {
+                RenderDevice::DrawCommand& drawCommand = drawCommands[commandIndex];
+                drawCommand.clearRenderTarget = false;
+
+                if (passes.empty() || passes.back().renderTarget != drawCommand.renderTarget)
+                {
+                    Pass pass;
+                    pass.renderTarget = drawCommand.renderTarget;
+                    pass.firstCommand = commandIndex;
+                    pass.commandCount = 0;
+                    pass.dependencyCount = 0;
+                    passes.push_back(pass);
+                }
+
+                Pass& pass = passes.back();
+                ++pass.commandCount;
+
+                for (TextureResource* texture : drawCommand.textures)
+                {
+                    if (texture && texture != pass.renderTarget &&
+                        (texture->getFlags() & Texture::RENDER_TARGET) &&
+                        std::find(pass.inputs.begin(), pass.inputs.end(), texture) == pass.inputs.end())
+                    {
+                        pass.inputs.push_back(texture);
+                    }
+                }
+            }
+
+            // passes that draw to the same target and passes that sample a target keep their submission order,
+            // except that a pass that samples a transient target is moved after the pass that draws it,
+            // because transient targets have no contents from the previous frame
+            for (uint32_t earlierIndex = 0; earlierIndex < passes.size(); ++earlierIndex)
+            {
+                Pass& earlier = passes[earlierIndex];
+
+                for (uint32_t laterIndex = earlierIndex + 1; laterIndex < passes.size(); ++laterIndex)
+                {
+                    Pass& later = passes[laterIndex];
+
+                    bool laterReadsEarlier = earlier.renderTarget &&
+                        std::find(later.inputs.begin(), later.inputs.end(), earlier.renderTarget) != later.inputs.end();
+                    bool earlierReadsLater = later.renderTarget &&
+                        std::find(earlier.inputs.begin(), earlier.inputs.end(), later.renderTarget) != earlier.inputs.end();
+
+                    if (earlierReadsLater && !laterReadsEarlier &&
+                        earlier.renderTarget != later.renderTarget &&
+                        (later.renderTarget->getFlags() & Texture::TRANSIENT))
+                    {
+                        later.dependents.push_back(earlierIndex);
+                        ++earlier.dependencyCount;
+                    }
+                    else if (earlier.renderTarget == later.renderTarget || laterReadsEarlier || earlierReadsLater)
+                    {
+                        earlier.dependents.push_back(laterIndex);
+                        ++later.dependencyCount;
+                    }
+                }
+            }
+
+            // passes that are ready are drawn in the submission order, but the ones that continue drawing to
+            // the target of the previous pass go first, so that they are merged with it and share its clear
+            std::vector<uint32_t> ready;
+
+            for (uint32_t passIndex = 0; passIndex < passes.size(); ++passIndex)
+            {
+                if (passes[passIndex].dependencyCount == 0) ready.push_back(passIndex);
+            }
+
+            while (!ready.empty())
+            {
+                bool continuing = !order.empty();
+                TextureResource* currentTarget = continuing ? passes[order.back()].renderTarget : nullptr;
+
+                auto next = std::min_element(ready.begin(), ready.end(), [this, continuing, currentTarget](uint32_t a, uint32_t b) {
+                    bool aContinues = continuing && passes[a].renderTarget == currentTarget;
+                    bool bContinues = continuing && passes[b].renderTarget == currentTarget;
+
+                    return aContinues != bContinues ? aContinues : a < b;
+                });
+
+                uint32_t passIndex = *next;
+                ready.erase(next);
+                order.push_back(passIndex);
+
+                for (uint32_t dependent : passes[passIndex].dependents)
+                {
+                    if (--passes[dependent].dependencyCount == 0) ready.push_back(dependent);
+                }
+            }
+
+            if (order.size() != passes.size())
+            {
+                Log(Log::Level::WARN) << "Render targets depend on each other, drawing the remaining passes in submission order";
+
+                for (uint32_t passIndex = 0; passIndex < passes.size(); ++passIndex)
+                {
+                    if (passes[passIndex].dependencyCount) order.push_back(passIndex);
+                }
+            }
+
+            bool reordered = false;
+
+            for (uint32_t i = 0; i < order.size(); ++i)
+            {
+                if (order[i] != i)
+                {
+                    reordered = true;
+                    break;
+                }
+            }
+
+            if (reordered)
+            {
+                sortedCommands.clear();
+                sortedCommands.reserve(drawCommands.size());
+
+                for (uint32_t passIndex : order)
+                {
+                    Pass& pass = passes[passIndex];
+                    uint32_t firstCommand = static_cast<uint32_t>(sortedCommands.size());
+
+                    for (uint32_t i = 0; i < pass.commandCount; ++i)
+                    {
+                        sortedCommands.push_back(std::move(drawCommands[pass.firstCommand + i]));
+                    }
+
+                    pass.firstCommand = firstCommand;
+                }
+
+                drawCommands.swap(sortedCommands);
+            }
+
+            // every pass clears its target when it starts, passes that continue drawing to the target of the previous
+            // pass are merged with it, a target that is drawn again after other passes keeps what was drawn to it
+            std::vector<TextureResource*> drawnTargets;
+            bool hasTransients = false;
+
+            for (uint32_t position = 0; position < order.size(); ++position)
+            {
+                const Pass& pass = passes[order[position]];
+
+                bool merged = position > 0 && passes[order[position - 1]].renderTarget == pass.renderTarget;
+
+                if (!merged)
+                {
+                    if (std::find(drawnTargets.begin(), drawnTargets.end(), pass.renderTarget) == drawnTargets.end())
+                    {
+                        drawCommands[pass.firstCommand].clearRenderTarget = true;
+                        drawnTargets.push_back(pass.renderTarget);
+                    }
+                }
+
+                if (pass.renderTarget && (pass.renderTarget->getFlags() & Texture::TRANSIENT))
+                {
+                    addTransientUse(pass.renderTarget, position);
+                    hasTransients = true;
+                }
+
+                for (TextureResource* input : pass.inputs)
+                {
+                    if (input->getFlags() & Texture::TRANSIENT)
+                    {
+                        // a transient target that nothing has drawn to gets no pooled target
+                        if (std::find(drawnTargets.begin(), drawnTargets.end(), input) != drawnTargets.end())
+                        {
+                            addTransientUse(input, position);
+                        }
+
+                        hasTransients = true;
+                    }
+                }
+            }
+
+            for (PooledTarget& pooledTarget : pool)
+            {
+                pooledTarget.used = false;
+            }
+
+            if (hasTransients)
+            {
+                // targets are acquired before the ones used for the last time are released, so a pass never reads and writes the same pooled target
+                for (uint32_t position = 0; position < order.size(); ++position)
+                {
+                    for (Transient& transient : transients)
+                    {
+                        if (transient.firstPass == position)
+                        {
+                            transient.resource = acquireTarget(transient.description, frame);
+                        }
+                    }
+
+                    for (Transient& transient : transients)
+                    {
+                        if (transient.lastPass == position && transient.resource)
+                        {
+                            releaseTarget(transient.resource);
+                        }
+                    }
+                }
+
+                // commands that draw to a transient target without a pooled target are dropped
+                drawCommands.erase(std::remove_if(drawCommands.begin(), drawCommands.end(), [this](const RenderDevice::DrawCommand& drawCommand) {
+                    return drawCommand.renderTarget && !getTransientResource(drawCommand.renderTarget);
+                }), drawCommands.end());
+
+                for (RenderDevice::DrawCommand& drawCommand : drawCommands)
+                {
+                    if (drawCommand.renderTarget) drawCommand.renderTarget = getTransientResource(drawCommand.renderTarget);
+
+                    for (TextureResource*& texture : drawCommand.textures)
+                    {
+                        if (texture)
+                        {
+                            TextureResource* resource = getTransientResource(texture);
+
+                            if (!resource)
+                            {
+                                Log(Log::Level::ERR) << "Transient texture is sampled, but it has no render target in this frame";
+                            }
+
+                            texture = resource;
+                        }
+                    }
+                }
+            }
+
+            trimPool(frame);
+
+            return true;
+        }
+
+        void RenderGraph::addTransientUse(TextureResource* description, uint32_t position)
+        {
+            auto i = transientIndices.find(description);
+
+            if (i != transientIndices.end())
+            {
+                transients[i->second].lastPass = position;
+                return;
+            }
+
+            Transient transient;
+            transient.description = description;
+            transient.firstPass = position;
+            transient.lastPass = position;
+            transient.resource = nullptr;
+            transientIndices[description] = static_cast<uint32_t>(transients.size());
+            transients.push_back(transient);
+        }
+
+        TextureResource* RenderGraph::getTransientResource(TextureResource* texture) const
+        {
+            if (!(texture->getFlags() & Texture::TRANSIENT)) return texture;
+
+            auto i = transientIndices.find(texture);
+
+            return i == transientIndices.end() ? nullptr : transients[i->second].resource;
+        }
+
+        bool RenderGraph::isCompatible(const TextureResource* description, const TextureResource* resource)
+        {
+            Color descriptionClearColor = description->getClearColor();
+            Color resourceClearColor = resource->getClearColor();
+
+            return description->getSize() == resource->getSize() &&
+                (description->getFlags() & ~Texture::TRANSIENT) == resource->getFlags() &&
+                description->getMipmaps() == resource->getMipmaps() &&
+                description->getSampleCount() == resource->getSampleCount() &&
+                description->getPixelFormat() == resource->getPixelFormat() &&
+                description->getFilter() == resource->getFilter() &&
+                description->getAddressX() == resource->getAddressX() &&
+                description->getAddressY() == resource->getAddressY() &&
+                description->getMaxAnisotropy() == resource->getMaxAnisotropy() &&
+                description->getClearColorBuffer() == resource->getClearColorBuffer() &&
+                description->getClearDepthBuffer() == resource->getClearDepthBuffer() &&
+                descriptionClearColor.r == resourceClearColor.r &&
+                descriptionClearColor.g == resourceClearColor.g &&
+                descriptionClearColor.b == resourceClearColor.b &&
+                descriptionClearColor.a == resourceClearColor.a &&
+                description->getClearDepth() == resource->getClearDepth();
+        }
+
+        TextureResource* RenderGraph::acquireTarget(const TextureResource* description, uint32_t frame)
+        {
+            for (PooledTarget& pooledTarget : pool)
+            {
+                if (!pooledTarget.used && isCompatible(description, pooledTarget.resource))
+                {
+                    pooledTarget.used = true;
+                    pooledTarget.lastUsedFrame = frame;
+                    return pooledTarget.resource;
+                }
+            }
+
+            TextureResource* resource = renderDevice->createTexture();
+
+            if (!resource->init(description->getSize(),
+                                description->getFlags() & ~Texture::TRANSIENT,
+                                description->getMipmaps(),
+                                description->getSampleCount(),
+                                description->getPixelFormat()) ||
+                !resource->setFilter(description->getFilter()) ||
+                !resource->setAddressX(description->getAddressX()) ||
+                !resource->setAddressY(description->getAddressY()) ||
+                !resource->setMaxAnisotropy(description->getMaxAnisotropy()) ||
+                !resource->setClearColorBuffer(description->getClearColorBuffer()) ||
+                !resource->setClearDepthBuffer(description->getClearDepthBuffer()) ||
+                !resource->setClearColor(description->getClearColor()) ||
+                !resource->setClearDepth(description->getClearDepth()))
+            {
+                Log(Log::Level::ERR) << "Failed to create a render target for a transient texture";
+                renderDevice->deleteResource(resource);
+                return nullptr;
+            }
+
+            PooledTarget pooledTarget;
+            pooledTarget.resource = resource;
+            pooledTarget.lastUsedFrame = frame;
+            pooledTarget.used = true;
+            pool.push_back(pooledTarget);
+
+            return resource;
+        }
+
+        void RenderGraph::releaseTarget(TextureResource* resource)
+        {
+            for (PooledTarget& pooledTarget : pool)
+            {
+                if (pooledTarget.resource == resource)
+                {
+                    pooledTarget.used = false;
+                    break;
+                }
+            }
+        }
+
+        void RenderGraph::trimPool(uint32_t frame)
+        {
+            for (auto i = pool.begin(); i != pool.end();)
+            {
+                if (frame - i->lastUsedFrame > POOL_TIMEOUT)
+                {
+                    renderDevice->deleteResource(i->resource);
+                    i = pool.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,90 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "utils/Noncopyable.hpp"
+#include "graphics/RenderDevice.hpp"
+#include "graphics/TextureResource.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        // Description of a transient render target, it has no storage of its own and is drawn to a pooled render target
+        class TransientTextureResource: public TextureResource
+        {
+            friend RenderDevice;
+        public:
+            virtual bool init(const Size2& newSize,
+                              uint32_t newFlags = 0,
+                              uint32_t newMipmaps = 0,
+                              uint32_t newSampleCount = 1,
+                              PixelFormat newPixelFormat = PixelFormat::RGBA8_UNORM) override;
+
+            virtual bool setSize(const Size2& newSize) override;
+
+        protected:
+            TransientTextureResource() {}
+        };
+
+        // Orders the passes of a frame by their render target dependencies, assigns pooled render targets to
+        // the transient ones and marks the commands that have to clear their render target
+        class RenderGraph: public Noncopyable
+        {
+        public:
+            static const uint32_t POOL_TIMEOUT = 120; // frames an unused pooled render target is kept
+
+            RenderGraph(RenderDevice* aRenderDevice);
+
+            bool compile(std::vector<RenderDevice::DrawCommand>& drawCommands, uint32_t frame);
+
+        protected:
+            struct Pass
+            {
+                TextureResource* renderTarget;
+                uint32_t firstCommand;
+                uint32_t commandCount;
+                std::vector<TextureResource*> inputs;
+                std::vector<uint32_t> dependents;
+                uint32_t dependencyCount;
+            };
+
+            struct Transient
+            {
+                TextureResource* description;
+                uint32_t firstPass; // positions in the sorted pass order
+                uint32_t lastPass;
+                TextureResource* resource;
+            };
+
+            struct PooledTarget
+            {
+                TextureResource* resource;
+                uint32_t lastUsedFrame;
+                bool used;
+            };
+
+            void addTransientUse(TextureResource* description, uint32_t position);
+            TextureResource* getTransientResource(TextureResource* texture) const;
+
+            static bool isCompatible(const TextureResource* description, const TextureResource* resource);
+
+            TextureResource* acquireTarget(const TextureResource* description, uint32_t frame);
+            void releaseTarget(TextureResource* resource);
+            void trimPool(uint32_t frame);
+
+            RenderDevice* renderDevice;
+
+            std::vector<Pass> passes;
+            std::vector<uint32_t> order;
+            std::vector<Transient> transients;
+            std::unordered_map<TextureResource*, uint32_t> transientIndices; // description to the index in transients
+            std::vector<PooledTarget> pool;
+            std::vector<RenderDevice::DrawCommand> sortedCommands;
+        };
+    } // namespace graphics
+} // namespace ouzel
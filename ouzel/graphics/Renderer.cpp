@@ -10,6 +10,7 @@
 #include "BlendStateResource.hpp"
 #include "MeshBufferResource.hpp"
 #include "BufferResource.hpp"
+#include "Buffer.hpp"
 #include "events/EventHandler.hpp"
 #include "events/EventDispatcher.hpp"
 #include "core/Window.hpp"
@@ -37,6 +38,7 @@
 #endif
 
 #include "graphics/empty/RenderDeviceEmpty.hpp"
+#include "graphics/software/RenderDeviceSoftware.hpp"
 #include "graphics/opengl/RenderDeviceOGL.hpp"
 #include "graphics/direct3d11/RenderDeviceD3D11.hpp"
 #include "graphics/metal/RenderDeviceMetal.hpp"
@@ -56,6 +58,7 @@ namespace ouzel
             if (availableDrivers.empty())
             {
                 availableDrivers.insert(Driver::EMPTY);
+                availableDrivers.insert(Driver::SOFTWARE);
 
 #if OUZEL_COMPILE_OPENGL
                 availableDrivers.insert(Driver::OPENGL);
@@ -128,6 +131,10 @@ namespace ouzel
 #endif
                     break;
 #endif
+                case Driver::SOFTWARE:
+                    Log(Log::Level::INFO) << "Using software render driver";
+                    device.reset(new RenderDeviceSoftware());
+                    break;
                 case Driver::EMPTY:
                 default:
                     Log(Log::Level::INFO) << "Not using render driver";
@@ -195,10 +202,11 @@ namespace ouzel
 
             std::shared_ptr<BlendState> alphaBlendState = std::make_shared<BlendState>();
 
+            // the alpha is composited over the destination too, so that render targets get the correct coverage
             alphaBlendState->init(true,
                                   BlendState::BlendFactor::SRC_ALPHA, BlendState::BlendFactor::INV_SRC_ALPHA,
                                   BlendState::BlendOperation::ADD,
-                                  BlendState::BlendFactor::ONE, BlendState::BlendFactor::ONE,
+                                  BlendState::BlendFactor::ONE, BlendState::BlendFactor::INV_SRC_ALPHA,
                                   BlendState::BlendOperation::ADD);
 
             sharedEngine->getCache()->setBlendState(BLEND_ALPHA, alphaBlendState);
@@ -283,7 +291,9 @@ namespace ouzel
                                       bool wireframe,
                                       bool scissorTest,
                                       const Rectangle& scissorRectangle,
-                                      CullMode cullMode)
+                                      CullMode cullMode,
+                                      const std::shared_ptr<Buffer>& instanceBuffer,
+                                      uint32_t instanceCount)
         {
             if (!shader)
             {
@@ -303,6 +313,12 @@ namespace ouzel
                 return false;
             }
 
+            if (instanceCount && (!instanceBuffer || !device->isInstancingSupported()))
+            {
+                Log(Log::Level::ERR) << "Invalid instanced draw command passed to render queue";
+                return false;
+            }
+
             std::vector<TextureResource*> drawTextures;
 
             for (const std::shared_ptr<Texture>& texture : textures)
@@ -327,7 +343,10 @@ namespace ouzel
                 wireframe,
                 scissorTest,
                 scissorRectangle,
-                cullMode
+                cullMode,
+                instanceBuffer ? instanceBuffer->getResource() : nullptr,
+                instanceCount,
+                false
             };
 
             return device->addDrawCommand(drawCommand);
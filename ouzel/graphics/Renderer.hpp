@@ -27,6 +27,8 @@ namespace ouzel
     namespace graphics
     {
         const std::string SHADER_TEXTURE = "shaderTexture";
+        const std::string SHADER_TEXTURE_SDF = "shaderTextureSDF";
+        const std::string SHADER_TEXTURE_INSTANCED = "shaderTextureInstanced";
         const std::string SHADER_COLOR = "shaderColor";
 
         const std::string BLEND_NO_BLEND = "blendNoBlend";
@@ -39,6 +41,7 @@ namespace ouzel
 
         class RenderDevice;
         class BlendState;
+        class Buffer;
         class MeshBuffer;
         class Shader;
 
@@ -51,6 +54,7 @@ namespace ouzel
             {
                 DEFAULT,
                 EMPTY,
+                SOFTWARE,
                 OPENGL,
                 DIRECT3D11,
                 METAL
@@ -112,7 +116,9 @@ namespace ouzel
                                 bool wireframe,
                                 bool scissorTest,
                                 const Rectangle& scissorRectangle,
-                                CullMode cullMode);
+                                CullMode cullMode,
+                                const std::shared_ptr<Buffer>& instanceBuffer = nullptr,
+                                uint32_t instanceCount = 0);
 
         protected:
             Renderer(Driver aDriver);
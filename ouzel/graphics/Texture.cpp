@@ -1,6 +1,7 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include "Texture.hpp"
 #include "TextureResource.hpp"
 #include "Renderer.hpp"
@@ -28,6 +29,9 @@ namespace ouzel
                            uint32_t newSampleCount,
                            PixelFormat newPixelFormat)
         {
+            if (!(newFlags & RENDER_TARGET)) newFlags &= ~TRANSIENT;
+            bool resourceChanged = setTransient((newFlags & TRANSIENT) != 0);
+
             size = newSize;
             flags = newFlags;
             mipmaps = newMipmaps;
@@ -42,6 +46,8 @@ namespace ouzel
                                                                          newSampleCount,
                                                                          newPixelFormat));
 
+            if (resourceChanged) applyProperties();
+
             return true;
         }
 
@@ -56,6 +62,9 @@ namespace ouzel
                 return false;
             }
 
+            newFlags &= ~TRANSIENT;
+            bool resourceChanged = setTransient(false);
+
             size = image.getSize();
             flags = newFlags;
             mipmaps = newMipmaps;
@@ -70,6 +79,8 @@ namespace ouzel
                                                                          newMipmaps,
                                                                          image.getPixelFormat()));
 
+            if (resourceChanged) applyProperties();
+
             return true;
         }
 
@@ -79,6 +90,9 @@ namespace ouzel
                            uint32_t newMipmaps,
                            PixelFormat newPixelFormat)
         {
+            newFlags &= ~TRANSIENT;
+            bool resourceChanged = setTransient(false);
+
             size = newSize;
             flags = newFlags;
             mipmaps = newMipmaps;
@@ -93,6 +107,8 @@ namespace ouzel
                                                                          newMipmaps,
                                                                          newPixelFormat));
 
+            if (resourceChanged) applyProperties();
+
             return true;
         }
 
@@ -101,6 +117,9 @@ namespace ouzel
                            uint32_t newFlags,
                            PixelFormat newPixelFormat)
         {
+            newFlags &= ~TRANSIENT;
+            bool resourceChanged = setTransient(false);
+
             size = newSize;
             flags = newFlags;
             mipmaps = static_cast<uint32_t>(newLevels.size());
@@ -114,9 +133,52 @@ namespace ouzel
                                                                          newFlags,
                                                                          newPixelFormat));
 
+            if (resourceChanged) applyProperties();
+
+            return true;
+        }
+
+        void Texture::swap(Texture& other)
+        {
+            std::swap(resource, other.resource);
+            std::swap(size, other.size);
+            std::swap(flags, other.flags);
+            std::swap(mipmaps, other.mipmaps);
+            std::swap(sampleCount, other.sampleCount);
+            std::swap(pixelFormat, other.pixelFormat);
+
+            // the sampler and clear settings stay with the texture objects, so they are applied to the exchanged resources
+            applyProperties();
+            other.applyProperties();
+        }
+
+        bool Texture::setTransient(bool transient)
+        {
+            if (((flags & TRANSIENT) != 0) == transient)
+            {
+                return false;
+            }
+
+            // transient render targets only keep the description, the render graph assigns them a pooled render target
+            RenderDevice* renderDevice = sharedEngine->getRenderer()->getDevice();
+            renderDevice->deleteResource(resource);
+            resource = transient ? renderDevice->createTransientTexture() : renderDevice->createTexture();
+
             return true;
         }
 
+        void Texture::applyProperties()
+        {
+            setFilter(filter);
+            setAddressX(addressX);
+            setAddressY(addressY);
+            setMaxAnisotropy(maxAnisotropy);
+            setClearColorBuffer(clearColorBuffer);
+            setClearDepthBuffer(clearDepthBuffer);
+            setClearColor(clearColor);
+            setClearDepth(clearDepth);
+        }
+
         const Size2& Texture::getSize() const
         {
             return size;
@@ -145,6 +207,16 @@ namespace ouzel
             return true;
         }
 
+        bool Texture::setSubData(const std::vector<uint8_t>& newData, const Rectangle& region)
+        {
+            sharedEngine->getRenderer()->executeOnRenderThread(std::bind(&TextureResource::setSubData,
+                                                                         resource,
+                                                                         newData,
+                                                                         region));
+
+            return true;
+        }
+
         Texture::Filter Texture::getFilter() const
         {
             return filter;
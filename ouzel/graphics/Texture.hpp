@@ -9,6 +9,7 @@
 #include "utils/Noncopyable.hpp"
 #include "graphics/PixelFormat.hpp"
 #include "math/Color.hpp"
+#include "math/Rectangle.hpp"
 #include "math/Size2.hpp"
 
 namespace ouzel
@@ -24,7 +25,8 @@ namespace ouzel
             {
                 DYNAMIC = 0x01,
                 RENDER_TARGET = 0x02,
-                DEPTH_BUFFER = 0x04
+                DEPTH_BUFFER = 0x04,
+                TRANSIENT = 0x08 // render target that is only used within a frame, its storage is shared through the render graph
             };
 
             enum class Filter
@@ -74,12 +76,18 @@ namespace ouzel
                       uint32_t newFlags = 0,
                       PixelFormat newPixelFormat = PixelFormat::RGBA8_UNORM);
 
+            // exchanges the render resource and the properties that come from the image data with the other texture,
+            // the sampler and clear settings are kept
+            void swap(Texture& other);
+
             TextureResource* getResource() const { return resource; }
 
             const Size2& getSize() const;
             bool setSize(const Size2& newSize);
 
             bool setData(const std::vector<uint8_t>& newData, const Size2& newSize);
+            // updates only the given region of the first level, newData must contain tightly packed pixels of the region
+            bool setSubData(const std::vector<uint8_t>& newData, const Rectangle& region);
 
             uint32_t getFlags() const { return flags; }
             uint32_t getMipmaps() const { return mipmaps; }
@@ -112,6 +120,9 @@ namespace ouzel
             void setClearDepth(float depth);
 
         private:
+            bool setTransient(bool transient);
+            void applyProperties();
+
             TextureResource* resource = nullptr;
 
             Size2 size;
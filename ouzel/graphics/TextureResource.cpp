@@ -132,6 +132,45 @@ namespace ouzel
             return true;
         }
 
+        bool TextureResource::setSubData(const std::vector<uint8_t>& newData, const Rectangle& region)
+        {
+            if (!(flags & Texture::DYNAMIC) || flags & Texture::RENDER_TARGET)
+            {
+                return false;
+            }
+
+            if (levels.empty() ||
+                region.position.x < 0.0f || region.position.y < 0.0f ||
+                region.size.width <= 0.0f || region.size.height <= 0.0f ||
+                region.position.x + region.size.width > size.width ||
+                region.position.y + region.size.height > size.height)
+            {
+                return false;
+            }
+
+            uint32_t pixelSize = getPixelSize(pixelFormat);
+            uint32_t regionX = static_cast<uint32_t>(region.position.x);
+            uint32_t regionY = static_cast<uint32_t>(region.position.y);
+            uint32_t regionPitch = static_cast<uint32_t>(region.size.width) * pixelSize;
+            uint32_t regionHeight = static_cast<uint32_t>(region.size.height);
+
+            if (newData.size() < regionPitch * regionHeight)
+            {
+                return false;
+            }
+
+            Texture::Level& level = levels[0];
+
+            for (uint32_t row = 0; row < regionHeight; ++row)
+            {
+                std::copy(newData.begin() + row * regionPitch,
+                          newData.begin() + (row + 1) * regionPitch,
+                          level.data.begin() + (regionY + row) * level.pitch + regionX * pixelSize);
+            }
+
+            return calculateMipmaps();
+        }
+
         bool TextureResource::calculateSizes(const Size2& newSize)
         {
             levels.clear();
@@ -514,6 +553,11 @@ namespace ouzel
         {
             levels[0].data = newData;
 
+            return calculateMipmaps();
+        }
+
+        bool TextureResource::calculateMipmaps()
+        {
             for (uint32_t level = 1; level < static_cast<uint32_t>(levels.size()); ++level)
             {
                 uint32_t previousWidth = static_cast<uint32_t>(levels[level - 1].size.width);
@@ -9,6 +9,7 @@
 #include "graphics/RenderResource.hpp"
 #include "graphics/Texture.hpp"
 #include "math/Color.hpp"
+#include "math/Rectangle.hpp"
 #include "math/Size2.hpp"
 
 namespace ouzel
@@ -42,6 +43,7 @@ namespace ouzel
             const Size2& getSize() const { return size; }
 
             virtual bool setData(const std::vector<uint8_t>& newData, const Size2& newSize);
+            virtual bool setSubData(const std::vector<uint8_t>& newData, const Rectangle& region);
 
             uint32_t getFlags() const { return flags; }
             uint32_t getMipmaps() const { return mipmaps; }
@@ -74,14 +76,12 @@ namespace ouzel
 
             PixelFormat getPixelFormat() const { return pixelFormat; }
 
-            uint32_t getFrameBufferClearedFrame() const { return frameBufferClearedFrame; }
-            void setFrameBufferClearedFrame(uint32_t clearedFrame) { frameBufferClearedFrame = clearedFrame; }
-
         protected:
             TextureResource();
 
             bool calculateSizes(const Size2& newSize);
             bool calculateData(const std::vector<uint8_t>& newData);
+            bool calculateMipmaps();
 
             Size2 size;
             uint32_t flags = 0;
@@ -97,8 +97,6 @@ namespace ouzel
             Texture::Address addressX = Texture::Address::CLAMP;
             Texture::Address addressY = Texture::Address::CLAMP;
             uint32_t maxAnisotropy = 0;
-
-            uint32_t frameBufferClearedFrame = 0;
         };
     } // namespace graphics
 } // namespace ouzel
@@ -1,6 +1,8 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <iterator>
 #include "Vertex.hpp"
 
 namespace ouzel
@@ -51,5 +53,29 @@ namespace ouzel
             position(aPosition), color(aColor), texCoord(aTexCoord), normal(aNormal)
         {
         }
+
+        // the columns of the transform, the color and the texture coordinate offset and scale
+        const std::vector<VertexAttribute> InstanceData::ATTRIBUTES = {
+            VertexAttribute(VertexAttribute::Usage::TEXTURE_COORDINATES, 1, DataType::FLOAT_VECTOR4, false),
+            VertexAttribute(VertexAttribute::Usage::TEXTURE_COORDINATES, 2, DataType::FLOAT_VECTOR4, false),
+            VertexAttribute(VertexAttribute::Usage::TEXTURE_COORDINATES, 3, DataType::FLOAT_VECTOR4, false),
+            VertexAttribute(VertexAttribute::Usage::TEXTURE_COORDINATES, 4, DataType::FLOAT_VECTOR4, false),
+            VertexAttribute(VertexAttribute::Usage::COLOR, 1, DataType::UNSIGNED_BYTE_VECTOR4, true),
+            VertexAttribute(VertexAttribute::Usage::TEXTURE_COORDINATES, 5, DataType::FLOAT_VECTOR4, false)
+        };
+
+        InstanceData::InstanceData():
+            texCoordScale(1.0f, 1.0f)
+        {
+            std::copy(std::begin(Matrix4::IDENTITY.m), std::end(Matrix4::IDENTITY.m), transform);
+        }
+
+        InstanceData::InstanceData(const Matrix4& aTransform, Color aColor,
+                                   const Vector2& aTexCoordOffset,
+                                   const Vector2& aTexCoordScale):
+            color(aColor), texCoordOffset(aTexCoordOffset), texCoordScale(aTexCoordScale)
+        {
+            std::copy(std::begin(aTransform.m), std::end(aTransform.m), transform);
+        }
     } // namespace graphics
 } // namespace ouzel
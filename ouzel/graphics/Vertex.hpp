@@ -8,6 +8,7 @@
 #include "graphics/DataType.hpp"
 #include "math/Vector2.hpp"
 #include "math/Vector3.hpp"
+#include "math/Matrix4.hpp"
 #include "math/Color.hpp"
 
 namespace ouzel
@@ -79,5 +80,22 @@ namespace ouzel
             VertexPCTN();
             VertexPCTN(const Vector3& aPosition, Color aColor, const Vector2& aTexCoord, const Vector3& aNormal);
         };
+
+        // per-instance data of instanced draws, its attributes follow the attributes of the mesh buffer
+        class InstanceData
+        {
+        public:
+            static const std::vector<VertexAttribute> ATTRIBUTES;
+
+            float transform[16];
+            Color color;
+            Vector2 texCoordOffset;
+            Vector2 texCoordScale;
+
+            InstanceData();
+            InstanceData(const Matrix4& aTransform, Color aColor,
+                         const Vector2& aTexCoordOffset = Vector2(0.0f, 0.0f),
+                         const Vector2& aTexCoordScale = Vector2(1.0f, 1.0f));
+        };
     } // namespace graphics
 } // namespace ouzel
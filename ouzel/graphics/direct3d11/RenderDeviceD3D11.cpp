@@ -433,8 +433,6 @@ namespace ouzel
 
             if (drawCommands.empty())
             {
-                frameBufferClearedFrame = currentFrame;
-
                 context->OMSetRenderTargets(1, &renderTargetView, depthStencilView);
                 context->RSSetState(rasterizerStates[0]);
                 context->OMSetDepthStencilState(depthStencilStates[1], 0); // enable depth write
@@ -478,9 +476,8 @@ namespace ouzel
                     newClearColor = renderTargetD3D11->getFrameBufferClearColor();
                     newClearDepth = renderTargetD3D11->getClearDepth();
 
-                    if (renderTargetD3D11->getFrameBufferClearedFrame() != currentFrame)
+                    if (drawCommand.clearRenderTarget)
                     {
-                        renderTargetD3D11->setFrameBufferClearedFrame(currentFrame);
                         newClearFrameBufferView = renderTargetD3D11->getClearFrameBufferView();
                         newClearDepthBufferView = renderTargetD3D11->getClearDepthBufferView();
                     }
@@ -492,9 +489,8 @@ namespace ouzel
                     newClearColor = frameBufferClearColor;
                     newClearDepth = clearDepth;
 
-                    if (frameBufferClearedFrame != currentFrame)
+                    if (drawCommand.clearRenderTarget)
                     {
-                        frameBufferClearedFrame = currentFrame;
                         newClearFrameBufferView = clearColorBuffer;
                         newClearDepthBufferView = clearDepthBuffer;
                     }
@@ -39,6 +39,7 @@ namespace ouzel
 
             virtual bool setSize(const Size2& newSize) override;
             virtual bool setData(const std::vector<uint8_t>& newData, const Size2& newSize) override;
+            virtual bool setSubData(const std::vector<uint8_t>& newData, const Rectangle& region) override;
             virtual bool setFilter(Texture::Filter newFilter) override;
             virtual bool setAddressX(Texture::Address newAddressX) override;
             virtual bool setAddressY(Texture::Address newAddressY) override;
@@ -65,6 +66,7 @@ namespace ouzel
 
         protected:
             bool createTexture();
+            bool uploadData();
             bool updateSamplerState();
 
             RenderDeviceD3D11* renderDeviceD3D11;
@@ -49,6 +49,7 @@ namespace ouzel
                                 {{"modelViewProj", DataType::FLOAT_MATRIX4}});
 
             sharedEngine->getCache()->setShader(SHADER_TEXTURE, textureShader);
+            sharedEngine->getCache()->setShader(SHADER_TEXTURE_SDF, textureShader);
 
             std::shared_ptr<Shader> colorShader = std::make_shared<Shader>();
 
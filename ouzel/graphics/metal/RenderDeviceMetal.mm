@@ -419,9 +419,9 @@ namespace ouzel
 
             if (drawCommands.empty())
             {
-                frameBufferClearedFrame = currentFrame;
-
                 currentRenderPassDescriptor = renderPassDescriptor;
+                currentRenderPassDescriptor.colorAttachments[0].loadAction = colorBufferLoadAction;
+                currentRenderPassDescriptor.depthAttachment.loadAction = depthBufferLoadAction;
                 currentRenderCommandEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:currentRenderPassDescriptor];
 
                 if (!currentRenderCommandEncoder)
@@ -436,9 +436,6 @@ namespace ouzel
 
                 [currentRenderCommandEncoder setViewport: viewport];
                 [currentRenderCommandEncoder setDepthStencilState:depthStencilStates[1]]; // enable depth write
-
-                currentRenderPassDescriptor.colorAttachments[0].loadAction = colorBufferLoadAction;
-                currentRenderPassDescriptor.depthAttachment.loadAction = depthBufferLoadAction;
             }
             else for (const DrawCommand& drawCommand : drawCommands)
             {
@@ -469,9 +466,8 @@ namespace ouzel
                     renderTargetWidth = renderTargetTextureMetal->getWidth();
                     renderTargetHeight = renderTargetTextureMetal->getHeight();
 
-                    if (renderTargetMetal->getFrameBufferClearedFrame() != currentFrame)
+                    if (drawCommand.clearRenderTarget)
                     {
-                        renderTargetMetal->setFrameBufferClearedFrame(currentFrame);
                         newColorBufferLoadAction = renderTargetMetal->getColorBufferLoadAction();
                         newDepthBufferLoadAction = renderTargetMetal->getDepthBufferLoadAction();
                     }
@@ -486,9 +482,8 @@ namespace ouzel
                     renderTargetWidth = frameBufferWidth;
                     renderTargetHeight = frameBufferHeight;
 
-                    if (frameBufferClearedFrame != currentFrame)
+                    if (drawCommand.clearRenderTarget)
                     {
-                        frameBufferClearedFrame = currentFrame;
                         newColorBufferLoadAction = colorBufferLoadAction;
                         newDepthBufferLoadAction = depthBufferLoadAction;
                     }
@@ -502,7 +497,10 @@ namespace ouzel
                         [currentRenderCommandEncoder endEncoding];
                     }
 
+                    // the load actions are copied when the encoder is created
                     currentRenderPassDescriptor = newRenderPassDescriptor;
+                    currentRenderPassDescriptor.colorAttachments[0].loadAction = newColorBufferLoadAction;
+                    currentRenderPassDescriptor.depthAttachment.loadAction = newDepthBufferLoadAction;
                     currentRenderCommandEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:currentRenderPassDescriptor];
 
                     if (!currentRenderCommandEncoder)
@@ -510,9 +508,6 @@ namespace ouzel
                         Log(Log::Level::ERR) << "Failed to create Metal render command encoder";
                         return false;
                     }
-
-                    currentRenderPassDescriptor.colorAttachments[0].loadAction = newColorBufferLoadAction;
-                    currentRenderPassDescriptor.depthAttachment.loadAction = newDepthBufferLoadAction;
                 }
 
                 viewport.originX = static_cast<double>(drawCommand.viewport.position.x);
@@ -244,6 +244,43 @@ namespace ouzel
             return true;
         }
 
+        bool TextureResourceMetal::setSubData(const std::vector<uint8_t>& newData, const Rectangle& region)
+        {
+            if (!TextureResource::setSubData(newData, region))
+            {
+                return false;
+            }
+
+            if (!texture)
+            {
+                Log(Log::Level::ERR) << "Texture not initialized";
+                return false;
+            }
+
+            NSUInteger regionX = static_cast<NSUInteger>(region.position.x);
+            NSUInteger regionY = static_cast<NSUInteger>(region.position.y);
+
+            [texture replaceRegion:MTLRegionMake2D(regionX, regionY,
+                                                   static_cast<NSUInteger>(region.size.width),
+                                                   static_cast<NSUInteger>(region.size.height))
+                       mipmapLevel:0 withBytes:levels[0].data.data() + regionY * levels[0].pitch + regionX * getPixelSize(pixelFormat)
+                       bytesPerRow:static_cast<NSUInteger>(levels[0].pitch)];
+
+            for (size_t level = 1; level < levels.size(); ++level)
+            {
+                if (!levels[level].data.empty())
+                {
+                    [texture replaceRegion:MTLRegionMake2D(0, 0,
+                                                           static_cast<NSUInteger>(levels[level].size.width),
+                                                           static_cast<NSUInteger>(levels[level].size.height))
+                               mipmapLevel:level withBytes:levels[level].data.data()
+                               bytesPerRow:static_cast<NSUInteger>(levels[level].pitch)];
+                }
+            }
+
+            return true;
+        }
+
         bool TextureResourceMetal::setFilter(Texture::Filter newFilter)
         {
             if (!TextureResource::setFilter(newFilter))
@@ -6,6 +6,7 @@
 #if OUZEL_COMPILE_OPENGL
 
 #include "BlendStateResourceOGL.hpp"
+#include "RenderDeviceOGL.hpp"
 #include "utils/Log.hpp"
 
 namespace ouzel
@@ -52,10 +53,16 @@ namespace ouzel
             }
         }
 
-        BlendStateResourceOGL::BlendStateResourceOGL()
+        BlendStateResourceOGL::BlendStateResourceOGL(RenderDeviceOGL* aRenderDeviceOGL):
+            renderDeviceOGL(aRenderDeviceOGL)
         {
         }
 
+        BlendStateResourceOGL::~BlendStateResourceOGL()
+        {
+            renderDeviceOGL->deleteBlendState(this);
+        }
+
         bool BlendStateResourceOGL::init(bool newEnableBlending,
                                          BlendState::BlendFactor newColorBlendSource, BlendState::BlendFactor newColorBlendDest,
                                          BlendState::BlendOperation newColorOperation,
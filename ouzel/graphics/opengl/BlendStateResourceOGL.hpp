@@ -25,10 +25,13 @@ namespace ouzel
 {
     namespace graphics
     {
+        class RenderDeviceOGL;
+
         class BlendStateResourceOGL: public BlendStateResource
         {
         public:
-            BlendStateResourceOGL();
+            BlendStateResourceOGL(RenderDeviceOGL* aRenderDeviceOGL);
+            virtual ~BlendStateResourceOGL();
 
             virtual bool init(bool newEnableBlending,
                               BlendState::BlendFactor newColorBlendSource, BlendState::BlendFactor newColorBlendDest,
@@ -52,6 +55,8 @@ namespace ouzel
             GLboolean getAlphaMask() const { return alphaMask; }
 
         protected:
+            RenderDeviceOGL* renderDeviceOGL;
+
             GLenum modeRGB = GL_NONE;
             GLenum modeAlpha = GL_NONE;
             GLenum sourceFactorRGB = GL_NONE;
@@ -426,6 +426,64 @@ namespace ouzel
             return true;
         }
 
+        bool MeshBufferResourceOGL::bindInstanceBuffer(BufferResourceOGL* instanceBufferOGL)
+        {
+            if (!vertexArrayId)
+            {
+                Log(Log::Level::ERR) << "Instancing requires a vertex array";
+                return false;
+            }
+
+            if (!instanceBufferOGL || !instanceBufferOGL->getBufferId())
+            {
+                Log(Log::Level::ERR) << "Instance buffer not initialized";
+                return false;
+            }
+
+            if (!renderDeviceOGL->bindBuffer(GL_ARRAY_BUFFER, instanceBufferOGL->getBufferId()))
+            {
+                return false;
+            }
+
+            GLuint index = static_cast<GLuint>(vertexAttribs.size());
+            GLuint offset = 0;
+
+            for (const VertexAttribute& vertexAttribute : InstanceData::ATTRIBUTES)
+            {
+                glEnableVertexAttribArrayProc(index);
+                glVertexAttribPointerProc(index,
+                                          getArraySize(vertexAttribute.dataType),
+                                          getVertexFormat(vertexAttribute.dataType),
+                                          vertexAttribute.normalized ? GL_TRUE : GL_FALSE,
+                                          static_cast<GLsizei>(sizeof(InstanceData)),
+                                          static_cast<const GLchar*>(nullptr) + offset);
+                glVertexAttribDivisorProc(index, 1);
+
+                offset += getDataTypeSize(vertexAttribute.dataType);
+                ++index;
+            }
+
+            if (RenderDeviceOGL::checkOpenGLError())
+            {
+                Log(Log::Level::ERR) << "Failed to set instance attributes";
+                return false;
+            }
+
+            return true;
+        }
+
+        void MeshBufferResourceOGL::unbindInstanceBuffer()
+        {
+            // the attributes are part of the vertex array state, so reset them for the draws without instancing
+            GLuint index = static_cast<GLuint>(vertexAttribs.size());
+
+            for (size_t i = 0; i < InstanceData::ATTRIBUTES.size(); ++i, ++index)
+            {
+                glVertexAttribDivisorProc(index, 0);
+                glDisableVertexAttribArrayProc(index);
+            }
+        }
+
         bool MeshBufferResourceOGL::createVertexArray()
         {
             if (glGenVertexArraysProc) glGenVertexArraysProc(1, &vertexArrayId);
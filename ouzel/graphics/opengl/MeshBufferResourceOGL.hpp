@@ -48,6 +48,10 @@ namespace ouzel
 
             bool bindBuffers();
 
+            // per-instance attributes are bound after the attributes of the mesh
+            bool bindInstanceBuffer(BufferResourceOGL* instanceBufferOGL);
+            void unbindInstanceBuffer();
+
             GLenum getIndexType() const { return indexType; }
             GLuint getBytesPerIndex() const { return bytesPerIndex; }
             GLuint getVertexArrayId() const { return vertexArrayId; }
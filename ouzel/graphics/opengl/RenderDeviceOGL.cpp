@@ -9,6 +9,7 @@
 #include <dlfcn.h>
 #endif
 
+#include <algorithm>
 #include <sstream>
 
 #if OUZEL_SUPPORTS_OPENGLES
@@ -51,23 +52,32 @@
 #include "ColorVSGLES2.h"
 #include "TexturePSGLES2.h"
 #include "TextureVSGLES2.h"
+#include "TextureSDFPSGLES2.h"
+#include "TextureSDFFallbackPSGLES2.h"
 #include "ColorPSGLES3.h"
 #include "ColorVSGLES3.h"
 #include "TexturePSGLES3.h"
 #include "TextureVSGLES3.h"
+#include "TextureSDFPSGLES3.h"
+#include "TextureInstancedVSGLES3.h"
 #else
 #include "ColorPSGL2.h"
 #include "ColorVSGL2.h"
 #include "TexturePSGL2.h"
 #include "TextureVSGL2.h"
+#include "TextureSDFPSGL2.h"
 #include "ColorPSGL3.h"
 #include "ColorVSGL3.h"
 #include "TexturePSGL3.h"
 #include "TextureVSGL3.h"
+#include "TextureSDFPSGL3.h"
+#include "TextureInstancedVSGL3.h"
 #include "ColorPSGL4.h"
 #include "ColorVSGL4.h"
 #include "TexturePSGL4.h"
 #include "TextureVSGL4.h"
+#include "TextureSDFPSGL4.h"
+#include "TextureInstancedVSGL4.h"
 #endif
 
 PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparateProc;
@@ -136,6 +146,15 @@ PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArraysProc;
 PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArrayProc;
 PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArrayProc;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointerProc;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisorProc;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstancedProc;
+
+PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndexProc;
+PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBindingProc;
+PFNGLGETACTIVEUNIFORMBLOCKIVPROC glGetActiveUniformBlockivProc;
+PFNGLGETUNIFORMINDICESPROC glGetUniformIndicesProc;
+PFNGLGETACTIVEUNIFORMSIVPROC glGetActiveUniformsivProc;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRangeProc;
 
 PFNGLGETSTRINGIPROC glGetStringiProc;
 
@@ -324,6 +343,9 @@ namespace ouzel
 #endif
 
             anisotropicFilteringSupported = false;
+#if OUZEL_SUPPORTS_OPENGLES
+            bool standardDerivativesSupported = false;
+#endif
 
             std::vector<std::string> extensions;
 
@@ -434,6 +456,51 @@ namespace ouzel
                 glFramebufferTexture2DMultisampleProc = reinterpret_cast<PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC>(getProcAddress("glFramebufferTexture2DMultisample"));
     #endif
 #endif
+
+#if OUZEL_OPENGL_INTERFACE_EAGL
+                glVertexAttribDivisorProc = glVertexAttribDivisor;
+                glDrawElementsInstancedProc = glDrawElementsInstanced;
+#else
+                glVertexAttribDivisorProc = reinterpret_cast<PFNGLVERTEXATTRIBDIVISORPROC>(getProcAddress("glVertexAttribDivisor"));
+                glDrawElementsInstancedProc = reinterpret_cast<PFNGLDRAWELEMENTSINSTANCEDPROC>(getProcAddress("glDrawElementsInstanced"));
+#endif
+
+                instancingSupported = glVertexAttribDivisorProc && glDrawElementsInstancedProc && glGenVertexArraysProc;
+
+#if OUZEL_OPENGL_INTERFACE_EAGL
+                glGetUniformBlockIndexProc = glGetUniformBlockIndex;
+                glUniformBlockBindingProc = glUniformBlockBinding;
+                glGetActiveUniformBlockivProc = glGetActiveUniformBlockiv;
+                glGetUniformIndicesProc = glGetUniformIndices;
+                glGetActiveUniformsivProc = glGetActiveUniformsiv;
+                glBindBufferRangeProc = glBindBufferRange;
+#else
+                glGetUniformBlockIndexProc = reinterpret_cast<PFNGLGETUNIFORMBLOCKINDEXPROC>(getProcAddress("glGetUniformBlockIndex"));
+                glUniformBlockBindingProc = reinterpret_cast<PFNGLUNIFORMBLOCKBINDINGPROC>(getProcAddress("glUniformBlockBinding"));
+                glGetActiveUniformBlockivProc = reinterpret_cast<PFNGLGETACTIVEUNIFORMBLOCKIVPROC>(getProcAddress("glGetActiveUniformBlockiv"));
+                glGetUniformIndicesProc = reinterpret_cast<PFNGLGETUNIFORMINDICESPROC>(getProcAddress("glGetUniformIndices"));
+                glGetActiveUniformsivProc = reinterpret_cast<PFNGLGETACTIVEUNIFORMSIVPROC>(getProcAddress("glGetActiveUniformsiv"));
+                glBindBufferRangeProc = reinterpret_cast<PFNGLBINDBUFFERRANGEPROC>(getProcAddress("glBindBufferRange"));
+#endif
+
+                if (glGetUniformBlockIndexProc &&
+                    glUniformBlockBindingProc &&
+                    glGetActiveUniformBlockivProc &&
+                    glGetUniformIndicesProc &&
+                    glGetActiveUniformsivProc &&
+                    glBindBufferRangeProc)
+                {
+                    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferOffsetAlignment);
+
+                    if (checkOpenGLError() || uniformBufferOffsetAlignment <= 0)
+                    {
+                        Log(Log::Level::WARN) << "Failed to get uniform buffer offset alignment";
+                    }
+                    else
+                    {
+                        uniformBuffersSupported = true;
+                    }
+                }
             }
             else
             {
@@ -458,6 +525,12 @@ namespace ouzel
                     {
                         npotTexturesSupported = true;
                     }
+#if OUZEL_SUPPORTS_OPENGLES
+                    else if (extension == "GL_OES_standard_derivatives")
+                    {
+                        standardDerivativesSupported = true;
+                    }
+#endif
 #if !OUZEL_SUPPORTS_OPENGLES
                     else if (extension == "GL_EXT_framebuffer_object")
                     {
@@ -578,6 +651,108 @@ namespace ouzel
 
             sharedEngine->getCache()->setShader(SHADER_TEXTURE, textureShader);
 
+            std::shared_ptr<Shader> textureSDFShader = std::make_shared<Shader>();
+
+            switch (apiMajorVersion)
+            {
+#if OUZEL_SUPPORTS_OPENGLES
+                case 2:
+                    if (standardDerivativesSupported)
+                    {
+                        textureSDFShader->init(std::vector<uint8_t>(std::begin(TextureSDFPSGLES2_glsl), std::end(TextureSDFPSGLES2_glsl)),
+                                               std::vector<uint8_t>(std::begin(TextureVSGLES2_glsl), std::end(TextureVSGLES2_glsl)),
+                                               VertexPCT::ATTRIBUTES,
+                                               {{"color", DataType::FLOAT_VECTOR4}},
+                                               {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                    }
+                    else
+                    {
+                        // without fwidth the edge is smoothed over a fixed distance range
+                        textureSDFShader->init(std::vector<uint8_t>(std::begin(TextureSDFFallbackPSGLES2_glsl), std::end(TextureSDFFallbackPSGLES2_glsl)),
+                                               std::vector<uint8_t>(std::begin(TextureVSGLES2_glsl), std::end(TextureVSGLES2_glsl)),
+                                               VertexPCT::ATTRIBUTES,
+                                               {{"color", DataType::FLOAT_VECTOR4}},
+                                               {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                    }
+                    break;
+                case 3:
+                    textureSDFShader->init(std::vector<uint8_t>(std::begin(TextureSDFPSGLES3_glsl), std::end(TextureSDFPSGLES3_glsl)),
+                                           std::vector<uint8_t>(std::begin(TextureVSGLES3_glsl), std::end(TextureVSGLES3_glsl)),
+                                           VertexPCT::ATTRIBUTES,
+                                           {{"color", DataType::FLOAT_VECTOR4}},
+                                           {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                    break;
+#else
+                case 2:
+                    textureSDFShader->init(std::vector<uint8_t>(std::begin(TextureSDFPSGL2_glsl), std::end(TextureSDFPSGL2_glsl)),
+                                           std::vector<uint8_t>(std::begin(TextureVSGL2_glsl), std::end(TextureVSGL2_glsl)),
+                                           VertexPCT::ATTRIBUTES,
+                                           {{"color", DataType::FLOAT_VECTOR4}},
+                                           {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                    break;
+                case 3:
+                    textureSDFShader->init(std::vector<uint8_t>(std::begin(TextureSDFPSGL3_glsl), std::end(TextureSDFPSGL3_glsl)),
+                                           std::vector<uint8_t>(std::begin(TextureVSGL3_glsl), std::end(TextureVSGL3_glsl)),
+                                           VertexPCT::ATTRIBUTES,
+                                           {{"color", DataType::FLOAT_VECTOR4}},
+                                           {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                    break;
+                case 4:
+                    textureSDFShader->init(std::vector<uint8_t>(std::begin(TextureSDFPSGL4_glsl), std::end(TextureSDFPSGL4_glsl)),
+                                           std::vector<uint8_t>(std::begin(TextureVSGL4_glsl), std::end(TextureVSGL4_glsl)),
+                                           VertexPCT::ATTRIBUTES,
+                                           {{"color", DataType::FLOAT_VECTOR4}},
+                                           {{"modelViewProj", DataType::FLOAT_MATRIX4}});
+                    break;
+#endif
+                default:
+                    Log(Log::Level::ERR) << "Unsupported OpenGL version";
+                    return false;
+            }
+
+            sharedEngine->getCache()->setShader(SHADER_TEXTURE_SDF, textureSDFShader);
+
+            if (instancingSupported)
+            {
+                std::vector<VertexAttribute> instancedAttributes = VertexPCT::ATTRIBUTES;
+                instancedAttributes.insert(instancedAttributes.end(), InstanceData::ATTRIBUTES.begin(), InstanceData::ATTRIBUTES.end());
+
+                std::shared_ptr<Shader> textureInstancedShader = std::make_shared<Shader>();
+
+                switch (apiMajorVersion)
+                {
+#if OUZEL_SUPPORTS_OPENGLES
+                    case 3:
+                        textureInstancedShader->init(std::vector<uint8_t>(std::begin(TexturePSGLES3_glsl), std::end(TexturePSGLES3_glsl)),
+                                                     std::vector<uint8_t>(std::begin(TextureInstancedVSGLES3_glsl), std::end(TextureInstancedVSGLES3_glsl)),
+                                                     instancedAttributes,
+                                                     {{"color", DataType::FLOAT_VECTOR4}},
+                                                     {{"viewProj", DataType::FLOAT_MATRIX4}});
+                        break;
+#else
+                    case 3:
+                        textureInstancedShader->init(std::vector<uint8_t>(std::begin(TexturePSGL3_glsl), std::end(TexturePSGL3_glsl)),
+                                                     std::vector<uint8_t>(std::begin(TextureInstancedVSGL3_glsl), std::end(TextureInstancedVSGL3_glsl)),
+                                                     instancedAttributes,
+                                                     {{"color", DataType::FLOAT_VECTOR4}},
+                                                     {{"viewProj", DataType::FLOAT_MATRIX4}});
+                        break;
+                    case 4:
+                        textureInstancedShader->init(std::vector<uint8_t>(std::begin(TexturePSGL4_glsl), std::end(TexturePSGL4_glsl)),
+                                                     std::vector<uint8_t>(std::begin(TextureInstancedVSGL4_glsl), std::end(TextureInstancedVSGL4_glsl)),
+                                                     instancedAttributes,
+                                                     {{"color", DataType::FLOAT_VECTOR4}},
+                                                     {{"viewProj", DataType::FLOAT_MATRIX4}});
+                        break;
+#endif
+                    default:
+                        Log(Log::Level::ERR) << "Unsupported OpenGL version";
+                        return false;
+                }
+
+                sharedEngine->getCache()->setShader(SHADER_TEXTURE_INSTANCED, textureInstancedShader);
+            }
+
             std::shared_ptr<Shader> colorShader = std::make_shared<Shader>();
 
             switch (apiMajorVersion)
@@ -713,10 +888,18 @@ namespace ouzel
 
         bool RenderDeviceOGL::draw(const std::vector<DrawCommand>& drawCommands)
         {
-            if (drawCommands.empty())
+            currentShaderConstantUploadCount = 0;
+            currentSkippedShaderConstantUploadCount = 0;
+            currentStateChangeCount = 0;
+            currentPipelineState = nullptr;
+
+            if (uniformBuffersSupported && !uploadShaderConstants(drawCommands))
             {
-                frameBufferClearedFrame = currentFrame;
+                return false;
+            }
 
+            if (drawCommands.empty())
+            {
                 if (clearMask)
                 {
                     if (!bindFrameBuffer(frameBufferId))
@@ -750,11 +933,11 @@ namespace ouzel
                     return false;
                 }
             }
-            else for (const DrawCommand& drawCommand : drawCommands)
+            else for (size_t commandIndex = 0; commandIndex < drawCommands.size(); ++commandIndex)
             {
-#if !OUZEL_SUPPORTS_OPENGLES
-                setPolygonFillMode(drawCommand.wireframe ? GL_LINE : GL_FILL);
-#else
+                const DrawCommand& drawCommand = drawCommands[commandIndex];
+
+#if OUZEL_SUPPORTS_OPENGLES
                 if (drawCommand.wireframe)
                 {
                     continue;
@@ -770,23 +953,13 @@ namespace ouzel
                     continue;
                 }
 
-                if (!setBlendState(blendStateOGL->isGLBlendEnabled(),
-                                   blendStateOGL->getModeRGB(),
-                                   blendStateOGL->getModeAlpha(),
-                                   blendStateOGL->getSourceFactorRGB(),
-                                   blendStateOGL->getDestFactorRGB(),
-                                   blendStateOGL->getSourceFactorAlpha(),
-                                   blendStateOGL->getDestFactorAlpha()))
-                {
-                    return false;
-                }
+                // shader
+                ShaderResourceOGL* shaderOGL = static_cast<ShaderResourceOGL*>(drawCommand.shader);
 
-                if (!setColorMask(blendStateOGL->getRedMask(),
-                                  blendStateOGL->getGreenMask(),
-                                  blendStateOGL->getBlueMask(),
-                                  blendStateOGL->getAlphaMask()))
+                if (!shaderOGL || !shaderOGL->getProgramId())
                 {
-                    return false;
+                    // don't render if invalid shader
+                    continue;
                 }
 
                 GLenum cullFace = GL_NONE;
@@ -799,7 +972,14 @@ namespace ouzel
                     default: Log(Log::Level::ERR) << "Invalid cull mode"; return false;
                 }
 
-                if (!setCullFace(cullFace != GL_NONE, cullFace))
+                const PipelineState* pipelineState = getPipelineState(blendStateOGL,
+                                                                      shaderOGL->getProgramId(),
+                                                                      cullFace,
+                                                                      drawCommand.wireframe,
+                                                                      drawCommand.depthTest,
+                                                                      drawCommand.depthWrite);
+
+                if (!setPipelineState(pipelineState))
                 {
                     return false;
                 }
@@ -843,19 +1023,8 @@ namespace ouzel
                     continue;
                 }
 
-                // shader
-                ShaderResourceOGL* shaderOGL = static_cast<ShaderResourceOGL*>(drawCommand.shader);
-
-                if (!shaderOGL || !shaderOGL->getProgramId())
-                {
-                    // don't render if invalid shader
-                    continue;
-                }
-
-                useProgram(shaderOGL->getProgramId());
-
                 // pixel shader constants
-                const std::vector<ShaderResourceOGL::Location>& pixelShaderConstantLocations = shaderOGL->getPixelShaderConstantLocations();
+                std::vector<ShaderResourceOGL::Location>& pixelShaderConstantLocations = shaderOGL->getPixelShaderConstantLocations();
 
                 if (drawCommand.pixelShaderConstants.size() > pixelShaderConstantLocations.size())
                 {
@@ -863,51 +1032,23 @@ namespace ouzel
                     return false;
                 }
 
-                for (size_t i = 0; i < drawCommand.pixelShaderConstants.size(); ++i)
+                if (GLuint blockSize = shaderOGL->getPixelShaderConstantBlockSize())
                 {
-                    const ShaderResourceOGL::Location& pixelShaderConstantLocation = pixelShaderConstantLocations[i];
-                    const std::vector<float>& pixelShaderConstant = drawCommand.pixelShaderConstants[i];
-
-                    switch (pixelShaderConstantLocation.dataType)
+                    if (!bindUniformBufferRange(ShaderResourceOGL::PIXEL_SHADER_CONSTANT_BINDING,
+                                                uniformBufferId,
+                                                shaderConstantOffsets[commandIndex].pixel,
+                                                static_cast<GLsizeiptr>(blockSize)))
                     {
-                        case DataType::INTEGER:
-                            glUniform1ivProc(pixelShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(pixelShaderConstant.data()));
-                            break;
-                        case DataType::INTEGER_VECTOR2:
-                            glUniform2ivProc(pixelShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(pixelShaderConstant.data()));
-                            break;
-                        case DataType::INTEGER_VECTOR3:
-                            glUniform3ivProc(pixelShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(pixelShaderConstant.data()));
-                            break;
-                        case DataType::INTEGER_VECTOR4:
-                            glUniform4ivProc(pixelShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(pixelShaderConstant.data()));
-                            break;
-                        case DataType::FLOAT:
-                            glUniform1fvProc(pixelShaderConstantLocation.location, 1, pixelShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_VECTOR2:
-                            glUniform2fvProc(pixelShaderConstantLocation.location, 1, pixelShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_VECTOR3:
-                            glUniform3fvProc(pixelShaderConstantLocation.location, 1, pixelShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_VECTOR4:
-                            glUniform4fvProc(pixelShaderConstantLocation.location, 1, pixelShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_MATRIX3:
-                            glUniformMatrix3fvProc(pixelShaderConstantLocation.location, 1, GL_FALSE, pixelShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_MATRIX4:
-                            glUniformMatrix4fvProc(pixelShaderConstantLocation.location, 1, GL_FALSE, pixelShaderConstant.data());
-                            break;
-                        default:
-                            Log(Log::Level::ERR) << "Unsupported uniform size";
-                            return false;
+                        return false;
                     }
                 }
+                else if (!setShaderConstants(pixelShaderConstantLocations, drawCommand.pixelShaderConstants))
+                {
+                    return false;
+                }
 
                 // vertex shader constants
-                const std::vector<ShaderResourceOGL::Location>& vertexShaderConstantLocations = shaderOGL->getVertexShaderConstantLocations();
+                std::vector<ShaderResourceOGL::Location>& vertexShaderConstantLocations = shaderOGL->getVertexShaderConstantLocations();
 
                 if (drawCommand.vertexShaderConstants.size() > vertexShaderConstantLocations.size())
                 {
@@ -915,48 +1056,20 @@ namespace ouzel
                     return false;
                 }
 
-                for (size_t i = 0; i < drawCommand.vertexShaderConstants.size(); ++i)
+                if (GLuint blockSize = shaderOGL->getVertexShaderConstantBlockSize())
                 {
-                    const ShaderResourceOGL::Location& vertexShaderConstantLocation = vertexShaderConstantLocations[i];
-                    const std::vector<float>& vertexShaderConstant = drawCommand.vertexShaderConstants[i];
-
-                    switch (vertexShaderConstantLocation.dataType)
+                    if (!bindUniformBufferRange(ShaderResourceOGL::VERTEX_SHADER_CONSTANT_BINDING,
+                                                uniformBufferId,
+                                                shaderConstantOffsets[commandIndex].vertex,
+                                                static_cast<GLsizeiptr>(blockSize)))
                     {
-                        case DataType::INTEGER:
-                            glUniform1ivProc(vertexShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(vertexShaderConstant.data()));
-                            break;
-                        case DataType::INTEGER_VECTOR2:
-                            glUniform2ivProc(vertexShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(vertexShaderConstant.data()));
-                            break;
-                        case DataType::INTEGER_VECTOR3:
-                            glUniform3ivProc(vertexShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(vertexShaderConstant.data()));
-                            break;
-                        case DataType::INTEGER_VECTOR4:
-                            glUniform4ivProc(vertexShaderConstantLocation.location, 1, reinterpret_cast<const GLint*>(vertexShaderConstant.data()));
-                            break;
-                        case DataType::FLOAT:
-                            glUniform1fvProc(vertexShaderConstantLocation.location, 1, vertexShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_VECTOR2:
-                            glUniform2fvProc(vertexShaderConstantLocation.location, 1, vertexShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_VECTOR3:
-                            glUniform3fvProc(vertexShaderConstantLocation.location, 1, vertexShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_VECTOR4:
-                            glUniform4fvProc(vertexShaderConstantLocation.location, 1, vertexShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_MATRIX3:
-                            glUniformMatrix3fvProc(vertexShaderConstantLocation.location, 1, GL_FALSE, vertexShaderConstant.data());
-                            break;
-                        case DataType::FLOAT_MATRIX4:
-                            glUniformMatrix4fvProc(vertexShaderConstantLocation.location, 1, GL_FALSE, vertexShaderConstant.data());
-                            break;
-                        default:
-                            Log(Log::Level::ERR) << "Unsupported uniform size";
-                            return false;
+                        return false;
                     }
                 }
+                else if (!setShaderConstants(vertexShaderConstantLocations, drawCommand.vertexShaderConstants))
+                {
+                    return false;
+                }
 
                 // render target
                 GLuint newFrameBufferId = 0;
@@ -980,9 +1093,8 @@ namespace ouzel
                     newClearColor = renderTargetOGL->getFrameBufferClearColor();
                     newClearDepth = renderTargetOGL->getClearDepth();
 
-                    if (renderTargetOGL->getFrameBufferClearedFrame() != currentFrame)
+                    if (drawCommand.clearRenderTarget)
                     {
-                        renderTargetOGL->setFrameBufferClearedFrame(currentFrame);
                         newClearMask = renderTargetOGL->getClearMask();
                     }
                 }
@@ -994,9 +1106,8 @@ namespace ouzel
                     newClearColor = frameBufferClearColor;
                     newClearDepth = clearDepth;
 
-                    if (frameBufferClearedFrame != currentFrame)
+                    if (drawCommand.clearRenderTarget)
                     {
-                        frameBufferClearedFrame = currentFrame;
                         newClearMask = clearMask;
                     }
                 }
@@ -1006,8 +1117,13 @@ namespace ouzel
                     return false;
                 }
 
+                // render targets are drawn upside down (see renderTargetProjectionTransform), so their rows are already top to bottom
+                GLint viewportY = drawCommand.renderTarget ?
+                    static_cast<GLint>(drawCommand.viewport.position.y) :
+                    static_cast<GLint>(renderTargetHeight - (drawCommand.viewport.position.y + drawCommand.viewport.size.height));
+
                 setViewport(static_cast<GLint>(drawCommand.viewport.position.x),
-                            static_cast<GLint>(renderTargetHeight - (drawCommand.viewport.position.y + drawCommand.viewport.size.height)),
+                            viewportY,
                             static_cast<GLsizei>(drawCommand.viewport.size.width),
                             static_cast<GLsizei>(drawCommand.viewport.size.height));
 
@@ -1032,15 +1148,17 @@ namespace ouzel
                         Log(Log::Level::ERR) << "Failed to clear frame buffer";
                         return false;
                     }
-                }
 
-                enableDepthTest(drawCommand.depthTest);
-                setDepthMask(drawCommand.depthWrite);
+                    // restore the depth mask of the pipeline state
+                    setDepthMask(pipelineState->depthWrite);
+                }
 
                 // scissor test
                 setScissorTest(drawCommand.scissorTest,
                                static_cast<GLint>(drawCommand.scissorRectangle.position.x),
-                               static_cast<GLint>(renderTargetHeight - (drawCommand.scissorRectangle.position.y + drawCommand.scissorRectangle.size.height)),
+                               drawCommand.renderTarget ?
+                                   static_cast<GLint>(drawCommand.scissorRectangle.position.y) :
+                                   static_cast<GLint>(renderTargetHeight - (drawCommand.scissorRectangle.position.y + drawCommand.scissorRectangle.size.height)),
                                static_cast<GLsizei>(drawCommand.scissorRectangle.size.width),
                                static_cast<GLsizei>(drawCommand.scissorRectangle.size.height));
 
@@ -1084,10 +1202,28 @@ namespace ouzel
                     indexCount = (indexBufferOGL->getSize() / meshBufferOGL->getIndexSize()) - drawCommand.startIndex;
                 }
 
-                glDrawElements(mode,
-                               static_cast<GLsizei>(indexCount),
-                               meshBufferOGL->getIndexType(),
-                               static_cast<const char*>(nullptr) + (drawCommand.startIndex * meshBufferOGL->getBytesPerIndex()));
+                if (drawCommand.instanceCount)
+                {
+                    if (!meshBufferOGL->bindInstanceBuffer(static_cast<BufferResourceOGL*>(drawCommand.instanceBuffer)))
+                    {
+                        return false;
+                    }
+
+                    glDrawElementsInstancedProc(mode,
+                                                static_cast<GLsizei>(indexCount),
+                                                meshBufferOGL->getIndexType(),
+                                                static_cast<const char*>(nullptr) + (drawCommand.startIndex * meshBufferOGL->getBytesPerIndex()),
+                                                static_cast<GLsizei>(drawCommand.instanceCount));
+
+                    meshBufferOGL->unbindInstanceBuffer();
+                }
+                else
+                {
+                    glDrawElements(mode,
+                                   static_cast<GLsizei>(indexCount),
+                                   meshBufferOGL->getIndexType(),
+                                   static_cast<const char*>(nullptr) + (drawCommand.startIndex * meshBufferOGL->getBytesPerIndex()));
+                }
 
                 if (checkOpenGLError())
                 {
@@ -1096,6 +1232,10 @@ namespace ouzel
                 }
             }
 
+            shaderConstantUploadCount = currentShaderConstantUploadCount;
+            skippedShaderConstantUploadCount = currentSkippedShaderConstantUploadCount;
+            stateChangeCount = currentStateChangeCount;
+
             if (!swapBuffers())
             {
                 return false;
@@ -1104,6 +1244,329 @@ namespace ouzel
             return true;
         }
 
+        RenderDeviceOGL::PipelineState::PipelineState(BlendStateResourceOGL* aBlendState,
+                                                      GLuint aProgramId,
+                                                      GLenum aCullFace,
+                                                      bool aWireframe,
+                                                      bool aDepthTest,
+                                                      bool aDepthWrite):
+            blendState(aBlendState),
+            programId(aProgramId),
+            cullFace(aCullFace),
+            wireframe(aWireframe),
+            depthTest(aDepthTest),
+            depthWrite(aDepthWrite)
+        {
+            hash = std::hash<BlendStateResourceOGL*>()(blendState);
+            hash ^= std::hash<GLuint>()(programId) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<GLenum>()(cullFace) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= static_cast<size_t>((wireframe ? 1 : 0) | (depthTest ? 2 : 0) | (depthWrite ? 4 : 0)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+
+        const RenderDeviceOGL::PipelineState* RenderDeviceOGL::getPipelineState(BlendStateResourceOGL* blendState,
+                                                                                GLuint programId,
+                                                                                GLenum cullFace,
+                                                                                bool wireframe,
+                                                                                bool depthTest,
+                                                                                bool depthWrite)
+        {
+            // consecutive draw commands usually share the state, so the hash lookup is skipped for them
+            if (lastPipelineState &&
+                lastPipelineState->blendState == blendState &&
+                lastPipelineState->programId == programId &&
+                lastPipelineState->cullFace == cullFace &&
+                lastPipelineState->wireframe == wireframe &&
+                lastPipelineState->depthTest == depthTest &&
+                lastPipelineState->depthWrite == depthWrite)
+            {
+                return lastPipelineState;
+            }
+
+            auto result = pipelineStates.emplace(blendState, programId, cullFace, wireframe, depthTest, depthWrite);
+            lastPipelineState = &*result.first;
+
+            return lastPipelineState;
+        }
+
+        void RenderDeviceOGL::deletePipelineStates(BlendStateResourceOGL* blendState, GLuint programId)
+        {
+            for (auto i = pipelineStates.begin(); i != pipelineStates.end();)
+            {
+                if ((blendState && i->blendState == blendState) ||
+                    (programId && i->programId == programId))
+                {
+                    if (lastPipelineState == &*i) lastPipelineState = nullptr;
+                    if (currentPipelineState == &*i) currentPipelineState = nullptr;
+
+                    i = pipelineStates.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        bool RenderDeviceOGL::setPipelineState(const PipelineState* pipelineState)
+        {
+            if (currentPipelineState == pipelineState)
+            {
+                return true;
+            }
+
+            BlendStateResourceOGL* blendStateOGL = pipelineState->blendState;
+
+            if (!setBlendState(blendStateOGL->isGLBlendEnabled(),
+                               blendStateOGL->getModeRGB(),
+                               blendStateOGL->getModeAlpha(),
+                               blendStateOGL->getSourceFactorRGB(),
+                               blendStateOGL->getDestFactorRGB(),
+                               blendStateOGL->getSourceFactorAlpha(),
+                               blendStateOGL->getDestFactorAlpha()))
+            {
+                return false;
+            }
+
+            if (!setColorMask(blendStateOGL->getRedMask(),
+                              blendStateOGL->getGreenMask(),
+                              blendStateOGL->getBlueMask(),
+                              blendStateOGL->getAlphaMask()))
+            {
+                return false;
+            }
+
+            if (!setCullFace(pipelineState->cullFace != GL_NONE, pipelineState->cullFace))
+            {
+                return false;
+            }
+
+#if !OUZEL_SUPPORTS_OPENGLES
+            if (!setPolygonFillMode(pipelineState->wireframe ? GL_LINE : GL_FILL))
+            {
+                return false;
+            }
+#endif
+
+            if (!useProgram(pipelineState->programId))
+            {
+                return false;
+            }
+
+            if (!enableDepthTest(pipelineState->depthTest))
+            {
+                return false;
+            }
+
+            if (!setDepthMask(pipelineState->depthWrite))
+            {
+                return false;
+            }
+
+            currentPipelineState = pipelineState;
+            ++currentStateChangeCount;
+
+            return true;
+        }
+
+        bool RenderDeviceOGL::uploadShaderConstants(const std::vector<DrawCommand>& drawCommands)
+        {
+            shaderConstantData.clear();
+            shaderConstantOffsets.resize(drawCommands.size());
+
+            GLintptr lastPixelOffset = -1;
+            GLuint lastPixelSize = 0;
+            GLintptr lastVertexOffset = -1;
+            GLuint lastVertexSize = 0;
+
+            for (size_t commandIndex = 0; commandIndex < drawCommands.size(); ++commandIndex)
+            {
+                const DrawCommand& drawCommand = drawCommands[commandIndex];
+                ShaderConstantOffsets& offsets = shaderConstantOffsets[commandIndex];
+                offsets.pixel = -1;
+                offsets.vertex = -1;
+
+                ShaderResourceOGL* shaderOGL = static_cast<ShaderResourceOGL*>(drawCommand.shader);
+
+                if (!shaderOGL || !shaderOGL->getProgramId())
+                {
+                    continue;
+                }
+
+                if (GLuint blockSize = shaderOGL->getPixelShaderConstantBlockSize())
+                {
+                    offsets.pixel = addShaderConstantBlock(shaderOGL->getPixelShaderConstantLocations(),
+                                                           drawCommand.pixelShaderConstants,
+                                                           blockSize,
+                                                           lastPixelOffset,
+                                                           lastPixelSize);
+                }
+
+                if (GLuint blockSize = shaderOGL->getVertexShaderConstantBlockSize())
+                {
+                    offsets.vertex = addShaderConstantBlock(shaderOGL->getVertexShaderConstantLocations(),
+                                                            drawCommand.vertexShaderConstants,
+                                                            blockSize,
+                                                            lastVertexOffset,
+                                                            lastVertexSize);
+                }
+            }
+
+            if (shaderConstantData.empty())
+            {
+                return true;
+            }
+
+            if (!uniformBufferId)
+            {
+                glGenBuffersProc(1, &uniformBufferId);
+
+                if (checkOpenGLError())
+                {
+                    Log(Log::Level::ERR) << "Failed to create uniform buffer";
+                    return false;
+                }
+            }
+
+            if (!bindBuffer(GL_UNIFORM_BUFFER, uniformBufferId))
+            {
+                return false;
+            }
+
+            // the whole buffer is respecified every frame, so the driver can orphan the previous storage
+            glBufferDataProc(GL_UNIFORM_BUFFER,
+                             static_cast<GLsizeiptr>(shaderConstantData.size()),
+                             shaderConstantData.data(),
+                             GL_STREAM_DRAW);
+
+            if (checkOpenGLError())
+            {
+                Log(Log::Level::ERR) << "Failed to upload uniform buffer data";
+                return false;
+            }
+
+            return true;
+        }
+
+        GLintptr RenderDeviceOGL::addShaderConstantBlock(const std::vector<ShaderResourceOGL::Location>& constantLocations,
+                                                         const std::vector<std::vector<float>>& shaderConstants,
+                                                         GLuint blockSize,
+                                                         GLintptr& lastOffset,
+                                                         GLuint& lastSize)
+        {
+            size_t previousSize = shaderConstantData.size();
+            size_t alignment = static_cast<size_t>(uniformBufferOffsetAlignment);
+            size_t offset = ((previousSize + alignment - 1) / alignment) * alignment;
+
+            shaderConstantData.resize(offset + blockSize);
+            uint8_t* block = shaderConstantData.data() + offset;
+
+            for (size_t i = 0; i < shaderConstants.size() && i < constantLocations.size(); ++i)
+            {
+                const ShaderResourceOGL::Location& constantLocation = constantLocations[i];
+                const std::vector<float>& shaderConstant = shaderConstants[i];
+
+                if (constantLocation.offset < 0 || static_cast<GLuint>(constantLocation.offset) >= blockSize)
+                {
+                    continue;
+                }
+
+                uint8_t* destination = block + constantLocation.offset;
+                size_t available = blockSize - static_cast<size_t>(constantLocation.offset);
+
+                if (constantLocation.dataType == DataType::FLOAT_MATRIX3)
+                {
+                    // std140 pads every column of a mat3 to a vec4
+                    for (size_t column = 0; column < 3 && (column + 1) * 3 <= shaderConstant.size(); ++column)
+                    {
+                        size_t columnOffset = column * 4 * sizeof(float);
+
+                        if (columnOffset + 3 * sizeof(float) > available) break;
+
+                        memcpy(destination + columnOffset, shaderConstant.data() + column * 3, 3 * sizeof(float));
+                    }
+                }
+                else
+                {
+                    memcpy(destination, shaderConstant.data(), std::min(shaderConstant.size() * sizeof(float), available));
+                }
+            }
+
+            // consecutive draw calls often share the constants (e.g. the color), so the previous block is reused
+            if (lastOffset >= 0 &&
+                lastSize == blockSize &&
+                memcmp(shaderConstantData.data() + lastOffset, block, blockSize) == 0)
+            {
+                shaderConstantData.resize(previousSize);
+                ++currentSkippedShaderConstantUploadCount;
+                return lastOffset;
+            }
+
+            lastOffset = static_cast<GLintptr>(offset);
+            lastSize = blockSize;
+            ++currentShaderConstantUploadCount;
+
+            return lastOffset;
+        }
+
+        bool RenderDeviceOGL::setShaderConstants(std::vector<ShaderResourceOGL::Location>& constantLocations,
+                                                 const std::vector<std::vector<float>>& shaderConstants)
+        {
+            for (size_t i = 0; i < shaderConstants.size(); ++i)
+            {
+                ShaderResourceOGL::Location& constantLocation = constantLocations[i];
+                const std::vector<float>& shaderConstant = shaderConstants[i];
+
+                // the program keeps the uniform values, so they have to be set only if they have changed
+                if (constantLocation.value == shaderConstant)
+                {
+                    ++currentSkippedShaderConstantUploadCount;
+                    continue;
+                }
+
+                switch (constantLocation.dataType)
+                {
+                    case DataType::INTEGER:
+                        glUniform1ivProc(constantLocation.location, 1, reinterpret_cast<const GLint*>(shaderConstant.data()));
+                        break;
+                    case DataType::INTEGER_VECTOR2:
+                        glUniform2ivProc(constantLocation.location, 1, reinterpret_cast<const GLint*>(shaderConstant.data()));
+                        break;
+                    case DataType::INTEGER_VECTOR3:
+                        glUniform3ivProc(constantLocation.location, 1, reinterpret_cast<const GLint*>(shaderConstant.data()));
+                        break;
+                    case DataType::INTEGER_VECTOR4:
+                        glUniform4ivProc(constantLocation.location, 1, reinterpret_cast<const GLint*>(shaderConstant.data()));
+                        break;
+                    case DataType::FLOAT:
+                        glUniform1fvProc(constantLocation.location, 1, shaderConstant.data());
+                        break;
+                    case DataType::FLOAT_VECTOR2:
+                        glUniform2fvProc(constantLocation.location, 1, shaderConstant.data());
+                        break;
+                    case DataType::FLOAT_VECTOR3:
+                        glUniform3fvProc(constantLocation.location, 1, shaderConstant.data());
+                        break;
+                    case DataType::FLOAT_VECTOR4:
+                        glUniform4fvProc(constantLocation.location, 1, shaderConstant.data());
+                        break;
+                    case DataType::FLOAT_MATRIX3:
+                        glUniformMatrix3fvProc(constantLocation.location, 1, GL_FALSE, shaderConstant.data());
+                        break;
+                    case DataType::FLOAT_MATRIX4:
+                        glUniformMatrix4fvProc(constantLocation.location, 1, GL_FALSE, shaderConstant.data());
+                        break;
+                    default:
+                        Log(Log::Level::ERR) << "Unsupported uniform size";
+                        return false;
+                }
+
+                constantLocation.value = shaderConstant;
+                ++currentShaderConstantUploadCount;
+            }
+
+            return true;
+        }
+
         bool RenderDeviceOGL::lockContext()
         {
             return true;
@@ -1155,7 +1618,7 @@ namespace ouzel
         {
             std::lock_guard<std::mutex> lock(resourceMutex);
 
-            BlendStateResource* blendState = new BlendStateResourceOGL();
+            BlendStateResource* blendState = new BlendStateResourceOGL(this);
             resources.push_back(std::unique_ptr<RenderResource>(blendState));
             return blendState;
         }
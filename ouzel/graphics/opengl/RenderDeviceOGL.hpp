@@ -12,6 +12,7 @@
 #include <map>
 #include <mutex>
 #include <queue>
+#include <unordered_set>
 #include <utility>
 
 #if OUZEL_SUPPORTS_OPENGLES
@@ -92,6 +93,15 @@ extern PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArraysProc;
 extern PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArrayProc;
 extern PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArrayProc;
 extern PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointerProc;
+extern PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisorProc;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstancedProc;
+
+extern PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndexProc;
+extern PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBindingProc;
+extern PFNGLGETACTIVEUNIFORMBLOCKIVPROC glGetActiveUniformBlockivProc;
+extern PFNGLGETUNIFORMINDICESPROC glGetUniformIndicesProc;
+extern PFNGLGETACTIVEUNIFORMSIVPROC glGetActiveUniformsivProc;
+extern PFNGLBINDBUFFERRANGEPROC glBindBufferRangeProc;
 
 extern PFNGLGETSTRINGIPROC glGetStringiProc;
 
@@ -108,12 +118,15 @@ extern PFNGLMAPBUFFERRANGEPROC glMapBufferRangeProc;
 
 #include "graphics/RenderDevice.hpp"
 #include "graphics/TextureResource.hpp"
+#include "graphics/opengl/ShaderResourceOGL.hpp"
 #include "utils/Log.hpp"
 
 namespace ouzel
 {
     namespace graphics
     {
+        class BlendStateResourceOGL;
+
         class RenderDeviceOGL: public RenderDevice
         {
             friend RenderDevice;
@@ -157,6 +170,7 @@ namespace ouzel
 
             bool isTextureBaseLevelSupported() const { return textureBaseLevelSupported; }
             bool isTextureMaxLevelSupported() const { return textureMaxLevelSupported; }
+            bool isUniformBuffersSupported() const { return uniformBuffersSupported; }
 
             inline bool bindTexture(GLuint textureId, uint32_t layer)
             {
@@ -229,6 +243,30 @@ namespace ouzel
                 return true;
             }
 
+            inline bool bindUniformBufferRange(GLuint index, GLuint bufferId, GLintptr offset, GLsizeiptr size)
+            {
+                StateCache::UniformBufferRange& range = stateCache.uniformBufferRanges[index];
+
+                if (range.bufferId != bufferId ||
+                    range.offset != offset ||
+                    range.size != size)
+                {
+                    glBindBufferRangeProc(GL_UNIFORM_BUFFER, index, bufferId, offset, size);
+                    range.bufferId = bufferId;
+                    range.offset = offset;
+                    range.size = size;
+                    stateCache.bufferId[GL_UNIFORM_BUFFER] = bufferId;
+
+                    if (checkOpenGLError())
+                    {
+                        Log(Log::Level::ERR) << "Failed to bind uniform buffer range";
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
             inline bool bindVertexArray(GLuint vertexArrayId)
             {
                 if (stateCache.vertexArrayId != vertexArrayId)
@@ -579,9 +617,15 @@ namespace ouzel
             void deleteProgram(GLuint programId)
             {
                 if (stateCache.programId == programId) stateCache.programId = 0;
+                deletePipelineStates(nullptr, programId);
                 glDeleteProgramProc(programId);
             }
 
+            void deleteBlendState(BlendStateResourceOGL* blendState)
+            {
+                deletePipelineStates(blendState, 0);
+            }
+
             void deleteTexture(GLuint textureId)
             {
                 for (uint32_t layer = 0; layer < Texture::LAYERS; ++layer)
@@ -641,6 +685,59 @@ namespace ouzel
 
             void* getProcAddress(const std::string& name) const;
 
+            // blend, cull, fill and depth state and the program of a draw command, created once and compared by pointer
+            struct PipelineState
+            {
+                PipelineState(BlendStateResourceOGL* aBlendState,
+                              GLuint aProgramId,
+                              GLenum aCullFace,
+                              bool aWireframe,
+                              bool aDepthTest,
+                              bool aDepthWrite);
+
+                bool operator==(const PipelineState& other) const
+                {
+                    return blendState == other.blendState &&
+                        programId == other.programId &&
+                        cullFace == other.cullFace &&
+                        wireframe == other.wireframe &&
+                        depthTest == other.depthTest &&
+                        depthWrite == other.depthWrite;
+                }
+
+                struct Hasher
+                {
+                    size_t operator()(const PipelineState& pipelineState) const { return pipelineState.hash; }
+                };
+
+                BlendStateResourceOGL* blendState;
+                GLuint programId;
+                GLenum cullFace; // GL_NONE if culling is disabled
+                bool wireframe;
+                bool depthTest;
+                bool depthWrite;
+                size_t hash;
+            };
+
+            const PipelineState* getPipelineState(BlendStateResourceOGL* blendState,
+                                                  GLuint programId,
+                                                  GLenum cullFace,
+                                                  bool wireframe,
+                                                  bool depthTest,
+                                                  bool depthWrite);
+            bool setPipelineState(const PipelineState* pipelineState);
+            // removes the pipeline states that use the blend state or the program
+            void deletePipelineStates(BlendStateResourceOGL* blendState, GLuint programId);
+
+            bool uploadShaderConstants(const std::vector<DrawCommand>& drawCommands);
+            GLintptr addShaderConstantBlock(const std::vector<ShaderResourceOGL::Location>& constantLocations,
+                                            const std::vector<std::vector<float>>& shaderConstants,
+                                            GLuint blockSize,
+                                            GLintptr& lastOffset,
+                                            GLuint& lastSize);
+            bool setShaderConstants(std::vector<ShaderResourceOGL::Location>& constantLocations,
+                                    const std::vector<std::vector<float>>& shaderConstants);
+
             GLuint frameBufferId = 0;
             GLsizei frameBufferWidth = 0;
             GLsizei frameBufferHeight = 0;
@@ -649,6 +746,28 @@ namespace ouzel
             GLfloat frameBufferClearColor[4];
             bool textureBaseLevelSupported = true;
             bool textureMaxLevelSupported = true;
+            bool uniformBuffersSupported = false;
+
+            // constants of all the draw commands of a frame are uploaded to one uniform buffer
+            GLuint uniformBufferId = 0;
+            GLint uniformBufferOffsetAlignment = 0;
+            std::vector<uint8_t> shaderConstantData;
+
+            struct ShaderConstantOffsets
+            {
+                GLintptr pixel;
+                GLintptr vertex;
+            };
+
+            std::vector<ShaderConstantOffsets> shaderConstantOffsets; // for every draw command
+
+            std::unordered_set<PipelineState, PipelineState::Hasher> pipelineStates; // elements keep their addresses on rehash
+            const PipelineState* lastPipelineState = nullptr; // last one returned by getPipelineState
+            const PipelineState* currentPipelineState = nullptr; // reset every frame, because resources can change the state between frames
+
+            uint32_t currentShaderConstantUploadCount = 0;
+            uint32_t currentSkippedShaderConstantUploadCount = 0;
+            uint32_t currentStateChangeCount = 0;
 
             struct StateCache
             {
@@ -667,6 +786,15 @@ namespace ouzel
                 std::map<GLuint, GLuint> bufferId;
                 GLuint vertexArrayId = 0;
 
+                struct UniformBufferRange
+                {
+                    GLuint bufferId = 0;
+                    GLintptr offset = 0;
+                    GLsizeiptr size = 0;
+                };
+
+                UniformBufferRange uniformBufferRanges[2];
+
                 bool blendEnabled = false;
                 GLenum blendModeRGB = 0;
                 GLenum blendModeAlpha = 0;
@@ -239,31 +239,86 @@ namespace ouzel
                 return false;
             }
 
-            if (!pixelShaderConstantInfo.empty())
+            if (!getConstantLocations("PixelConstants",
+                                      PIXEL_SHADER_CONSTANT_BINDING,
+                                      pixelShaderConstantInfo,
+                                      pixelShaderConstantLocations,
+                                      pixelShaderConstantBlockSize))
             {
-                pixelShaderConstantLocations.clear();
-                pixelShaderConstantLocations.reserve(pixelShaderConstantInfo.size());
+                return false;
+            }
+
+            if (!getConstantLocations("VertexConstants",
+                                      VERTEX_SHADER_CONSTANT_BINDING,
+                                      vertexShaderConstantInfo,
+                                      vertexShaderConstantLocations,
+                                      vertexShaderConstantBlockSize))
+            {
+                return false;
+            }
+
+            return true;
+        }
+
+        bool ShaderResourceOGL::getConstantLocations(const GLchar* blockName,
+                                                     GLuint binding,
+                                                     const std::vector<Shader::ConstantInfo>& constantInfo,
+                                                     std::vector<Location>& constantLocations,
+                                                     GLuint& blockSize)
+        {
+            constantLocations.clear();
+            constantLocations.reserve(constantInfo.size());
+            blockSize = 0;
+
+            GLuint blockIndex = GL_INVALID_INDEX;
+
+            if (renderDeviceOGL->isUniformBuffersSupported() && !constantInfo.empty())
+            {
+                blockIndex = glGetUniformBlockIndexProc(programId, blockName);
+            }
+
+            if (blockIndex != GL_INVALID_INDEX)
+            {
+                glUniformBlockBindingProc(programId, blockIndex, binding);
+
+                GLint dataSize;
+                glGetActiveUniformBlockivProc(programId, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
 
-                for (const Shader::ConstantInfo& info : pixelShaderConstantInfo)
+                if (RenderDeviceOGL::checkOpenGLError())
                 {
-                    GLint location = glGetUniformLocationProc(programId, info.name.c_str());
+                    Log(Log::Level::ERR) << "Failed to get OpenGL uniform block size";
+                    return false;
+                }
 
-                    if (location == -1 || RenderDeviceOGL::checkOpenGLError())
+                blockSize = static_cast<GLuint>(dataSize);
+
+                for (const Shader::ConstantInfo& info : constantInfo)
+                {
+                    const GLchar* name = info.name.c_str();
+                    GLuint index;
+                    glGetUniformIndicesProc(programId, 1, &name, &index);
+
+                    if (index == GL_INVALID_INDEX || RenderDeviceOGL::checkOpenGLError())
                     {
-                        Log(Log::Level::ERR) << "Failed to get OpenGL uniform location";
+                        Log(Log::Level::ERR) << "Failed to get OpenGL uniform index";
+                        return false;
+                    }
+
+                    GLint offset;
+                    glGetActiveUniformsivProc(programId, 1, &index, GL_UNIFORM_OFFSET, &offset);
+
+                    if (RenderDeviceOGL::checkOpenGLError())
+                    {
+                        Log(Log::Level::ERR) << "Failed to get OpenGL uniform offset";
                         return false;
                     }
 
-                    pixelShaderConstantLocations.push_back({location, info.dataType});
+                    constantLocations.push_back({-1, info.dataType, offset, std::vector<float>()});
                 }
             }
-
-            if (!vertexShaderConstantInfo.empty())
+            else
             {
-                vertexShaderConstantLocations.clear();
-                vertexShaderConstantLocations.reserve(vertexShaderConstantInfo.size());
-
-                for (const Shader::ConstantInfo& info : vertexShaderConstantInfo)
+                for (const Shader::ConstantInfo& info : constantInfo)
                 {
                     GLint location = glGetUniformLocationProc(programId, info.name.c_str());
 
@@ -273,7 +328,7 @@ namespace ouzel
                         return false;
                     }
 
-                    vertexShaderConstantLocations.push_back({location, info.dataType});
+                    constantLocations.push_back({location, info.dataType, -1, std::vector<float>()});
                 }
             }
 
@@ -45,19 +45,34 @@ namespace ouzel
 
             virtual bool reload() override;
 
+            // uniform buffer binding points of the PixelConstants and VertexConstants blocks
+            static const GLuint PIXEL_SHADER_CONSTANT_BINDING = 0;
+            static const GLuint VERTEX_SHADER_CONSTANT_BINDING = 1;
+
             struct Location
             {
-                GLint location;
+                GLint location; // -1 if the constant is in a uniform block
                 DataType dataType;
+                GLint offset; // offset in the uniform block
+                std::vector<float> value; // last value set with glUniform, used to skip redundant uploads
             };
 
-            const std::vector<Location>& getPixelShaderConstantLocations() const { return pixelShaderConstantLocations; }
-            const std::vector<Location>& getVertexShaderConstantLocations() const { return vertexShaderConstantLocations; }
+            std::vector<Location>& getPixelShaderConstantLocations() { return pixelShaderConstantLocations; }
+            std::vector<Location>& getVertexShaderConstantLocations() { return vertexShaderConstantLocations; }
+
+            // 0 if the constants are not in a uniform block
+            GLuint getPixelShaderConstantBlockSize() const { return pixelShaderConstantBlockSize; }
+            GLuint getVertexShaderConstantBlockSize() const { return vertexShaderConstantBlockSize; }
 
             GLuint getProgramId() const { return programId; }
 
         protected:
             bool compileShader();
+            bool getConstantLocations(const GLchar* blockName,
+                                      GLuint binding,
+                                      const std::vector<Shader::ConstantInfo>& constantInfo,
+                                      std::vector<Location>& constantLocations,
+                                      GLuint& blockSize);
             void printShaderMessage(GLuint shaderId);
             void printProgramMessage();
 
@@ -69,6 +84,8 @@ namespace ouzel
 
             std::vector<Location> pixelShaderConstantLocations;
             std::vector<Location> vertexShaderConstantLocations;
+            GLuint pixelShaderConstantBlockSize = 0;
+            GLuint vertexShaderConstantBlockSize = 0;
         };
     } // namespace graphics
 } // namespace ouzel
@@ -629,6 +629,52 @@ namespace ouzel
             return true;
         }
 
+        bool TextureResourceOGL::setSubData(const std::vector<uint8_t>& newData, const Rectangle& region)
+        {
+            if (!TextureResource::setSubData(newData, region))
+            {
+                return false;
+            }
+
+            if (!textureId)
+            {
+                Log(Log::Level::ERR) << "Texture not initialized";
+                return false;
+            }
+
+            renderDeviceOGL->bindTexture(textureId, 0);
+
+            // upload whole rows of the first level, because GL_UNPACK_ROW_LENGTH is not available on OpenGL ES 2
+            GLint regionY = static_cast<GLint>(region.position.y);
+            GLsizei regionHeight = static_cast<GLsizei>(region.size.height);
+
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, regionY,
+                            static_cast<GLsizei>(levels[0].size.width),
+                            regionHeight,
+                            oglPixelFormat, oglPixelType,
+                            levels[0].data.data() + static_cast<uint32_t>(regionY) * levels[0].pitch);
+
+            for (size_t level = 1; level < levels.size(); ++level)
+            {
+                if (!levels[level].data.empty())
+                {
+                    glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), 0, 0,
+                                    static_cast<GLsizei>(levels[level].size.width),
+                                    static_cast<GLsizei>(levels[level].size.height),
+                                    oglPixelFormat, oglPixelType,
+                                    levels[level].data.data());
+                }
+            }
+
+            if (RenderDeviceOGL::checkOpenGLError())
+            {
+                Log(Log::Level::ERR) << "Failed to upload texture data";
+                return false;
+            }
+
+            return true;
+        }
+
         bool TextureResourceOGL::setFilter(Texture::Filter newFilter)
         {
             if (!TextureResource::setFilter(newFilter))
@@ -310,6 +310,7 @@ namespace ouzel
             frameBufferHeight = surfaceHeight;
 
             stateCache = StateCache();
+            uniformBufferId = 0;
 
             glDisable(GL_DITHER);
             glDepthFunc(GL_LEQUAL);
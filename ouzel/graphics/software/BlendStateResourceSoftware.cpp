@@ -0,0 +1,14 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "BlendStateResourceSoftware.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        BlendStateResourceSoftware::BlendStateResourceSoftware()
+        {
+        }
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,18 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "graphics/BlendStateResource.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        class BlendStateResourceSoftware: public BlendStateResource
+        {
+        public:
+            BlendStateResourceSoftware();
+        };
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,14 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "BufferResourceSoftware.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        BufferResourceSoftware::BufferResourceSoftware()
+        {
+        }
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,20 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "graphics/BufferResource.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        class BufferResourceSoftware: public BufferResource
+        {
+        public:
+            BufferResourceSoftware();
+
+            const std::vector<uint8_t>& getData() const { return data; }
+        };
+    } // namespace graphics
+} // namespace ouzel
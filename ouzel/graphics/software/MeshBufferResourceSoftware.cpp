@@ -0,0 +1,14 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "MeshBufferResourceSoftware.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        MeshBufferResourceSoftware::MeshBufferResourceSoftware()
+        {
+        }
+    } // namespace graphics
+} // namespace ouzel
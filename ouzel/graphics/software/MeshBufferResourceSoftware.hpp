@@ -0,0 +1,18 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "graphics/MeshBufferResource.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        class MeshBufferResourceSoftware: public MeshBufferResource
+        {
+        public:
+            MeshBufferResourceSoftware();
+        };
+    } // namespace graphics
+} // namespace ouzel
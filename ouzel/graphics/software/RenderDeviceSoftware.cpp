@@ -0,0 +1,1437 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "RenderDeviceSoftware.hpp"
+#include "BlendStateResourceSoftware.hpp"
+#include "TextureResourceSoftware.hpp"
+#include "ShaderResourceSoftware.hpp"
+#include "MeshBufferResourceSoftware.hpp"
+#include "BufferResourceSoftware.hpp"
+#include "core/Engine.hpp"
+#include "assets/Cache.hpp"
+#include "utils/Log.hpp"
+#include "utils/Utils.hpp"
+#include "stb_image_write.h"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        static const float SDF_EDGE_WIDTH = 0.05f; // replaces fwidth of the OpenGL shader
+
+        static void readAttribute(const uint8_t* data, DataType dataType, bool normalized, float* result, uint32_t components)
+        {
+            uint32_t count = 0;
+
+            switch (dataType)
+            {
+                case DataType::FLOAT: count = 1; break;
+                case DataType::FLOAT_VECTOR2: count = 2; break;
+                case DataType::FLOAT_VECTOR3: count = 3; break;
+                case DataType::FLOAT_VECTOR4: count = 4; break;
+                case DataType::UNSIGNED_BYTE:
+                case DataType::UNSIGNED_BYTE_VECTOR2:
+                case DataType::UNSIGNED_BYTE_VECTOR3:
+                case DataType::UNSIGNED_BYTE_VECTOR4:
+                {
+                    count = static_cast<uint32_t>(dataType) - static_cast<uint32_t>(DataType::UNSIGNED_BYTE) + 1;
+                    if (count > components) count = components;
+
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        result[i] = normalized ? data[i] / 255.0f : static_cast<float>(data[i]);
+                    }
+                    return;
+                }
+                default:
+                    return;
+            }
+
+            if (count > components) count = components;
+            memcpy(result, data, count * sizeof(float));
+        }
+
+        static inline float edgeFunction(float ax, float ay, float bx, float by, float px, float py)
+        {
+            return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        }
+
+        // D3D fill convention for clockwise triangles in the y-down screen space
+        static inline bool isTopLeftEdge(float ax, float ay, float bx, float by)
+        {
+            return (ay == by && bx > ax) || by < ay;
+        }
+
+        static inline int32_t wrapCoordinate(int32_t coordinate, int32_t size, Texture::Address address)
+        {
+            switch (address)
+            {
+                case Texture::Address::REPEAT:
+                    coordinate %= size;
+                    return (coordinate < 0) ? coordinate + size : coordinate;
+                case Texture::Address::MIRROR_REPEAT:
+                {
+                    int32_t period = size * 2;
+                    coordinate %= period;
+                    if (coordinate < 0) coordinate += period;
+                    return (coordinate >= size) ? period - 1 - coordinate : coordinate;
+                }
+                case Texture::Address::CLAMP:
+                default:
+                    return (coordinate < 0) ? 0 : ((coordinate >= size) ? size - 1 : coordinate);
+            }
+        }
+
+        static inline void fetchTexel(const Texture::Level& level, PixelFormat pixelFormat, int32_t x, int32_t y, float* result)
+        {
+            const uint8_t* texel = level.data.data() + y * level.pitch;
+
+            switch (pixelFormat)
+            {
+                case PixelFormat::RGBA8_UNORM:
+                    texel += x * 4;
+                    result[0] = texel[0] / 255.0f;
+                    result[1] = texel[1] / 255.0f;
+                    result[2] = texel[2] / 255.0f;
+                    result[3] = texel[3] / 255.0f;
+                    break;
+                case PixelFormat::A8_UNORM:
+                    result[0] = result[1] = result[2] = 0.0f;
+                    result[3] = texel[x] / 255.0f;
+                    break;
+                case PixelFormat::R8_UNORM:
+                    result[0] = texel[x] / 255.0f;
+                    result[1] = result[2] = 0.0f;
+                    result[3] = 1.0f;
+                    break;
+                default:
+                    result[0] = result[1] = result[2] = result[3] = 1.0f;
+                    break;
+            }
+        }
+
+        // other filters than point are bilinear inside of the given level
+        static void sampleTexture(const TextureResourceSoftware* texture, uint32_t textureLevel, Texture::Filter defaultFilter, float u, float v, float* result)
+        {
+            const std::vector<Texture::Level>& levels = texture->getLevels();
+
+            if (textureLevel >= levels.size() || levels[textureLevel].data.empty())
+            {
+                result[0] = result[1] = result[2] = result[3] = 1.0f;
+                return;
+            }
+
+            const Texture::Level& level = levels[textureLevel];
+            int32_t width = static_cast<int32_t>(level.size.width);
+            int32_t height = static_cast<int32_t>(level.size.height);
+            Texture::Filter filter = (texture->getFilter() == Texture::Filter::DEFAULT) ? defaultFilter : texture->getFilter();
+
+            if (filter == Texture::Filter::POINT)
+            {
+                int32_t x = wrapCoordinate(static_cast<int32_t>(floorf(u * width)), width, texture->getAddressX());
+                int32_t y = wrapCoordinate(static_cast<int32_t>(floorf(v * height)), height, texture->getAddressY());
+                fetchTexel(level, texture->getPixelFormat(), x, y, result);
+            }
+            else
+            {
+                float x = u * width - 0.5f;
+                float y = v * height - 0.5f;
+                float x0 = floorf(x);
+                float y0 = floorf(y);
+                float fx = x - x0;
+                float fy = y - y0;
+
+                int32_t left = wrapCoordinate(static_cast<int32_t>(x0), width, texture->getAddressX());
+                int32_t right = wrapCoordinate(static_cast<int32_t>(x0) + 1, width, texture->getAddressX());
+                int32_t top = wrapCoordinate(static_cast<int32_t>(y0), height, texture->getAddressY());
+                int32_t bottom = wrapCoordinate(static_cast<int32_t>(y0) + 1, height, texture->getAddressY());
+
+                float texels[4][4];
+                fetchTexel(level, texture->getPixelFormat(), left, top, texels[0]);
+                fetchTexel(level, texture->getPixelFormat(), right, top, texels[1]);
+                fetchTexel(level, texture->getPixelFormat(), left, bottom, texels[2]);
+                fetchTexel(level, texture->getPixelFormat(), right, bottom, texels[3]);
+
+                for (uint32_t i = 0; i < 4; ++i)
+                {
+                    float topValue = texels[0][i] + (texels[1][i] - texels[0][i]) * fx;
+                    float bottomValue = texels[2][i] + (texels[3][i] - texels[2][i]) * fx;
+                    result[i] = topValue + (bottomValue - topValue) * fy;
+                }
+            }
+        }
+
+        static inline float getBlendFactor(BlendState::BlendFactor factor, const float* src, const float* dst, uint32_t channel)
+        {
+            switch (factor)
+            {
+                case BlendState::BlendFactor::ZERO: return 0.0f;
+                case BlendState::BlendFactor::ONE: return 1.0f;
+                case BlendState::BlendFactor::SRC_COLOR: return src[channel];
+                case BlendState::BlendFactor::INV_SRC_COLOR: return 1.0f - src[channel];
+                case BlendState::BlendFactor::SRC_ALPHA: return src[3];
+                case BlendState::BlendFactor::INV_SRC_ALPHA: return 1.0f - src[3];
+                case BlendState::BlendFactor::DEST_ALPHA: return dst[3];
+                case BlendState::BlendFactor::INV_DEST_ALPHA: return 1.0f - dst[3];
+                case BlendState::BlendFactor::DEST_COLOR: return dst[channel];
+                case BlendState::BlendFactor::INV_DEST_COLOR: return 1.0f - dst[channel];
+                case BlendState::BlendFactor::SRC_ALPHA_SAT: return (channel == 3) ? 1.0f : std::min(src[3], 1.0f - dst[3]);
+                // the engine never sets a blend factor, so the default of white is used
+                case BlendState::BlendFactor::BLEND_FACTOR: return 1.0f;
+                case BlendState::BlendFactor::INV_BLEND_FACTOR: return 0.0f;
+                default: return 0.0f;
+            }
+        }
+
+        static inline float blend(BlendState::BlendOperation operation, float src, float srcFactor, float dst, float dstFactor)
+        {
+            switch (operation)
+            {
+                case BlendState::BlendOperation::ADD: return src * srcFactor + dst * dstFactor;
+                case BlendState::BlendOperation::SUBTRACT: return src * srcFactor - dst * dstFactor;
+                case BlendState::BlendOperation::REV_SUBTRACT: return dst * dstFactor - src * srcFactor;
+                case BlendState::BlendOperation::MIN: return std::min(src, dst);
+                case BlendState::BlendOperation::MAX: return std::max(src, dst);
+                default: return src;
+            }
+        }
+
+        static inline uint8_t toByte(float value)
+        {
+            if (value <= 0.0f) return 0;
+            if (value >= 1.0f) return 255;
+            return static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
+
+        RenderDeviceSoftware::RenderDeviceSoftware():
+            RenderDevice(Renderer::Driver::SOFTWARE),
+            nextJobItem(0)
+#if OUZEL_MULTITHREADED
+            , running(false)
+#endif
+        {
+        }
+
+        RenderDeviceSoftware::~RenderDeviceSoftware()
+        {
+#if OUZEL_MULTITHREADED
+            running = false;
+            flushCommands();
+            if (renderThread.joinable()) renderThread.join();
+
+            {
+                std::lock_guard<std::mutex> lock(jobMutex);
+                workersRunning = false;
+            }
+
+            jobCondition.notify_all();
+
+            for (std::thread& worker : workers)
+            {
+                if (worker.joinable()) worker.join();
+            }
+#endif
+        }
+
+        bool RenderDeviceSoftware::init(Window* newWindow,
+                                        const Size2& newSize,
+                                        uint32_t,
+                                        Texture::Filter newTextureFilter,
+                                        uint32_t newMaxAnisotropy,
+                                        bool newVerticalSync,
+                                        bool newDepth,
+                                        bool newDebugRenderer)
+        {
+            if (!RenderDevice::init(newWindow,
+                                    newSize,
+                                    1,
+                                    newTextureFilter,
+                                    newMaxAnisotropy,
+                                    newVerticalSync,
+                                    newDepth,
+                                    newDebugRenderer))
+            {
+                return false;
+            }
+
+            multisamplingSupported = false;
+            anisotropicFilteringSupported = false;
+
+            resizeBackBuffer();
+
+            std::shared_ptr<Shader> textureShader = std::make_shared<Shader>();
+
+            textureShader->init(std::vector<uint8_t>(),
+                                std::vector<uint8_t>(),
+                                VertexPCT::ATTRIBUTES,
+                                {{"color", DataType::FLOAT_VECTOR4}},
+                                {{"modelViewProj", DataType::FLOAT_MATRIX4}},
+                                0, 0,
+                                ShaderResourceSoftware::TEXTURE_FUNCTION);
+
+            sharedEngine->getCache()->setShader(SHADER_TEXTURE, textureShader);
+
+            std::shared_ptr<Shader> textureSDFShader = std::make_shared<Shader>();
+
+            textureSDFShader->init(std::vector<uint8_t>(),
+                                   std::vector<uint8_t>(),
+                                   VertexPCT::ATTRIBUTES,
+                                   {{"color", DataType::FLOAT_VECTOR4}},
+                                   {{"modelViewProj", DataType::FLOAT_MATRIX4}},
+                                   0, 0,
+                                   ShaderResourceSoftware::TEXTURE_SDF_FUNCTION);
+
+            sharedEngine->getCache()->setShader(SHADER_TEXTURE_SDF, textureSDFShader);
+
+            std::shared_ptr<Shader> colorShader = std::make_shared<Shader>();
+
+            colorShader->init(std::vector<uint8_t>(),
+                              std::vector<uint8_t>(),
+                              VertexPC::ATTRIBUTES,
+                              {{"color", DataType::FLOAT_VECTOR4}},
+                              {{"modelViewProj", DataType::FLOAT_MATRIX4}},
+                              0, 0,
+                              ShaderResourceSoftware::COLOR_FUNCTION);
+
+            sharedEngine->getCache()->setShader(SHADER_COLOR, colorShader);
+
+#if OUZEL_MULTITHREADED
+            uint32_t threadCount = std::thread::hardware_concurrency();
+            if (threadCount > MAX_WORKERS) threadCount = MAX_WORKERS;
+
+            workersRunning = true;
+
+            // the render thread does its share of the work
+            for (uint32_t i = 1; i < threadCount; ++i)
+            {
+                workers.push_back(std::thread(&RenderDeviceSoftware::workerMain, this, i));
+            }
+
+            Log(Log::Level::INFO) << "Software renderer using " << getWorkerCount() << " thread(s)";
+
+            running = true;
+            renderThread = std::thread(&RenderDeviceSoftware::main, this);
+#endif
+
+            return true;
+        }
+
+        void RenderDeviceSoftware::setSize(const Size2& newSize)
+        {
+            RenderDevice::setSize(newSize);
+
+            resizeBackBuffer();
+        }
+
+        void RenderDeviceSoftware::resizeBackBuffer()
+        {
+            frameBufferWidth = static_cast<uint32_t>(size.width);
+            frameBufferHeight = static_cast<uint32_t>(size.height);
+
+            size_t pixelCount = static_cast<size_t>(frameBufferWidth) * frameBufferHeight;
+            colorBuffer.assign(pixelCount * 4, 0);
+            if (depth) depthBuffer.assign(pixelCount, 1.0f);
+        }
+
+        bool RenderDeviceSoftware::getTarget(TextureResource* renderTarget, Target& result)
+        {
+            if (renderTarget)
+            {
+                TextureResourceSoftware* renderTargetSoftware = static_cast<TextureResourceSoftware*>(renderTarget);
+                Texture::Level* level = renderTargetSoftware->getRenderTargetLevel();
+
+                if (!level || level->data.empty()) return false;
+
+                result.width = static_cast<uint32_t>(level->size.width);
+                result.height = static_cast<uint32_t>(level->size.height);
+                result.pitch = level->pitch;
+                result.color = level->data.data();
+                result.depth = renderTargetSoftware->getDepthBuffer();
+            }
+            else
+            {
+                if (colorBuffer.empty()) return false;
+
+                result.width = frameBufferWidth;
+                result.height = frameBufferHeight;
+                result.pitch = frameBufferWidth * 4;
+                result.color = colorBuffer.data();
+                result.depth = depthBuffer.empty() ? nullptr : depthBuffer.data();
+            }
+
+            return true;
+        }
+
+        void RenderDeviceSoftware::clearTarget(TextureResource* renderTarget)
+        {
+            bool clearColorTarget;
+            bool clearDepthTarget;
+            Color color;
+            float depthValue;
+
+            if (renderTarget)
+            {
+                clearColorTarget = renderTarget->getClearColorBuffer();
+                clearDepthTarget = renderTarget->getClearDepthBuffer();
+                color = renderTarget->getClearColor();
+                depthValue = renderTarget->getClearDepth();
+            }
+            else
+            {
+                clearColorTarget = clearColorBuffer;
+                clearDepthTarget = clearDepthBuffer;
+                color = clearColor;
+                depthValue = clearDepth;
+            }
+
+            if (clearColorTarget)
+            {
+                const uint8_t pixel[4] = {color.r, color.g, color.b, color.a};
+
+                for (uint32_t y = 0; y < target.height; ++y)
+                {
+                    uint8_t* row = target.color + y * target.pitch;
+
+                    for (uint32_t x = 0; x < target.width; ++x)
+                    {
+                        memcpy(row + x * 4, pixel, 4);
+                    }
+                }
+            }
+
+            if (clearDepthTarget && target.depth)
+            {
+                std::fill(target.depth, target.depth + target.width * target.height, depthValue);
+            }
+        }
+
+        bool RenderDeviceSoftware::draw(const std::vector<DrawCommand>& drawCommands)
+        {
+            std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+            primitiveCount = 0;
+            drawCallCount = static_cast<uint32_t>(drawCommands.size());
+
+            // commands are drawn in passes that share the render target
+            TextureResource* currentRenderTarget = nullptr;
+            bool targetValid = false;
+            bool passStarted = false;
+            bool backBufferDrawn = false;
+
+            for (const DrawCommand& drawCommand : drawCommands)
+            {
+                if (!passStarted || drawCommand.renderTarget != currentRenderTarget)
+                {
+                    flushPrimitives();
+
+                    currentRenderTarget = drawCommand.renderTarget;
+                    passStarted = true;
+                    targetValid = getTarget(currentRenderTarget, target);
+
+                    if (!currentRenderTarget) backBufferDrawn = true;
+                    if (targetValid && drawCommand.clearRenderTarget) clearTarget(currentRenderTarget);
+                }
+
+                if (targetValid && !addPrimitives(drawCommand))
+                {
+                    return false;
+                }
+            }
+
+            flushPrimitives();
+
+            // the back buffer is cleared even if nothing was drawn to it
+            if (!backBufferDrawn && getTarget(nullptr, target))
+            {
+                clearTarget(nullptr);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(frontBufferMutex);
+                frontBuffer = colorBuffer;
+                frontBufferWidth = frameBufferWidth;
+                frontBufferHeight = frameBufferHeight;
+            }
+
+            auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+            float frameTime = diff.count() / 1000000000.0f;
+
+            std::lock_guard<std::mutex> lock(statisticsMutex);
+
+            ++statistics.frameCount;
+            statistics.primitiveCount = primitiveCount;
+            statistics.frameTime = frameTime;
+            totalFrameTime += frameTime;
+            statistics.averageFrameTime = totalFrameTime / statistics.frameCount;
+
+            if (statistics.frameCount == 1)
+            {
+                statistics.minFrameTime = statistics.maxFrameTime = frameTime;
+            }
+            else
+            {
+                statistics.minFrameTime = std::min(statistics.minFrameTime, frameTime);
+                statistics.maxFrameTime = std::max(statistics.maxFrameTime, frameTime);
+            }
+
+            return true;
+        }
+
+        bool RenderDeviceSoftware::addPrimitives(const DrawCommand& drawCommand)
+        {
+            ShaderResourceSoftware* shaderSoftware = static_cast<ShaderResourceSoftware*>(drawCommand.shader);
+            MeshBufferResourceSoftware* meshBufferSoftware = static_cast<MeshBufferResourceSoftware*>(drawCommand.meshBuffer);
+
+            if (!shaderSoftware || !meshBufferSoftware)
+            {
+                // don't draw if mesh buffer or shader is null
+                return true;
+            }
+
+            BufferResourceSoftware* indexBufferSoftware = static_cast<BufferResourceSoftware*>(meshBufferSoftware->getIndexBuffer());
+            BufferResourceSoftware* vertexBufferSoftware = static_cast<BufferResourceSoftware*>(meshBufferSoftware->getVertexBuffer());
+
+            if (!indexBufferSoftware || !vertexBufferSoftware)
+            {
+                return true;
+            }
+
+            const std::vector<uint8_t>& indexData = indexBufferSoftware->getData();
+            const std::vector<uint8_t>& vertexData = vertexBufferSoftware->getData();
+            uint32_t indexSize = meshBufferSoftware->getIndexSize();
+            uint32_t vertexSize = meshBufferSoftware->getVertexSize();
+
+            if ((indexSize != 2 && indexSize != 4) || vertexSize == 0)
+            {
+                Log(Log::Level::ERR) << "Invalid mesh buffer layout";
+                return false;
+            }
+
+            DrawState drawState;
+            drawState.program = shaderSoftware->getProgram();
+            drawState.texture = drawCommand.textures.empty() ? nullptr : static_cast<TextureResourceSoftware*>(drawCommand.textures[0]);
+            drawState.blendState = drawCommand.blendState;
+            drawState.depthTest = drawCommand.depthTest && target.depth;
+            drawState.depthWrite = drawCommand.depthWrite;
+
+            if (!drawCommand.pixelShaderConstants.empty() && drawCommand.pixelShaderConstants[0].size() >= 4)
+            {
+                memcpy(drawState.color, drawCommand.pixelShaderConstants[0].data(), sizeof(drawState.color));
+            }
+            else
+            {
+                drawState.color[0] = drawState.color[1] = drawState.color[2] = drawState.color[3] = 1.0f;
+            }
+
+            const Rectangle& viewport = drawCommand.viewport;
+
+            drawState.minX = std::max(0, static_cast<int32_t>(floorf(viewport.position.x)));
+            drawState.minY = std::max(0, static_cast<int32_t>(floorf(viewport.position.y)));
+            drawState.maxX = std::min(static_cast<int32_t>(target.width), static_cast<int32_t>(ceilf(viewport.position.x + viewport.size.width)));
+            drawState.maxY = std::min(static_cast<int32_t>(target.height), static_cast<int32_t>(ceilf(viewport.position.y + viewport.size.height)));
+
+            if (drawCommand.scissorTest)
+            {
+                const Rectangle& scissor = drawCommand.scissorRectangle;
+
+                drawState.minX = std::max(drawState.minX, static_cast<int32_t>(scissor.position.x));
+                drawState.minY = std::max(drawState.minY, static_cast<int32_t>(scissor.position.y));
+                drawState.maxX = std::min(drawState.maxX, static_cast<int32_t>(scissor.position.x + scissor.size.width));
+                drawState.maxY = std::min(drawState.maxY, static_cast<int32_t>(scissor.position.y + scissor.size.height));
+            }
+
+            if (drawState.minX >= drawState.maxX || drawState.minY >= drawState.maxY)
+            {
+                return true;
+            }
+
+            const float* modelViewProj = Matrix4::IDENTITY.m;
+
+            if (!drawCommand.vertexShaderConstants.empty() && drawCommand.vertexShaderConstants[0].size() >= 16)
+            {
+                modelViewProj = drawCommand.vertexShaderConstants[0].data();
+            }
+
+            const VertexAttribute* positionAttribute = nullptr;
+            const VertexAttribute* colorAttribute = nullptr;
+            const VertexAttribute* texCoordAttribute = nullptr;
+            uint32_t positionOffset = 0;
+            uint32_t colorOffset = 0;
+            uint32_t texCoordOffset = 0;
+            uint32_t offset = 0;
+
+            for (const VertexAttribute& vertexAttribute : meshBufferSoftware->getVertexAttributes())
+            {
+                if (vertexAttribute.usage == VertexAttribute::Usage::POSITION && vertexAttribute.index == 0)
+                {
+                    positionAttribute = &vertexAttribute;
+                    positionOffset = offset;
+                }
+                else if (vertexAttribute.usage == VertexAttribute::Usage::COLOR && vertexAttribute.index == 0)
+                {
+                    colorAttribute = &vertexAttribute;
+                    colorOffset = offset;
+                }
+                else if (vertexAttribute.usage == VertexAttribute::Usage::TEXTURE_COORDINATES && vertexAttribute.index == 0)
+                {
+                    texCoordAttribute = &vertexAttribute;
+                    texCoordOffset = offset;
+                }
+
+                offset += getDataTypeSize(vertexAttribute.dataType);
+            }
+
+            if (!positionAttribute)
+            {
+                Log(Log::Level::ERR) << "Mesh buffer has no position attribute";
+                return false;
+            }
+
+            uint32_t drawStateIndex = static_cast<uint32_t>(drawStates.size());
+            drawStates.push_back(drawState);
+
+            // every vertex is transformed once per draw command
+            size_t vertexCount = vertexData.size() / vertexSize;
+            if (vertexCache.size() < vertexCount)
+            {
+                vertexCache.resize(vertexCount);
+                vertexCacheStamps.resize(vertexCount, 0);
+            }
+
+            if (++vertexCacheStamp == 0)
+            {
+                std::fill(vertexCacheStamps.begin(), vertexCacheStamps.end(), 0);
+                vertexCacheStamp = 1;
+            }
+
+            auto getVertex = [&](uint32_t index) -> const ClipVertex* {
+                if (index >= vertexCount) return nullptr;
+
+                ClipVertex& vertex = vertexCache[index];
+
+                if (vertexCacheStamps[index] != vertexCacheStamp)
+                {
+                    vertexCacheStamps[index] = vertexCacheStamp;
+
+                    const uint8_t* vertexPointer = vertexData.data() + index * vertexSize;
+
+                    float position[3] = {0.0f, 0.0f, 0.0f};
+                    readAttribute(vertexPointer + positionOffset, positionAttribute->dataType, positionAttribute->normalized, position, 3);
+
+                    for (uint32_t i = 0; i < 4; ++i)
+                    {
+                        vertex.position[i] = modelViewProj[i] * position[0] +
+                            modelViewProj[4 + i] * position[1] +
+                            modelViewProj[8 + i] * position[2] +
+                            modelViewProj[12 + i];
+                    }
+
+                    vertex.color[0] = vertex.color[1] = vertex.color[2] = vertex.color[3] = 1.0f;
+                    if (colorAttribute) readAttribute(vertexPointer + colorOffset, colorAttribute->dataType, colorAttribute->normalized, vertex.color, 4);
+
+                    vertex.texCoord[0] = vertex.texCoord[1] = 0.0f;
+                    if (texCoordAttribute) readAttribute(vertexPointer + texCoordOffset, texCoordAttribute->dataType, texCoordAttribute->normalized, vertex.texCoord, 2);
+                }
+
+                return &vertex;
+            };
+
+            uint32_t totalIndexCount = static_cast<uint32_t>(indexData.size() / indexSize);
+            uint32_t startIndex = std::min(drawCommand.startIndex, totalIndexCount);
+            uint32_t indexCount = drawCommand.indexCount ? drawCommand.indexCount : totalIndexCount - startIndex;
+            indexCount = std::min(indexCount, totalIndexCount - startIndex);
+
+            auto getIndex = [&](uint32_t i) -> uint32_t {
+                const uint8_t* indexPointer = indexData.data() + (startIndex + i) * indexSize;
+
+                if (indexSize == 2)
+                {
+                    uint16_t index;
+                    memcpy(&index, indexPointer, sizeof(index));
+                    return index;
+                }
+                else
+                {
+                    uint32_t index;
+                    memcpy(&index, indexPointer, sizeof(index));
+                    return index;
+                }
+            };
+
+            switch (drawCommand.drawMode)
+            {
+                case Renderer::DrawMode::POINT_LIST:
+                    for (uint32_t i = 0; i < indexCount; ++i)
+                    {
+                        const ClipVertex* vertex = getVertex(getIndex(i));
+                        if (vertex) addPoint(*vertex, drawStateIndex, viewport);
+                    }
+                    break;
+                case Renderer::DrawMode::LINE_LIST:
+                case Renderer::DrawMode::LINE_STRIP:
+                {
+                    bool strip = drawCommand.drawMode == Renderer::DrawMode::LINE_STRIP;
+                    uint32_t step = strip ? 1 : 2;
+
+                    for (uint32_t i = 0; i + 1 < indexCount; i += step)
+                    {
+                        const ClipVertex* vertex1 = getVertex(getIndex(i));
+                        const ClipVertex* vertex2 = getVertex(getIndex(i + 1));
+                        if (vertex1 && vertex2) addLine(*vertex1, *vertex2, drawStateIndex, viewport);
+                    }
+                    break;
+                }
+                case Renderer::DrawMode::TRIANGLE_LIST:
+                case Renderer::DrawMode::TRIANGLE_STRIP:
+                {
+                    bool strip = drawCommand.drawMode == Renderer::DrawMode::TRIANGLE_STRIP;
+                    uint32_t step = strip ? 1 : 3;
+
+                    for (uint32_t i = 0; i + 2 < indexCount; i += step)
+                    {
+                        // every other triangle of a strip has the opposite winding
+                        bool swap = strip && (i & 1);
+                        const ClipVertex* vertex1 = getVertex(getIndex(swap ? i + 1 : i));
+                        const ClipVertex* vertex2 = getVertex(getIndex(swap ? i : i + 1));
+                        const ClipVertex* vertex3 = getVertex(getIndex(i + 2));
+
+                        if (vertex1 && vertex2 && vertex3)
+                        {
+                            addTriangle(*vertex1, *vertex2, *vertex3, drawStateIndex, viewport,
+                                        drawCommand.cullMode, drawCommand.wireframe);
+                        }
+                    }
+                    break;
+                }
+                default:
+                    Log(Log::Level::ERR) << "Invalid draw mode";
+                    return false;
+            }
+
+            return true;
+        }
+
+        RenderDeviceSoftware::ClipVertex RenderDeviceSoftware::interpolateVertex(const ClipVertex& vertex1,
+                                                                                 const ClipVertex& vertex2,
+                                                                                 float t)
+        {
+            ClipVertex result;
+
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                result.position[i] = vertex1.position[i] + (vertex2.position[i] - vertex1.position[i]) * t;
+                result.color[i] = vertex1.color[i] + (vertex2.color[i] - vertex1.color[i]) * t;
+            }
+
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                result.texCoord[i] = vertex1.texCoord[i] + (vertex2.texCoord[i] - vertex1.texCoord[i]) * t;
+            }
+
+            return result;
+        }
+
+        // distance to the clip planes w > 0, z >= 0 (near) and z <= w (far)
+        static const uint32_t CLIP_PLANE_COUNT = 3;
+        static const float MIN_W = 0.00001f;
+
+        float RenderDeviceSoftware::getClipDistance(const ClipVertex& vertex, uint32_t plane)
+        {
+            switch (plane)
+            {
+                case 0: return vertex.position[3] - MIN_W;
+                case 1: return vertex.position[2];
+                default: return vertex.position[3] - vertex.position[2];
+            }
+        }
+
+        RenderDeviceSoftware::ScreenVertex RenderDeviceSoftware::toScreen(const ClipVertex& vertex, const Rectangle& viewport)
+        {
+            ScreenVertex result;
+
+            result.invW = 1.0f / vertex.position[3];
+            result.x = viewport.position.x + (vertex.position[0] * result.invW * 0.5f + 0.5f) * viewport.size.width;
+            result.y = viewport.position.y + (0.5f - vertex.position[1] * result.invW * 0.5f) * viewport.size.height;
+            result.z = vertex.position[2] * result.invW;
+
+            for (uint32_t i = 0; i < 4; ++i) result.color[i] = vertex.color[i] * result.invW;
+            for (uint32_t i = 0; i < 2; ++i) result.texCoord[i] = vertex.texCoord[i] * result.invW;
+
+            return result;
+        }
+
+        // selects the nearest mip level from the ratio of the texel and pixel areas of the whole triangle,
+        // there are no per-pixel derivatives, so the level does not change across a triangle
+        uint32_t RenderDeviceSoftware::selectTextureLevel(const TextureResourceSoftware* texture, const ScreenVertex* vertices)
+        {
+            const std::vector<Texture::Level>& levels = texture->getLevels();
+            if (levels.size() <= 1) return 0;
+
+            float u[3];
+            float v[3];
+
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                u[i] = vertices[i].texCoord[0] / vertices[i].invW * levels[0].size.width;
+                v[i] = vertices[i].texCoord[1] / vertices[i].invW * levels[0].size.height;
+            }
+
+            float texelArea = fabsf((u[1] - u[0]) * (v[2] - v[0]) - (u[2] - u[0]) * (v[1] - v[0]));
+            float pixelArea = fabsf((vertices[1].x - vertices[0].x) * (vertices[2].y - vertices[0].y) -
+                                    (vertices[2].x - vertices[0].x) * (vertices[1].y - vertices[0].y));
+
+            if (pixelArea <= 0.0f || texelArea <= pixelArea) return 0;
+
+            float lod = 0.5f * log2f(texelArea / pixelArea);
+            uint32_t level = static_cast<uint32_t>(lod + 0.5f);
+
+            return std::min(level, static_cast<uint32_t>(levels.size() - 1));
+        }
+
+        void RenderDeviceSoftware::addPoint(const ClipVertex& vertex, uint32_t drawState, const Rectangle& viewport)
+        {
+            for (uint32_t plane = 0; plane < CLIP_PLANE_COUNT; ++plane)
+            {
+                if (getClipDistance(vertex, plane) < 0.0f) return;
+            }
+
+            Primitive primitive;
+            primitive.vertexCount = 1;
+            primitive.drawState = drawState;
+            primitive.vertices[0] = toScreen(vertex, viewport);
+
+            const DrawState& state = drawStates[drawState];
+            primitive.minX = static_cast<int32_t>(floorf(primitive.vertices[0].x));
+            primitive.minY = static_cast<int32_t>(floorf(primitive.vertices[0].y));
+            primitive.maxX = primitive.minX + 1;
+            primitive.maxY = primitive.minY + 1;
+
+            if (primitive.minX < state.minX || primitive.maxX > state.maxX ||
+                primitive.minY < state.minY || primitive.maxY > state.maxY)
+            {
+                return;
+            }
+
+            primitives.push_back(primitive);
+        }
+
+        void RenderDeviceSoftware::addLine(const ClipVertex& vertex1, const ClipVertex& vertex2, uint32_t drawState, const Rectangle& viewport)
+        {
+            float t1 = 0.0f;
+            float t2 = 1.0f;
+
+            for (uint32_t plane = 0; plane < CLIP_PLANE_COUNT; ++plane)
+            {
+                float distance1 = getClipDistance(vertex1, plane);
+                float distance2 = getClipDistance(vertex2, plane);
+
+                if (distance1 < 0.0f && distance2 < 0.0f) return;
+
+                if (distance1 < 0.0f) t1 = std::max(t1, distance1 / (distance1 - distance2));
+                else if (distance2 < 0.0f) t2 = std::min(t2, distance1 / (distance1 - distance2));
+            }
+
+            if (t1 > t2) return;
+
+            Primitive primitive;
+            primitive.vertexCount = 2;
+            primitive.drawState = drawState;
+            primitive.vertices[0] = toScreen((t1 > 0.0f) ? interpolateVertex(vertex1, vertex2, t1) : vertex1, viewport);
+            primitive.vertices[1] = toScreen((t2 < 1.0f) ? interpolateVertex(vertex1, vertex2, t2) : vertex2, viewport);
+
+            const DrawState& state = drawStates[drawState];
+            primitive.minX = std::max(state.minX, static_cast<int32_t>(floorf(std::min(primitive.vertices[0].x, primitive.vertices[1].x))));
+            primitive.minY = std::max(state.minY, static_cast<int32_t>(floorf(std::min(primitive.vertices[0].y, primitive.vertices[1].y))));
+            primitive.maxX = std::min(state.maxX, static_cast<int32_t>(floorf(std::max(primitive.vertices[0].x, primitive.vertices[1].x))) + 1);
+            primitive.maxY = std::min(state.maxY, static_cast<int32_t>(floorf(std::max(primitive.vertices[0].y, primitive.vertices[1].y))) + 1);
+
+            if (primitive.minX >= primitive.maxX || primitive.minY >= primitive.maxY) return;
+
+            primitives.push_back(primitive);
+        }
+
+        void RenderDeviceSoftware::addTriangle(const ClipVertex& vertex1, const ClipVertex& vertex2, const ClipVertex& vertex3,
+                                               uint32_t drawState, const Rectangle& viewport, Renderer::CullMode cullMode, bool wireframe)
+        {
+            // each clip plane can add one vertex to the polygon
+            ClipVertex polygons[2][3 + CLIP_PLANE_COUNT];
+            uint32_t vertexCount = 3;
+            polygons[0][0] = vertex1;
+            polygons[0][1] = vertex2;
+            polygons[0][2] = vertex3;
+
+            uint32_t current = 0;
+
+            for (uint32_t plane = 0; plane < CLIP_PLANE_COUNT; ++plane)
+            {
+                const ClipVertex* input = polygons[current];
+                ClipVertex* output = polygons[current ^ 1];
+                uint32_t outputCount = 0;
+
+                for (uint32_t i = 0; i < vertexCount; ++i)
+                {
+                    const ClipVertex& currentVertex = input[i];
+                    const ClipVertex& nextVertex = input[(i + 1) % vertexCount];
+                    float currentDistance = getClipDistance(currentVertex, plane);
+                    float nextDistance = getClipDistance(nextVertex, plane);
+
+                    if (currentDistance >= 0.0f) output[outputCount++] = currentVertex;
+
+                    if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+                    {
+                        output[outputCount++] = interpolateVertex(currentVertex, nextVertex,
+                                                                  currentDistance / (currentDistance - nextDistance));
+                    }
+                }
+
+                vertexCount = outputCount;
+                current ^= 1;
+
+                if (vertexCount < 3) return;
+            }
+
+            ScreenVertex screenVertices[3 + CLIP_PLANE_COUNT];
+            float area = 0.0f;
+
+            for (uint32_t i = 0; i < vertexCount; ++i)
+            {
+                screenVertices[i] = toScreen(polygons[current][i], viewport);
+            }
+
+            for (uint32_t i = 0; i < vertexCount; ++i)
+            {
+                const ScreenVertex& a = screenVertices[i];
+                const ScreenVertex& b = screenVertices[(i + 1) % vertexCount];
+                area += a.x * b.y - b.x * a.y;
+            }
+
+            if (area == 0.0f) return;
+
+            // front faces are clockwise on the screen, which is a positive area with y pointing down
+            bool frontFace = area > 0.0f;
+            if ((cullMode == Renderer::CullMode::BACK && !frontFace) ||
+                (cullMode == Renderer::CullMode::FRONT && frontFace))
+            {
+                return;
+            }
+
+            if (wireframe)
+            {
+                addLine(vertex1, vertex2, drawState, viewport);
+                addLine(vertex2, vertex3, drawState, viewport);
+                addLine(vertex3, vertex1, drawState, viewport);
+                return;
+            }
+
+            const DrawState& state = drawStates[drawState];
+
+            for (uint32_t i = 1; i + 1 < vertexCount; ++i)
+            {
+                Primitive primitive;
+                primitive.vertexCount = 3;
+                primitive.drawState = drawState;
+                primitive.vertices[0] = screenVertices[0];
+
+                // the rasterizer expects clockwise triangles
+                primitive.vertices[1] = frontFace ? screenVertices[i] : screenVertices[i + 1];
+                primitive.vertices[2] = frontFace ? screenVertices[i + 1] : screenVertices[i];
+
+                if (state.texture) primitive.textureLevel = selectTextureLevel(state.texture, primitive.vertices);
+
+                float minX = std::min(primitive.vertices[0].x, std::min(primitive.vertices[1].x, primitive.vertices[2].x));
+                float minY = std::min(primitive.vertices[0].y, std::min(primitive.vertices[1].y, primitive.vertices[2].y));
+                float maxX = std::max(primitive.vertices[0].x, std::max(primitive.vertices[1].x, primitive.vertices[2].x));
+                float maxY = std::max(primitive.vertices[0].y, std::max(primitive.vertices[1].y, primitive.vertices[2].y));
+
+                primitive.minX = std::max(state.minX, static_cast<int32_t>(floorf(minX)));
+                primitive.minY = std::max(state.minY, static_cast<int32_t>(floorf(minY)));
+                primitive.maxX = std::min(state.maxX, static_cast<int32_t>(ceilf(maxX)));
+                primitive.maxY = std::min(state.maxY, static_cast<int32_t>(ceilf(maxY)));
+
+                if (primitive.minX >= primitive.maxX || primitive.minY >= primitive.maxY) continue;
+
+                primitives.push_back(primitive);
+            }
+        }
+
+        void RenderDeviceSoftware::flushPrimitives()
+        {
+            if (primitives.empty())
+            {
+                drawStates.clear();
+                return;
+            }
+
+            tilesX = (target.width + TILE_SIZE - 1) / TILE_SIZE;
+            tilesY = (target.height + TILE_SIZE - 1) / TILE_SIZE;
+            uint32_t tileCount = tilesX * tilesY;
+
+            bool parallel = !workers.empty();
+            binSetCount = (parallel && primitives.size() >= PARALLEL_BINNING_THRESHOLD) ? getWorkerCount() : 1;
+
+            if (bins.size() < binSetCount) bins.resize(binSetCount);
+
+            for (uint32_t binSet = 0; binSet < binSetCount; ++binSet)
+            {
+                if (bins[binSet].size() < tileCount) bins[binSet].resize(tileCount);
+
+                for (uint32_t tile = 0; tile < tileCount; ++tile)
+                {
+                    bins[binSet][tile].clear();
+                }
+            }
+
+            runJob(Job::BIN, binSetCount > 1);
+            runJob(Job::RASTERIZE, parallel && tileCount > 1);
+
+            primitiveCount += static_cast<uint32_t>(primitives.size());
+            primitives.clear();
+            drawStates.clear();
+        }
+
+        void RenderDeviceSoftware::runJob(Job job, bool parallel)
+        {
+            nextJobItem = 0;
+
+#if OUZEL_MULTITHREADED
+            if (parallel && !workers.empty())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(jobMutex);
+                    currentJob = job;
+                    ++jobGeneration;
+                    pendingWorkers = static_cast<uint32_t>(workers.size());
+                }
+
+                jobCondition.notify_all();
+
+                performJob(job, 0);
+
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobFinishedCondition.wait(lock, [this]() { return pendingWorkers == 0; });
+                return;
+            }
+#else
+            OUZEL_UNUSED(parallel);
+#endif
+
+            performJob(job, 0);
+        }
+
+        void RenderDeviceSoftware::performJob(Job job, uint32_t workerIndex)
+        {
+            switch (job)
+            {
+                case Job::BIN:
+                {
+                    // contiguous ranges keep the primitives of each bin set in the draw order
+                    if (workerIndex < binSetCount)
+                    {
+                        size_t first = primitives.size() * workerIndex / binSetCount;
+                        size_t last = primitives.size() * (workerIndex + 1) / binSetCount;
+                        binPrimitives(workerIndex, first, last);
+                    }
+                    break;
+                }
+                case Job::RASTERIZE:
+                {
+                    uint32_t tileCount = tilesX * tilesY;
+
+                    for (;;)
+                    {
+                        uint32_t tile = nextJobItem++;
+                        if (tile >= tileCount) break;
+                        rasterizeTile(tile);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        void RenderDeviceSoftware::binPrimitives(uint32_t binSet, size_t first, size_t last)
+        {
+            std::vector<std::vector<uint32_t>>& tileBins = bins[binSet];
+
+            for (size_t i = first; i < last; ++i)
+            {
+                const Primitive& primitive = primitives[i];
+
+                uint32_t firstTileX = static_cast<uint32_t>(primitive.minX) / TILE_SIZE;
+                uint32_t firstTileY = static_cast<uint32_t>(primitive.minY) / TILE_SIZE;
+                uint32_t lastTileX = static_cast<uint32_t>(primitive.maxX - 1) / TILE_SIZE;
+                uint32_t lastTileY = static_cast<uint32_t>(primitive.maxY - 1) / TILE_SIZE;
+
+                for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+                {
+                    for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+                    {
+                        tileBins[tileY * tilesX + tileX].push_back(static_cast<uint32_t>(i));
+                    }
+                }
+            }
+        }
+
+        void RenderDeviceSoftware::rasterizeTile(uint32_t tile)
+        {
+            int32_t tileMinX = static_cast<int32_t>((tile % tilesX) * TILE_SIZE);
+            int32_t tileMinY = static_cast<int32_t>((tile / tilesX) * TILE_SIZE);
+            int32_t tileMaxX = std::min(tileMinX + static_cast<int32_t>(TILE_SIZE), static_cast<int32_t>(target.width));
+            int32_t tileMaxY = std::min(tileMinY + static_cast<int32_t>(TILE_SIZE), static_cast<int32_t>(target.height));
+
+            for (uint32_t binSet = 0; binSet < binSetCount; ++binSet)
+            {
+                for (uint32_t primitiveIndex : bins[binSet][tile])
+                {
+                    const Primitive& primitive = primitives[primitiveIndex];
+
+                    int32_t minX = std::max(primitive.minX, tileMinX);
+                    int32_t minY = std::max(primitive.minY, tileMinY);
+                    int32_t maxX = std::min(primitive.maxX, tileMaxX);
+                    int32_t maxY = std::min(primitive.maxY, tileMaxY);
+
+                    if (minX >= maxX || minY >= maxY) continue;
+
+                    switch (primitive.vertexCount)
+                    {
+                        case 1:
+                        {
+                            const ScreenVertex& vertex = primitive.vertices[0];
+                            ScreenVertex fragment = vertex;
+                            float w = 1.0f / vertex.invW;
+                            for (uint32_t i = 0; i < 4; ++i) fragment.color[i] *= w;
+                            for (uint32_t i = 0; i < 2; ++i) fragment.texCoord[i] *= w;
+
+                            shadePixel(drawStates[primitive.drawState], primitive.textureLevel, minX, minY, fragment);
+                            break;
+                        }
+                        case 2:
+                            rasterizeLine(primitive, minX, minY, maxX, maxY);
+                            break;
+                        case 3:
+                            rasterizeTriangle(primitive, minX, minY, maxX, maxY);
+                            break;
+                    }
+                }
+            }
+        }
+
+        void RenderDeviceSoftware::rasterizeTriangle(const Primitive& primitive, int32_t minX, int32_t minY, int32_t maxX, int32_t maxY)
+        {
+            const DrawState& drawState = drawStates[primitive.drawState];
+            const ScreenVertex& v0 = primitive.vertices[0];
+            const ScreenVertex& v1 = primitive.vertices[1];
+            const ScreenVertex& v2 = primitive.vertices[2];
+
+            float area = edgeFunction(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y);
+            if (area <= 0.0f) return;
+            float invArea = 1.0f / area;
+
+            bool topLeft0 = isTopLeftEdge(v1.x, v1.y, v2.x, v2.y);
+            bool topLeft1 = isTopLeftEdge(v2.x, v2.y, v0.x, v0.y);
+            bool topLeft2 = isTopLeftEdge(v0.x, v0.y, v1.x, v1.y);
+
+            // edge function increments for one pixel step
+            float stepX0 = v1.y - v2.y, stepY0 = v2.x - v1.x;
+            float stepX1 = v2.y - v0.y, stepY1 = v0.x - v2.x;
+            float stepX2 = v0.y - v1.y, stepY2 = v1.x - v0.x;
+
+            float startX = minX + 0.5f;
+            float startY = minY + 0.5f;
+            float row0 = edgeFunction(v1.x, v1.y, v2.x, v2.y, startX, startY);
+            float row1 = edgeFunction(v2.x, v2.y, v0.x, v0.y, startX, startY);
+            float row2 = edgeFunction(v0.x, v0.y, v1.x, v1.y, startX, startY);
+
+            ScreenVertex fragment;
+
+            for (int32_t y = minY; y < maxY; ++y)
+            {
+                float w0 = row0;
+                float w1 = row1;
+                float w2 = row2;
+
+                for (int32_t x = minX; x < maxX; ++x)
+                {
+                    if ((w0 > 0.0f || (w0 == 0.0f && topLeft0)) &&
+                        (w1 > 0.0f || (w1 == 0.0f && topLeft1)) &&
+                        (w2 > 0.0f || (w2 == 0.0f && topLeft2)))
+                    {
+                        float b0 = w0 * invArea;
+                        float b1 = w1 * invArea;
+                        float b2 = w2 * invArea;
+
+                        fragment.z = b0 * v0.z + b1 * v1.z + b2 * v2.z;
+                        fragment.invW = b0 * v0.invW + b1 * v1.invW + b2 * v2.invW;
+                        float w = 1.0f / fragment.invW;
+
+                        for (uint32_t i = 0; i < 4; ++i)
+                        {
+                            fragment.color[i] = (b0 * v0.color[i] + b1 * v1.color[i] + b2 * v2.color[i]) * w;
+                        }
+
+                        for (uint32_t i = 0; i < 2; ++i)
+                        {
+                            fragment.texCoord[i] = (b0 * v0.texCoord[i] + b1 * v1.texCoord[i] + b2 * v2.texCoord[i]) * w;
+                        }
+
+                        shadePixel(drawState, primitive.textureLevel, x, y, fragment);
+                    }
+
+                    w0 += stepX0;
+                    w1 += stepX1;
+                    w2 += stepX2;
+                }
+
+                row0 += stepY0;
+                row1 += stepY1;
+                row2 += stepY2;
+            }
+        }
+
+        void RenderDeviceSoftware::rasterizeLine(const Primitive& primitive, int32_t minX, int32_t minY, int32_t maxX, int32_t maxY)
+        {
+            const DrawState& drawState = drawStates[primitive.drawState];
+            const ScreenVertex& v0 = primitive.vertices[0];
+            const ScreenVertex& v1 = primitive.vertices[1];
+
+            float dx = v1.x - v0.x;
+            float dy = v1.y - v0.y;
+            uint32_t steps = static_cast<uint32_t>(ceilf(std::max(fabsf(dx), fabsf(dy))));
+            if (steps == 0) steps = 1;
+
+            ScreenVertex fragment;
+
+            for (uint32_t step = 0; step <= steps; ++step)
+            {
+                float t = static_cast<float>(step) / steps;
+                int32_t x = static_cast<int32_t>(floorf(v0.x + dx * t));
+                int32_t y = static_cast<int32_t>(floorf(v0.y + dy * t));
+
+                // the pixels outside of the tile are drawn by the other tiles
+                if (x < minX || x >= maxX || y < minY || y >= maxY) continue;
+
+                fragment.z = v0.z + (v1.z - v0.z) * t;
+                fragment.invW = v0.invW + (v1.invW - v0.invW) * t;
+                float w = 1.0f / fragment.invW;
+
+                for (uint32_t i = 0; i < 4; ++i)
+                {
+                    fragment.color[i] = (v0.color[i] + (v1.color[i] - v0.color[i]) * t) * w;
+                }
+
+                for (uint32_t i = 0; i < 2; ++i)
+                {
+                    fragment.texCoord[i] = (v0.texCoord[i] + (v1.texCoord[i] - v0.texCoord[i]) * t) * w;
+                }
+
+                shadePixel(drawState, primitive.textureLevel, x, y, fragment);
+            }
+        }
+
+        void RenderDeviceSoftware::shadePixel(const DrawState& drawState, uint32_t textureLevel, int32_t x, int32_t y, const ScreenVertex& vertex)
+        {
+            if (drawState.depthTest)
+            {
+                float& depthValue = target.depth[static_cast<size_t>(y) * target.width + x];
+                if (vertex.z > depthValue) return;
+                if (drawState.depthWrite) depthValue = vertex.z;
+            }
+
+            float src[4];
+
+            switch (drawState.program)
+            {
+                case ShaderResourceSoftware::Program::TEXTURE:
+                {
+                    float texel[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+                    if (drawState.texture) sampleTexture(drawState.texture, textureLevel, textureFilter, vertex.texCoord[0], vertex.texCoord[1], texel);
+
+                    for (uint32_t i = 0; i < 4; ++i) src[i] = texel[i] * vertex.color[i] * drawState.color[i];
+                    break;
+                }
+                case ShaderResourceSoftware::Program::TEXTURE_SDF:
+                {
+                    float texel[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+                    if (drawState.texture) sampleTexture(drawState.texture, textureLevel, textureFilter, vertex.texCoord[0], vertex.texCoord[1], texel);
+
+                    float t = (texel[3] - (0.5f - SDF_EDGE_WIDTH)) / (2.0f * SDF_EDGE_WIDTH);
+                    t = std::max(0.0f, std::min(1.0f, t));
+                    float alpha = t * t * (3.0f - 2.0f * t);
+
+                    for (uint32_t i = 0; i < 3; ++i) src[i] = vertex.color[i] * drawState.color[i];
+                    src[3] = vertex.color[3] * drawState.color[3] * alpha;
+                    break;
+                }
+                case ShaderResourceSoftware::Program::COLOR:
+                default:
+                    for (uint32_t i = 0; i < 4; ++i) src[i] = vertex.color[i] * drawState.color[i];
+                    break;
+            }
+
+            uint8_t* pixel = target.color + static_cast<size_t>(y) * target.pitch + static_cast<size_t>(x) * 4;
+            const BlendStateResource* blendState = drawState.blendState;
+            uint8_t colorMask = blendState ? blendState->getColorMask() : BlendState::COLOR_MASK_ALL;
+
+            if (blendState && blendState->isBlendingEnabled())
+            {
+                float dst[4] = {pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, pixel[3] / 255.0f};
+                float result[4];
+
+                for (uint32_t i = 0; i < 3; ++i)
+                {
+                    result[i] = blend(blendState->getColorOperation(),
+                                      src[i], getBlendFactor(blendState->getColorBlendSource(), src, dst, i),
+                                      dst[i], getBlendFactor(blendState->getColorBlendDest(), src, dst, i));
+                }
+
+                result[3] = blend(blendState->getAlphaOperation(),
+                                  src[3], getBlendFactor(blendState->getAlphaBlendSource(), src, dst, 3),
+                                  dst[3], getBlendFactor(blendState->getAlphaBlendDest(), src, dst, 3));
+
+                memcpy(src, result, sizeof(src));
+            }
+
+            if (colorMask & BlendState::COLOR_MASK_RED) pixel[0] = toByte(src[0]);
+            if (colorMask & BlendState::COLOR_MASK_GREEN) pixel[1] = toByte(src[1]);
+            if (colorMask & BlendState::COLOR_MASK_BLUE) pixel[2] = toByte(src[2]);
+            if (colorMask & BlendState::COLOR_MASK_ALPHA) pixel[3] = toByte(src[3]);
+        }
+
+        bool RenderDeviceSoftware::readPixels(std::vector<uint8_t>& pixels, Size2& pixelsSize)
+        {
+            std::lock_guard<std::mutex> lock(frontBufferMutex);
+
+            if (frontBuffer.empty()) return false;
+
+            pixels = frontBuffer;
+            pixelsSize = Size2(static_cast<float>(frontBufferWidth), static_cast<float>(frontBufferHeight));
+
+            return true;
+        }
+
+        bool RenderDeviceSoftware::generateScreenshot(const std::string& filename)
+        {
+            std::lock_guard<std::mutex> lock(frontBufferMutex);
+
+            if (frontBuffer.empty())
+            {
+                Log(Log::Level::ERR) << "No frame has been drawn";
+                return false;
+            }
+
+            if (!stbi_write_png(filename.c_str(),
+                                static_cast<int>(frontBufferWidth),
+                                static_cast<int>(frontBufferHeight),
+                                4,
+                                frontBuffer.data(),
+                                static_cast<int>(frontBufferWidth * 4)))
+            {
+                Log(Log::Level::ERR) << "Failed to save image to file";
+                return false;
+            }
+
+            return true;
+        }
+
+        RenderDeviceSoftware::Statistics RenderDeviceSoftware::getStatistics()
+        {
+            std::lock_guard<std::mutex> lock(statisticsMutex);
+            return statistics;
+        }
+
+        void RenderDeviceSoftware::resetStatistics()
+        {
+            std::lock_guard<std::mutex> lock(statisticsMutex);
+            statistics = Statistics();
+            totalFrameTime = 0.0f;
+        }
+
+        BlendStateResource* RenderDeviceSoftware::createBlendState()
+        {
+            std::lock_guard<std::mutex> lock(resourceMutex);
+
+            BlendStateResource* blendState = new BlendStateResourceSoftware();
+            resources.push_back(std::unique_ptr<RenderResource>(blendState));
+            return blendState;
+        }
+
+        TextureResource* RenderDeviceSoftware::createTexture()
+        {
+            std::lock_guard<std::mutex> lock(resourceMutex);
+
+            TextureResource* texture(new TextureResourceSoftware());
+            resources.push_back(std::unique_ptr<RenderResource>(texture));
+            return texture;
+        }
+
+        ShaderResource* RenderDeviceSoftware::createShader()
+        {
+            std::lock_guard<std::mutex> lock(resourceMutex);
+
+            ShaderResource* shader = new ShaderResourceSoftware();
+            resources.push_back(std::unique_ptr<RenderResource>(shader));
+            return shader;
+        }
+
+        MeshBufferResource* RenderDeviceSoftware::createMeshBuffer()
+        {
+            std::lock_guard<std::mutex> lock(resourceMutex);
+
+            MeshBufferResource* meshBuffer = new MeshBufferResourceSoftware();
+            resources.push_back(std::unique_ptr<RenderResource>(meshBuffer));
+            return meshBuffer;
+        }
+
+        BufferResource* RenderDeviceSoftware::createBuffer()
+        {
+            std::lock_guard<std::mutex> lock(resourceMutex);
+
+            BufferResource* buffer = new BufferResourceSoftware();
+            resources.push_back(std::unique_ptr<RenderResource>(buffer));
+            return buffer;
+        }
+
+        void RenderDeviceSoftware::main()
+        {
+            sharedEngine->setCurrentThreadName("Render");
+
+#if OUZEL_MULTITHREADED
+            while (running)
+            {
+                process();
+            }
+#endif
+        }
+
+        void RenderDeviceSoftware::workerMain(uint32_t workerIndex)
+        {
+            sharedEngine->setCurrentThreadName("Rasterizer");
+
+            uint32_t generation = 0;
+
+            for (;;)
+            {
+                Job job;
+
+                {
+                    std::unique_lock<std::mutex> lock(jobMutex);
+                    jobCondition.wait(lock, [this, generation]() { return !workersRunning || jobGeneration != generation; });
+
+                    if (!workersRunning) return;
+
+                    generation = jobGeneration;
+                    job = currentJob;
+                }
+
+                performJob(job, workerIndex);
+
+                std::lock_guard<std::mutex> lock(jobMutex);
+                if (--pendingWorkers == 0) jobFinishedCondition.notify_all();
+            }
+        }
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,205 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "core/Setup.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "graphics/RenderDevice.hpp"
+#include "graphics/software/ShaderResourceSoftware.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        class TextureResourceSoftware;
+
+        // Rasterizes the draw commands on the CPU into a memory back buffer, nothing is presented to the window
+        class RenderDeviceSoftware: public RenderDevice
+        {
+            friend Renderer;
+        public:
+            struct Statistics
+            {
+                uint32_t frameCount = 0;
+                uint32_t primitiveCount = 0; // primitives rasterized in the last frame
+                float frameTime = 0.0f; // seconds spent in the last draw
+                float averageFrameTime = 0.0f;
+                float minFrameTime = 0.0f;
+                float maxFrameTime = 0.0f;
+            };
+
+            static const uint32_t TILE_SIZE = 64;
+            static const uint32_t MAX_WORKERS = 16;
+            static const uint32_t PARALLEL_BINNING_THRESHOLD = 1024; // smaller passes are binned on the render thread
+
+            virtual ~RenderDeviceSoftware();
+
+            // copies the last finished frame as RGBA8 pixels, top row first
+            bool readPixels(std::vector<uint8_t>& pixels, Size2& pixelsSize);
+
+            Statistics getStatistics();
+            void resetStatistics();
+
+            uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers.size() + 1); }
+
+        protected:
+            RenderDeviceSoftware();
+
+            virtual bool init(Window* newWindow,
+                              const Size2& newSize,
+                              uint32_t newSampleCount,
+                              Texture::Filter newTextureFilter,
+                              uint32_t newMaxAnisotropy,
+                              bool newVerticalSync,
+                              bool newDepth,
+                              bool newDebugRenderer) override;
+
+            virtual void setSize(const Size2& newSize) override;
+
+            virtual bool draw(const std::vector<DrawCommand>& drawCommands) override;
+            virtual bool generateScreenshot(const std::string& filename) override;
+
+            virtual BlendStateResource* createBlendState() override;
+            virtual TextureResource* createTexture() override;
+            virtual ShaderResource* createShader() override;
+            virtual MeshBufferResource* createMeshBuffer() override;
+            virtual BufferResource* createBuffer() override;
+
+            struct Target
+            {
+                uint32_t width = 0;
+                uint32_t height = 0;
+                uint32_t pitch = 0;
+                uint8_t* color = nullptr;
+                float* depth = nullptr;
+            };
+
+            struct DrawState
+            {
+                ShaderResourceSoftware::Program program;
+                TextureResourceSoftware* texture;
+                BlendStateResource* blendState;
+                float color[4];
+                bool depthTest;
+                bool depthWrite;
+                // intersection of the viewport, scissor rectangle and the target
+                int32_t minX;
+                int32_t minY;
+                int32_t maxX;
+                int32_t maxY;
+            };
+
+            struct ClipVertex
+            {
+                float position[4];
+                float color[4];
+                float texCoord[2];
+            };
+
+            // attributes are divided by w for perspective correct interpolation
+            struct ScreenVertex
+            {
+                float x;
+                float y;
+                float z;
+                float invW;
+                float color[4];
+                float texCoord[2];
+            };
+
+            struct Primitive
+            {
+                uint32_t vertexCount; // 1 for points, 2 for lines and 3 for triangles
+                uint32_t drawState;
+                uint32_t textureLevel = 0; // mip level of the texture, selected per triangle
+                ScreenVertex vertices[3];
+                int32_t minX;
+                int32_t minY;
+                int32_t maxX;
+                int32_t maxY;
+            };
+
+            enum class Job
+            {
+                NONE,
+                BIN,
+                RASTERIZE
+            };
+
+            static ClipVertex interpolateVertex(const ClipVertex& vertex1, const ClipVertex& vertex2, float t);
+            static float getClipDistance(const ClipVertex& vertex, uint32_t plane);
+            static ScreenVertex toScreen(const ClipVertex& vertex, const Rectangle& viewport);
+            static uint32_t selectTextureLevel(const TextureResourceSoftware* texture, const ScreenVertex* vertices);
+
+            void resizeBackBuffer();
+            bool getTarget(TextureResource* renderTarget, Target& result);
+            void clearTarget(TextureResource* renderTarget);
+
+            bool addPrimitives(const DrawCommand& drawCommand);
+            void addPoint(const ClipVertex& vertex, uint32_t drawState, const Rectangle& viewport);
+            void addLine(const ClipVertex& vertex1, const ClipVertex& vertex2, uint32_t drawState, const Rectangle& viewport);
+            void addTriangle(const ClipVertex& vertex1, const ClipVertex& vertex2, const ClipVertex& vertex3,
+                             uint32_t drawState, const Rectangle& viewport, Renderer::CullMode cullMode, bool wireframe);
+            void flushPrimitives();
+
+            void runJob(Job job, bool parallel);
+            void performJob(Job job, uint32_t workerIndex);
+            void binPrimitives(uint32_t binSet, size_t first, size_t last);
+            void rasterizeTile(uint32_t tile);
+            void rasterizeTriangle(const Primitive& primitive, int32_t minX, int32_t minY, int32_t maxX, int32_t maxY);
+            void rasterizeLine(const Primitive& primitive, int32_t minX, int32_t minY, int32_t maxX, int32_t maxY);
+            void shadePixel(const DrawState& drawState, uint32_t textureLevel, int32_t x, int32_t y, const ScreenVertex& vertex);
+
+            void main();
+            void workerMain(uint32_t workerIndex);
+
+            std::vector<uint8_t> colorBuffer;
+            std::vector<float> depthBuffer;
+            uint32_t frameBufferWidth = 0;
+            uint32_t frameBufferHeight = 0;
+
+            std::mutex frontBufferMutex;
+            std::vector<uint8_t> frontBuffer;
+            uint32_t frontBufferWidth = 0;
+            uint32_t frontBufferHeight = 0;
+
+            // state of the pass that is being rasterized
+            Target target;
+            uint32_t tilesX = 0;
+            uint32_t tilesY = 0;
+            std::vector<DrawState> drawStates;
+            std::vector<Primitive> primitives;
+            std::vector<std::vector<std::vector<uint32_t>>> bins; // primitive indices for each bin set and tile
+            uint32_t binSetCount = 1;
+
+            std::vector<ClipVertex> vertexCache;
+            std::vector<uint32_t> vertexCacheStamps;
+            uint32_t vertexCacheStamp = 0;
+
+            std::vector<std::thread> workers;
+            std::mutex jobMutex;
+            std::condition_variable jobCondition;
+            std::condition_variable jobFinishedCondition;
+            Job currentJob = Job::NONE;
+            uint32_t jobGeneration = 0;
+            uint32_t pendingWorkers = 0;
+            bool workersRunning = false;
+            std::atomic<uint32_t> nextJobItem;
+
+            std::mutex statisticsMutex;
+            Statistics statistics;
+            float totalFrameTime = 0.0f;
+            uint32_t primitiveCount = 0;
+
+#if OUZEL_MULTITHREADED
+            std::atomic<bool> running;
+            std::thread renderThread;
+#endif
+        };
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,63 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "ShaderResourceSoftware.hpp"
+#include "utils/Log.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        const std::string ShaderResourceSoftware::COLOR_FUNCTION = "colorPS";
+        const std::string ShaderResourceSoftware::TEXTURE_FUNCTION = "texturePS";
+        const std::string ShaderResourceSoftware::TEXTURE_SDF_FUNCTION = "textureSDFPS";
+
+        ShaderResourceSoftware::ShaderResourceSoftware()
+        {
+        }
+
+        bool ShaderResourceSoftware::init(const std::vector<uint8_t>& newPixelShader,
+                                          const std::vector<uint8_t>& newVertexShader,
+                                          const std::vector<VertexAttribute>& newVertexAttributes,
+                                          const std::vector<Shader::ConstantInfo>& newPixelShaderConstantInfo,
+                                          const std::vector<Shader::ConstantInfo>& newVertexShaderConstantInfo,
+                                          uint32_t newPixelShaderDataAlignment,
+                                          uint32_t newVertexShaderDataAlignment,
+                                          const std::string& newPixelShaderFunction,
+                                          const std::string& newVertexShaderFunction)
+        {
+            if (!ShaderResource::init(newPixelShader,
+                                      newVertexShader,
+                                      newVertexAttributes,
+                                      newPixelShaderConstantInfo,
+                                      newVertexShaderConstantInfo,
+                                      newPixelShaderDataAlignment,
+                                      newVertexShaderDataAlignment,
+                                      newPixelShaderFunction,
+                                      newVertexShaderFunction))
+            {
+                return false;
+            }
+
+            if (newPixelShaderFunction == COLOR_FUNCTION)
+            {
+                program = Program::COLOR;
+            }
+            else if (newPixelShaderFunction == TEXTURE_FUNCTION)
+            {
+                program = Program::TEXTURE;
+            }
+            else if (newPixelShaderFunction == TEXTURE_SDF_FUNCTION)
+            {
+                program = Program::TEXTURE_SDF;
+            }
+            else
+            {
+                program = Program::NONE;
+                Log(Log::Level::WARN) << "Custom shaders are not supported by the software renderer";
+            }
+
+            return true;
+        }
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,46 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "graphics/ShaderResource.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        class ShaderResourceSoftware: public ShaderResource
+        {
+        public:
+            // the built-in shaders implemented by the rasterizer, selected by the pixel shader function name
+            enum class Program
+            {
+                NONE,
+                COLOR,
+                TEXTURE,
+                TEXTURE_SDF
+            };
+
+            static const std::string COLOR_FUNCTION;
+            static const std::string TEXTURE_FUNCTION;
+            static const std::string TEXTURE_SDF_FUNCTION;
+
+            ShaderResourceSoftware();
+
+            virtual bool init(const std::vector<uint8_t>& newPixelShader,
+                              const std::vector<uint8_t>& newVertexShader,
+                              const std::vector<VertexAttribute>& newVertexAttributes,
+                              const std::vector<Shader::ConstantInfo>& newPixelShaderConstantInfo,
+                              const std::vector<Shader::ConstantInfo>& newVertexShaderConstantInfo,
+                              uint32_t newPixelShaderDataAlignment = 0,
+                              uint32_t newVertexShaderDataAlignment = 0,
+                              const std::string& newPixelShaderFunction = "",
+                              const std::string& newVertexShaderFunction = "") override;
+
+            Program getProgram() const { return program; }
+
+        protected:
+            Program program = Program::NONE;
+        };
+    } // namespace graphics
+} // namespace ouzel
@@ -0,0 +1,40 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "TextureResourceSoftware.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        TextureResourceSoftware::TextureResourceSoftware()
+        {
+        }
+
+        Texture::Level* TextureResourceSoftware::getRenderTargetLevel()
+        {
+            if (!(flags & Texture::RENDER_TARGET) ||
+                levels.empty() ||
+                pixelFormat != PixelFormat::RGBA8_UNORM)
+            {
+                return nullptr;
+            }
+
+            return &levels[0];
+        }
+
+        float* TextureResourceSoftware::getDepthBuffer()
+        {
+            if (!(flags & Texture::DEPTH_BUFFER) || levels.empty())
+            {
+                return nullptr;
+            }
+
+            // allocated on first use and after the render target is resized
+            size_t pixelCount = static_cast<size_t>(levels[0].size.width) * static_cast<size_t>(levels[0].size.height);
+            if (depthBuffer.size() != pixelCount) depthBuffer.resize(pixelCount, 1.0f);
+
+            return depthBuffer.data();
+        }
+    } // namespace graphics
+} // namespace ouzel
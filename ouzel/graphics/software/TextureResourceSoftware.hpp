@@ -0,0 +1,27 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "graphics/TextureResource.hpp"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        class TextureResourceSoftware: public TextureResource
+        {
+        public:
+            TextureResourceSoftware();
+
+            const std::vector<Texture::Level>& getLevels() const { return levels; }
+
+            // render targets are drawn directly to the first level
+            Texture::Level* getRenderTargetLevel();
+            float* getDepthBuffer();
+
+        protected:
+            std::vector<float> depthBuffer;
+        };
+    } // namespace graphics
+} // namespace ouzel
@@ -1,6 +1,7 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -45,7 +46,6 @@ namespace ouzel
 
         int16_t k;
         uint32_t first, second;
-        CharDescriptor c;
 
         for (std::string line; std::getline(stream, line);)
         {
@@ -104,7 +104,7 @@ namespace ouzel
                 else if (read == "char")
                 {
                     //This is data for each specific character.
-                    int32_t charId = 0;
+                    CharDescriptor c;
 
                     while (!lineStream.eof())
                     {
@@ -116,7 +116,7 @@ namespace ouzel
 
                         //Assign the correct value
                         converter << value;
-                        if (key == "id") converter >> charId;
+                        if (key == "id") converter >> c.id;
                         else if (key == "x") converter >> c.x;
                         else if (key == "y") converter >> c.y;
                         else if (key == "width") converter >> c.width;
@@ -127,7 +127,7 @@ namespace ouzel
                         else if (key == "page") converter >> c.page;
                     }
 
-                    chars.insert(std::unordered_map<int32_t, CharDescriptor>::value_type(charId, c));
+                    chars.push_back(c);
                 }
                 else if (read == "kernings")
                 {
@@ -162,115 +162,96 @@ namespace ouzel
                         else if (key == "second") converter >> second;
                         else if (key == "amount") converter >> k;
                     }
-                    kern[std::make_pair(first, second)] = k;
+                    kern.push_back(std::make_pair((static_cast<uint64_t>(first) << 32) | second, k));
                 }
             }
         }
 
+        // the first definition of a character and the last definition of a kerning pair win
+        std::stable_sort(chars.begin(), chars.end(), [](const CharDescriptor& a, const CharDescriptor& b) {
+            return a.id < b.id;
+        });
+        chars.erase(std::unique(chars.begin(), chars.end(), [](const CharDescriptor& a, const CharDescriptor& b) {
+            return a.id == b.id;
+        }), chars.end());
+
+        std::reverse(kern.begin(), kern.end());
+        std::stable_sort(kern.begin(), kern.end(), [](const std::pair<uint64_t, int16_t>& a, const std::pair<uint64_t, int16_t>& b) {
+            return a.first < b.first;
+        });
+        kern.erase(std::unique(kern.begin(), kern.end(), [](const std::pair<uint64_t, int16_t>& a, const std::pair<uint64_t, int16_t>& b) {
+            return a.first == b.first;
+        }), kern.end());
+
+        charIndices.assign(256, -1);
+
+        for (size_t index = 0; index < chars.size() && chars[index].id < charIndices.size(); ++index)
+        {
+            charIndices[chars[index].id] = static_cast<int32_t>(index);
+        }
+
         return true;
     }
 
-    void BMFont::getVertices(const std::string& text,
-                             const Color& color,
-                             float fontSize,
-                             const Vector2& anchor,
-                             std::vector<uint16_t>& indices,
-                             std::vector<graphics::VertexPCT>& vertices,
-                             std::shared_ptr<graphics::Texture>& texture)
+    bool BMFont::getGlyph(uint32_t character, float fontSize, Glyph& glyph)
     {
-        Vector2 position;
-
-        std::vector<uint32_t> utf32Text = utf8to32(text);
-
-        indices.clear();
-        vertices.clear();
-
-        indices.reserve(utf32Text.size() * 6);
-        vertices.reserve(utf32Text.size() * 4);
-
-        Vector2 textCoords[4];
-
-        size_t firstChar = 0;
+        const CharDescriptor* c = getChar(character);
 
-        for (auto i = utf32Text.begin(); i != utf32Text.end(); ++i)
+        if (!c)
         {
-            std::unordered_map<uint32_t, CharDescriptor>::iterator iter = chars.find(*i);
-
-            if (iter != chars.end())
-            {
-                const CharDescriptor& f = iter->second;
-
-                uint16_t startIndex = static_cast<uint16_t>(vertices.size());
-                indices.push_back(startIndex + 0);
-                indices.push_back(startIndex + 1);
-                indices.push_back(startIndex + 2);
-
-                indices.push_back(startIndex + 1);
-                indices.push_back(startIndex + 3);
-                indices.push_back(startIndex + 2);
-
-                Vector2 leftTop(f.x / static_cast<float>(width),
-                                f.y / static_cast<float>(height));
-
-                Vector2 rightBottom((f.x + f.width) / static_cast<float>(width),
-                                    (f.y + f.height) / static_cast<float>(height));
-
-                textCoords[0] = Vector2(leftTop.x, rightBottom.y);
-                textCoords[1] = Vector2(rightBottom.x, rightBottom.y);
-                textCoords[2] = Vector2(leftTop.x, leftTop.y);
-                textCoords[3] = Vector2(rightBottom.x, leftTop.y);
-
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.xOffset, -position.y - f.yOffset - f.height, 0.0f),
-                                                       color, textCoords[0]));
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.xOffset + f.width, -position.y - f.yOffset - f.height, 0.0f),
-                                                       color, textCoords[1]));
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.xOffset, -position.y - f.yOffset, 0.0f),
-                                                       color, textCoords[2]));
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.xOffset + f.width, -position.y - f.yOffset, 0.0f),
-                                                       color, textCoords[3]));
-
-                if ((i + 1) != utf32Text.end())
-                {
-                    position.x += static_cast<float>(getKerningPair(*i, *(i + 1)));
-                }
+            return false;
+        }
 
-                position.x += f.xAdvance;
-            }
+        glyph.offset = Vector2(c->xOffset * fontSize, c->yOffset * fontSize);
+        glyph.size = Size2(c->width * fontSize, c->height * fontSize);
+        glyph.leftTop = Vector2(c->x / static_cast<float>(width),
+                                c->y / static_cast<float>(height));
+        glyph.rightBottom = Vector2((c->x + c->width) / static_cast<float>(width),
+                                    (c->y + c->height) / static_cast<float>(height));
+        glyph.advance = c->xAdvance * fontSize;
 
-            if (*i == static_cast<uint32_t>('\n') || // line feed
-                (i + 1) == utf32Text.end()) // end of string
-            {
-                float lineWidth = position.x;
-                position.x = 0.0f;
-                position.y += lineHeight;
+        return true;
+    }
 
-                for (size_t c = firstChar; c < vertices.size(); ++c)
-                {
-                    vertices[c].position.x -= lineWidth * anchor.x;
-                }
+    float BMFont::getKerning(uint32_t first, uint32_t second, float fontSize)
+    {
+        return getKerningPair(first, second) * fontSize;
+    }
 
-                firstChar = vertices.size();
-            }
-        }
+    float BMFont::getLineHeight(float fontSize)
+    {
+        return lineHeight * fontSize;
+    }
 
-        float textHeight = position.y;
+    std::shared_ptr<graphics::Texture> BMFont::getTexture(float)
+    {
+        return fontTexture;
+    }
 
-        for (size_t c = 0; c < vertices.size(); ++c)
+    const BMFont::CharDescriptor* BMFont::getChar(uint32_t character) const
+    {
+        if (character < charIndices.size())
         {
-            vertices[c].position.y += textHeight * (1.0f - anchor.y);
-
-            vertices[c].position.x *= fontSize;
-            vertices[c].position.y *= fontSize;
+            int32_t index = charIndices[character];
+            return (index >= 0) ? &chars[static_cast<size_t>(index)] : nullptr;
         }
 
-        texture = fontTexture;
+        auto i = std::lower_bound(chars.begin(), chars.end(), character, [](const CharDescriptor& c, uint32_t id) {
+            return c.id < id;
+        });
+
+        return (i != chars.end() && i->id == character) ? &(*i) : nullptr;
     }
 
-    int16_t BMFont::getKerningPair(uint32_t first, uint32_t second)
+    int16_t BMFont::getKerningPair(uint32_t first, uint32_t second) const
     {
-        auto i = kern.find(std::make_pair(first, second));
+        uint64_t key = (static_cast<uint64_t>(first) << 32) | second;
 
-        if (i != kern.end())
+        auto i = std::lower_bound(kern.begin(), kern.end(), key, [](const std::pair<uint64_t, int16_t>& pair, uint64_t k) {
+            return pair.first < k;
+        });
+
+        if (i != kern.end() && i->first == key)
         {
             return i->second;
         }
@@ -278,7 +259,7 @@ namespace ouzel
         return 0;
     }
 
-    float BMFont::getStringWidth(const std::string& text)
+    float BMFont::getStringWidth(const std::string& text) const
     {
         float total = 0.0f;
 
@@ -286,12 +267,9 @@ namespace ouzel
 
         for (auto i = utf32Text.begin(); i != utf32Text.end(); ++i)
         {
-            std::unordered_map<uint32_t, CharDescriptor>::iterator iter = chars.find(*i);
-
-            if (iter != chars.end())
+            if (const CharDescriptor* c = getChar(*i))
             {
-                const CharDescriptor& f = iter->second;
-                total += f.xAdvance;
+                total += c->xAdvance;
             }
         }
 
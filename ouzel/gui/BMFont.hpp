@@ -16,21 +16,16 @@ namespace ouzel
         bool init(const std::string& filename, bool mipmaps = true);
         bool init(const std::vector<uint8_t>& data, bool mipmaps = true);
 
-        virtual void getVertices(const std::string& text,
-                                 const Color& color,
-                                 float fontSize,
-                                 const Vector2& anchor,
-                                 std::vector<uint16_t>& indices,
-                                 std::vector<graphics::VertexPCT>& vertices,
-                                 std::shared_ptr<graphics::Texture>& texture) override;
+        virtual bool getGlyph(uint32_t character, float fontSize, Glyph& glyph) override;
+        virtual float getKerning(uint32_t first, uint32_t second, float fontSize) override;
+        virtual float getLineHeight(float fontSize) override;
+        virtual std::shared_ptr<graphics::Texture> getTexture(float fontSize) override;
 
     protected:
-        int16_t getKerningPair(uint32_t, uint32_t);
-        float getStringWidth(const std::string& text);
-
         class CharDescriptor
         {
         public:
+            uint32_t id = 0;
             int16_t x = 0, y = 0;
             int16_t width = 0;
             int16_t height = 0;
@@ -40,6 +35,10 @@ namespace ouzel
             int16_t page = 0;
         };
 
+        const CharDescriptor* getChar(uint32_t character) const;
+        int16_t getKerningPair(uint32_t, uint32_t) const;
+        float getStringWidth(const std::string& text) const;
+
         uint16_t lineHeight = 0;
         uint16_t base = 0;
         uint16_t width = 0;
@@ -47,8 +46,9 @@ namespace ouzel
         uint16_t pages = 0;
         uint16_t outline = 0;
         uint16_t kernCount = 0;
-        std::unordered_map<uint32_t, CharDescriptor> chars;
-        std::map<std::pair<uint32_t, uint32_t>, int16_t> kern;
+        std::vector<CharDescriptor> chars; // sorted by id
+        std::vector<int32_t> charIndices; // indices in chars of the first 256 characters, -1 if missing
+        std::vector<std::pair<uint64_t, int16_t>> kern; // sorted by the pair of characters
         std::shared_ptr<graphics::Texture> fontTexture;
     };
 }
@@ -2,10 +2,72 @@
 // This file is part of the Ouzel engine.
 
 #include "Font.hpp"
+#include "TextLayout.hpp"
+#include "core/Engine.hpp"
 
 namespace ouzel
 {
+    static const size_t MAX_CACHED_RUNS = 256;
+
     Font::~Font()
     {
     }
+
+    void Font::getVertices(const std::string& text,
+                           const Color& color,
+                           float fontSize,
+                           const Vector2& anchor,
+                           std::vector<uint32_t>& indices,
+                           std::vector<graphics::VertexPCT>& vertices,
+                           std::shared_ptr<graphics::Texture>& texture,
+                           float maxWidth)
+    {
+        TextLayout layout;
+        layout.update(this, text, fontSize, maxWidth, anchor, color);
+
+        indices = layout.getIndices();
+        vertices = layout.getVertices();
+        texture = layout.getTexture();
+    }
+
+    bool Font::prepareGlyphs(const uint32_t*, uint32_t, float)
+    {
+        return true;
+    }
+
+    std::shared_ptr<const TextRun> Font::getCachedRun(const std::string& key) const
+    {
+        auto i = runs.find(key);
+
+        return (i == runs.end()) ? nullptr : i->second;
+    }
+
+    void Font::cacheRun(const std::string& key, const std::shared_ptr<const TextRun>& run)
+    {
+        // start over instead of tracking the usage of every run
+        if (runs.size() >= MAX_CACHED_RUNS) runs.clear();
+
+        runs[key] = run;
+    }
+
+    void Font::invalidateGlyphs()
+    {
+        ++generation;
+        runs.clear();
+
+        for (UpdateCallback* callback : invalidationCallbacks)
+        {
+            sharedEngine->scheduleUpdate(callback);
+        }
+    }
+
+    void Font::addInvalidationCallback(UpdateCallback* callback)
+    {
+        invalidationCallbacks.insert(callback);
+    }
+
+    void Font::removeInvalidationCallback(UpdateCallback* callback)
+    {
+        invalidationCallbacks.erase(callback);
+    }
 }
@@ -7,26 +7,68 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <vector>
+#include "core/UpdateCallback.hpp"
 #include "utils/Noncopyable.hpp"
 #include "math/Color.hpp"
+#include "math/Size2.hpp"
 #include "graphics/Texture.hpp"
 #include "graphics/Vertex.hpp"
 
 namespace ouzel
 {
+    struct TextRun;
+
     class Font: public Noncopyable
     {
     public:
+        struct Glyph
+        {
+            Vector2 offset; // from the pen position to the top left corner, y pointing down
+            Size2 size;
+            Vector2 leftTop; // texture coordinates
+            Vector2 rightBottom;
+            float advance = 0.0f;
+        };
+
         virtual ~Font();
 
-        virtual void getVertices(const std::string& text,
-                                 const Color& color,
-                                 float fontSize,
-                                 const Vector2& anchor,
-                                 std::vector<uint16_t>& indices,
-                                 std::vector<graphics::VertexPCT>& vertices,
-                                 std::shared_ptr<graphics::Texture>& texture) = 0;
+        void getVertices(const std::string& text,
+                         const Color& color,
+                         float fontSize,
+                         const Vector2& anchor,
+                         std::vector<uint32_t>& indices,
+                         std::vector<graphics::VertexPCT>& vertices,
+                         std::shared_ptr<graphics::Texture>& texture,
+                         float maxWidth = 0.0f);
+
+        // makes the glyphs available for getGlyph, can invalidate the previously returned glyphs
+        virtual bool prepareGlyphs(const uint32_t* characters, uint32_t count, float fontSize);
+        virtual bool getGlyph(uint32_t character, float fontSize, Glyph& glyph) = 0;
+        virtual float getKerning(uint32_t first, uint32_t second, float fontSize) = 0;
+        virtual float getLineHeight(float fontSize) = 0;
+        virtual std::shared_ptr<graphics::Texture> getTexture(float fontSize) = 0;
+
+        // true if the texture stores signed distance fields instead of coverage
+        virtual bool isSDF() const { return false; }
+
+        // incremented every time the glyph placement or texture coordinates change
+        uint32_t getGeneration() const { return generation; }
+
+        std::shared_ptr<const TextRun> getCachedRun(const std::string& key) const;
+        void cacheRun(const std::string& key, const std::shared_ptr<const TextRun>& run);
+
+        // the callbacks are scheduled once every time the glyphs are invalidated
+        void addInvalidationCallback(UpdateCallback* callback);
+        void removeInvalidationCallback(UpdateCallback* callback);
+
+    protected:
+        void invalidateGlyphs();
+
+        uint32_t generation = 0;
+        std::unordered_map<std::string, std::shared_ptr<const TextRun>> runs;
+        std::set<UpdateCallback*> invalidationCallbacks;
     };
 }
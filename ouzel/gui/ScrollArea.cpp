@@ -2,13 +2,58 @@
 // This file is part of the Ouzel engine.
 
 #include "ScrollArea.hpp"
+#include "WidgetCache.hpp"
 
 namespace ouzel
 {
     namespace gui
     {
-        ScrollArea::ScrollArea()
+        ScrollArea::ScrollArea(const Size2& aSize):
+            size(aSize)
         {
+            addChild(&content);
+            setCached(true);
+        }
+
+        void ScrollArea::visit(std::vector<scene::Actor*>& drawQueue,
+                               const Matrix4& newParentTransform,
+                               bool parentTransformDirty,
+                               scene::Camera* camera,
+                               int32_t parentOrder,
+                               bool parentHidden)
+        {
+            // the content is moved by the negative scroll offset, so in its space the window starts at the offset
+            if (cache)
+            {
+                cache->setClipRectangle(Rectangle(scrollOffset, size));
+            }
+
+            Widget::visit(drawQueue, newParentTransform, parentTransformDirty, camera, parentOrder, parentHidden);
+        }
+
+        void ScrollArea::findActors(const Vector2& position, std::vector<std::pair<scene::Actor*, Vector3>>& actors) const
+        {
+            Vector3 localPosition = convertWorldToLocal(position);
+
+            // content outside of the window can not be picked
+            if (localPosition.x < 0.0f || localPosition.x > size.width ||
+                localPosition.y < 0.0f || localPosition.y > size.height)
+            {
+                return;
+            }
+
+            Widget::findActors(position, actors);
+        }
+
+        void ScrollArea::setSize(const Size2& newSize)
+        {
+            size = newSize;
+        }
+
+        void ScrollArea::setScrollOffset(const Vector2& newScrollOffset)
+        {
+            scrollOffset = newScrollOffset;
+            content.setPosition(-scrollOffset);
         }
     } // namespace gui
 } // namespace ouzel
@@ -4,15 +4,44 @@
 #pragma once
 
 #include "gui/Widget.hpp"
+#include "math/Size2.hpp"
+#include "math/Vector2.hpp"
 
 namespace ouzel
 {
     namespace gui
     {
+        // Children should be added to the content actor. The area is cached, so scrolling only moves
+        // the visible window over the cache, the content is not redrawn.
         class ScrollArea: public Widget
         {
         public:
-            ScrollArea();
+            ScrollArea(const Size2& aSize = Size2());
+
+            virtual void visit(std::vector<scene::Actor*>& drawQueue,
+                               const Matrix4& newParentTransform,
+                               bool parentTransformDirty,
+                               scene::Camera* camera,
+                               int32_t parentOrder,
+                               bool parentHidden) override;
+
+            using Widget::findActors;
+            virtual void findActors(const Vector2& position, std::vector<std::pair<scene::Actor*, Vector3>>& actors) const override;
+
+            void setSize(const Size2& newSize);
+            const Size2& getSize() const { return size; }
+
+            void setScrollOffset(const Vector2& newScrollOffset);
+            const Vector2& getScrollOffset() const { return scrollOffset; }
+
+            scene::Actor* getContent() { return &content; }
+
+        protected:
+            virtual scene::Actor* getCacheRoot() override { return &content; }
+
+            Size2 size;
+            Vector2 scrollOffset;
+            scene::Actor content;
         };
     } // namespace gui
 } // namespace ouzel
@@ -1,12 +1,16 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include <cassert>
 
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "TTFont.hpp"
+#include "assets/Cache.hpp"
 #include "core/Engine.hpp"
 #include "files/FileSystem.hpp"
+#include "graphics/Renderer.hpp"
+#include "math/MathUtils.hpp"
 #include "utils/Log.hpp"
 #include "utils/Utils.hpp"
 
@@ -17,14 +21,28 @@ namespace ouzel
     {
     }
 
-    TTFont::TTFont(const std::string& filename, bool aMipmaps)
+    TTFont::TTFont(const std::string& filename, bool, bool aSDF)
     {
-        init(filename, aMipmaps);
+        init(filename, false, aSDF);
     }
 
-    bool TTFont::init(const std::string & filename, bool newMipmaps)
+    static bool isSDFSupported()
     {
-        mipmaps = newMipmaps;
+        // renderers without a distance field shader would draw the raw distance values
+        if (!sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE_SDF))
+        {
+            Log(Log::Level::ERR) << "Signed distance field fonts are not supported by this renderer";
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TTFont::init(const std::string & filename, bool, bool newSDF)
+    {
+        if (newSDF && !isSDFSupported()) return false;
+
+        sdf = newSDF;
 
         if (!sharedEngine->getFileSystem()->readFile(sharedEngine->getFileSystem()->getPath(filename), data))
         {
@@ -40,10 +58,12 @@ namespace ouzel
         return true;
     }
 
-    bool TTFont::init(const std::vector<uint8_t>& newData, bool newMipmaps)
+    bool TTFont::init(const std::vector<uint8_t>& newData, bool, bool newSDF)
     {
+        if (newSDF && !isSDFSupported()) return false;
+
         data = newData;
-        mipmaps = newMipmaps;
+        sdf = newSDF;
 
         if (!stbtt_InitFont(&font, data.data(), stbtt_GetFontOffsetForIndex(data.data(), 0)))
         {
@@ -54,188 +74,318 @@ namespace ouzel
         return true;
     }
 
-    void TTFont::getVertices(const std::string& text,
-                             const Color& color,
-                             float fontSize,
-                             const Vector2& anchor,
-                             std::vector<uint16_t>& indices,
-                             std::vector<graphics::VertexPCT>& vertices,
-                             std::shared_ptr<graphics::Texture>& texture)
+    static const uint16_t SPACING = 2;
+    static const size_t MAX_ATLASES = 4;
+    static const int MIN_ATLAS_SIZE = 256;
+    static const int MAX_ATLAS_SIZE = 2048;
+    static const float SDF_FONT_SIZE = 32.0f;
+    static const int SDF_PADDING = 4;
+    static const unsigned char SDF_ON_EDGE = 128;
+
+    float TTFont::getAtlasFontSize(float fontSize) const
     {
-        static const uint32_t SPACING = 2;
+        return sdf ? SDF_FONT_SIZE : fontSize;
+    }
 
-        struct CharDescriptor
-        {
-            uint16_t x = 0, y = 0;
-            uint16_t width = 0;
-            uint16_t height = 0;
-            Vector2 offset;
-            float advance = 0;
-            std::vector<uint8_t> bitmap;
-        };
+    TTFont::Atlas& TTFont::getAtlas(float fontSize)
+    {
+        auto i = atlases.find(fontSize);
 
-        std::unordered_map<uint32_t, CharDescriptor> chars;
+        if (i == atlases.end())
+        {
+            if (atlases.size() >= MAX_ATLASES)
+            {
+                // drop the least recently used font size
+                auto leastRecentlyUsed = atlases.begin();
 
-        float s = stbtt_ScaleForPixelHeight(&font, fontSize);
+                for (auto atlasIterator = atlases.begin(); atlasIterator != atlases.end(); ++atlasIterator)
+                {
+                    if (atlasIterator->second.lastUsed < leastRecentlyUsed->second.lastUsed)
+                    {
+                        leastRecentlyUsed = atlasIterator;
+                    }
+                }
 
-        std::vector<uint32_t> utf32Text = utf8to32(text);
+                atlases.erase(leastRecentlyUsed);
+                invalidateGlyphs();
+            }
 
-        std::set<uint32_t> glyphs;
-        for (uint32_t i : utf32Text)
-        {
-            glyphs.insert(i);
+            i = atlases.insert(std::make_pair(fontSize, Atlas())).first;
+            resetAtlas(i->second, fontSize);
         }
 
-        uint16_t width = 0;
-        uint16_t height = 0;
+        i->second.lastUsed = ++atlasUseCounter;
 
-        int ascent, descent, lineGap;
-        stbtt_GetFontVMetrics(&font,  &ascent, &descent, &lineGap);
+        return i->second;
+    }
+
+    bool TTFont::resetAtlas(Atlas& atlas, float fontSize)
+    {
+        // room for roughly 16 rows of glyphs
+        int glyphSize = static_cast<int>(fontSize) + (sdf ? SDF_PADDING * 2 : 0);
+        uint16_t size = static_cast<uint16_t>(clamp(nextPOT(glyphSize * 16), MIN_ATLAS_SIZE, MAX_ATLAS_SIZE));
 
-        for (uint32_t c : glyphs)
+        atlas.width = size;
+        atlas.height = size;
+        atlas.shelves.clear();
+        atlas.glyphs.clear();
+
+        atlas.pixels.resize(size * size * 4);
+
+        for (size_t pixel = 0; pixel < atlas.pixels.size(); pixel += 4)
         {
-            int w, h, xoff, yoff;
-            if (unsigned char* bitmap = stbtt_GetCodepointBitmap(&font, s, s, static_cast<int>(c), &w, &h, &xoff, &yoff))
-            {
-                int advance, leftBearing;
-                stbtt_GetCodepointHMetrics(&font, static_cast<int>(c), &advance, &leftBearing);
+            atlas.pixels[pixel + 0] = 255;
+            atlas.pixels[pixel + 1] = 255;
+            atlas.pixels[pixel + 2] = 255;
+            atlas.pixels[pixel + 3] = 0;
+        }
 
-                CharDescriptor charDesc;
-                charDesc.width = static_cast<uint16_t>(w);
-                charDesc.height = static_cast<uint16_t>(h);
-                charDesc.offset.x = static_cast<float>(leftBearing * s);
-                charDesc.offset.y = static_cast<float>(yoff + (ascent - descent) * s);
-                charDesc.advance = static_cast<float>(advance * s);
-                charDesc.bitmap = std::vector<uint8_t>(bitmap, bitmap + h * w);
-                charDesc.x = width;
+        // text that was built before keeps the old texture
+        atlas.texture = std::make_shared<graphics::Texture>();
 
-                width += static_cast<uint16_t>(w);
+        // a single level, otherwise every glyph upload would rebuild and upload the whole mipmap chain
+        return atlas.texture->init(atlas.pixels, Size2(size, size), graphics::Texture::DYNAMIC, 1);
+    }
 
-                if (!chars.empty())
-                {
-                    width += SPACING;
-                }
-                height = height > static_cast<uint16_t>(h) ? height : static_cast<uint16_t>(h);
+    bool TTFont::packGlyph(Atlas& atlas, uint16_t width, uint16_t height, uint16_t& x, uint16_t& y)
+    {
+        uint16_t paddedWidth = width + SPACING;
+        uint16_t paddedHeight = height + SPACING;
+
+        if (paddedWidth > atlas.width || paddedHeight > atlas.height)
+        {
+            return false;
+        }
 
-                chars[c] = charDesc;
+        // find the lowest shelf the glyph fits in
+        Shelf* bestShelf = nullptr;
 
-                stbtt_FreeBitmap(bitmap, nullptr);
+        for (Shelf& shelf : atlas.shelves)
+        {
+            if (shelf.height >= paddedHeight &&
+                atlas.width - shelf.x >= paddedWidth &&
+                (!bestShelf || shelf.height < bestShelf->height))
+            {
+                bestShelf = &shelf;
             }
         }
 
-        std::vector<uint8_t> textureData(width * height * 4);
-
-        for (uint16_t posX = 0; posX < width; ++posX)
+        if (!bestShelf)
         {
-            for (uint16_t posY = 0; posY < height; ++posY)
+            uint16_t top = atlas.shelves.empty() ? 0 : atlas.shelves.back().y + atlas.shelves.back().height;
+
+            if (atlas.height - top < paddedHeight)
             {
-                textureData[(posY * width + posX) * 4 + 0] = 255;
-                textureData[(posY * width + posX) * 4 + 1] = 255;
-                textureData[(posY * width + posX) * 4 + 2] = 255;
-                textureData[(posY * width + posX) * 4 + 3] = 0;
+                return false;
             }
+
+            Shelf shelf;
+            shelf.y = top;
+            shelf.height = paddedHeight;
+            atlas.shelves.push_back(shelf);
+
+            bestShelf = &atlas.shelves.back();
+        }
+
+        x = bestShelf->x;
+        y = bestShelf->y;
+        bestShelf->x += paddedWidth;
+
+        return true;
+    }
+
+    bool TTFont::addGlyph(Atlas& atlas, uint32_t character, float scale, int ascent, int descent,
+                          uint16_t& dirtyLeft, uint16_t& dirtyTop, uint16_t& dirtyRight, uint16_t& dirtyBottom)
+    {
+        int advance, leftBearing;
+        stbtt_GetCodepointHMetrics(&font, static_cast<int>(character), &advance, &leftBearing);
+
+        AtlasGlyph glyph;
+        glyph.offset.x = static_cast<float>(leftBearing * scale) - (sdf ? SDF_PADDING : 0);
+        glyph.advance = static_cast<float>(advance * scale);
+
+        int w, h, xoff, yoff;
+        unsigned char* bitmap;
+
+        if (sdf)
+        {
+            // distance of SDF_PADDING pixels maps to the full range from the edge value
+            bitmap = stbtt_GetCodepointSDF(&font, scale, static_cast<int>(character), SDF_PADDING,
+                                           SDF_ON_EDGE, static_cast<float>(SDF_ON_EDGE) / SDF_PADDING,
+                                           &w, &h, &xoff, &yoff);
+        }
+        else
+        {
+            bitmap = stbtt_GetCodepointBitmap(&font, scale, scale, static_cast<int>(character), &w, &h, &xoff, &yoff);
         }
 
-        for (auto& c : chars)
+        if (bitmap)
         {
-            CharDescriptor& charDesc = c.second;
+            if (!packGlyph(atlas, static_cast<uint16_t>(w), static_cast<uint16_t>(h), glyph.x, glyph.y))
+            {
+                if (sdf) stbtt_FreeSDF(bitmap, nullptr);
+                else stbtt_FreeBitmap(bitmap, nullptr);
+                return false;
+            }
 
-            for (uint16_t posX = 0; posX < charDesc.width; ++posX)
+            glyph.width = static_cast<uint16_t>(w);
+            glyph.height = static_cast<uint16_t>(h);
+
+            for (uint16_t posY = 0; posY < glyph.height; ++posY)
             {
-                for (uint16_t posY = 0; posY < charDesc.height; ++posY)
+                for (uint16_t posX = 0; posX < glyph.width; ++posX)
                 {
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 0] = 255;
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 1] = 255;
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 2] = 255;
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 3] = charDesc.bitmap[posY * charDesc.width + posX];
+                    atlas.pixels[((glyph.y + posY) * atlas.width + glyph.x + posX) * 4 + 3] = bitmap[posY * glyph.width + posX];
                 }
             }
+
+            if (sdf) stbtt_FreeSDF(bitmap, nullptr);
+            else stbtt_FreeBitmap(bitmap, nullptr);
+
+            if (glyph.x < dirtyLeft) dirtyLeft = glyph.x;
+            if (glyph.y < dirtyTop) dirtyTop = glyph.y;
+            if (glyph.x + glyph.width > dirtyRight) dirtyRight = glyph.x + glyph.width;
+            if (glyph.y + glyph.height > dirtyBottom) dirtyBottom = glyph.y + glyph.height;
+        }
+        else
+        {
+            yoff = 0;
         }
 
-        texture = std::make_shared<graphics::Texture>();
-        texture->init(textureData, Size2(width, height), 0, mipmaps ? 0 : 1);
+        glyph.offset.y = static_cast<float>(yoff + (ascent - descent) * scale);
 
-        Vector2 position;
+        atlas.glyphs[character] = glyph;
 
-        indices.clear();
-        vertices.clear();
+        return true;
+    }
 
-        indices.reserve(utf32Text.size() * 6);
-        vertices.reserve(utf32Text.size() * 4);
+    bool TTFont::prepareGlyphs(const uint32_t* characters, uint32_t count, float fontSize)
+    {
+        float atlasFontSize = getAtlasFontSize(fontSize);
+        Atlas& atlas = getAtlas(atlasFontSize);
 
-        Vector2 textCoords[4];
+        float s = stbtt_ScaleForPixelHeight(&font, atlasFontSize);
 
-        size_t firstChar = 0;
+        int ascent, descent, lineGap;
+        stbtt_GetFontVMetrics(&font,  &ascent, &descent, &lineGap);
+
+        uint16_t dirtyLeft = atlas.width;
+        uint16_t dirtyTop = atlas.height;
+        uint16_t dirtyRight = 0;
+        uint16_t dirtyBottom = 0;
 
-        for (auto i = utf32Text.begin(); i != utf32Text.end(); ++i)
+        // rasterize only the glyphs that are not in the atlas yet
+        for (uint32_t attempt = 0; attempt < 2; ++attempt)
         {
-            std::unordered_map<uint32_t, CharDescriptor>::iterator iter = chars.find(*i);
+            bool full = false;
 
-            if (iter != chars.end())
+            for (uint32_t i = 0; i < count; ++i)
             {
-                const CharDescriptor& f = iter->second;
-
-                uint16_t startIndex = static_cast<uint16_t>(vertices.size());
-                indices.push_back(startIndex + 0);
-                indices.push_back(startIndex + 1);
-                indices.push_back(startIndex + 2);
-
-                indices.push_back(startIndex + 1);
-                indices.push_back(startIndex + 3);
-                indices.push_back(startIndex + 2);
-
-                Vector2 leftTop(f.x / static_cast<float>(width),
-                                f.y / static_cast<float>(height));
-
-                Vector2 rightBottom((f.x + f.width) / static_cast<float>(width),
-                                    (f.y + f.height) / static_cast<float>(height));
-
-                textCoords[0] = Vector2(leftTop.x, rightBottom.y);
-                textCoords[1] = Vector2(rightBottom.x, rightBottom.y);
-                textCoords[2] = Vector2(leftTop.x, leftTop.y);
-                textCoords[3] = Vector2(rightBottom.x, leftTop.y);
-
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.offset.x, -position.y - f.offset.y - f.height, 0.0f),
-                                                       color, textCoords[0]));
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.offset.x + f.width, -position.y - f.offset.y - f.height, 0.0f),
-                                                       color, textCoords[1]));
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.offset.x, -position.y - f.offset.y, 0.0f),
-                                                       color, textCoords[2]));
-                vertices.push_back(graphics::VertexPCT(Vector3(position.x + f.offset.x + f.width, -position.y - f.offset.y, 0.0f),
-                                                       color, textCoords[3]));
-
-                if ((i + 1) != utf32Text.end())
+                uint32_t c = characters[i];
+
+                if (atlas.glyphs.find(c) == atlas.glyphs.end() &&
+                    !addGlyph(atlas, c, s, ascent, descent, dirtyLeft, dirtyTop, dirtyRight, dirtyBottom))
                 {
-                    int kernAdvance = stbtt_GetCodepointKernAdvance(&font,
-                                                                    static_cast<int>(*i),
-                                                                    static_cast<int>(*(i + 1)));
-                    position.x += static_cast<float>(kernAdvance) * s;
+                    full = true;
+                    break;
                 }
-
-                position.x += f.advance;
             }
 
-            if (*i == static_cast<uint32_t>('\n') || // line feed
-                (i + 1) == utf32Text.end()) // end of string
-            {
-                float lineWidth = position.x;
-                position.x = 0.0f;
-                position.y += fontSize + lineGap;
+            if (!full) break;
 
-                for (size_t c = firstChar; c < vertices.size(); ++c)
+            if (attempt == 0)
+            {
+                // evict all glyphs and start over with the ones needed for this text
+                if (!resetAtlas(atlas, atlasFontSize))
                 {
-                    vertices[c].position.x -= lineWidth * anchor.x;
+                    return false;
                 }
 
-                firstChar = vertices.size();
+                invalidateGlyphs();
+
+                dirtyLeft = atlas.width;
+                dirtyTop = atlas.height;
+                dirtyRight = 0;
+                dirtyBottom = 0;
+            }
+            else
+            {
+                Log(Log::Level::WARN) << "Text does not fit in the glyph atlas";
+            }
+        }
+
+        if (dirtyRight > dirtyLeft && dirtyBottom > dirtyTop)
+        {
+            uint16_t regionWidth = dirtyRight - dirtyLeft;
+            uint16_t regionHeight = dirtyBottom - dirtyTop;
+
+            std::vector<uint8_t> regionData(regionWidth * regionHeight * 4);
+
+            for (uint16_t row = 0; row < regionHeight; ++row)
+            {
+                auto rowStart = atlas.pixels.begin() + ((dirtyTop + row) * atlas.width + dirtyLeft) * 4;
+                std::copy(rowStart, rowStart + regionWidth * 4, regionData.begin() + row * regionWidth * 4);
             }
+
+            atlas.texture->setSubData(regionData, Rectangle(dirtyLeft, dirtyTop, regionWidth, regionHeight));
         }
 
-        float textHeight = position.y;
+        return true;
+    }
+
+    bool TTFont::getGlyph(uint32_t character, float fontSize, Glyph& glyph)
+    {
+        float atlasFontSize = getAtlasFontSize(fontSize);
+        auto atlasIterator = atlases.find(atlasFontSize);
+
+        if (atlasIterator == atlases.end())
+        {
+            return false;
+        }
+
+        const Atlas& atlas = atlasIterator->second;
+        auto glyphIterator = atlas.glyphs.find(character);
 
-        for (size_t c = 0; c < vertices.size(); ++c)
+        if (glyphIterator == atlas.glyphs.end())
         {
-            vertices[c].position.y += textHeight * (1.0f - anchor.y);
+            return false;
         }
+
+        const AtlasGlyph& f = glyphIterator->second;
+        float scale = fontSize / atlasFontSize;
+
+        glyph.offset = f.offset * scale;
+        glyph.size = Size2(f.width * scale, f.height * scale);
+        glyph.leftTop = Vector2(f.x / static_cast<float>(atlas.width),
+                                f.y / static_cast<float>(atlas.height));
+        glyph.rightBottom = Vector2((f.x + f.width) / static_cast<float>(atlas.width),
+                                    (f.y + f.height) / static_cast<float>(atlas.height));
+        glyph.advance = f.advance * scale;
+
+        return true;
+    }
+
+    float TTFont::getKerning(uint32_t first, uint32_t second, float fontSize)
+    {
+        int kernAdvance = stbtt_GetCodepointKernAdvance(&font,
+                                                        static_cast<int>(first),
+                                                        static_cast<int>(second));
+
+        return static_cast<float>(kernAdvance) * stbtt_ScaleForPixelHeight(&font, fontSize);
+    }
+
+    float TTFont::getLineHeight(float fontSize)
+    {
+        int ascent, descent, lineGap;
+        stbtt_GetFontVMetrics(&font,  &ascent, &descent, &lineGap);
+
+        return fontSize + static_cast<float>(lineGap) * stbtt_ScaleForPixelHeight(&font, fontSize);
+    }
+
+    std::shared_ptr<graphics::Texture> TTFont::getTexture(float fontSize)
+    {
+        auto i = atlases.find(getAtlasFontSize(fontSize));
+
+        return (i == atlases.end()) ? nullptr : i->second.texture;
     }
 }
@@ -12,25 +12,66 @@ namespace ouzel
     {
     public:
         TTFont();
-        TTFont(const std::string& filename, bool aMipmaps = true);
+        TTFont(const std::string& filename, bool aMipmaps = true, bool aSDF = false);
 
-        bool init(const std::string& filename, bool newMipmaps = true);
-        bool init(const std::vector<uint8_t>& newData, bool newMipmaps = true);
+        // with SDF enabled all font sizes share one distance field atlas,
+        // glyphs are added to the atlases one by one, so they have no mipmaps and the mipmaps argument is ignored
+        bool init(const std::string& filename, bool newMipmaps = true, bool newSDF = false);
+        bool init(const std::vector<uint8_t>& newData, bool newMipmaps = true, bool newSDF = false);
 
-        virtual void getVertices(const std::string& text,
-                                 const Color& color,
-                                 float fontSize,
-                                 const Vector2& anchor,
-                                 std::vector<uint16_t>& indices,
-                                 std::vector<graphics::VertexPCT>& vertices,
-                                 std::shared_ptr<graphics::Texture>& texture) override;
+        virtual bool prepareGlyphs(const uint32_t* characters, uint32_t count, float fontSize) override;
+        virtual bool getGlyph(uint32_t character, float fontSize, Glyph& glyph) override;
+        virtual float getKerning(uint32_t first, uint32_t second, float fontSize) override;
+        virtual float getLineHeight(float fontSize) override;
+        virtual std::shared_ptr<graphics::Texture> getTexture(float fontSize) override;
+
+        virtual bool isSDF() const override { return sdf; }
 
     protected:
+        struct AtlasGlyph
+        {
+            uint16_t x = 0;
+            uint16_t y = 0;
+            uint16_t width = 0;
+            uint16_t height = 0;
+            Vector2 offset;
+            float advance = 0.0f;
+        };
+
+        struct Shelf
+        {
+            uint16_t y = 0;
+            uint16_t height = 0;
+            uint16_t x = 0;
+        };
+
+        // glyphs of a single font size packed on shelves of a dynamic texture
+        struct Atlas
+        {
+            std::shared_ptr<graphics::Texture> texture;
+            uint16_t width = 0;
+            uint16_t height = 0;
+            std::vector<uint8_t> pixels;
+            std::vector<Shelf> shelves;
+            std::unordered_map<uint32_t, AtlasGlyph> glyphs;
+            uint32_t lastUsed = 0;
+        };
+
         int16_t getKerningPair(uint32_t, uint32_t);
         float getStringWidth(const std::string& text);
 
-        bool mipmaps = true;
+        float getAtlasFontSize(float fontSize) const;
+        Atlas& getAtlas(float fontSize);
+        bool resetAtlas(Atlas& atlas, float fontSize);
+        bool addGlyph(Atlas& atlas, uint32_t character, float scale, int ascent, int descent,
+                      uint16_t& dirtyLeft, uint16_t& dirtyTop, uint16_t& dirtyRight, uint16_t& dirtyBottom);
+        bool packGlyph(Atlas& atlas, uint16_t width, uint16_t height, uint16_t& x, uint16_t& y);
+
+        bool sdf = false;
         stbtt_fontinfo font;
         std::vector<unsigned char> data;
+
+        std::unordered_map<float, Atlas> atlases;
+        uint32_t atlasUseCounter = 0;
     };
 }
@@ -0,0 +1,346 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "TextLayout.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    // longer texts are not likely to be repeated
+    static const size_t MAX_CACHED_RUN_LENGTH = 256;
+
+    static bool isSpace(uint32_t character)
+    {
+        return character == ' ' ||
+            character == '\t' ||
+            character == 0x200B || // zero width space
+            character == 0x3000; // ideographic space
+    }
+
+    static bool isIdeographic(uint32_t character)
+    {
+        return (character >= 0x2E80 && character <= 0x9FFF) || // CJK radicals, kana and unified ideographs
+            (character >= 0xF900 && character <= 0xFAFF) || // CJK compatibility ideographs
+            (character >= 0x20000 && character <= 0x2FA1F); // supplementary ideographic plane
+    }
+
+    static bool isBreakAfter(uint32_t character)
+    {
+        return isSpace(character) ||
+            character == '\n' ||
+            character == '-' ||
+            isIdeographic(character);
+    }
+
+    static bool isVisible(const Font::Glyph& glyph)
+    {
+        return glyph.size.width > 0.0f && glyph.size.height > 0.0f;
+    }
+
+    bool TextLayout::update(Font* newFont,
+                            const std::string& text,
+                            float newFontSize,
+                            float newMaxWidth,
+                            const Vector2& newAnchor,
+                            const Color& newColor)
+    {
+        if (!newFont)
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> characters = utf8to32(text);
+
+        std::shared_ptr<const TextRun> previousRun;
+
+        if (run &&
+            newFont == font &&
+            newFontSize == fontSize &&
+            newMaxWidth == maxWidth &&
+            run->generation == newFont->getGeneration())
+        {
+            previousRun = run;
+        }
+
+        bool sameStyle = (newAnchor == anchor && newColor.getIntValue() == color.getIntValue());
+
+        font = newFont;
+        fontSize = newFontSize;
+        maxWidth = newMaxWidth;
+        anchor = newAnchor;
+        color = newColor;
+
+        // glyphs before the word with the first changed character keep their placement
+        uint32_t start = 0;
+
+        if (previousRun)
+        {
+            const std::vector<uint32_t>& previousCharacters = previousRun->characters;
+            size_t length = std::min(previousCharacters.size(), characters.size());
+
+            while (start < length && previousCharacters[start] == characters[start])
+            {
+                ++start;
+            }
+
+            if (start == previousCharacters.size() && start == characters.size())
+            {
+                if (!sameStyle) buildVertices(previousRun, 0);
+                return true;
+            }
+
+            while (start > 0 && !isBreakAfter(characters[start - 1]))
+            {
+                --start;
+            }
+        }
+
+        uint32_t generation = font->getGeneration();
+
+        if (!font->prepareGlyphs(characters.data() + start, static_cast<uint32_t>(characters.size()) - start, fontSize))
+        {
+            return false;
+        }
+
+        if (font->getGeneration() != generation)
+        {
+            // the font has dropped the glyphs of the unchanged part
+            previousRun.reset();
+
+            if (start > 0)
+            {
+                start = 0;
+
+                if (!font->prepareGlyphs(characters.data(), static_cast<uint32_t>(characters.size()), fontSize))
+                {
+                    return false;
+                }
+            }
+        }
+
+        bool cacheable = characters.size() <= MAX_CACHED_RUN_LENGTH;
+        std::string key;
+        std::shared_ptr<const TextRun> newRun;
+
+        if (cacheable)
+        {
+            key.assign(reinterpret_cast<const char*>(&fontSize), sizeof(fontSize));
+            key.append(reinterpret_cast<const char*>(&maxWidth), sizeof(maxWidth));
+            key.append(text);
+
+            newRun = font->getCachedRun(key);
+        }
+
+        if (!newRun)
+        {
+            newRun = shape(characters, previousRun, start);
+
+            if (cacheable) font->cacheRun(key, newRun);
+        }
+
+        run = newRun;
+        texture = font->getTexture(fontSize);
+
+        buildVertices(previousRun, sameStyle ? start : 0);
+
+        return true;
+    }
+
+    bool TextLayout::isOutdated() const
+    {
+        return run && font && run->generation != font->getGeneration();
+    }
+
+    uint32_t TextLayout::getLineCount() const
+    {
+        return run ? static_cast<uint32_t>(run->lineWidths.size()) : 0;
+    }
+
+    std::shared_ptr<TextRun> TextLayout::shape(const std::vector<uint32_t>& characters,
+                                               const std::shared_ptr<const TextRun>& previousRun,
+                                               uint32_t start) const
+    {
+        std::shared_ptr<TextRun> result = std::make_shared<TextRun>();
+        result->characters = characters;
+        result->placements.resize(characters.size());
+        result->lineHeight = font->getLineHeight(fontSize);
+        result->generation = font->getGeneration();
+
+        uint32_t line = 0;
+        uint32_t lineStart = 0;
+        float x = 0.0f;
+
+        if (previousRun && start > 0)
+        {
+            std::copy(previousRun->placements.begin(), previousRun->placements.begin() + start, result->placements.begin());
+
+            const TextRun::Placement& last = previousRun->placements[start - 1];
+            lineStart = start;
+
+            if (characters[start - 1] == '\n')
+            {
+                line = last.line + 1;
+            }
+            else
+            {
+                line = last.line;
+                x = last.x + last.glyph.advance;
+
+                while (lineStart > 0 && previousRun->placements[lineStart - 1].line == line)
+                {
+                    --lineStart;
+                }
+            }
+        }
+
+        // index of the last character a line can start with
+        uint32_t breakIndex = lineStart;
+
+        for (uint32_t i = start; i < characters.size();)
+        {
+            uint32_t character = characters[i];
+            TextRun::Placement& placement = result->placements[i];
+
+            if (character == '\n')
+            {
+                placement.glyph = Font::Glyph();
+                placement.x = x;
+                placement.line = line;
+
+                ++line;
+                x = 0.0f;
+                lineStart = breakIndex = ++i;
+                continue;
+            }
+
+            float position = x;
+
+            if (i > lineStart)
+            {
+                uint32_t previous = characters[i - 1];
+
+                if (isBreakAfter(previous) || isIdeographic(character))
+                {
+                    breakIndex = i;
+                }
+
+                position += font->getKerning(previous, character, fontSize);
+            }
+
+            Font::Glyph glyph;
+            font->getGlyph(character, fontSize, glyph);
+
+            if (maxWidth > 0.0f && i > lineStart && !isSpace(character) &&
+                position + std::max(glyph.advance, glyph.offset.x + glyph.size.width) > maxWidth)
+            {
+                // move the word to the next line or break it if it does not fit on a line
+                if (breakIndex > lineStart) i = breakIndex;
+
+                ++line;
+                x = 0.0f;
+                lineStart = breakIndex = i;
+                continue;
+            }
+
+            placement.glyph = glyph;
+            placement.x = position;
+            placement.line = line;
+
+            x = position + glyph.advance;
+            ++i;
+        }
+
+        if (!characters.empty())
+        {
+            result->lineWidths.resize(result->placements.back().line + 1, 0.0f);
+
+            // trailing spaces do not count to the width of a line
+            for (uint32_t i = 0; i < characters.size(); ++i)
+            {
+                const TextRun::Placement& placement = result->placements[i];
+
+                if (!isSpace(characters[i]) && characters[i] != '\n')
+                {
+                    float right = placement.x + placement.glyph.advance;
+                    if (right > result->lineWidths[placement.line]) result->lineWidths[placement.line] = right;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    void TextLayout::buildVertices(const std::shared_ptr<const TextRun>& previousRun, uint32_t start)
+    {
+        // vertices of the unchanged glyphs can be kept if their lines did not move
+        if (previousRun && start > 0)
+        {
+            if (anchor.y != 1.0f && previousRun->lineWidths.size() != run->lineWidths.size())
+            {
+                start = 0;
+            }
+            else if (anchor.x != 0.0f)
+            {
+                for (uint32_t line = 0; line <= run->placements[start - 1].line; ++line)
+                {
+                    if (previousRun->lineWidths[line] != run->lineWidths[line])
+                    {
+                        start = 0;
+                        break;
+                    }
+                }
+            }
+        }
+        else
+        {
+            start = 0;
+        }
+
+        uint32_t keptGlyphs = 0;
+
+        for (uint32_t i = 0; i < start; ++i)
+        {
+            if (isVisible(run->placements[i].glyph)) ++keptGlyphs;
+        }
+
+        indices.resize(keptGlyphs * 6);
+        vertices.resize(keptGlyphs * 4);
+
+        indices.reserve(run->placements.size() * 6);
+        vertices.reserve(run->placements.size() * 4);
+
+        float top = static_cast<float>(run->lineWidths.size()) * run->lineHeight * (1.0f - anchor.y);
+
+        for (uint32_t i = start; i < run->placements.size(); ++i)
+        {
+            const TextRun::Placement& placement = run->placements[i];
+            const Font::Glyph& glyph = placement.glyph;
+
+            if (!isVisible(glyph)) continue;
+
+            uint32_t startIndex = static_cast<uint32_t>(vertices.size());
+            indices.push_back(startIndex + 0);
+            indices.push_back(startIndex + 1);
+            indices.push_back(startIndex + 2);
+
+            indices.push_back(startIndex + 1);
+            indices.push_back(startIndex + 3);
+            indices.push_back(startIndex + 2);
+
+            float left = placement.x + glyph.offset.x - run->lineWidths[placement.line] * anchor.x;
+            float right = left + glyph.size.width;
+            float glyphTop = top - placement.line * run->lineHeight - glyph.offset.y;
+            float glyphBottom = glyphTop - glyph.size.height;
+
+            vertices.push_back(graphics::VertexPCT(Vector3(left, glyphBottom, 0.0f),
+                                                   color, Vector2(glyph.leftTop.x, glyph.rightBottom.y)));
+            vertices.push_back(graphics::VertexPCT(Vector3(right, glyphBottom, 0.0f),
+                                                   color, Vector2(glyph.rightBottom.x, glyph.rightBottom.y)));
+            vertices.push_back(graphics::VertexPCT(Vector3(left, glyphTop, 0.0f),
+                                                   color, Vector2(glyph.leftTop.x, glyph.leftTop.y)));
+            vertices.push_back(graphics::VertexPCT(Vector3(right, glyphTop, 0.0f),
+                                                   color, Vector2(glyph.rightBottom.x, glyph.leftTop.y)));
+        }
+    }
+}
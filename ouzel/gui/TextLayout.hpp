@@ -0,0 +1,68 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gui/Font.hpp"
+
+namespace ouzel
+{
+    // glyphs of a string placed on lines, shared between the layouts of the same text
+    struct TextRun
+    {
+        struct Placement
+        {
+            Font::Glyph glyph;
+            float x = 0.0f; // pen position on the line
+            uint32_t line = 0;
+        };
+
+        std::vector<uint32_t> characters;
+        std::vector<Placement> placements;
+        std::vector<float> lineWidths;
+        float lineHeight = 0.0f;
+        uint32_t generation = 0;
+    };
+
+    class TextLayout
+    {
+    public:
+        // maxWidth of zero disables word wrapping
+        bool update(Font* newFont,
+                    const std::string& text,
+                    float newFontSize,
+                    float newMaxWidth,
+                    const Vector2& newAnchor,
+                    const Color& newColor);
+
+        // true if the font has invalidated the glyphs used by this layout
+        bool isOutdated() const;
+
+        const std::vector<uint32_t>& getIndices() const { return indices; }
+        const std::vector<graphics::VertexPCT>& getVertices() const { return vertices; }
+        const std::shared_ptr<graphics::Texture>& getTexture() const { return texture; }
+
+        uint32_t getLineCount() const;
+
+    protected:
+        std::shared_ptr<TextRun> shape(const std::vector<uint32_t>& characters,
+                                       const std::shared_ptr<const TextRun>& previousRun,
+                                       uint32_t start) const;
+        void buildVertices(const std::shared_ptr<const TextRun>& previousRun, uint32_t start);
+
+        Font* font = nullptr;
+        float fontSize = 0.0f;
+        float maxWidth = 0.0f;
+        Vector2 anchor;
+        Color color;
+
+        std::shared_ptr<const TextRun> run;
+        std::vector<uint32_t> indices;
+        std::vector<graphics::VertexPCT> vertices;
+        std::shared_ptr<graphics::Texture> texture;
+    };
+}
@@ -1,8 +1,10 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include "Widget.hpp"
 #include "Menu.hpp"
+#include "WidgetCache.hpp"
 
 namespace ouzel
 {
@@ -12,6 +14,73 @@ namespace ouzel
         {
         }
 
+        Widget::~Widget()
+        {
+        }
+
+        void Widget::visit(std::vector<scene::Actor*>& drawQueue,
+                           const Matrix4& newParentTransform,
+                           bool parentTransformDirty,
+                           scene::Camera* camera,
+                           int32_t parentOrder,
+                           bool parentHidden)
+        {
+            // a cached widget inside another cached widget is drawn into the outer cache
+            cacheActive = cache && camera;
+
+            if (!cacheActive)
+            {
+                Actor::visit(drawQueue, newParentTransform, parentTransformDirty, camera, parentOrder, parentHidden);
+                return;
+            }
+
+            // collect the whole tree without culling, this also keeps the transforms up to date for picking
+            std::vector<scene::Actor*>& cacheDrawQueue = cache->getDrawQueue();
+            cacheDrawQueue.clear();
+
+            Actor::visit(cacheDrawQueue, newParentTransform, parentTransformDirty, nullptr, parentOrder, parentHidden);
+
+            std::stable_sort(cacheDrawQueue.begin(), cacheDrawQueue.end(), [](Actor* a, Actor* b) {
+                return a->getWorldOrder() > b->getWorldOrder();
+            });
+
+            if (!worldHidden)
+            {
+                cache->update(getCacheRoot(), camera);
+
+                // the cache did the culling already, the layer only sorts the draw queue
+                if (cache->checkVisibility(camera))
+                {
+                    drawQueue.push_back(this);
+                }
+            }
+        }
+
+        void Widget::draw(scene::Camera* camera, bool wireframe)
+        {
+            if (cacheActive)
+            {
+                cache->draw(this, camera, wireframe);
+            }
+            else
+            {
+                Actor::draw(camera, wireframe);
+            }
+        }
+
+        void Widget::setCached(bool newCached)
+        {
+            if (newCached && !cache)
+            {
+                cache.reset(new WidgetCache());
+            }
+            else if (!newCached)
+            {
+                cache.reset();
+                cacheActive = false;
+            }
+        }
+
         void Widget::setEnabled(bool newEnabled)
         {
             enabled = newEnabled;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include "scene/Actor.hpp"
 
 namespace ouzel
@@ -10,12 +11,25 @@ namespace ouzel
     namespace gui
     {
         class Menu;
+        class WidgetCache;
 
         class Widget: public scene::Actor
         {
             friend Menu;
         public:
             Widget();
+            virtual ~Widget();
+
+            virtual void visit(std::vector<scene::Actor*>& drawQueue,
+                               const Matrix4& newParentTransform,
+                               bool parentTransformDirty,
+                               scene::Camera* camera,
+                               int32_t parentOrder,
+                               bool parentHidden) override;
+            virtual void draw(scene::Camera* camera, bool wireframe) override;
+
+            // a cached widget culls itself by the bounds of the cache
+            virtual bool isCullDisabled() const override { return cacheActive || Actor::isCullDisabled(); }
 
             Menu* getMenu() const { return menu; }
 
@@ -24,12 +38,22 @@ namespace ouzel
 
             bool isSelected() const { return selected; }
 
+            // draws the widget and its children from a texture that is updated only where something has changed
+            void setCached(bool newCached);
+            bool isCached() const { return cache != nullptr; }
+
         protected:
             virtual void setSelected(bool newSelected);
 
+            // actor in whose space the cache is kept
+            virtual scene::Actor* getCacheRoot() { return this; }
+
             Menu* menu = nullptr;
             bool enabled = true;
             bool selected = false;
+
+            std::unique_ptr<WidgetCache> cache;
+            bool cacheActive = false;
         };
     } // namespace gui
 } // namespace ouzel
@@ -0,0 +1,434 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include "WidgetCache.hpp"
+#include "core/Engine.hpp"
+#include "graphics/Renderer.hpp"
+#include "graphics/Vertex.hpp"
+#include "scene/Layer.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    namespace gui
+    {
+        static Rectangle getRegion(const Matrix4& transform, const Box3& boundingBox)
+        {
+            Vector3 corners[] = {
+                Vector3(boundingBox.min.x, boundingBox.min.y, 0.0f),
+                Vector3(boundingBox.max.x, boundingBox.min.y, 0.0f),
+                Vector3(boundingBox.min.x, boundingBox.max.y, 0.0f),
+                Vector3(boundingBox.max.x, boundingBox.max.y, 0.0f)
+            };
+
+            transform.transformPoints(corners, corners, 4);
+
+            Box3 region;
+            region.insertPoints(corners, 4);
+
+            return Rectangle(region.min.x, region.min.y, region.max.x - region.min.x, region.max.y - region.min.y);
+        }
+
+        static Rectangle merge(const Rectangle& a, const Rectangle& b)
+        {
+            float left = std::min(a.left(), b.left());
+            float bottom = std::min(a.bottom(), b.bottom());
+
+            return Rectangle(left, bottom,
+                             std::max(a.right(), b.right()) - left,
+                             std::max(a.top(), b.top()) - bottom);
+        }
+
+        static bool intersect(const Rectangle& a, const Rectangle& b, Rectangle& result)
+        {
+            float left = std::max(a.left(), b.left());
+            float bottom = std::max(a.bottom(), b.bottom());
+            float right = std::min(a.right(), b.right());
+            float top = std::min(a.top(), b.top());
+
+            if (right <= left || top <= bottom) return false;
+
+            result = Rectangle(left, bottom, right - left, top - bottom);
+            return true;
+        }
+
+        // transforms relative to the root are recalculated every frame, so ignore the rounding errors
+        static bool transformsEqual(const Matrix4& a, const Matrix4& b)
+        {
+            for (size_t i = 0; i < 16; ++i)
+            {
+                if (fabsf(a.m[i] - b.m[i]) > 0.001f * (1.0f + fabsf(a.m[i])))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        WidgetCache::WidgetCache()
+        {
+            cameraActor.addComponent(&camera);
+
+            shader = sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE);
+            noBlendState = sharedEngine->getCache()->getBlendState(graphics::BLEND_NO_BLEND);
+            whitePixelTexture = sharedEngine->getCache()->getTexture(graphics::TEXTURE_WHITE_PIXEL);
+
+            // the actors are drawn into the cache with BLEND_ALPHA, so it holds colors already multiplied by alpha
+            premultipliedBlendState = std::make_shared<graphics::BlendState>();
+            premultipliedBlendState->init(true,
+                                          graphics::BlendState::BlendFactor::ONE, graphics::BlendState::BlendFactor::INV_SRC_ALPHA,
+                                          graphics::BlendState::BlendOperation::ADD,
+                                          graphics::BlendState::BlendFactor::ONE, graphics::BlendState::BlendFactor::INV_SRC_ALPHA,
+                                          graphics::BlendState::BlendOperation::ADD);
+
+            // first quad clears the dirty region, second one composites the cache
+            const uint16_t indices[] = {0, 1, 2, 1, 3, 2, 4, 5, 6, 5, 7, 6};
+
+            indexBuffer = std::make_shared<graphics::Buffer>();
+            indexBuffer->init(graphics::Buffer::Usage::INDEX, indices, static_cast<uint32_t>(sizeof(indices)));
+
+            vertexBuffer = std::make_shared<graphics::Buffer>();
+            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, graphics::Buffer::DYNAMIC);
+
+            meshBuffer = std::make_shared<graphics::MeshBuffer>();
+            meshBuffer->init(sizeof(uint16_t), indexBuffer, graphics::VertexPCT::ATTRIBUTES, vertexBuffer);
+        }
+
+        void WidgetCache::setClipRectangle(const Rectangle& newClipRectangle)
+        {
+            clipRectangle = newClipRectangle;
+            clipped = true;
+        }
+
+        void WidgetCache::update(scene::Actor* newRoot, scene::Camera* renderCamera)
+        {
+            if (root != newRoot)
+            {
+                root = newRoot;
+                valid = false;
+            }
+
+            const Matrix4& rootTransform = root->getTransform();
+            const Matrix4& rootInverseTransform = root->getInverseTransform();
+
+            entries.clear();
+
+            Rectangle newBounds;
+            bool hasBounds = false;
+
+            for (scene::Actor* actor : drawQueue)
+            {
+                Entry entry;
+                entry.actor = actor;
+                entry.revision = actor->getRevision();
+                entry.worldOrder = actor->getWorldOrder();
+                entry.transform = rootInverseTransform * actor->getTransform();
+
+                // actors with culling disabled may have no bounding box
+                Box3 boundingBox = actor->getBoundingBox();
+
+                if (boundingBox.isEmpty())
+                {
+                    entry.region = Rectangle();
+                }
+                else
+                {
+                    entry.region = getRegion(entry.transform, boundingBox);
+
+                    newBounds = hasBounds ? merge(newBounds, entry.region) : entry.region;
+                    hasBounds = true;
+                }
+
+                entries.push_back(entry);
+            }
+
+            if (!hasBounds)
+            {
+                // nothing to draw, stale pixels are cleared when something appears again
+                if (valid)
+                {
+                    for (const Entry& entry : previousEntries)
+                    {
+                        addDirtyRegion(entry.region);
+                    }
+                }
+
+                previousEntries.clear();
+                return;
+            }
+
+            float newPixelScale = renderCamera->getContentScale().x * Vector2(rootTransform.m[0], rootTransform.m[1]).length();
+
+            float maxSide = std::max(newBounds.size.width, newBounds.size.height);
+            if (maxSide * newPixelScale + 2.0f > static_cast<float>(MAX_SIZE))
+            {
+                newPixelScale = (static_cast<float>(MAX_SIZE) - 2.0f) / maxSide;
+            }
+
+            // keep the texture as long as the content fits in it and does not occupy only a small part of it
+            if (!valid ||
+                fabsf(newPixelScale - pixelScale) > 0.001f * pixelScale ||
+                newBounds.left() < bounds.left() || newBounds.right() > bounds.right() ||
+                newBounds.bottom() < bounds.bottom() || newBounds.top() > bounds.top() ||
+                (newBounds.size.width * newPixelScale + 2.0f) * (newBounds.size.height * newPixelScale + 2.0f) * 4.0f < static_cast<float>(width * height))
+            {
+                pixelScale = newPixelScale;
+
+                // align to texels and leave a one texel border to absorb the rounding errors
+                float left = floorf(newBounds.left() * pixelScale) - 1.0f;
+                float bottom = floorf(newBounds.bottom() * pixelScale) - 1.0f;
+                float right = ceilf(newBounds.right() * pixelScale) + 1.0f;
+                float top = ceilf(newBounds.top() * pixelScale) + 1.0f;
+
+                bounds = Rectangle(left / pixelScale, bottom / pixelScale,
+                                   (right - left) / pixelScale, (top - bottom) / pixelScale);
+
+                uint32_t newWidth = static_cast<uint32_t>(right - left);
+                uint32_t newHeight = static_cast<uint32_t>(top - bottom);
+
+                if (!texture || newWidth != width || newHeight != height)
+                {
+                    width = newWidth;
+                    height = newHeight;
+
+                    texture = std::make_shared<graphics::Texture>();
+                    texture->init(Size2(static_cast<float>(width), static_cast<float>(height)), graphics::Texture::RENDER_TARGET);
+                    // only the dirty region is cleared, with a quad
+                    texture->setClearColorBuffer(false);
+
+                    camera.setRenderTarget(texture);
+                }
+
+                valid = true;
+                dirty = true;
+                dirtyRegion = bounds;
+            }
+            else
+            {
+                previousIndices.clear();
+                for (size_t i = 0; i < previousEntries.size(); ++i)
+                {
+                    previousIndices[previousEntries[i].actor] = i;
+                }
+
+                matched.assign(previousEntries.size(), false);
+
+                for (const Entry& entry : entries)
+                {
+                    auto i = previousIndices.find(entry.actor);
+
+                    if (i == previousIndices.end())
+                    {
+                        addDirtyRegion(entry.region);
+                    }
+                    else
+                    {
+                        const Entry& previousEntry = previousEntries[i->second];
+                        matched[i->second] = true;
+
+                        if (previousEntry.revision != entry.revision ||
+                            previousEntry.worldOrder != entry.worldOrder ||
+                            !transformsEqual(previousEntry.transform, entry.transform))
+                        {
+                            addDirtyRegion(previousEntry.region);
+                            addDirtyRegion(entry.region);
+                        }
+                    }
+                }
+
+                for (size_t i = 0; i < previousEntries.size(); ++i)
+                {
+                    if (!matched[i])
+                    {
+                        addDirtyRegion(previousEntries[i].region);
+                    }
+                }
+            }
+
+            std::swap(entries, previousEntries);
+        }
+
+        void WidgetCache::addDirtyRegion(const Rectangle& region)
+        {
+            dirtyRegion = dirty ? merge(dirtyRegion, region) : region;
+            dirty = true;
+        }
+
+        Rectangle WidgetCache::getVisibleRegion() const
+        {
+            Rectangle result;
+
+            if (!clipped)
+            {
+                result = bounds;
+            }
+            else if (!intersect(bounds, clipRectangle, result))
+            {
+                result = Rectangle();
+            }
+
+            return result;
+        }
+
+        bool WidgetCache::checkVisibility(scene::Camera* renderCamera) const
+        {
+            if (!valid || previousEntries.empty()) return false;
+
+            Rectangle visibleRegion = getVisibleRegion();
+            if (visibleRegion.isEmpty()) return false;
+
+            Box3 boundingBox(Vector3(visibleRegion.left(), visibleRegion.bottom(), 0.0f),
+                             Vector3(visibleRegion.right(), visibleRegion.top(), 0.0f));
+
+            return renderCamera->checkVisibility(root->getTransform(), boundingBox);
+        }
+
+        void WidgetCache::draw(scene::Actor* owner, scene::Camera* renderCamera, bool wireframe)
+        {
+            if (wireframe)
+            {
+                // show the actual actors instead of the cache
+                for (scene::Actor* actor : drawQueue)
+                {
+                    if (actor == owner) owner->scene::Actor::draw(renderCamera, true);
+                    else actor->draw(renderCamera, true);
+                }
+
+                return;
+            }
+
+            if (!valid || previousEntries.empty()) return;
+
+            // instances batched by the layer so far are drawn before the cache
+            scene::InstanceBatcher* instanceBatcher = owner->getLayer() ? owner->getLayer()->getInstanceBatcher() : nullptr;
+            if (instanceBatcher) instanceBatcher->flush();
+
+            const Matrix4& rootTransform = root->getTransform();
+
+            Rectangle clearRegion;
+            bool clear = false;
+
+            if (dirty)
+            {
+                dirty = false;
+
+                // round the dirty region out to whole texels, measured from the top left corner
+                float x0 = std::max(floorf((dirtyRegion.left() - bounds.left()) * pixelScale), 0.0f);
+                float x1 = std::min(ceilf((dirtyRegion.right() - bounds.left()) * pixelScale), static_cast<float>(width));
+                float y0 = std::max(floorf((bounds.top() - dirtyRegion.top()) * pixelScale), 0.0f);
+                float y1 = std::min(ceilf((bounds.top() - dirtyRegion.bottom()) * pixelScale), static_cast<float>(height));
+
+                if (x1 > x0 && y1 > y0)
+                {
+                    clear = true;
+                    clearRegion = Rectangle(bounds.left() + x0 / pixelScale,
+                                            bounds.top() - y1 / pixelScale,
+                                            (x1 - x0) / pixelScale,
+                                            (y1 - y0) / pixelScale);
+
+                    camera.setViewport(Rectangle(x0 / width, y0 / height,
+                                                 (x1 - x0) / width, (y1 - y0) / height));
+
+                    Matrix4 projection;
+                    Matrix4::createOrthographicOffCenter(clearRegion.left(), clearRegion.right(),
+                                                         clearRegion.bottom(), clearRegion.top(),
+                                                         -1.0f, 1.0f, projection);
+
+                    camera.setProjection(projection * root->getInverseTransform());
+
+                    vertices[0] = graphics::VertexPCT(Vector3(clearRegion.left(), clearRegion.bottom(), 0.0f), Color::WHITE, Vector2(0.0f, 1.0f));
+                    vertices[1] = graphics::VertexPCT(Vector3(clearRegion.right(), clearRegion.bottom(), 0.0f), Color::WHITE, Vector2(1.0f, 1.0f));
+                    vertices[2] = graphics::VertexPCT(Vector3(clearRegion.left(), clearRegion.top(), 0.0f), Color::WHITE, Vector2(0.0f, 0.0f));
+                    vertices[3] = graphics::VertexPCT(Vector3(clearRegion.right(), clearRegion.top(), 0.0f), Color::WHITE, Vector2(1.0f, 0.0f));
+                }
+            }
+
+            Rectangle visibleRegion = getVisibleRegion();
+
+            float u0 = (visibleRegion.left() - bounds.left()) / bounds.size.width;
+            float u1 = (visibleRegion.right() - bounds.left()) / bounds.size.width;
+            float v0 = (bounds.top() - visibleRegion.top()) / bounds.size.height;
+            float v1 = (bounds.top() - visibleRegion.bottom()) / bounds.size.height;
+
+            vertices[4] = graphics::VertexPCT(Vector3(visibleRegion.left(), visibleRegion.bottom(), 0.0f), Color::WHITE, Vector2(u0, v1));
+            vertices[5] = graphics::VertexPCT(Vector3(visibleRegion.right(), visibleRegion.bottom(), 0.0f), Color::WHITE, Vector2(u1, v1));
+            vertices[6] = graphics::VertexPCT(Vector3(visibleRegion.left(), visibleRegion.top(), 0.0f), Color::WHITE, Vector2(u0, v0));
+            vertices[7] = graphics::VertexPCT(Vector3(visibleRegion.right(), visibleRegion.top(), 0.0f), Color::WHITE, Vector2(u1, v0));
+
+            vertexBuffer->setData(vertices, static_cast<uint32_t>(sizeof(vertices)));
+
+            if (clear)
+            {
+                Matrix4 modelViewProj = camera.getRenderViewProjection() * rootTransform;
+                float colorVector[] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+                std::vector<std::vector<float>> pixelShaderConstants(1);
+                pixelShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
+
+                std::vector<std::vector<float>> vertexShaderConstants(1);
+                vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
+
+                sharedEngine->getRenderer()->addDrawCommand({whitePixelTexture},
+                                                            shader,
+                                                            pixelShaderConstants,
+                                                            vertexShaderConstants,
+                                                            noBlendState,
+                                                            meshBuffer,
+                                                            6,
+                                                            graphics::Renderer::DrawMode::TRIANGLE_LIST,
+                                                            0,
+                                                            texture,
+                                                            camera.getRenderViewport(),
+                                                            false,
+                                                            false,
+                                                            false,
+                                                            false,
+                                                            Rectangle(),
+                                                            graphics::Renderer::CullMode::NONE);
+
+                // redraw everything that overlaps the cleared region, in the original order
+                for (const Entry& entry : previousEntries)
+                {
+                    if (entry.region.intersects(clearRegion))
+                    {
+                        if (entry.actor == owner) owner->scene::Actor::draw(&camera, false);
+                        else entry.actor->draw(&camera, false);
+                    }
+                }
+            }
+
+            // the redrawn actors have to be in the texture before it is composited
+            if (instanceBatcher) instanceBatcher->flush();
+
+            Matrix4 modelViewProj = renderCamera->getRenderViewProjection() * rootTransform;
+            float colorVector[] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+            std::vector<std::vector<float>> pixelShaderConstants(1);
+            pixelShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
+
+            std::vector<std::vector<float>> vertexShaderConstants(1);
+            vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
+
+            sharedEngine->getRenderer()->addDrawCommand({texture},
+                                                        shader,
+                                                        pixelShaderConstants,
+                                                        vertexShaderConstants,
+                                                        premultipliedBlendState,
+                                                        meshBuffer,
+                                                        6,
+                                                        graphics::Renderer::DrawMode::TRIANGLE_LIST,
+                                                        6,
+                                                        renderCamera->getRenderTarget(),
+                                                        renderCamera->getRenderViewport(),
+                                                        renderCamera->getDepthWrite(),
+                                                        renderCamera->getDepthTest(),
+                                                        false,
+                                                        false,
+                                                        Rectangle(),
+                                                        graphics::Renderer::CullMode::NONE);
+        }
+    } // namespace gui
+} // namespace ouzel
@@ -0,0 +1,94 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "utils/Noncopyable.hpp"
+#include "scene/Actor.hpp"
+#include "scene/Camera.hpp"
+#include "math/Matrix4.hpp"
+#include "math/Rectangle.hpp"
+#include "graphics/BlendState.hpp"
+#include "graphics/Buffer.hpp"
+#include "graphics/MeshBuffer.hpp"
+#include "graphics/Shader.hpp"
+#include "graphics/Texture.hpp"
+#include "graphics/Vertex.hpp"
+
+namespace ouzel
+{
+    namespace gui
+    {
+        // Keeps a tree of actors rendered in a texture, redraws only the regions that have changed
+        // and composites the result with a single draw call
+        class WidgetCache: public Noncopyable
+        {
+        public:
+            static const uint32_t MAX_SIZE = 2048;
+
+            WidgetCache();
+
+            std::vector<scene::Actor*>& getDrawQueue() { return drawQueue; }
+
+            // compares the draw queue with the previous one, the texture is kept in the space of the root actor
+            void update(scene::Actor* newRoot, scene::Camera* renderCamera);
+            bool checkVisibility(scene::Camera* renderCamera) const;
+            void draw(scene::Actor* owner, scene::Camera* renderCamera, bool wireframe);
+
+            // only the part of the cache inside the clip rectangle (in root space) is drawn
+            void setClipRectangle(const Rectangle& newClipRectangle);
+            void removeClipRectangle() { clipped = false; }
+
+            void invalidate() { valid = false; }
+
+        protected:
+            struct Entry
+            {
+                scene::Actor* actor;
+                uint32_t revision;
+                int32_t worldOrder;
+                Matrix4 transform;
+                Rectangle region;
+            };
+
+            void addDirtyRegion(const Rectangle& region);
+            Rectangle getVisibleRegion() const;
+
+            scene::Actor* root = nullptr;
+            std::vector<scene::Actor*> drawQueue;
+            std::vector<Entry> entries;
+            std::vector<Entry> previousEntries;
+            std::unordered_map<scene::Actor*, size_t> previousIndices;
+            std::vector<bool> matched;
+
+            bool valid = false;
+            float pixelScale = 0.0f;
+            Rectangle bounds;
+            uint32_t width = 0;
+            uint32_t height = 0;
+
+            bool dirty = false;
+            Rectangle dirtyRegion;
+
+            bool clipped = false;
+            Rectangle clipRectangle;
+
+            std::shared_ptr<graphics::Texture> texture;
+            scene::Actor cameraActor;
+            scene::Camera camera;
+
+            std::shared_ptr<graphics::Shader> shader;
+            std::shared_ptr<graphics::BlendState> noBlendState;
+            std::shared_ptr<graphics::BlendState> premultipliedBlendState;
+            std::shared_ptr<graphics::Texture> whitePixelTexture;
+            std::shared_ptr<graphics::Buffer> indexBuffer;
+            std::shared_ptr<graphics::Buffer> vertexBuffer;
+            std::shared_ptr<graphics::MeshBuffer> meshBuffer;
+            // clear quad followed by the composite quad, kept between draws because the buffer is uploaded once per frame
+            graphics::VertexPCT vertices[8];
+        };
+    } // namespace gui
+} // namespace ouzel
@@ -13,7 +13,8 @@ namespace ouzel
 {
     namespace input
     {
-        Input::Input()
+        Input::Input():
+            sampleHistoryEnabled(false)
         {
             std::fill(std::begin(keyboardKeyStates), std::end(keyboardKeyStates), false);
             std::fill(std::begin(mouseButtonStates), std::end(mouseButtonStates), false);
@@ -192,6 +193,16 @@ namespace ouzel
 
             cursorPosition = position;
 
+            if (sampleHistoryEnabled)
+            {
+                InputSample sample;
+                sample.type = InputSample::Type::MOUSE_MOVE;
+                sample.position = position;
+                sample.difference = event.mouseEvent.difference;
+                sample.modifiers = modifiers;
+                addSample(sample);
+            }
+
             sharedEngine->getEventDispatcher()->postEvent(event);
         }
 
@@ -214,6 +225,16 @@ namespace ouzel
             event.mouseEvent.scroll = scroll;
             event.mouseEvent.modifiers = modifiers;
 
+            if (sampleHistoryEnabled)
+            {
+                InputSample sample;
+                sample.type = InputSample::Type::MOUSE_SCROLL;
+                sample.position = position;
+                sample.scroll = scroll;
+                sample.modifiers = modifiers;
+                addSample(sample);
+            }
+
             sharedEngine->getEventDispatcher()->postEvent(event);
         }
 
@@ -262,6 +283,17 @@ namespace ouzel
 
             touchPositions[touchId] = position;
 
+            if (sampleHistoryEnabled)
+            {
+                InputSample sample;
+                sample.type = InputSample::Type::TOUCH_MOVE;
+                sample.touchId = touchId;
+                sample.position = position;
+                sample.difference = event.touchEvent.difference;
+                sample.force = force;
+                addSample(sample);
+            }
+
             sharedEngine->getEventDispatcher()->postEvent(event);
         }
 
@@ -284,6 +316,35 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->postEvent(event);
         }
 
+        void Input::setSampleHistoryEnabled(bool enabled)
+        {
+            sampleHistoryEnabled = enabled;
+
+            if (!enabled)
+            {
+                std::lock_guard<std::mutex> lock(sampleMutex);
+                samples.clear();
+            }
+        }
+
+        void Input::getSamples(std::vector<InputSample>& result)
+        {
+            std::lock_guard<std::mutex> lock(sampleMutex);
+
+            result.assign(samples.begin(), samples.end());
+            samples.clear();
+        }
+
+        void Input::addSample(const InputSample& sample)
+        {
+            std::lock_guard<std::mutex> lock(sampleMutex);
+
+            if (samples.size() >= MAX_SAMPLES) samples.pop_front();
+
+            samples.push_back(sample);
+            samples.back().time = std::chrono::steady_clock::now();
+        }
+
         bool Input::showVirtualKeyboard()
         {
             return false;
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -217,6 +220,26 @@ namespace ouzel
 
         class Gamepad;
 
+        // mouse or touch sample as it was received, before the events of a frame were coalesced
+        struct InputSample
+        {
+            enum class Type
+            {
+                MOUSE_MOVE,
+                MOUSE_SCROLL,
+                TOUCH_MOVE
+            };
+
+            Type type;
+            uint64_t touchId = 0;
+            Vector2 position;
+            Vector2 difference;
+            Vector2 scroll;
+            float force = 1.0f;
+            uint32_t modifiers = 0;
+            std::chrono::steady_clock::time_point time;
+        };
+
         class Input: public Noncopyable
         {
             friend Engine;
@@ -268,6 +291,14 @@ namespace ouzel
             virtual bool showVirtualKeyboard();
             virtual bool hideVirtualKeyboard();
 
+            static const uint32_t MAX_SAMPLES = 4096; // the oldest samples are dropped if they are not taken
+
+            // records every move and scroll sample, for gameplay that needs more than the coalesced events
+            void setSampleHistoryEnabled(bool enabled);
+            bool isSampleHistoryEnabled() const { return sampleHistoryEnabled; }
+            // moves the samples received since the previous call to the vector, oldest first
+            void getSamples(std::vector<InputSample>& result);
+
         protected:
             Input();
             virtual bool init();
@@ -276,6 +307,7 @@ namespace ouzel
             virtual void activateCursorResource(CursorResource* resource);
             virtual CursorResource* createCursorResource();
             void deleteCursorResource(CursorResource* resource);
+            void addSample(const InputSample& sample);
 
             Vector2 cursorPosition;
             bool keyboardKeyStates[static_cast<uint32_t>(KeyboardKey::KEY_COUNT)];
@@ -288,6 +320,10 @@ namespace ouzel
             std::vector<std::unique_ptr<CursorResource>> resources;
             std::vector<std::unique_ptr<CursorResource>> resourceDeleteSet;
             CursorResource* currentCursorResource = nullptr;
+
+            std::atomic<bool> sampleHistoryEnabled;
+            std::mutex sampleMutex;
+            std::deque<InputSample> samples;
         };
     } // namespace input
 } // namespace ouzel
@@ -18,7 +18,7 @@ namespace ouzel
             {
                 WindowResourceLinux* windowLinux = static_cast<WindowResourceLinux*>(sharedEngine->getWindow()->getResource());
                 Display* display = windowLinux->getDisplay();
-                if (cursor != None) XFreeCursor(display, cursor);
+                if (display && cursor != None) XFreeCursor(display, cursor);
             }
         }
 
@@ -32,6 +32,9 @@ namespace ouzel
             WindowResourceLinux* windowLinux = static_cast<WindowResourceLinux*>(sharedEngine->getWindow()->getResource());
             Display* display = windowLinux->getDisplay();
 
+            // without an X server (software renderer) there are no native cursors
+            if (!display) return true;
+
             if (cursor != None)
             {
                 XFreeCursor(display, cursor);
@@ -84,6 +87,9 @@ namespace ouzel
             WindowResourceLinux* windowLinux = static_cast<WindowResourceLinux*>(sharedEngine->getWindow()->getResource());
             Display* display = windowLinux->getDisplay();
 
+            // without an X server (software renderer) there are no native cursors
+            if (!display) return true;
+
             if (cursor != None)
             {
                 XFreeCursor(display, cursor);
@@ -1,18 +1,399 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
 #include "GamepadLinux.hpp"
+#include "core/Engine.hpp"
+#include "events/EventDispatcher.hpp"
+#include "utils/Log.hpp"
+
+static const float THUMB_DEADZONE = 0.2f;
+static const uint32_t EVENT_BUFFER_SIZE = 64;
+
+#define BITS_PER_LONG (8 * sizeof(long))
+#define BITS_TO_LONGS(nr) (((nr) + BITS_PER_LONG - 1) / BITS_PER_LONG)
+
+static inline bool isBitSet(const unsigned long* array, int bit)
+{
+    return (array[bit / BITS_PER_LONG] & (1LL << (bit % BITS_PER_LONG))) != 0;
+}
 
 namespace ouzel
 {
     namespace input
     {
-        GamepadLinux::GamepadLinux()
+        GamepadLinux::GamepadLinux(const std::string& aDevicePath):
+            devicePath(aDevicePath), active(false)
         {
         }
 
         GamepadLinux::~GamepadLinux()
         {
+            close();
+        }
+
+        bool GamepadLinux::open()
+        {
+            fd = ::open(devicePath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+            if (fd == -1)
+            {
+                return false;
+            }
+
+            unsigned long keyBits[BITS_TO_LONGS(KEY_CNT)];
+            memset(keyBits, 0, sizeof(keyBits));
+
+            if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) == -1 ||
+                (!isBitSet(keyBits, BTN_GAMEPAD) && !isBitSet(keyBits, BTN_JOYSTICK)))
+            {
+                close();
+                return false;
+            }
+
+            char deviceName[256];
+            if (ioctl(fd, EVIOCGNAME(sizeof(deviceName) - 1), deviceName) == -1)
+            {
+                strcpy(deviceName, "Unknown");
+            }
+            deviceName[sizeof(deviceName) - 1] = '\0';
+            name = deviceName;
+
+            input_id id;
+            if (ioctl(fd, EVIOCGID, &id) != -1)
+            {
+                vendorId = id.vendor;
+                productId = id.product;
+            }
+
+            unsigned long absBits[BITS_TO_LONGS(ABS_CNT)];
+            memset(absBits, 0, sizeof(absBits));
+            ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+
+            for (uint32_t code = 0; code < ABS_CNT; ++code)
+            {
+                axes[code] = Axis();
+
+                input_absinfo absInfo;
+                if (isBitSet(absBits, code) && ioctl(fd, EVIOCGABS(code), &absInfo) != -1)
+                {
+                    axes[code].min = absInfo.minimum;
+                    axes[code].max = absInfo.maximum;
+                    axes[code].value = absInfo.value;
+                }
+            }
+
+            dropped = false;
+
+            return true;
+        }
+
+        void GamepadLinux::close()
+        {
+            if (fd != -1)
+            {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        void GamepadLinux::setDefaultAxisRanges()
+        {
+            for (uint32_t code = 0; code < ABS_CNT; ++code)
+            {
+                axes[code] = Axis();
+            }
+
+            axes[ABS_X].min = axes[ABS_Y].min = axes[ABS_RX].min = axes[ABS_RY].min = -32768;
+            axes[ABS_X].max = axes[ABS_Y].max = axes[ABS_RX].max = axes[ABS_RY].max = 32767;
+            axes[ABS_Z].max = axes[ABS_RZ].max = 255;
+            axes[ABS_HAT0X].min = axes[ABS_HAT0Y].min = -1;
+            axes[ABS_HAT0X].max = axes[ABS_HAT0Y].max = 1;
+        }
+
+        bool GamepadLinux::readEvents()
+        {
+            input_event events[EVENT_BUFFER_SIZE];
+
+            for (;;)
+            {
+                ssize_t bytesRead = read(fd, events, sizeof(events));
+
+                if (bytesRead == -1)
+                {
+                    if (errno == EINTR) continue;
+                    // ENODEV is returned after the device has been unplugged
+                    return errno == EAGAIN;
+                }
+
+                if (bytesRead == 0)
+                {
+                    return false;
+                }
+
+                size_t eventCount = static_cast<size_t>(bytesRead) / sizeof(input_event);
+
+                for (size_t i = 0; i < eventCount; ++i)
+                {
+                    handleEvent(events[i]);
+                }
+
+                if (eventCount < EVENT_BUFFER_SIZE)
+                {
+                    return true;
+                }
+            }
+        }
+
+        void GamepadLinux::handleEvent(const input_event& event)
+        {
+            if (event.type == EV_SYN)
+            {
+                if (event.code == SYN_DROPPED)
+                {
+                    dropped = true;
+                }
+                else if (event.code == SYN_REPORT && dropped)
+                {
+                    dropped = false;
+                    synchronize();
+                }
+            }
+            else if (!dropped)
+            {
+                if (event.type == EV_KEY)
+                {
+                    handleButtonChange(event.code, event.value != 0);
+                }
+                else if (event.type == EV_ABS && event.code < ABS_CNT)
+                {
+                    handleAxisChange(event.code, event.value);
+                }
+            }
+        }
+
+        void GamepadLinux::synchronize()
+        {
+            // events after SYN_DROPPED are incomplete, so the current state is read from the device
+            if (fd == -1) return;
+
+            unsigned long keyStates[BITS_TO_LONGS(KEY_CNT)];
+            memset(keyStates, 0, sizeof(keyStates));
+
+            if (ioctl(fd, EVIOCGKEY(sizeof(keyStates)), keyStates) != -1)
+            {
+                for (uint16_t code = BTN_MISC; code < BTN_DIGI; ++code)
+                {
+                    handleButtonChange(code, isBitSet(keyStates, code));
+                }
+
+                for (uint16_t code = BTN_DPAD_UP; code <= BTN_DPAD_RIGHT; ++code)
+                {
+                    handleButtonChange(code, isBitSet(keyStates, code));
+                }
+            }
+
+            for (uint16_t code = 0; code < ABS_CNT; ++code)
+            {
+                input_absinfo absInfo;
+                if (axes[code].min != axes[code].max && ioctl(fd, EVIOCGABS(code), &absInfo) != -1)
+                {
+                    handleAxisChange(code, absInfo.value);
+                }
+            }
+        }
+
+        void GamepadLinux::postButtonChange(GamepadButton button, bool pressed, float value)
+        {
+            ButtonState& buttonState = threadButtonStates[static_cast<uint32_t>(button)];
+
+            Event event;
+            event.type = Event::Type::GAMEPAD_BUTTON_CHANGE;
+
+            event.gamepadEvent.gamepad = this;
+            event.gamepadEvent.button = button;
+            event.gamepadEvent.previousPressed = buttonState.pressed;
+            event.gamepadEvent.pressed = pressed;
+            event.gamepadEvent.value = value;
+            event.gamepadEvent.previousValue = buttonState.value;
+
+            sharedEngine->getEventDispatcher()->postEvent(event);
+
+            buttonState.pressed = pressed;
+            buttonState.value = value;
+        }
+
+        void GamepadLinux::releaseButtons()
+        {
+            for (uint32_t button = 0; button < static_cast<uint32_t>(GamepadButton::BUTTON_COUNT); ++button)
+            {
+                const ButtonState& buttonState = threadButtonStates[button];
+
+                if (buttonState.pressed || buttonState.value != 0.0f)
+                {
+                    postButtonChange(static_cast<GamepadButton>(button), false, 0.0f);
+                }
+            }
+        }
+
+        void GamepadLinux::applyEvent(Event::Type type, const GamepadEvent& event)
+        {
+            switch (type)
+            {
+                case Event::Type::GAMEPAD_CONNECT:
+                    attached = true;
+                    break;
+                case Event::Type::GAMEPAD_DISCONNECT:
+                    attached = false;
+                    break;
+                case Event::Type::GAMEPAD_BUTTON_CHANGE:
+                    buttonStates[static_cast<uint32_t>(event.button)].pressed = event.pressed;
+                    buttonStates[static_cast<uint32_t>(event.button)].value = event.value;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void GamepadLinux::handleButtonChange(uint16_t code, bool pressed)
+        {
+            GamepadButton button;
+
+            switch (code)
+            {
+                case BTN_SOUTH: button = GamepadButton::FACE_BOTTOM; break;
+                case BTN_EAST: button = GamepadButton::FACE_RIGHT; break;
+                case BTN_NORTH: button = GamepadButton::FACE_TOP; break;
+                case BTN_WEST: button = GamepadButton::FACE_LEFT; break;
+                case BTN_TL: button = GamepadButton::LEFT_SHOULDER; break;
+                case BTN_TR: button = GamepadButton::RIGHT_SHOULDER; break;
+                case BTN_TL2: button = GamepadButton::LEFT_TRIGGER; break;
+                case BTN_TR2: button = GamepadButton::RIGHT_TRIGGER; break;
+                case BTN_SELECT: button = GamepadButton::BACK; break;
+                case BTN_START: button = GamepadButton::START; break;
+                case BTN_MODE: button = GamepadButton::PAUSE; break;
+                case BTN_THUMBL: button = GamepadButton::LEFT_THUMB; break;
+                case BTN_THUMBR: button = GamepadButton::RIGHT_THUMB; break;
+                case BTN_DPAD_UP: button = GamepadButton::DPAD_UP; break;
+                case BTN_DPAD_DOWN: button = GamepadButton::DPAD_DOWN; break;
+                case BTN_DPAD_LEFT: button = GamepadButton::DPAD_LEFT; break;
+                case BTN_DPAD_RIGHT: button = GamepadButton::DPAD_RIGHT; break;
+                default: return;
+            }
+
+            if (threadButtonStates[static_cast<uint32_t>(button)].pressed != pressed)
+            {
+                postButtonChange(button, pressed, pressed ? 1.0f : 0.0f);
+            }
+        }
+
+        void GamepadLinux::handleAxisChange(uint16_t code, int32_t value)
+        {
+            Axis& axis = axes[code];
+            int32_t oldValue = axis.value;
+            axis.value = value;
+
+            if (axis.min == axis.max) return;
+
+            switch (code)
+            {
+                case ABS_X:
+                    handleThumbAxisChange(oldValue, value, axis.min, axis.max,
+                                          GamepadButton::LEFT_THUMB_LEFT, GamepadButton::LEFT_THUMB_RIGHT);
+                    break;
+                case ABS_Y:
+                    handleThumbAxisChange(oldValue, value, axis.min, axis.max,
+                                          GamepadButton::LEFT_THUMB_UP, GamepadButton::LEFT_THUMB_DOWN);
+                    break;
+                case ABS_RX:
+                    handleThumbAxisChange(oldValue, value, axis.min, axis.max,
+                                          GamepadButton::RIGHT_THUMB_LEFT, GamepadButton::RIGHT_THUMB_RIGHT);
+                    break;
+                case ABS_RY:
+                    handleThumbAxisChange(oldValue, value, axis.min, axis.max,
+                                          GamepadButton::RIGHT_THUMB_UP, GamepadButton::RIGHT_THUMB_DOWN);
+                    break;
+                case ABS_Z:
+                    handleTriggerChange(oldValue, value, axis.min, axis.max, GamepadButton::LEFT_TRIGGER);
+                    break;
+                case ABS_RZ:
+                    handleTriggerChange(oldValue, value, axis.min, axis.max, GamepadButton::RIGHT_TRIGGER);
+                    break;
+                case ABS_HAT0X:
+                    handleHatChange(oldValue, value, GamepadButton::DPAD_LEFT, GamepadButton::DPAD_RIGHT);
+                    break;
+                case ABS_HAT0Y:
+                    handleHatChange(oldValue, value, GamepadButton::DPAD_UP, GamepadButton::DPAD_DOWN);
+                    break;
+            }
+        }
+
+        void GamepadLinux::handleThumbAxisChange(int32_t oldValue, int32_t newValue,
+                                                 int32_t min, int32_t max,
+                                                 GamepadButton negativeButton, GamepadButton positiveButton)
+        {
+            if (oldValue != newValue)
+            {
+                float floatValue = 2.0f * (newValue - min) / (max - min) - 1.0f;
+
+                if (floatValue > 0.0f)
+                {
+                    postButtonChange(positiveButton,
+                                            floatValue > THUMB_DEADZONE,
+                                            floatValue);
+                }
+                else if (floatValue < 0.0f)
+                {
+                    postButtonChange(negativeButton,
+                                            -floatValue > THUMB_DEADZONE,
+                                            -floatValue);
+                }
+                else // thumbstick is 0
+                {
+                    if (oldValue > newValue)
+                    {
+                        postButtonChange(positiveButton, false, 0.0f);
+                    }
+                    else
+                    {
+                        postButtonChange(negativeButton, false, 0.0f);
+                    }
+                }
+            }
+        }
+
+        void GamepadLinux::handleHatChange(int32_t oldValue, int32_t newValue,
+                                           GamepadButton negativeButton, GamepadButton positiveButton)
+        {
+            // only the directions whose state changed are reported
+            if ((oldValue < 0) != (newValue < 0))
+            {
+                postButtonChange(negativeButton, newValue < 0, newValue < 0 ? 1.0f : 0.0f);
+            }
+
+            if ((oldValue > 0) != (newValue > 0))
+            {
+                postButtonChange(positiveButton, newValue > 0, newValue > 0 ? 1.0f : 0.0f);
+            }
+        }
+
+        void GamepadLinux::handleTriggerChange(int32_t oldValue, int32_t newValue,
+                                               int32_t min, int32_t max,
+                                               GamepadButton button)
+        {
+            if (oldValue != newValue)
+            {
+                // evdev triggers rest at the minimum of the range
+                float floatValue = static_cast<float>(newValue - min) / (max - min);
+
+                postButtonChange(button,
+                                        floatValue > 0.0f,
+                                        floatValue);
+            }
         }
     } // namespace input
 } // namespace ouzel
@@ -3,19 +3,69 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <linux/input.h>
 #include "input/Gamepad.hpp"
 
 namespace ouzel
 {
     namespace input
     {
+        class InputLinux;
+
+        // evdev joystick or gamepad, the events are read by the gamepad thread of InputLinux and the
+        // button states and the attached flag are updated when the posted events are dispatched
         class GamepadLinux: public Gamepad
         {
+            friend InputLinux;
         public:
             virtual ~GamepadLinux();
 
+            const std::string& getDevicePath() const { return devicePath; }
+
         protected:
-            GamepadLinux();
+            GamepadLinux(const std::string& aDevicePath);
+
+            // returns false if the device can not be opened or is not a joystick or a gamepad
+            bool open();
+            void close();
+            // replayed event streams have no device to query, so the usual axis ranges are assumed
+            void setDefaultAxisRanges();
+
+            bool readEvents();
+            void handleEvent(const input_event& event);
+            void synchronize();
+
+            void postButtonChange(GamepadButton button, bool pressed, float value);
+            void releaseButtons();
+            void applyEvent(Event::Type type, const GamepadEvent& event);
+
+            void handleButtonChange(uint16_t code, bool pressed);
+            void handleAxisChange(uint16_t code, int32_t value);
+            void handleThumbAxisChange(int32_t oldValue, int32_t newValue,
+                                       int32_t min, int32_t max,
+                                       GamepadButton negativeButton, GamepadButton positiveButton);
+            void handleHatChange(int32_t oldValue, int32_t newValue,
+                                 GamepadButton negativeButton, GamepadButton positiveButton);
+            void handleTriggerChange(int32_t oldValue, int32_t newValue,
+                                     int32_t min, int32_t max,
+                                     GamepadButton button);
+
+            struct Axis
+            {
+                int32_t min = 0;
+                int32_t max = 0;
+                int32_t value = 0;
+            };
+
+            std::string devicePath;
+            int fd = -1;
+            std::atomic<bool> active; // the device is open or an event stream is being replayed
+            ButtonState threadButtonStates[static_cast<uint32_t>(GamepadButton::BUTTON_COUNT)]; // button states seen by the reading thread
+            Axis axes[ABS_CNT];
+            bool dropped = false; // the kernel buffer overflowed, the state is read again after the next SYN_REPORT
         };
     } // namespace input
 } // namespace ouzel
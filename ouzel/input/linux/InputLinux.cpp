@@ -1,10 +1,21 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <glob.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <X11/cursorfont.h>
 #include <X11/extensions/XInput2.h>
 #include "InputLinux.hpp"
 #include "CursorResourceLinux.hpp"
+#include "GamepadLinux.hpp"
 #include "events/Event.hpp"
 #include "core/Engine.hpp"
 #include "core/linux/WindowResourceLinux.hpp"
@@ -231,8 +242,17 @@ namespace ouzel
             return modifiers;
         }
 
-        InputLinux::InputLinux()
+        static const char* INPUT_DEVICE_DIRECTORY = "/dev/input";
+        static const uint32_t MAX_EPOLL_EVENTS = 16;
+
+        InputLinux::InputLinux():
+            gamepadDiscovery(false), gamepadThreadRunning(false),
+            gamepadStateHandler(EventHandler::PRIORITY_MAX + 1)
         {
+            gamepadStateHandler.gamepadHandler = [](Event::Type type, const GamepadEvent& event) {
+                static_cast<GamepadLinux*>(event.gamepad)->applyEvent(type, event);
+                return true;
+            };
         }
 
         bool InputLinux::init()
@@ -241,60 +261,123 @@ namespace ouzel
             ::Window window = windowLinux->getNativeWindow();
             Display* display = windowLinux->getDisplay();
 
-            char data[1] = {0};
-
-            Pixmap pixmap = XCreateBitmapFromData(display, DefaultRootWindow(display), data, 1, 1);
-            if (pixmap)
+            // there is no X server with the software renderer, only gamepads are read then
+            if (display)
             {
-                XColor color;
-                color.red = color.green = color.blue = 0;
-
-                emptyCursor = XCreatePixmapCursor(display, pixmap, pixmap, &color, &color, 0, 0);
-                XFreePixmap(display, pixmap);
-            }
+                char data[1] = {0};
 
-            int event, err;
-            if (XQueryExtension(display, "XInputExtension", &xInputOpCode, &event, &err))
-            {
-                int majorVersion = 2, minorVersion = 0;
+                Pixmap pixmap = XCreateBitmapFromData(display, DefaultRootWindow(display), data, 1, 1);
+                if (pixmap)
+                {
+                    XColor color;
+                    color.red = color.green = color.blue = 0;
 
-                XIQueryVersion(display, &majorVersion, &minorVersion);
+                    emptyCursor = XCreatePixmapCursor(display, pixmap, pixmap, &color, &color, 0, 0);
+                    XFreePixmap(display, pixmap);
+                }
 
-                if (majorVersion >= 2)
+                int event, err;
+                if (XQueryExtension(display, "XInputExtension", &xInputOpCode, &event, &err))
                 {
-                    unsigned char mask[] = {0, 0 ,0};
+                    int majorVersion = 2, minorVersion = 0;
+
+                    XIQueryVersion(display, &majorVersion, &minorVersion);
+
+                    if (majorVersion >= 2)
+                    {
+                        unsigned char mask[] = {0, 0 ,0};
 
-                    XIEventMask eventMask;
-                    eventMask.deviceid = XIAllMasterDevices;
-                    eventMask.mask_len = sizeof(mask);
-                    eventMask.mask = mask;
+                        XIEventMask eventMask;
+                        eventMask.deviceid = XIAllMasterDevices;
+                        eventMask.mask_len = sizeof(mask);
+                        eventMask.mask = mask;
 
-                    XISetMask(mask, XI_TouchBegin);
-                    XISetMask(mask, XI_TouchEnd);
-                    XISetMask(mask, XI_TouchUpdate);
+                        XISetMask(mask, XI_TouchBegin);
+                        XISetMask(mask, XI_TouchEnd);
+                        XISetMask(mask, XI_TouchUpdate);
 
-                    XISelectEvents(display, window, &eventMask, 1);
+                        XISelectEvents(display, window, &eventMask, 1);
+                    }
+                    else
+                    {
+                        Log(Log::Level::WARN) << "XInput2 not supported";
+                    }
                 }
                 else
                 {
-                    Log(Log::Level::WARN) << "XInput2 not supported";
+                    Log(Log::Level::WARN) << "XInput not supported";
                 }
             }
+
+            epollFd = epoll_create1(EPOLL_CLOEXEC);
+            wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (epollFd == -1 || wakeFd == -1)
+            {
+                Log(Log::Level::ERR) << "Failed to create gamepad event queue, error: " << errno;
+                return false;
+            }
+
+            epoll_event epollEvent;
+            epollEvent.events = EPOLLIN;
+            epollEvent.data.fd = wakeFd;
+
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &epollEvent) == -1)
+            {
+                Log(Log::Level::ERR) << "Failed to add wake event to gamepad event queue, error: " << errno;
+                return false;
+            }
+
+            inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+            if (inotifyFd == -1 ||
+                inotify_add_watch(inotifyFd, INPUT_DEVICE_DIRECTORY, IN_CREATE | IN_ATTRIB | IN_DELETE) == -1)
+            {
+                Log(Log::Level::WARN) << "Failed to watch " << INPUT_DEVICE_DIRECTORY << ", gamepads will not be hotplugged";
+            }
             else
             {
-                Log(Log::Level::WARN) << "XInput not supported";
+                epollEvent.events = EPOLLIN;
+                epollEvent.data.fd = inotifyFd;
+
+                if (epoll_ctl(epollFd, EPOLL_CTL_ADD, inotifyFd, &epollEvent) == -1)
+                {
+                    Log(Log::Level::WARN) << "Failed to add device watch to gamepad event queue, error: " << errno;
+                }
             }
 
+            sharedEngine->getEventDispatcher()->addEventHandler(&gamepadStateHandler);
+
+            gamepadThreadRunning = true;
+            gamepadThread = std::thread(&InputLinux::gamepadMain, this);
+
+            startGamepadDiscovery();
+
             return true;
         }
 
         InputLinux::~InputLinux()
         {
+            if (gamepadThread.joinable())
+            {
+                gamepadThreadRunning = false;
+                uint64_t value = 1;
+                if (write(wakeFd, &value, sizeof(value)) == -1)
+                {
+                    Log(Log::Level::ERR) << "Failed to wake gamepad thread, error: " << errno;
+                }
+                gamepadThread.join();
+            }
+
+            if (inotifyFd != -1) close(inotifyFd);
+            if (wakeFd != -1) close(wakeFd);
+            if (epollFd != -1) close(epollFd);
+
             if (sharedEngine)
             {
                 WindowResourceLinux* windowLinux = static_cast<WindowResourceLinux*>(sharedEngine->getWindow()->getResource());
                 Display* display = windowLinux->getDisplay();
-                if (emptyCursor != None) XFreeCursor(display, emptyCursor);
+                if (display && emptyCursor != None) XFreeCursor(display, emptyCursor);
             }
         }
 
@@ -308,6 +391,8 @@ namespace ouzel
                 Display* display = windowLinux->getDisplay();
                 ::Window window = windowLinux->getNativeWindow();
 
+                if (!display) return;
+
                 CursorResourceLinux* cursorLinux = static_cast<CursorResourceLinux*>(resource);
 
                 if (cursorLinux)
@@ -361,6 +446,8 @@ namespace ouzel
                     Display* display = windowLinux->getDisplay();
                     ::Window window = windowLinux->getNativeWindow();
 
+                    if (!display) return;
+
                     if (visible)
                     {
                         if (currentCursor)
@@ -394,6 +481,8 @@ namespace ouzel
                 Display* display = windowLinux->getDisplay();
                 ::Window window = windowLinux->getNativeWindow();
 
+                if (!display) return;
+
                 if (locked)
                 {
                     if (XGrabPointer(display, window, False,
@@ -428,6 +517,8 @@ namespace ouzel
                 Display* display = windowLinux->getDisplay();
                 ::Window window = windowLinux->getNativeWindow();
 
+                if (!display) return;
+
                 XWindowAttributes attributes;
                 XGetWindowAttributes(display, window, &attributes);
 
@@ -473,5 +564,290 @@ namespace ouzel
                 }
             }
         }
+
+        void InputLinux::startGamepadDiscovery()
+        {
+            gamepadDiscovery = true;
+
+            // the devices that are already plugged in are opened by the gamepad thread
+            uint64_t value = 1;
+            if (wakeFd != -1 && write(wakeFd, &value, sizeof(value)) == -1)
+            {
+                Log(Log::Level::ERR) << "Failed to wake gamepad thread, error: " << errno;
+            }
+        }
+
+        void InputLinux::stopGamepadDiscovery()
+        {
+            gamepadDiscovery = false;
+        }
+
+        bool InputLinux::replayGamepadEvents(const std::string& filename, bool preserveTiming)
+        {
+            std::ifstream file(filename, std::ios::binary);
+
+            if (!file)
+            {
+                Log(Log::Level::ERR) << "Failed to open gamepad event file " << filename;
+                return false;
+            }
+
+            GamepadLinux* gamepad = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(gamepadMutex);
+
+                auto gamepadIterator = std::find_if(gamepadsLinux.begin(), gamepadsLinux.end(), [&filename](GamepadLinux* gamepadLinux) {
+                    return gamepadLinux->getDevicePath() == filename;
+                });
+
+                if (gamepadIterator != gamepadsLinux.end())
+                {
+                    gamepad = *gamepadIterator;
+                }
+                else
+                {
+                    std::unique_ptr<GamepadLinux> newGamepad(new GamepadLinux(filename));
+                    newGamepad->name = filename;
+                    gamepad = newGamepad.get();
+
+                    gamepadsLinux.push_back(gamepad);
+                    gamepads.push_back(std::move(newGamepad));
+                }
+            }
+
+            bool active = false;
+
+            if (!gamepad->active.compare_exchange_strong(active, true))
+            {
+                Log(Log::Level::ERR) << "Gamepad event file " << filename << " is already being replayed";
+                return false;
+            }
+
+            gamepad->setDefaultAxisRanges();
+
+            Event event;
+            event.type = Event::Type::GAMEPAD_CONNECT;
+            event.gamepadEvent.gamepad = gamepad;
+            sharedEngine->getEventDispatcher()->postEvent(event);
+
+            input_event inputEvent;
+            bool timeSet = false;
+            std::chrono::steady_clock::time_point startTime;
+            std::chrono::microseconds firstEventTime;
+
+            while (file.read(reinterpret_cast<char*>(&inputEvent), sizeof(inputEvent)))
+            {
+                if (preserveTiming)
+                {
+                    std::chrono::microseconds eventTime(static_cast<int64_t>(inputEvent.time.tv_sec) * 1000000 + inputEvent.time.tv_usec);
+
+                    if (!timeSet)
+                    {
+                        startTime = std::chrono::steady_clock::now();
+                        firstEventTime = eventTime;
+                        timeSet = true;
+                    }
+                    else
+                    {
+                        std::this_thread::sleep_until(startTime + (eventTime - firstEventTime));
+                    }
+                }
+
+                gamepad->handleEvent(inputEvent);
+            }
+
+            disconnectGamepad(gamepad);
+
+            return true;
+        }
+
+        void InputLinux::gamepadMain()
+        {
+            sharedEngine->setCurrentThreadName("Gamepad");
+
+            epoll_event events[MAX_EPOLL_EVENTS];
+
+            while (gamepadThreadRunning)
+            {
+                int eventCount = epoll_wait(epollFd, events, MAX_EPOLL_EVENTS, -1);
+
+                if (eventCount == -1)
+                {
+                    if (errno == EINTR) continue;
+
+                    Log(Log::Level::ERR) << "Failed to wait for gamepad events, error: " << errno;
+                    break;
+                }
+
+                for (int i = 0; i < eventCount; ++i)
+                {
+                    int fd = events[i].data.fd;
+
+                    if (fd == wakeFd)
+                    {
+                        uint64_t value;
+                        if (read(wakeFd, &value, sizeof(value)) == -1 && errno != EAGAIN)
+                        {
+                            Log(Log::Level::ERR) << "Failed to read gamepad thread wake event, error: " << errno;
+                        }
+
+                        if (!gamepadThreadRunning) return;
+
+                        scanGamepads();
+                    }
+                    else if (fd == inotifyFd)
+                    {
+                        handleDeviceChanges();
+                    }
+                    else
+                    {
+                        GamepadLinux* gamepad = nullptr;
+
+                        {
+                            std::lock_guard<std::mutex> lock(gamepadMutex);
+
+                            auto gamepadIterator = std::find_if(gamepadsLinux.begin(), gamepadsLinux.end(), [fd](GamepadLinux* gamepadLinux) {
+                                return gamepadLinux->fd == fd;
+                            });
+
+                            if (gamepadIterator != gamepadsLinux.end()) gamepad = *gamepadIterator;
+                        }
+
+                        if (!gamepad) continue;
+
+                        if (!gamepad->readEvents() || (events[i].events & (EPOLLERR | EPOLLHUP)))
+                        {
+                            disconnectGamepad(gamepad);
+                        }
+                    }
+                }
+            }
+        }
+
+        void InputLinux::scanGamepads()
+        {
+            if (!gamepadDiscovery) return;
+
+            glob_t g;
+            std::string pattern = std::string(INPUT_DEVICE_DIRECTORY) + "/event*";
+
+            if (glob(pattern.c_str(), GLOB_NOSORT, nullptr, &g) == 0)
+            {
+                for (size_t i = 0; i < g.gl_pathc; ++i)
+                {
+                    connectGamepad(g.gl_pathv[i]);
+                }
+            }
+
+            globfree(&g);
+        }
+
+        void InputLinux::handleDeviceChanges()
+        {
+            // inotify events are aligned to the event structure
+            alignas(inotify_event) char buffer[4096];
+
+            for (;;)
+            {
+                ssize_t bytesRead = read(inotifyFd, buffer, sizeof(buffer));
+
+                if (bytesRead <= 0)
+                {
+                    if (bytesRead == -1 && errno == EINTR) continue;
+                    break;
+                }
+
+                for (char* pointer = buffer; pointer < buffer + bytesRead;)
+                {
+                    inotify_event* notifyEvent = reinterpret_cast<inotify_event*>(pointer);
+                    pointer += sizeof(inotify_event) + notifyEvent->len;
+
+                    if (!notifyEvent->len || strncmp(notifyEvent->name, "event", 5) != 0) continue;
+
+                    std::string devicePath = std::string(INPUT_DEVICE_DIRECTORY) + "/" + notifyEvent->name;
+
+                    if (notifyEvent->mask & IN_DELETE)
+                    {
+                        GamepadLinux* gamepad = getGamepad(devicePath);
+                        if (gamepad && gamepad->active) disconnectGamepad(gamepad);
+                    }
+                    else if (gamepadDiscovery)
+                    {
+                        // the device node is readable only after udev has changed its permissions, which is reported by IN_ATTRIB
+                        connectGamepad(devicePath);
+                    }
+                }
+            }
+        }
+
+        void InputLinux::connectGamepad(const std::string& devicePath)
+        {
+            GamepadLinux* gamepad = getGamepad(devicePath);
+
+            if (gamepad && gamepad->active) return;
+
+            std::unique_ptr<GamepadLinux> newGamepad;
+
+            if (!gamepad)
+            {
+                newGamepad.reset(new GamepadLinux(devicePath));
+                gamepad = newGamepad.get();
+            }
+
+            if (!gamepad->open()) return;
+
+            epoll_event event;
+            event.events = EPOLLIN;
+            event.data.fd = gamepad->fd;
+
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, gamepad->fd, &event) == -1)
+            {
+                Log(Log::Level::ERR) << "Failed to add gamepad " << devicePath << " to event queue, error: " << errno;
+                gamepad->close();
+                return;
+            }
+
+            gamepad->active = true;
+
+            if (newGamepad)
+            {
+                std::lock_guard<std::mutex> lock(gamepadMutex);
+                gamepadsLinux.push_back(gamepad);
+                gamepads.push_back(std::move(newGamepad));
+            }
+
+            Event connectEvent;
+            connectEvent.type = Event::Type::GAMEPAD_CONNECT;
+            connectEvent.gamepadEvent.gamepad = gamepad;
+            sharedEngine->getEventDispatcher()->postEvent(connectEvent);
+        }
+
+        void InputLinux::disconnectGamepad(GamepadLinux* gamepad)
+        {
+            // closing the descriptor removes it from the epoll set
+            gamepad->close();
+            // listeners must not keep buttons that were held when the gamepad was unplugged
+            gamepad->releaseButtons();
+
+            Event event;
+            event.type = Event::Type::GAMEPAD_DISCONNECT;
+            event.gamepadEvent.gamepad = gamepad;
+            sharedEngine->getEventDispatcher()->postEvent(event);
+
+            gamepad->active = false;
+        }
+
+        GamepadLinux* InputLinux::getGamepad(const std::string& devicePath)
+        {
+            std::lock_guard<std::mutex> lock(gamepadMutex);
+
+            for (GamepadLinux* gamepad : gamepadsLinux)
+            {
+                if (gamepad->getDevicePath() == devicePath) return gamepad;
+            }
+
+            return nullptr;
+        }
     } // namespace input
 } // namespace ouzel
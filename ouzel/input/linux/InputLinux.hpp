@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <X11/keysym.h>
 #include <X11/X.h>
+#include "events/EventHandler.hpp"
 #include "input/Input.hpp"
 
 namespace ouzel
@@ -13,6 +19,8 @@ namespace ouzel
 
     namespace input
     {
+        class GamepadLinux;
+
         class InputLinux: public Input
         {
             friend Engine;
@@ -30,6 +38,12 @@ namespace ouzel
 
             virtual void setCursorPosition(const Vector2& position) override;
 
+            virtual void startGamepadDiscovery() override;
+            virtual void stopGamepadDiscovery() override;
+
+            // feeds raw input_event records (as read from /dev/input/event*) to a virtual gamepad on the calling thread
+            bool replayGamepadEvents(const std::string& filename, bool preserveTiming = false);
+
             void handleXInput2Event(XGenericEventCookie* cookie);
 
         protected:
@@ -44,6 +58,27 @@ namespace ouzel
             ::Cursor emptyCursor = None;
             ::Cursor currentCursor = None;
             int xInputOpCode = 0;
+
+            void gamepadMain();
+            void scanGamepads();
+            void handleDeviceChanges();
+            void connectGamepad(const std::string& devicePath);
+            void disconnectGamepad(GamepadLinux* gamepad);
+            GamepadLinux* getGamepad(const std::string& devicePath);
+
+            // disconnected gamepads are kept, because the posted events may still point to them
+            std::mutex gamepadMutex;
+            std::vector<GamepadLinux*> gamepadsLinux;
+
+            std::atomic<bool> gamepadDiscovery;
+            std::atomic<bool> gamepadThreadRunning;
+            std::thread gamepadThread;
+            int epollFd = -1;
+            int inotifyFd = -1;
+            int wakeFd = -1;
+
+            // applies the gamepad events to the gamepads on the dispatching thread, before any other handler sees them
+            EventHandler gamepadStateHandler;
         };
     } // namespace input
 } // namespace ouzel
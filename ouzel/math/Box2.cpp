@@ -2,6 +2,10 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include "core/Setup.h"
+#if OUZEL_SUPPORTS_SSE
+#include <xmmintrin.h>
+#endif
 #include "Box2.hpp"
 
 namespace ouzel
@@ -29,4 +33,38 @@ namespace ouzel
         max.x = std::max(max.x, box.max.x);
         max.y = std::max(max.y, box.max.y);
     }
+
+    void Box2::insertPoints(const Vector2* points, size_t count)
+    {
+        size_t i = 0;
+
+#if OUZEL_SUPPORTS_SSE
+        // two points per register, the halves are combined at the end
+        __m128 minimum = _mm_setr_ps(min.x, min.y, min.x, min.y);
+        __m128 maximum = _mm_setr_ps(max.x, max.y, max.x, max.y);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 xy = _mm_setr_ps(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y);
+            minimum = _mm_min_ps(minimum, xy);
+            maximum = _mm_max_ps(maximum, xy);
+        }
+
+        minimum = _mm_min_ps(minimum, _mm_movehl_ps(minimum, minimum));
+        maximum = _mm_max_ps(maximum, _mm_movehl_ps(maximum, maximum));
+
+        float values[4];
+        _mm_storeu_ps(values, minimum);
+        min.x = values[0];
+        min.y = values[1];
+        _mm_storeu_ps(values, maximum);
+        max.x = values[0];
+        max.y = values[1];
+#endif
+
+        for (; i < count; ++i)
+        {
+            insertPoint(points[i]);
+        }
+    }
 }
@@ -84,6 +84,8 @@ namespace ouzel
             if (point.y > max.y) max.y = point.y;
         }
 
+        void insertPoints(const Vector2* points, size_t count);
+
         inline Box2 operator+(const Vector2& v) const
         {
             Box2 result(*this);
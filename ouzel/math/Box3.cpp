@@ -2,6 +2,10 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include "core/Setup.h"
+#if OUZEL_SUPPORTS_SSE
+#include <xmmintrin.h>
+#endif
 #include "Box3.hpp"
 #include "Box2.hpp"
 
@@ -51,6 +55,57 @@ namespace ouzel
         // Calculate the new maximum point.
         max.x = std::max(max.x, box.max.x);
         max.y = std::max(max.y, box.max.y);
-        max.z = std::max(max.y, box.max.z);
+        max.z = std::max(max.z, box.max.z);
+    }
+
+    void Box3::merge(const Box3* boxes, size_t count)
+    {
+#if OUZEL_SUPPORTS_SSE
+        __m128 minimum = _mm_setr_ps(min.x, min.y, min.z, 0.0f);
+        __m128 maximum = _mm_setr_ps(max.x, max.y, max.z, 0.0f);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            minimum = _mm_min_ps(minimum, _mm_setr_ps(boxes[i].min.x, boxes[i].min.y, boxes[i].min.z, 0.0f));
+            maximum = _mm_max_ps(maximum, _mm_setr_ps(boxes[i].max.x, boxes[i].max.y, boxes[i].max.z, 0.0f));
+        }
+
+        float values[4];
+        _mm_storeu_ps(values, minimum);
+        min.set(values[0], values[1], values[2]);
+        _mm_storeu_ps(values, maximum);
+        max.set(values[0], values[1], values[2]);
+#else
+        for (size_t i = 0; i < count; ++i)
+        {
+            merge(boxes[i]);
+        }
+#endif
+    }
+
+    void Box3::insertPoints(const Vector3* points, size_t count)
+    {
+#if OUZEL_SUPPORTS_SSE
+        __m128 minimum = _mm_setr_ps(min.x, min.y, min.z, 0.0f);
+        __m128 maximum = _mm_setr_ps(max.x, max.y, max.z, 0.0f);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            __m128 point = _mm_setr_ps(points[i].x, points[i].y, points[i].z, 0.0f);
+            minimum = _mm_min_ps(minimum, point);
+            maximum = _mm_max_ps(maximum, point);
+        }
+
+        float values[4];
+        _mm_storeu_ps(values, minimum);
+        min.set(values[0], values[1], values[2]);
+        _mm_storeu_ps(values, maximum);
+        max.set(values[0], values[1], values[2]);
+#else
+        for (size_t i = 0; i < count; ++i)
+        {
+            insertPoint(points[i]);
+        }
+#endif
     }
 }
@@ -68,6 +68,7 @@ namespace ouzel
         }
 
         void merge(const Box3& box);
+        void merge(const Box3* boxes, size_t count);
 
         void set(const Vector2& newMin, const Vector2& newMax)
         {
@@ -96,6 +97,8 @@ namespace ouzel
             if (point.z > max.z) max.z = point.z;
         }
 
+        void insertPoints(const Vector3* points, size_t count);
+
         inline Box3 operator+(const Vector3& v) const
         {
             Box3 result(*this);
@@ -0,0 +1,59 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cmath>
+#include <limits>
+#include "Box3Array.hpp"
+
+namespace ouzel
+{
+    void Box3Array::clear()
+    {
+        centerX.clear();
+        centerY.clear();
+        centerZ.clear();
+        extentX.clear();
+        extentY.clear();
+        extentZ.clear();
+    }
+
+    void Box3Array::reserve(size_t count)
+    {
+        centerX.reserve(count);
+        centerY.reserve(count);
+        centerZ.reserve(count);
+        extentX.reserve(count);
+        extentY.reserve(count);
+        extentZ.reserve(count);
+    }
+
+    void Box3Array::add(const Matrix4& transform, const Box3& box)
+    {
+        if (box.isEmpty())
+        {
+            centerX.push_back(0.0f);
+            centerY.push_back(0.0f);
+            centerZ.push_back(0.0f);
+            extentX.push_back(std::numeric_limits<float>::lowest());
+            extentY.push_back(std::numeric_limits<float>::lowest());
+            extentZ.push_back(std::numeric_limits<float>::lowest());
+            return;
+        }
+
+        const float* m = transform.m;
+
+        float cx = (box.min.x + box.max.x) * 0.5f;
+        float cy = (box.min.y + box.max.y) * 0.5f;
+        float cz = (box.min.z + box.max.z) * 0.5f;
+        float ex = (box.max.x - box.min.x) * 0.5f;
+        float ey = (box.max.y - box.min.y) * 0.5f;
+        float ez = (box.max.z - box.min.z) * 0.5f;
+
+        centerX.push_back(m[0] * cx + m[4] * cy + m[8] * cz + m[12]);
+        centerY.push_back(m[1] * cx + m[5] * cy + m[9] * cz + m[13]);
+        centerZ.push_back(m[2] * cx + m[6] * cy + m[10] * cz + m[14]);
+        extentX.push_back(fabsf(m[0]) * ex + fabsf(m[4]) * ey + fabsf(m[8]) * ez);
+        extentY.push_back(fabsf(m[1]) * ex + fabsf(m[5]) * ey + fabsf(m[9]) * ez);
+        extentZ.push_back(fabsf(m[2]) * ex + fabsf(m[6]) * ey + fabsf(m[10]) * ez);
+    }
+}
@@ -0,0 +1,30 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <vector>
+#include "math/Box3.hpp"
+#include "math/Matrix4.hpp"
+
+namespace ouzel
+{
+    // axis aligned boxes stored as separate arrays of center and extent components, so that they can be processed in batches
+    class Box3Array
+    {
+    public:
+        void clear();
+        void reserve(size_t count);
+        size_t size() const { return centerX.size(); }
+
+        // adds the axis aligned box that encloses the box transformed by the matrix, empty boxes are never visible
+        void add(const Matrix4& transform, const Box3& box);
+
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+        std::vector<float> extentX;
+        std::vector<float> extentY;
+        std::vector<float> extentZ;
+    };
+}
@@ -1,8 +1,128 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <cmath>
+#include "core/Setup.h"
+#if OUZEL_SUPPORTS_SSE
+#include <xmmintrin.h>
+#elif OUZEL_SUPPORTS_NEON || OUZEL_SUPPORTS_NEON64
+#include <arm_neon.h>
+#endif
 #include "ConvexVolume.hpp"
+#include "Box3Array.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
+    bool ConvexVolume::isBoxInside(const Vector3& center, const Vector3& extent) const
+    {
+        for (const Plane& plane : planes)
+        {
+            // distance of the box corner furthest along the plane normal
+            float distance = plane.a * center.x + plane.b * center.y + plane.c * center.z + plane.d;
+            float radius = fabsf(plane.a) * extent.x + fabsf(plane.b) * extent.y + fabsf(plane.c) * extent.z;
+
+            if (distance + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void ConvexVolume::checkBoxes(const Box3Array& boxes, std::vector<uint32_t>& visibility) const
+    {
+        size_t count = boxes.size();
+        visibility.assign((count + 31) / 32, 0);
+
+        size_t i = 0;
+
+#if OUZEL_SUPPORTS_SSE
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        // four boxes per step, bits 0-3 of the move mask go to four consecutive visibility bits
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 centerX = _mm_loadu_ps(boxes.centerX.data() + i);
+            __m128 centerY = _mm_loadu_ps(boxes.centerY.data() + i);
+            __m128 centerZ = _mm_loadu_ps(boxes.centerZ.data() + i);
+            __m128 extentX = _mm_loadu_ps(boxes.extentX.data() + i);
+            __m128 extentY = _mm_loadu_ps(boxes.extentY.data() + i);
+            __m128 extentZ = _mm_loadu_ps(boxes.extentZ.data() + i);
+
+            __m128 inside = _mm_cmpeq_ps(zero, zero);
+
+            for (const Plane& plane : planes)
+            {
+                __m128 a = _mm_set1_ps(plane.a);
+                __m128 b = _mm_set1_ps(plane.b);
+                __m128 c = _mm_set1_ps(plane.c);
+
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, centerX), _mm_mul_ps(b, centerY)),
+                                             _mm_add_ps(_mm_mul_ps(c, centerZ), _mm_set1_ps(plane.d)));
+                __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, a), extentX),
+                                                      _mm_mul_ps(_mm_andnot_ps(signMask, b), extentY)),
+                                           _mm_mul_ps(_mm_andnot_ps(signMask, c), extentZ));
+
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+
+                if (_mm_movemask_ps(inside) == 0) break;
+            }
+
+            visibility[i / 32] |= static_cast<uint32_t>(_mm_movemask_ps(inside)) << (i % 32);
+        }
+#elif OUZEL_SUPPORTS_NEON || OUZEL_SUPPORTS_NEON64
+    #if OUZEL_SUPPORTS_NEON_CHECK
+        if (anrdoidNEONChecker.isNEONAvailable())
+        {
+    #endif
+        static const uint32_t LANE_BITS[] = {1, 2, 4, 8};
+        const uint32x4_t laneBits = vld1q_u32(LANE_BITS);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t centerX = vld1q_f32(boxes.centerX.data() + i);
+            float32x4_t centerY = vld1q_f32(boxes.centerY.data() + i);
+            float32x4_t centerZ = vld1q_f32(boxes.centerZ.data() + i);
+            float32x4_t extentX = vld1q_f32(boxes.extentX.data() + i);
+            float32x4_t extentY = vld1q_f32(boxes.extentY.data() + i);
+            float32x4_t extentZ = vld1q_f32(boxes.extentZ.data() + i);
+
+            uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+
+            for (const Plane& plane : planes)
+            {
+                float32x4_t distance = vmlaq_n_f32(vdupq_n_f32(plane.d), centerX, plane.a);
+                distance = vmlaq_n_f32(distance, centerY, plane.b);
+                distance = vmlaq_n_f32(distance, centerZ, plane.c);
+
+                float32x4_t radius = vmulq_n_f32(extentX, fabsf(plane.a));
+                radius = vmlaq_n_f32(radius, extentY, fabsf(plane.b));
+                radius = vmlaq_n_f32(radius, extentZ, fabsf(plane.c));
+
+                inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(distance, radius), vdupq_n_f32(0.0f)));
+            }
+
+            uint32x4_t bits = vandq_u32(inside, laneBits);
+            uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+            uint32_t mask = vget_lane_u32(vpadd_u32(sum, sum), 0);
+
+            visibility[i / 32] |= mask << (i % 32);
+        }
+    #if OUZEL_SUPPORTS_NEON_CHECK
+        }
+    #endif
+#endif
+
+        for (; i < count; ++i)
+        {
+            if (isBoxInside(Vector3(boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i]),
+                            Vector3(boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i])))
+            {
+                visibility[i / 32] |= 1U << (i % 32);
+            }
+        }
+    }
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include "math/Box3.hpp"
 #include "math/Plane.hpp"
@@ -10,6 +11,8 @@
 
 namespace ouzel
 {
+    class Box3Array;
+
     class ConvexVolume
     {
     public:
@@ -98,6 +101,12 @@ namespace ouzel
             return true;
         }
 
+        // tests an axis aligned box given by its center and half size
+        bool isBoxInside(const Vector3& center, const Vector3& extent) const;
+
+        // tests all the boxes in batches, bit i of visibility is set if box i is at least partially inside
+        void checkBoxes(const Box3Array& boxes, std::vector<uint32_t>& visibility) const;
+
         std::vector<Plane> planes;
     };
 }
@@ -4,8 +4,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cassert>
+#include "core/Setup.h"
+#if OUZEL_SUPPORTS_NEON64
+#include <arm_neon.h>
+#endif
 #include "Matrix4.hpp"
 #include "Quaternion.hpp"
+#include "Vector2.hpp"
 #include "MathUtils.hpp"
 
 namespace ouzel
@@ -333,6 +338,71 @@ namespace ouzel
         dst.m[14] = zTranslation;
     }
 
+    void Matrix4::createTransform(const Vector3& translation, const Quaternion& rotation, const Vector3& scale, Matrix4& dst)
+    {
+#if OUZEL_SUPPORTS_SSE
+        __m128 q = _mm_setr_ps(rotation.x, rotation.y, rotation.z, rotation.w);
+        __m128 q2 = _mm_add_ps(q, q);
+
+        // every rotation column is the unit vector plus two sets of signed quaternion component products
+        __m128 t1 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 0, 1)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 1, 1))); // yy, xy, xz
+        __m128 t2 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 2)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 2, 2))); // zz, wz, wy
+        __m128 col0 = _mm_add_ps(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f),
+                                 _mm_add_ps(_mm_mul_ps(t1, _mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f)),
+                                            _mm_mul_ps(t2, _mm_setr_ps(-1.0f, 1.0f, -1.0f, 0.0f))));
+
+        t1 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 0, 0)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 0, 1))); // xy, xx, yz
+        t2 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 2, 3)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 2))); // wz, zz, wx
+        __m128 col1 = _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f),
+                                 _mm_add_ps(_mm_mul_ps(t1, _mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f)),
+                                            _mm_mul_ps(t2, _mm_setr_ps(-1.0f, -1.0f, 1.0f, 0.0f))));
+
+        t1 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 1, 0)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 2))); // xz, yz, xx
+        t2 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 3, 3)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 0, 1))); // wy, wx, yy
+        __m128 col2 = _mm_add_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f),
+                                 _mm_add_ps(_mm_mul_ps(t1, _mm_setr_ps(1.0f, 1.0f, -1.0f, 0.0f)),
+                                            _mm_mul_ps(t2, _mm_setr_ps(1.0f, -1.0f, -1.0f, 0.0f))));
+
+        dst.col[0] = _mm_mul_ps(col0, _mm_set1_ps(scale.x));
+        dst.col[1] = _mm_mul_ps(col1, _mm_set1_ps(scale.y));
+        dst.col[2] = _mm_mul_ps(col2, _mm_set1_ps(scale.z));
+        dst.col[3] = _mm_setr_ps(translation.x, translation.y, translation.z, 1.0f);
+#else
+        float wx = rotation.w * rotation.x;
+        float wy = rotation.w * rotation.y;
+        float wz = rotation.w * rotation.z;
+
+        float xx = rotation.x * rotation.x;
+        float xy = rotation.x * rotation.y;
+        float xz = rotation.x * rotation.z;
+
+        float yy = rotation.y * rotation.y;
+        float yz = rotation.y * rotation.z;
+
+        float zz = rotation.z * rotation.z;
+
+        dst.m[0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+        dst.m[1] = 2.0f * (xy + wz) * scale.x;
+        dst.m[2] = 2.0f * (xz - wy) * scale.x;
+        dst.m[3] = 0.0f;
+
+        dst.m[4] = 2.0f * (xy - wz) * scale.y;
+        dst.m[5] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+        dst.m[6] = 2.0f * (yz + wx) * scale.y;
+        dst.m[7] = 0.0f;
+
+        dst.m[8] = 2.0f * (xz + wy) * scale.z;
+        dst.m[9] = 2.0f * (yz - wx) * scale.z;
+        dst.m[10] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+        dst.m[11] = 0.0f;
+
+        dst.m[12] = translation.x;
+        dst.m[13] = translation.y;
+        dst.m[14] = translation.z;
+        dst.m[15] = 1.0f;
+#endif
+    }
+
     inline bool makeFrustumPlane(float a, float b, float c, float d, Plane& plane)
     {
         float n = sqrtf(a * a + b * b + c * c);
@@ -614,6 +684,63 @@ namespace ouzel
 
     bool Matrix4::invert(Matrix4& dst) const
     {
+#if OUZEL_SUPPORTS_SSE
+        // 2x2 minors of the first two and the last two columns
+        __m128 a = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(col[0], col[0], _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(col[1], col[1], _MM_SHUFFLE(2, 3, 2, 1))),
+                              _mm_mul_ps(_mm_shuffle_ps(col[0], col[0], _MM_SHUFFLE(2, 3, 2, 1)), _mm_shuffle_ps(col[1], col[1], _MM_SHUFFLE(1, 0, 0, 0)))); // a0, a1, a2, a3
+        __m128 a45 = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(col[0], col[0], _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(col[1], col[1], _MM_SHUFFLE(3, 3, 3, 3))),
+                                _mm_mul_ps(_mm_shuffle_ps(col[0], col[0], _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(col[1], col[1], _MM_SHUFFLE(2, 1, 2, 1)))); // a4, a5, a4, a5
+        __m128 b = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(col[2], col[2], _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(col[3], col[3], _MM_SHUFFLE(2, 3, 2, 1))),
+                              _mm_mul_ps(_mm_shuffle_ps(col[2], col[2], _MM_SHUFFLE(2, 3, 2, 1)), _mm_shuffle_ps(col[3], col[3], _MM_SHUFFLE(1, 0, 0, 0)))); // b0, b1, b2, b3
+        __m128 b45 = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(col[2], col[2], _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(col[3], col[3], _MM_SHUFFLE(3, 3, 3, 3))),
+                                _mm_mul_ps(_mm_shuffle_ps(col[2], col[2], _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(col[3], col[3], _MM_SHUFFLE(2, 1, 2, 1)))); // b4, b5, b4, b5
+
+        // det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0
+        __m128 d1 = _mm_mul_ps(a, _mm_shuffle_ps(b45, b, _MM_SHUFFLE(2, 3, 0, 1))); // a0 * b5, a1 * b4, a2 * b3, a3 * b2
+        __m128 d2 = _mm_mul_ps(a45, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 1))); // a4 * b1, a5 * b0
+        float dets[8];
+        _mm_storeu_ps(dets, d1);
+        _mm_storeu_ps(dets + 4, d2);
+        float det = dets[0] - dets[1] + dets[2] + dets[3] - dets[4] + dets[5];
+
+        // Close to zero, can't invert.
+        if (fabs(det) <= TOLERANCE)
+            return false;
+
+        // columns of the inverse are sums of (m4, -m0, m12, -m8), (m5, -m1, m13, -m9), (m6, -m2, m14, -m10)
+        // and (m7, -m3, m15, -m11) scaled by (bk, bk, ak, ak)
+        const __m128 sign = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+        __m128 low10 = _mm_unpacklo_ps(col[1], col[0]);
+        __m128 low32 = _mm_unpacklo_ps(col[3], col[2]);
+        __m128 high10 = _mm_unpackhi_ps(col[1], col[0]);
+        __m128 high32 = _mm_unpackhi_ps(col[3], col[2]);
+        __m128 n = _mm_xor_ps(_mm_movelh_ps(low10, low32), sign);
+        __m128 p = _mm_xor_ps(_mm_movehl_ps(low32, low10), sign);
+        __m128 q = _mm_xor_ps(_mm_movelh_ps(high10, high32), sign);
+        __m128 r = _mm_xor_ps(_mm_movehl_ps(high32, high10), sign);
+
+        __m128 s0 = _mm_shuffle_ps(b, a, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 s1 = _mm_shuffle_ps(b, a, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 s2 = _mm_shuffle_ps(b, a, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 s3 = _mm_shuffle_ps(b, a, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 s4 = _mm_shuffle_ps(b45, a45, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 s5 = _mm_shuffle_ps(b45, a45, _MM_SHUFFLE(1, 1, 1, 1));
+
+        __m128 invDet = _mm_set1_ps(1.0f / det);
+
+        // Support the case where m == dst.
+        __m128 c0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(p, s5), _mm_mul_ps(q, s4)), _mm_mul_ps(r, s3));
+        __m128 c1 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(q, s2), _mm_mul_ps(n, s5)), _mm_mul_ps(r, s1));
+        __m128 c2 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(n, s4), _mm_mul_ps(p, s2)), _mm_mul_ps(r, s0));
+        __m128 c3 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(p, s1), _mm_mul_ps(n, s3)), _mm_mul_ps(q, s0));
+
+        dst.col[0] = _mm_mul_ps(c0, invDet);
+        dst.col[1] = _mm_mul_ps(c1, invDet);
+        dst.col[2] = _mm_mul_ps(c2, invDet);
+        dst.col[3] = _mm_mul_ps(c3, invDet);
+
+        return true;
+#else
         float a0 = m[0] * m[5] - m[1] * m[4];
         float a1 = m[0] * m[6] - m[2] * m[4];
         float a2 = m[0] * m[7] - m[3] * m[4];
@@ -659,6 +786,7 @@ namespace ouzel
         multiply(inverse, 1.0f / det, dst);
 
         return true;
+#endif
     }
 
     bool Matrix4::isIdentity() const
@@ -1300,6 +1428,98 @@ namespace ouzel
 #endif
     }
 
+    void Matrix4::transformPoints(const Vector3* points, Vector3* dst, size_t count) const
+    {
+#if OUZEL_SUPPORTS_SSE
+        for (size_t i = 0; i < count; ++i)
+        {
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col[0], _mm_set1_ps(points[i].x)),
+                                                  _mm_mul_ps(col[1], _mm_set1_ps(points[i].y))),
+                                       _mm_add_ps(_mm_mul_ps(col[2], _mm_set1_ps(points[i].z)), col[3]));
+
+            float values[4];
+            _mm_storeu_ps(values, result);
+            dst[i].x = values[0];
+            dst[i].y = values[1];
+            dst[i].z = values[2];
+        }
+#elif OUZEL_SUPPORTS_NEON64
+        float32x4_t col0 = vld1q_f32(m);
+        float32x4_t col1 = vld1q_f32(m + 4);
+        float32x4_t col2 = vld1q_f32(m + 8);
+        float32x4_t col3 = vld1q_f32(m + 12);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float32x4_t result = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(col3, col0, points[i].x), col1, points[i].y), col2, points[i].z);
+
+            dst[i].x = vgetq_lane_f32(result, 0);
+            dst[i].y = vgetq_lane_f32(result, 1);
+            dst[i].z = vgetq_lane_f32(result, 2);
+        }
+#else
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector3 point = points[i];
+
+            dst[i].x = point.x * m[0] + point.y * m[4] + point.z * m[8] + m[12];
+            dst[i].y = point.x * m[1] + point.y * m[5] + point.z * m[9] + m[13];
+            dst[i].z = point.x * m[2] + point.y * m[6] + point.z * m[10] + m[14];
+        }
+#endif
+    }
+
+    void Matrix4::transformPoints(const Vector2* points, Vector2* dst, size_t count) const
+    {
+        size_t i = 0;
+
+#if OUZEL_SUPPORTS_SSE
+        // two points per register
+        __m128 col0 = _mm_shuffle_ps(col[0], col[0], _MM_SHUFFLE(1, 0, 1, 0));
+        __m128 col1 = _mm_shuffle_ps(col[1], col[1], _MM_SHUFFLE(1, 0, 1, 0));
+        __m128 col3 = _mm_shuffle_ps(col[3], col[3], _MM_SHUFFLE(1, 0, 1, 0));
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 xy = _mm_setr_ps(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y);
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 2, 0, 0)), col0),
+                                                  _mm_mul_ps(_mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 3, 1, 1)), col1)),
+                                       col3);
+
+            float values[4];
+            _mm_storeu_ps(values, result);
+            dst[i].x = values[0];
+            dst[i].y = values[1];
+            dst[i + 1].x = values[2];
+            dst[i + 1].y = values[3];
+        }
+#elif OUZEL_SUPPORTS_NEON64
+        float32x4_t col0 = vcombine_f32(vld1_f32(m), vld1_f32(m));
+        float32x4_t col1 = vcombine_f32(vld1_f32(m + 4), vld1_f32(m + 4));
+        float32x4_t col3 = vcombine_f32(vld1_f32(m + 12), vld1_f32(m + 12));
+
+        for (; i + 2 <= count; i += 2)
+        {
+            float32x4_t x = {points[i].x, points[i].x, points[i + 1].x, points[i + 1].x};
+            float32x4_t y = {points[i].y, points[i].y, points[i + 1].y, points[i + 1].y};
+            float32x4_t result = vmlaq_f32(vmlaq_f32(col3, col0, x), col1, y);
+
+            dst[i].x = vgetq_lane_f32(result, 0);
+            dst[i].y = vgetq_lane_f32(result, 1);
+            dst[i + 1].x = vgetq_lane_f32(result, 2);
+            dst[i + 1].y = vgetq_lane_f32(result, 3);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            Vector2 point = points[i];
+
+            dst[i].x = point.x * m[0] + point.y * m[4] + m[12];
+            dst[i].y = point.x * m[1] + point.y * m[5] + m[13];
+        }
+    }
+
     void Matrix4::translate(float x, float y, float z)
     {
         translate(x, y, z, *this);
@@ -15,6 +15,7 @@
 namespace ouzel
 {
     class Quaternion;
+    class Vector2;
 
     class Matrix4
     {
@@ -70,6 +71,8 @@ namespace ouzel
         static void createRotationZ(float angle, Matrix4& dst);
         static void createTranslation(const Vector3& translation, Matrix4& dst);
         static void createTranslation(float xTranslation, float yTranslation, float zTranslation, Matrix4& dst);
+        // translation * rotation * scale without the intermediate matrix multiplications
+        static void createTransform(const Vector3& translation, const Quaternion& rotation, const Vector3& scale, Matrix4& dst);
 
         bool getFrustumLeftPlane(Plane& plane) const;
         bool getFrustumRightPlane(Plane& plane) const;
@@ -194,6 +197,11 @@ namespace ouzel
 
         void transformVector(const Vector4& vector, Vector4& dst) const;
 
+        // transforms count points, points and dst may point to the same array
+        void transformPoints(const Vector3* points, Vector3* dst, size_t count) const;
+        // transforms count points in the xy plane, the z of the result is dropped
+        void transformPoints(const Vector2* points, Vector2* dst, size_t count) const;
+
         void translate(float x, float y, float z);
         void translate(float x, float y, float z, Matrix4& dst) const;
         void translate(const Vector3& t);
@@ -219,39 +219,7 @@ namespace ouzel
         Matrix4 getMatrix() const
         {
             Matrix4 result;
-
-            float wx = w * x;
-            float wy = w * y;
-            float wz = w * z;
-
-            float xx = x * x;
-            float xy = x * y;
-            float xz = x * z;
-
-            float yy = y * y;
-            float yz = y * z;
-
-            float zz = z * z;
-
-            result.m[0] = 1.0f - 2.0f * (yy + zz);
-            result.m[1] = 2.0f * (xy + wz);
-            result.m[2] = 2.0f * (xz - wy);
-            result.m[3] = 0.0f;
-
-            result.m[4] = 2.0f * (xy - wz);
-            result.m[5] = 1.0f - 2.0f * (xx + zz);
-            result.m[6] = 2.0f * (yz + wx);
-            result.m[7] = 0.0f;
-
-            result.m[8] = 2.0f * (xz +  wy);
-            result.m[9] = 2.0f * (yz - wx);
-            result.m[10] = 1.0f - 2.0f * (xx + yy);
-            result.m[11] = 0.0f;
-
-            result.m[12] = 0.0f;
-            result.m[13] = 0.0f;
-            result.m[14] = 0.0f;
-            result.m[15] = 1.0f;
+            Matrix4::createTransform(Vector3::ZERO, *this, Vector3::ONE, result);
 
             return result;
         }
@@ -0,0 +1,497 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "Channel.hpp"
+#include "utils/Log.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    namespace network
+    {
+        static const uint32_t PACKET_HEADER_SIZE = 1 + 2 + 2 + 4; // flags, sequence, ack, ack bits
+        static const uint32_t MESSAGE_HEADER_SIZE = 1 + 2 + 2 + 2 + 2; // flags, id, fragment index, fragment count, size
+        static const uint32_t FRAGMENT_SIZE = Channel::MAX_PACKET_SIZE - PACKET_HEADER_SIZE - MESSAGE_HEADER_SIZE;
+        static const uint32_t SEQUENCE_BUFFER_SIZE = 256;
+        static const uint32_t MESSAGE_WINDOW_SIZE = 1024;
+        static const uint32_t FRAGMENT_GROUP_COUNT = 4;
+        static const uint32_t ACK_BIT_COUNT = 32;
+        static const uint32_t EMPTY_SEQUENCE = 0xFFFFFFFF;
+        static const float MIN_RESEND_TIME = 0.05f;
+        static const float INITIAL_RESEND_TIME = 0.2f;
+        static const float SMOOTHING_FACTOR = 0.1f;
+        static const float MAX_BURST_TIME = 0.1f; // the unused send budget is kept for this long
+
+        enum PacketFlags: uint8_t
+        {
+            PACKET_ACK = 0x01 // ack fields are valid
+        };
+
+        enum MessageFlags: uint8_t
+        {
+            MESSAGE_RELIABLE = 0x01,
+            MESSAGE_FRAGMENT = 0x02
+        };
+
+        // true if a is newer than b, taking the wrap around into account
+        static bool sequenceGreater(uint16_t a, uint16_t b)
+        {
+            return ((a > b) && (a - b <= 32768)) ||
+                ((a < b) && (b - a > 32768));
+        }
+
+        Channel::Channel(const std::function<bool(const std::vector<uint8_t>&)>& aSendCallback):
+            sendCallback(aSendCallback),
+            sentPackets(SEQUENCE_BUFFER_SIZE),
+            receivedSequences(SEQUENCE_BUFFER_SIZE, EMPTY_SEQUENCE),
+            incomingMessages(MESSAGE_WINDOW_SIZE),
+            fragmentGroups(FRAGMENT_GROUP_COUNT)
+        {
+            packetBuffer.reserve(MAX_PACKET_SIZE);
+        }
+
+        uint32_t Channel::getMaxMessageSize()
+        {
+            return FRAGMENT_SIZE * MAX_FRAGMENTS;
+        }
+
+        bool Channel::send(const std::vector<uint8_t>& data, bool reliable)
+        {
+            if (data.size() > getMaxMessageSize())
+            {
+                Log(Log::Level::ERR) << "Message too big";
+                return false;
+            }
+
+            uint32_t fragmentCount = std::max(static_cast<uint32_t>((data.size() + FRAGMENT_SIZE - 1) / FRAGMENT_SIZE), 1U);
+
+            if (reliable && reliableMessages.size() + fragmentCount > MESSAGE_WINDOW_SIZE)
+            {
+                Log(Log::Level::ERR) << "Too many unacknowledged messages";
+                return false;
+            }
+
+            uint16_t fragmentGroupId = 0;
+            if (!reliable && fragmentCount > 1) fragmentGroupId = nextFragmentGroupId++;
+
+            for (uint32_t fragmentIndex = 0; fragmentIndex < fragmentCount; ++fragmentIndex)
+            {
+                OutgoingMessage message;
+                message.flags = (reliable ? MESSAGE_RELIABLE : 0) | (fragmentCount > 1 ? MESSAGE_FRAGMENT : 0);
+                message.fragmentIndex = static_cast<uint16_t>(fragmentIndex);
+                message.fragmentCount = static_cast<uint16_t>(fragmentCount);
+
+                size_t start = fragmentIndex * FRAGMENT_SIZE;
+                size_t end = std::min(start + FRAGMENT_SIZE, data.size());
+                message.data.assign(data.begin() + static_cast<ptrdiff_t>(start), data.begin() + static_cast<ptrdiff_t>(end));
+
+                if (reliable)
+                {
+                    message.id = nextMessageId++;
+                    reliableMessages.push_back(std::move(message));
+                }
+                else
+                {
+                    message.id = fragmentGroupId;
+                    unreliableMessages.push_back(std::move(message));
+                }
+            }
+
+            return true;
+        }
+
+        bool Channel::getMessage(std::vector<uint8_t>& message)
+        {
+            if (receivedMessages.empty())
+            {
+                return false;
+            }
+
+            message = std::move(receivedMessages.front());
+            receivedMessages.pop_front();
+
+            return true;
+        }
+
+        void Channel::update(float delta)
+        {
+            time += delta;
+
+            float resendTime = (statistics.packetsAcked > 0) ? std::max(statistics.rtt * 1.5f, MIN_RESEND_TIME) : INITIAL_RESEND_TIME;
+
+            // at least one full packet can always be sent, even with a low send rate
+            float maxSendBudget = std::max(static_cast<float>(sendRate) * MAX_BURST_TIME, static_cast<float>(MAX_PACKET_SIZE));
+            sendBudget = std::min(sendBudget + static_cast<float>(sendRate) * delta, maxSendBudget);
+
+            // messages are coalesced into as few packets as possible, the oldest ones are (re)sent first
+            for (OutgoingMessage& message : reliableMessages)
+            {
+                if (message.acked) continue;
+
+                if (message.sendTime < 0.0f || time - message.sendTime >= resendTime)
+                {
+                    if (sendBudget < static_cast<float>(PACKET_HEADER_SIZE + getMessageSize(message))) break;
+
+                    if (message.sendTime >= 0.0f) ++statistics.messagesResent;
+
+                    writeMessage(message);
+                    message.sendTime = time;
+                    currentPacket.messageIds.push_back(message.id);
+                }
+            }
+
+            // unreliable messages are not delayed, but they are subtracted from the budget of the next updates
+            for (const OutgoingMessage& message : unreliableMessages)
+            {
+                writeMessage(message);
+            }
+
+            unreliableMessages.clear();
+
+            // the peer needs acks even if there is nothing to send
+            if (!packetOpen && ackPending)
+            {
+                beginPacket();
+            }
+
+            if (packetOpen)
+            {
+                sendPacket();
+            }
+
+            if (delta > 0.0f)
+            {
+                statistics.sendBandwidth += (static_cast<float>(bytesSentSinceUpdate) / delta - statistics.sendBandwidth) * SMOOTHING_FACTOR;
+                statistics.receiveBandwidth += (static_cast<float>(bytesReceivedSinceUpdate) / delta - statistics.receiveBandwidth) * SMOOTHING_FACTOR;
+                bytesSentSinceUpdate = 0;
+                bytesReceivedSinceUpdate = 0;
+            }
+        }
+
+        uint32_t Channel::getMessageSize(const OutgoingMessage& message)
+        {
+            uint32_t size = 1 + 2 + static_cast<uint32_t>(message.data.size()); // flags and size
+            if (message.flags & (MESSAGE_RELIABLE | MESSAGE_FRAGMENT)) size += 2; // id
+            if (message.flags & MESSAGE_FRAGMENT) size += 4; // fragment index and count
+            return size;
+        }
+
+        uint32_t Channel::getAckBits() const
+        {
+            uint32_t ackBits = 0;
+
+            for (uint32_t i = 0; i < ACK_BIT_COUNT; ++i)
+            {
+                uint16_t sequence = static_cast<uint16_t>(remoteSequence - 1 - i);
+                if (receivedSequences[sequence % SEQUENCE_BUFFER_SIZE] == sequence) ackBits |= (1U << i);
+            }
+
+            return ackBits;
+        }
+
+        void Channel::beginPacket()
+        {
+            currentPacket.valid = true;
+            currentPacket.acked = false;
+            currentPacket.sequence = localSequence;
+            currentPacket.sendTime = time;
+            currentPacket.messageIds.clear();
+
+            packetBuffer.clear();
+            writeUInt8(packetBuffer, remoteSequenceValid ? PACKET_ACK : 0);
+            writeUInt16Big(packetBuffer, localSequence);
+            writeUInt16Big(packetBuffer, remoteSequence);
+            writeUInt32Big(packetBuffer, remoteSequenceValid ? getAckBits() : 0);
+
+            packetOpen = true;
+            ++localSequence;
+            sendBudget -= static_cast<float>(PACKET_HEADER_SIZE);
+
+            // every packet carries the acks
+            ackPending = false;
+        }
+
+        void Channel::writeMessage(const OutgoingMessage& message)
+        {
+            if (packetOpen && packetBuffer.size() + getMessageSize(message) > MAX_PACKET_SIZE)
+            {
+                sendPacket();
+            }
+
+            if (!packetOpen)
+            {
+                beginPacket();
+            }
+
+            writeUInt8(packetBuffer, message.flags);
+            if (message.flags & (MESSAGE_RELIABLE | MESSAGE_FRAGMENT)) writeUInt16Big(packetBuffer, message.id);
+            if (message.flags & MESSAGE_FRAGMENT)
+            {
+                writeUInt16Big(packetBuffer, message.fragmentIndex);
+                writeUInt16Big(packetBuffer, message.fragmentCount);
+            }
+            writeUInt16Big(packetBuffer, static_cast<uint16_t>(message.data.size()));
+            packetBuffer.insert(packetBuffer.end(), message.data.begin(), message.data.end());
+            sendBudget -= static_cast<float>(getMessageSize(message));
+        }
+
+        void Channel::sendPacket()
+        {
+            packetOpen = false;
+
+            // packets with only the acks are not acknowledged by the peer, so they are not tracked
+            if (packetBuffer.size() > PACKET_HEADER_SIZE)
+            {
+                SentPacket& packet = sentPackets[currentPacket.sequence % SEQUENCE_BUFFER_SIZE];
+
+                if (packet.valid && !packet.acked)
+                {
+                    ++statistics.packetsLost;
+                    statistics.packetLoss += (1.0f - statistics.packetLoss) * SMOOTHING_FACTOR;
+                }
+
+                currentPacket.size = static_cast<uint32_t>(packetBuffer.size());
+                std::swap(packet, currentPacket);
+            }
+
+            ++statistics.packetsSent;
+            statistics.bytesSent += packetBuffer.size();
+            bytesSentSinceUpdate += packetBuffer.size();
+
+            if (sendCallback) sendCallback(packetBuffer);
+        }
+
+        bool Channel::receive(const std::vector<uint8_t>& packet)
+        {
+            uint32_t offset = 0;
+            uint8_t flags;
+            uint16_t sequence;
+            uint16_t ack;
+            uint32_t ackBits;
+
+            if (!readUInt8(packet, offset, flags) ||
+                !readUInt16Big(packet, offset, sequence) ||
+                !readUInt16Big(packet, offset, ack) ||
+                !readUInt32Big(packet, offset, ackBits))
+            {
+                Log(Log::Level::ERR) << "Invalid packet";
+                return false;
+            }
+
+            ++statistics.packetsReceived;
+            statistics.bytesReceived += packet.size();
+            bytesReceivedSinceUpdate += packet.size();
+
+            // packets with messages have to be acknowledged, duplicates too as the previous ack could have been lost
+            if (packet.size() > offset) ackPending = true;
+
+            if (receivedSequences[sequence % SEQUENCE_BUFFER_SIZE] == sequence)
+            {
+                return true;
+            }
+
+            if (remoteSequenceValid)
+            {
+                // too old to be acknowledged
+                if (sequenceGreater(remoteSequence, sequence) &&
+                    static_cast<uint16_t>(remoteSequence - sequence) >= SEQUENCE_BUFFER_SIZE)
+                {
+                    return true;
+                }
+
+                if (sequenceGreater(sequence, remoteSequence)) remoteSequence = sequence;
+            }
+            else
+            {
+                remoteSequence = sequence;
+                remoteSequenceValid = true;
+            }
+
+            receivedSequences[sequence % SEQUENCE_BUFFER_SIZE] = sequence;
+
+            if (flags & PACKET_ACK)
+            {
+                processAck(ack, ackBits);
+            }
+
+            return readMessages(packet, offset);
+        }
+
+        void Channel::processAck(uint16_t ack, uint32_t ackBits)
+        {
+            for (uint32_t i = 0; i <= ACK_BIT_COUNT; ++i)
+            {
+                // the first iteration checks the ack itself
+                if (i > 0 && !(ackBits & (1U << (i - 1)))) continue;
+
+                uint16_t sequence = static_cast<uint16_t>(ack - i);
+                SentPacket& packet = sentPackets[sequence % SEQUENCE_BUFFER_SIZE];
+
+                if (!packet.valid || packet.acked || packet.sequence != sequence) continue;
+
+                packet.acked = true;
+                ++statistics.packetsAcked;
+
+                float rtt = time - packet.sendTime;
+                if (statistics.packetsAcked == 1) statistics.rtt = rtt;
+                else statistics.rtt += (rtt - statistics.rtt) * SMOOTHING_FACTOR;
+
+                statistics.packetLoss -= statistics.packetLoss * SMOOTHING_FACTOR;
+
+                if (reliableMessages.empty()) continue;
+
+                uint16_t firstId = reliableMessages.front().id;
+
+                for (uint16_t messageId : packet.messageIds)
+                {
+                    uint16_t index = static_cast<uint16_t>(messageId - firstId);
+                    if (index < reliableMessages.size()) reliableMessages[index].acked = true;
+                }
+            }
+
+            while (!reliableMessages.empty() && reliableMessages.front().acked)
+            {
+                reliableMessages.pop_front();
+            }
+        }
+
+        bool Channel::readMessages(const std::vector<uint8_t>& packet, uint32_t offset)
+        {
+            while (offset < packet.size())
+            {
+                uint8_t flags;
+                uint16_t id = 0;
+                uint16_t fragmentIndex = 0;
+                uint16_t fragmentCount = 1;
+                uint16_t size;
+
+                if (!readUInt8(packet, offset, flags) ||
+                    ((flags & (MESSAGE_RELIABLE | MESSAGE_FRAGMENT)) && !readUInt16Big(packet, offset, id)) ||
+                    ((flags & MESSAGE_FRAGMENT) && (!readUInt16Big(packet, offset, fragmentIndex) || !readUInt16Big(packet, offset, fragmentCount))) ||
+                    !readUInt16Big(packet, offset, size) ||
+                    packet.size() - offset < size)
+                {
+                    Log(Log::Level::ERR) << "Invalid message";
+                    return false;
+                }
+
+                if (fragmentCount == 0 || fragmentCount > MAX_FRAGMENTS || fragmentIndex >= fragmentCount ||
+                    size > FRAGMENT_SIZE || ((flags & MESSAGE_FRAGMENT) && fragmentIndex < fragmentCount - 1 && size != FRAGMENT_SIZE))
+                {
+                    Log(Log::Level::ERR) << "Invalid message fragment";
+                    return false;
+                }
+
+                if (flags & MESSAGE_RELIABLE)
+                {
+                    receiveReliable(id, flags, fragmentIndex, fragmentCount, packet.data() + offset, size);
+                }
+                else
+                {
+                    receiveUnreliable(id, flags, fragmentIndex, fragmentCount, packet.data() + offset, size);
+                }
+
+                offset += size;
+            }
+
+            return true;
+        }
+
+        void Channel::receiveReliable(uint16_t id, uint8_t flags, uint16_t fragmentIndex, uint16_t fragmentCount,
+                                      const uint8_t* data, uint16_t size)
+        {
+            // already delivered
+            if (static_cast<uint16_t>(id - nextReceiveMessageId) >= MESSAGE_WINDOW_SIZE)
+            {
+                return;
+            }
+
+            IncomingMessage& message = incomingMessages[id % MESSAGE_WINDOW_SIZE];
+
+            if (!message.valid)
+            {
+                message.valid = true;
+                message.flags = flags;
+                message.fragmentIndex = fragmentIndex;
+                message.fragmentCount = fragmentCount;
+                message.data.assign(data, data + size);
+            }
+
+            // deliver in order
+            for (;;)
+            {
+                IncomingMessage& nextMessage = incomingMessages[nextReceiveMessageId % MESSAGE_WINDOW_SIZE];
+
+                if (!nextMessage.valid) break;
+
+                if (nextMessage.flags & MESSAGE_FRAGMENT)
+                {
+                    if (nextMessage.fragmentIndex == 0) reliableFragmentData.clear();
+
+                    reliableFragmentData.insert(reliableFragmentData.end(), nextMessage.data.begin(), nextMessage.data.end());
+
+                    if (nextMessage.fragmentIndex == nextMessage.fragmentCount - 1)
+                    {
+                        receivedMessages.push_back(std::move(reliableFragmentData));
+                        reliableFragmentData.clear();
+                    }
+                }
+                else
+                {
+                    receivedMessages.push_back(std::move(nextMessage.data));
+                }
+
+                nextMessage.valid = false;
+                ++nextReceiveMessageId;
+            }
+        }
+
+        void Channel::receiveUnreliable(uint16_t id, uint8_t flags, uint16_t fragmentIndex, uint16_t fragmentCount,
+                                        const uint8_t* data, uint16_t size)
+        {
+            if (!(flags & MESSAGE_FRAGMENT))
+            {
+                receivedMessages.push_back(std::vector<uint8_t>(data, data + size));
+                return;
+            }
+
+            FragmentGroup& group = fragmentGroups[id % FRAGMENT_GROUP_COUNT];
+
+            // newer groups replace the incomplete older ones
+            if (!group.valid || sequenceGreater(id, group.id))
+            {
+                group.valid = true;
+                group.id = id;
+                group.fragmentCount = fragmentCount;
+                group.receivedCount = 0;
+                group.size = 0;
+                group.received.assign(fragmentCount, false);
+                group.data.resize(fragmentCount * FRAGMENT_SIZE);
+            }
+            else if (group.id != id || group.fragmentCount != fragmentCount)
+            {
+                return;
+            }
+
+            if (group.received[fragmentIndex]) return;
+
+            std::copy(data, data + size, group.data.begin() + fragmentIndex * FRAGMENT_SIZE);
+            group.received[fragmentIndex] = true;
+            ++group.receivedCount;
+
+            if (fragmentIndex == fragmentCount - 1)
+            {
+                group.size = fragmentIndex * FRAGMENT_SIZE + size;
+            }
+
+            if (group.receivedCount == group.fragmentCount)
+            {
+                group.data.resize(group.size);
+                receivedMessages.push_back(std::move(group.data));
+                group.data.clear();
+                group.valid = false;
+            }
+        }
+    } // namespace network
+} // namespace ouzel
@@ -0,0 +1,145 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace ouzel
+{
+    namespace network
+    {
+        // reliable and unreliable messages over datagrams
+        class Channel
+        {
+        public:
+            static const uint32_t MAX_PACKET_SIZE = 1200;
+            static const uint32_t MAX_FRAGMENTS = 256;
+            static const uint32_t DEFAULT_SEND_RATE = 1024 * 1024; // bytes per second
+
+            struct Statistics
+            {
+                float rtt = 0.0f; // smoothed round trip time in seconds
+                float packetLoss = 0.0f; // smoothed fraction of packets that were not acknowledged
+                float sendBandwidth = 0.0f; // bytes per second
+                float receiveBandwidth = 0.0f; // bytes per second
+                uint64_t packetsSent = 0;
+                uint64_t packetsReceived = 0;
+                uint64_t packetsAcked = 0;
+                uint64_t packetsLost = 0;
+                uint64_t messagesResent = 0;
+                uint64_t bytesSent = 0;
+                uint64_t bytesReceived = 0;
+            };
+
+            // sendCallback is called with every packet that has to be sent, e.g. with Client::sendDatagram
+            explicit Channel(const std::function<bool(const std::vector<uint8_t>&)>& aSendCallback);
+
+            // queues a message, it is sent on the next update
+            bool send(const std::vector<uint8_t>& data, bool reliable);
+            // processes a datagram received from the peer
+            bool receive(const std::vector<uint8_t>& packet);
+            // reliable messages are returned in the order they were sent
+            bool getMessage(std::vector<uint8_t>& message);
+
+            // packs the queued messages into packets, resends lost messages and sends acks
+            void update(float delta);
+
+            // limits the bytes sent per second, the messages that do not fit are sent on the next updates
+            uint32_t getSendRate() const { return sendRate; }
+            void setSendRate(uint32_t newSendRate) { sendRate = newSendRate; }
+
+            const Statistics& getStatistics() const { return statistics; }
+            static uint32_t getMaxMessageSize();
+
+        protected:
+            struct SentPacket
+            {
+                bool valid = false;
+                bool acked = false;
+                uint16_t sequence = 0;
+                float sendTime = 0.0f;
+                uint32_t size = 0;
+                std::vector<uint16_t> messageIds;
+            };
+
+            struct OutgoingMessage
+            {
+                uint16_t id = 0;
+                uint8_t flags = 0;
+                uint16_t fragmentIndex = 0;
+                uint16_t fragmentCount = 0;
+                bool acked = false;
+                float sendTime = -1.0f;
+                std::vector<uint8_t> data;
+            };
+
+            struct IncomingMessage
+            {
+                bool valid = false;
+                uint8_t flags = 0;
+                uint16_t fragmentIndex = 0;
+                uint16_t fragmentCount = 0;
+                std::vector<uint8_t> data;
+            };
+
+            struct FragmentGroup
+            {
+                bool valid = false;
+                uint16_t id = 0;
+                uint16_t fragmentCount = 0;
+                uint16_t receivedCount = 0;
+                uint32_t size = 0;
+                std::vector<bool> received;
+                std::vector<uint8_t> data;
+            };
+
+            static uint32_t getMessageSize(const OutgoingMessage& message);
+
+            uint32_t getAckBits() const;
+            void beginPacket();
+            void writeMessage(const OutgoingMessage& message);
+            void sendPacket();
+            void processAck(uint16_t ack, uint32_t ackBits);
+            bool readMessages(const std::vector<uint8_t>& packet, uint32_t offset);
+            void receiveReliable(uint16_t id, uint8_t flags, uint16_t fragmentIndex, uint16_t fragmentCount,
+                                 const uint8_t* data, uint16_t size);
+            void receiveUnreliable(uint16_t id, uint8_t flags, uint16_t fragmentIndex, uint16_t fragmentCount,
+                                   const uint8_t* data, uint16_t size);
+
+            std::function<bool(const std::vector<uint8_t>&)> sendCallback;
+
+            float time = 0.0f;
+            Statistics statistics;
+            uint32_t sendRate = DEFAULT_SEND_RATE;
+            float sendBudget = 0.0f; // bytes that can be sent, negative if the unreliable messages exceeded it
+            uint64_t bytesSentSinceUpdate = 0;
+            uint64_t bytesReceivedSinceUpdate = 0;
+
+            // sending
+            uint16_t localSequence = 0;
+            std::vector<SentPacket> sentPackets;
+            std::deque<OutgoingMessage> reliableMessages; // ordered by id, the first one is the oldest unacknowledged
+            std::vector<OutgoingMessage> unreliableMessages;
+            uint16_t nextMessageId = 0;
+            uint16_t nextFragmentGroupId = 0;
+            std::vector<uint8_t> packetBuffer;
+            SentPacket currentPacket; // stored in sentPackets only if it carries messages
+            bool packetOpen = false;
+            bool ackPending = false;
+
+            // receiving
+            uint16_t remoteSequence = 0;
+            bool remoteSequenceValid = false;
+            std::vector<uint32_t> receivedSequences; // EMPTY_SEQUENCE if nothing was received in the slot
+            uint16_t nextReceiveMessageId = 0;
+            std::vector<IncomingMessage> incomingMessages;
+            std::vector<uint8_t> reliableFragmentData;
+            std::vector<FragmentGroup> fragmentGroups;
+            std::deque<std::vector<uint8_t>> receivedMessages;
+        };
+    } // namespace network
+} // namespace ouzel
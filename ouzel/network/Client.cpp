@@ -1,15 +1,185 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include "core/Setup.h"
+
+#if OUZEL_SUPPORTS_EPOLL
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+#include <iterator>
 #include "Client.hpp"
+#include "utils/Log.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace network
     {
+        static const size_t BUFFER_SIZE = 65536;
+
+        Client::Client(Network* aNetwork, Socket aSocket, uint32_t aAddress, uint16_t aPort):
+            network(aNetwork), socket(aSocket), address(aAddress), port(aPort), connected(false)
+        {
+            sendBuffer.reserve(BUFFER_SIZE);
+            receiveBuffer.resize(BUFFER_SIZE);
+        }
+
+        Client::~Client()
+        {
+        }
+
+        bool Client::send(const std::vector<uint8_t>& data)
+        {
+            if (data.size() > MAX_MESSAGE_SIZE)
+            {
+                Log(Log::Level::ERR) << "Message too big";
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(sendMutex);
+
+            if (socket == NULL_SOCKET)
+            {
+                return false;
+            }
+
+            if (sendBuffer.size() - sendOffset + sizeof(uint32_t) + data.size() > MAX_SEND_BUFFER_SIZE)
+            {
+                Log(Log::Level::WARN) << "Send buffer full, message dropped";
+                return false;
+            }
+
+            // messages are prefixed with their size
+            uint8_t header[sizeof(uint32_t)];
+            encodeUInt32Big(header, static_cast<uint32_t>(data.size()));
+            sendBuffer.insert(sendBuffer.end(), std::begin(header), std::end(header));
+            sendBuffer.insert(sendBuffer.end(), data.begin(), data.end());
+
+            // the rest is sent by the network thread when the socket becomes writable
+            if (connected && !waitingForWrite)
+            {
+                return flushSendBuffer();
+            }
+
+            return true;
+        }
+
+        size_t Client::getPendingSendSize()
+        {
+            std::lock_guard<std::mutex> lock(sendMutex);
+
+            return sendBuffer.size() - sendOffset;
+        }
+
+        bool Client::sendDatagram(const std::vector<uint8_t>& data)
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            if (data.size() > MAX_DATAGRAM_SIZE)
+            {
+                Log(Log::Level::ERR) << "Datagram too big";
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(sendMutex);
+
+            if (datagramSocket == NULL_SOCKET)
+            {
+                return false;
+            }
+
+            sockaddr_in peerAddress = {};
+            peerAddress.sin_family = AF_INET;
+            peerAddress.sin_addr.s_addr = htonl(address);
+            peerAddress.sin_port = htons(port);
+
+            if (sendto(datagramSocket, data.data(), data.size(), 0,
+                       reinterpret_cast<sockaddr*>(&peerAddress), sizeof(peerAddress)) < 0)
+            {
+                int error = Network::getLastError();
+
+                // datagrams are unreliable, so a full send buffer just drops it
+                if (error != EAGAIN && error != EWOULDBLOCK)
+                {
+                    Log(Log::Level::ERR) << "Failed to send datagram, error: " << error;
+                }
+
+                return false;
+            }
+
+            return true;
+#else
+            return false;
+#endif
+        }
+
         bool Client::disconnect()
         {
+#if OUZEL_SUPPORTS_EPOLL
+            std::lock_guard<std::mutex> lock(sendMutex);
+
+            // the network thread closes the connection when it notices the shutdown
+            if (socket != NULL_SOCKET && shutdown(socket, SHUT_RDWR) < 0)
+            {
+                int error = Network::getLastError();
+                Log(Log::Level::ERR) << "Failed to shut down socket, error: " << error;
+                return false;
+            }
+
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        bool Client::flushSendBuffer()
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            while (sendOffset < sendBuffer.size())
+            {
+                ssize_t sent = ::send(socket, sendBuffer.data() + sendOffset, sendBuffer.size() - sendOffset, MSG_NOSIGNAL);
+
+                if (sent < 0)
+                {
+                    int error = Network::getLastError();
+
+                    if (error == EINTR)
+                    {
+                        continue;
+                    }
+                    else if (error == EAGAIN || error == EWOULDBLOCK)
+                    {
+                        if (!waitingForWrite)
+                        {
+                            waitingForWrite = true;
+                            network->watch(socket, 0, true, false);
+                        }
+
+                        return true;
+                    }
+
+                    Log(Log::Level::ERR) << "Failed to send data, error: " << error;
+                    shutdown(socket, SHUT_RDWR);
+                    return false;
+                }
+
+                sendOffset += static_cast<size_t>(sent);
+            }
+
+            // keep the allocated memory for the next messages
+            sendBuffer.clear();
+            sendOffset = 0;
+
+            if (waitingForWrite)
+            {
+                waitingForWrite = false;
+                network->watch(socket, 0, false, false);
+            }
+
             return true;
+#else
+            return false;
+#endif
         }
     } // namespace network
 } // namespace ouzel
@@ -3,16 +3,61 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "utils/Noncopyable.hpp"
+#include "network/Network.hpp"
+
 namespace ouzel
 {
     namespace network
     {
-        class Client
+        class Client: public Noncopyable
         {
+            friend Network;
         public:
-            ~Client() {}
+            static const uint32_t MAX_MESSAGE_SIZE = 16 * 1024 * 1024;
+            static const uint32_t MAX_DATAGRAM_SIZE = 65507;
+            static const uint32_t MAX_SEND_BUFFER_SIZE = 64 * 1024 * 1024; // bytes queued before send fails
+
+            ~Client();
 
+            // messages are delivered reliably and in order, fails if the peer does not keep up and the send buffer is full
+            bool send(const std::vector<uint8_t>& data);
+            // datagrams can be lost, duplicated or reordered
+            bool sendDatagram(const std::vector<uint8_t>& data);
             bool disconnect();
+
+            uint32_t getAddress() const { return address; }
+            uint16_t getPort() const { return port; }
+            bool isConnected() const { return connected; }
+            // bytes that are queued but not sent yet
+            size_t getPendingSendSize();
+
+        protected:
+            Client(Network* aNetwork, Socket aSocket, uint32_t aAddress, uint16_t aPort);
+
+            // must be called with sendMutex locked
+            bool flushSendBuffer();
+
+            Network* network;
+            Socket socket; // closed only by the network thread, with sendMutex locked
+            Socket datagramSocket = NULL_SOCKET;
+            bool ownDatagramSocket = false;
+            uint32_t address;
+            uint16_t port;
+            std::atomic<bool> connected;
+
+            std::mutex sendMutex;
+            std::vector<uint8_t> sendBuffer;
+            size_t sendOffset = 0;
+            bool waitingForWrite = false;
+
+            // accessed only by the network thread
+            std::vector<uint8_t> receiveBuffer;
+            size_t receiveSize = 0;
         };
     } // namespace network
 } // namespace ouzel
@@ -1,6 +1,8 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include "core/Setup.h"
+
 #ifdef _WIN32
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -10,37 +12,89 @@
 #else
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
 #include <poll.h>
 #include <netdb.h>
 #include <unistd.h>
 #endif
+
+#if OUZEL_SUPPORTS_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#endif
+
+#include <algorithm>
 #include "Network.hpp"
+#include "Client.hpp"
+#include "core/Engine.hpp"
+#include "events/Event.hpp"
 #include "utils/Log.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace network
     {
-        Network::Network()
+        static const size_t DATAGRAM_BUFFER_SIZE = 65536;
+        static const int MAX_POLL_EVENTS = 64;
+
+        // identifies the kind of socket in the upper half of the poll event data
+        enum SocketTag: uint32_t
         {
+            TAG_WAKE,
+            TAG_LISTEN,
+            TAG_DATAGRAM,
+            TAG_CLIENT,
+            TAG_CLIENT_DATAGRAM
+        };
+
+        static uint64_t getPeerKey(uint32_t address, uint16_t port)
+        {
+            return (static_cast<uint64_t>(address) << 16) | port;
         }
 
-        Network::~Network()
+        static void closeSocket(Socket socket)
         {
-            if (endpoint != NULL_SOCKET)
-            {
 #ifdef _WIN32
-                int result = closesocket(endpoint);
+            int result = closesocket(socket);
 #else
-                int result = close(endpoint);
+            int result = close(socket);
 #endif
 
-                if (result < 0)
-                {
-                    int error = getLastError();
-                    Log(Log::Level::ERR) << "Failed to close socket, error: " << error;
-                }
+            if (result < 0)
+            {
+                int error = Network::getLastError();
+                Log(Log::Level::ERR) << "Failed to close socket, error: " << error;
             }
+        }
+
+#if OUZEL_SUPPORTS_EPOLL
+        static bool bindSocket(Socket socket, uint32_t address, uint16_t port)
+        {
+            sockaddr_in socketAddress = {};
+            socketAddress.sin_family = AF_INET;
+            socketAddress.sin_addr.s_addr = htonl(address);
+            socketAddress.sin_port = htons(port);
+
+            return bind(socket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) == 0;
+        }
+#endif
+
+        Network::Network():
+            running(false)
+        {
+        }
+
+        Network::~Network()
+        {
+            disconnect();
+
+#if OUZEL_SUPPORTS_EPOLL
+            if (wakeFd != -1) close(wakeFd);
+            if (pollFd != -1) close(pollFd);
+#endif
 
 #ifdef _WIN32
             WSACleanup();
@@ -58,21 +112,23 @@ namespace ouzel
 
         bool Network::getAddress(const std::string& address, uint32_t& result)
         {
+            addrinfo hints = {};
+            hints.ai_family = AF_INET;
+
             addrinfo* info;
-            int ret = getaddrinfo(address.c_str(), nullptr, nullptr, &info);
+            int ret = getaddrinfo(address.c_str(), nullptr, &hints, &info);
 
             if (ret != 0)
             {
-                int error = getLastError();
-                Log(Log::Level::ERR) << "Failed to get address info of " << address << ", error: " << error;
+                Log(Log::Level::ERR) << "Failed to get address info of " << address << ", error: " << gai_strerror(ret);
                 return false;
             }
 
             sockaddr_in* addr = reinterpret_cast<sockaddr_in*>(info->ai_addr);
             result = ntohl(addr->sin_addr.s_addr);
-            
+
             freeaddrinfo(info);
-            
+
             return true;
         }
 
@@ -96,22 +152,675 @@ namespace ouzel
             }
 #endif
 
+#if OUZEL_SUPPORTS_EPOLL
+            pollFd = epoll_create1(EPOLL_CLOEXEC);
+
+            if (pollFd == -1)
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to create epoll instance, error: " << error;
+                return false;
+            }
+
+            // used to wake up the network thread on disconnect
+            wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (wakeFd == -1)
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to create event descriptor, error: " << error;
+                return false;
+            }
+
+            if (!watch(wakeFd, TAG_WAKE, false, true))
+            {
+                return false;
+            }
+
+            datagramBuffer.resize(DATAGRAM_BUFFER_SIZE);
+#endif
+
             return true;
         }
 
         bool Network::listen(const std::string& address, uint16_t port)
         {
-            return true;
+#if OUZEL_SUPPORTS_EPOLL
+            if (endpoint != NULL_SOCKET)
+            {
+                Log(Log::Level::ERR) << "Already listening";
+                return false;
+            }
+
+            uint32_t ipAddress = ANY_ADDRESS;
+            if (!address.empty() && !getAddress(address, ipAddress))
+            {
+                return false;
+            }
+
+            endpoint = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+
+            if (endpoint == NULL_SOCKET)
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to create socket, error: " << error;
+                return false;
+            }
+
+            int value = 1;
+            setsockopt(endpoint, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value));
+
+            if (!bindSocket(endpoint, ipAddress, port) ||
+                ::listen(endpoint, SOMAXCONN) < 0)
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to listen on port " << port << ", error: " << error;
+                closeSocket(endpoint);
+                endpoint = NULL_SOCKET;
+                return false;
+            }
+
+            // datagrams are received on the same port as the connections
+            datagramEndpoint = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+
+            if (datagramEndpoint == NULL_SOCKET ||
+                !bindSocket(datagramEndpoint, ipAddress, port))
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to create datagram socket, error: " << error;
+                disconnect();
+                return false;
+            }
+
+            if (!watch(endpoint, TAG_LISTEN, false, true) ||
+                !watch(datagramEndpoint, TAG_DATAGRAM, false, true))
+            {
+                disconnect();
+                return false;
+            }
+
+            return startThread();
+#else
+            OUZEL_UNUSED(address);
+            OUZEL_UNUSED(port);
+            Log(Log::Level::ERR) << "Networking is not supported on this platform";
+            return false;
+#endif
         }
 
         bool Network::connect(const std::string& address, uint16_t port)
         {
-            return true;
+#if OUZEL_SUPPORTS_EPOLL
+            uint32_t ipAddress;
+            if (!getAddress(address, ipAddress))
+            {
+                return false;
+            }
+
+            Socket clientSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+
+            if (clientSocket == NULL_SOCKET)
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to create socket, error: " << error;
+                return false;
+            }
+
+            int value = 1;
+            setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+
+            sockaddr_in serverAddress = {};
+            serverAddress.sin_family = AF_INET;
+            serverAddress.sin_addr.s_addr = htonl(ipAddress);
+            serverAddress.sin_port = htons(port);
+
+            if (::connect(clientSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) < 0 &&
+                getLastError() != EINPROGRESS)
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to connect to " << address << ":" << port << ", error: " << error;
+                closeSocket(clientSocket);
+                return false;
+            }
+
+            std::shared_ptr<Client> client(new Client(this, clientSocket, ipAddress, port));
+            client->waitingForWrite = true;
+
+            // the server maps datagrams to connections by the address and port, so bind to the local port of the connection
+            sockaddr_in localAddress = {};
+            socklen_t localAddressLength = sizeof(localAddress);
+            Socket datagramSocket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+
+            if (datagramSocket != NULL_SOCKET &&
+                getsockname(clientSocket, reinterpret_cast<sockaddr*>(&localAddress), &localAddressLength) == 0 &&
+                bindSocket(datagramSocket, ANY_ADDRESS, ntohs(localAddress.sin_port)))
+            {
+                client->datagramSocket = datagramSocket;
+                client->ownDatagramSocket = true;
+            }
+            else
+            {
+                int error = getLastError();
+                Log(Log::Level::WARN) << "Failed to create datagram socket, error: " << error << ", datagrams will not be available";
+                if (datagramSocket != NULL_SOCKET) closeSocket(datagramSocket);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                clients[clientSocket] = client;
+                // several connections can go to the same server, so they are found by their own datagram socket
+                if (client->datagramSocket != NULL_SOCKET) clients[client->datagramSocket] = client;
+            }
+
+            // writability signals the completion of the connection
+            if (!watch(clientSocket, TAG_CLIENT, true, true) ||
+                (client->datagramSocket != NULL_SOCKET && !watch(client->datagramSocket, TAG_CLIENT_DATAGRAM, false, true)))
+            {
+                std::vector<Event> events;
+                closeClient(client, events);
+                return false;
+            }
+
+            return startThread();
+#else
+            OUZEL_UNUSED(address);
+            OUZEL_UNUSED(port);
+            Log(Log::Level::ERR) << "Networking is not supported on this platform";
+            return false;
+#endif
         }
 
         bool Network::disconnect()
         {
+#if OUZEL_SUPPORTS_EPOLL
+            if (running)
+            {
+                running = false;
+
+                uint64_t value = 1;
+                if (write(wakeFd, &value, sizeof(value)) < 0)
+                {
+                    int error = getLastError();
+                    Log(Log::Level::ERR) << "Failed to wake up the network thread, error: " << error;
+                }
+
+                if (ioThread.joinable()) ioThread.join();
+            }
+
+            std::vector<std::shared_ptr<Client>> closingClients;
+
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+
+                for (const auto& i : clients)
+                {
+                    if (std::find(closingClients.begin(), closingClients.end(), i.second) == closingClients.end())
+                    {
+                        closingClients.push_back(i.second);
+                    }
+                }
+            }
+
+            std::vector<Event> events;
+
+            for (const std::shared_ptr<Client>& client : closingClients)
+            {
+                closeClient(client, events);
+            }
+
+            if (endpoint != NULL_SOCKET)
+            {
+                closeSocket(endpoint);
+                endpoint = NULL_SOCKET;
+            }
+
+            if (datagramEndpoint != NULL_SOCKET)
+            {
+                closeSocket(datagramEndpoint);
+                datagramEndpoint = NULL_SOCKET;
+            }
+
+            // the engine is already gone when called from the destructor
+            if (sharedEngine && !events.empty())
+            {
+                sharedEngine->getEventDispatcher()->postEvents(events);
+            }
+#else
+            if (endpoint != NULL_SOCKET)
+            {
+                closeSocket(endpoint);
+                endpoint = NULL_SOCKET;
+            }
+#endif
+
+            return true;
+        }
+
+        bool Network::startThread()
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            if (!running)
+            {
+                running = true;
+                ioThread = std::thread(&Network::run, this);
+            }
+
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        bool Network::watch(Socket socket, uint32_t tag, bool write, bool add)
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            epoll_event event;
+            event.events = EPOLLIN | EPOLLRDHUP | (write ? EPOLLOUT : 0);
+            // only client connections are modified after they are added
+            event.data.u64 = (static_cast<uint64_t>(add ? tag : TAG_CLIENT) << 32) | static_cast<uint32_t>(socket);
+
+            if (epoll_ctl(pollFd, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, socket, &event) < 0)
+            {
+                int error = getLastError();
+                Log(Log::Level::ERR) << "Failed to watch socket, error: " << error;
+                return false;
+            }
+
             return true;
+#else
+            OUZEL_UNUSED(socket);
+            OUZEL_UNUSED(tag);
+            OUZEL_UNUSED(write);
+            OUZEL_UNUSED(add);
+            return false;
+#endif
+        }
+
+        void Network::run()
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            sharedEngine->setCurrentThreadName("Network");
+
+            epoll_event pollEvents[MAX_POLL_EVENTS];
+            std::vector<Event> events;
+
+            while (running)
+            {
+                int count = epoll_wait(pollFd, pollEvents, MAX_POLL_EVENTS, -1);
+
+                if (count < 0)
+                {
+                    int error = getLastError();
+                    if (error == EINTR) continue;
+
+                    Log(Log::Level::ERR) << "Failed to wait for socket events, error: " << error;
+                    break;
+                }
+
+                for (int i = 0; i < count; ++i)
+                {
+                    uint32_t tag = static_cast<uint32_t>(pollEvents[i].data.u64 >> 32);
+                    Socket socket = static_cast<Socket>(pollEvents[i].data.u64 & 0xFFFFFFFF);
+
+                    switch (tag)
+                    {
+                        case TAG_WAKE:
+                        {
+                            uint64_t value;
+                            while (read(wakeFd, &value, sizeof(value)) > 0);
+                            break;
+                        }
+                        case TAG_LISTEN:
+                            acceptConnections(socket, events);
+                            break;
+                        case TAG_DATAGRAM:
+                        case TAG_CLIENT_DATAGRAM:
+                            receiveDatagrams(socket, tag, events);
+                            break;
+                        case TAG_CLIENT:
+                        {
+                            std::shared_ptr<Client> client;
+
+                            {
+                                std::lock_guard<std::mutex> lock(clientsMutex);
+                                auto clientIterator = clients.find(socket);
+                                if (clientIterator != clients.end()) client = clientIterator->second;
+                            }
+
+                            if (client) handleClient(client, pollEvents[i].events, events);
+                            break;
+                        }
+                    }
+                }
+
+                // one lock of the event queue per wakeup
+                if (!events.empty())
+                {
+                    sharedEngine->getEventDispatcher()->postEvents(events);
+                }
+            }
+#endif
+        }
+
+        void Network::acceptConnections(Socket socket, std::vector<Event>& events)
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            for (;;)
+            {
+                sockaddr_in clientAddress;
+                socklen_t clientAddressLength = sizeof(clientAddress);
+
+                Socket clientSocket = accept4(socket, reinterpret_cast<sockaddr*>(&clientAddress), &clientAddressLength,
+                                              SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+                if (clientSocket == NULL_SOCKET)
+                {
+                    int error = getLastError();
+
+                    if (error == EINTR || error == ECONNABORTED) continue;
+
+                    if (error != EAGAIN && error != EWOULDBLOCK)
+                    {
+                        Log(Log::Level::ERR) << "Failed to accept client, error: " << error;
+                    }
+
+                    break;
+                }
+
+                int value = 1;
+                setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+
+                uint32_t address = ntohl(clientAddress.sin_addr.s_addr);
+                uint16_t port = ntohs(clientAddress.sin_port);
+
+                std::shared_ptr<Client> client(new Client(this, clientSocket, address, port));
+                client->datagramSocket = datagramEndpoint;
+                client->connected = true;
+
+                {
+                    std::lock_guard<std::mutex> lock(clientsMutex);
+                    clients[clientSocket] = client;
+                    peers[getPeerKey(address, port)] = client;
+                }
+
+                if (!watch(clientSocket, TAG_CLIENT, false, true))
+                {
+                    closeClient(client, events);
+                    continue;
+                }
+
+                Event event;
+                event.type = Event::Type::NETWORK_CONNECT;
+                event.networkEvent.client = client;
+                events.push_back(std::move(event));
+            }
+#else
+            OUZEL_UNUSED(socket);
+            OUZEL_UNUSED(events);
+#endif
+        }
+
+        void Network::receiveDatagrams(Socket socket, uint32_t tag, std::vector<Event>& events)
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            for (;;)
+            {
+                sockaddr_in senderAddress;
+                socklen_t senderAddressLength = sizeof(senderAddress);
+
+                ssize_t size = recvfrom(socket, datagramBuffer.data(), datagramBuffer.size(), 0,
+                                        reinterpret_cast<sockaddr*>(&senderAddress), &senderAddressLength);
+
+                if (size < 0)
+                {
+                    int error = getLastError();
+
+                    if (error == EINTR) continue;
+
+                    if (error != EAGAIN && error != EWOULDBLOCK)
+                    {
+                        Log(Log::Level::ERR) << "Failed to receive datagram, error: " << error;
+                    }
+
+                    break;
+                }
+
+                uint32_t address = ntohl(senderAddress.sin_addr.s_addr);
+                uint16_t port = ntohs(senderAddress.sin_port);
+                std::shared_ptr<Client> client;
+
+                {
+                    std::lock_guard<std::mutex> lock(clientsMutex);
+
+                    if (tag == TAG_CLIENT_DATAGRAM)
+                    {
+                        auto clientIterator = clients.find(socket);
+                        if (clientIterator != clients.end()) client = clientIterator->second;
+                    }
+                    else
+                    {
+                        auto peerIterator = peers.find(getPeerKey(address, port));
+                        if (peerIterator != peers.end()) client = peerIterator->second;
+                    }
+                }
+
+                // datagrams are accepted only from connected peers
+                if (!client || !client->connected ||
+                    client->address != address || client->port != port) continue;
+
+                Event event;
+                event.type = Event::Type::NETWORK_RECEIVE;
+                event.networkEvent.client = client;
+                event.networkEvent.datagram = true;
+                event.networkEvent.data.assign(datagramBuffer.begin(), datagramBuffer.begin() + size);
+                events.push_back(std::move(event));
+            }
+#else
+            OUZEL_UNUSED(socket);
+            OUZEL_UNUSED(tag);
+            OUZEL_UNUSED(events);
+#endif
+        }
+
+        void Network::handleClient(const std::shared_ptr<Client>& client, uint32_t flags, std::vector<Event>& events)
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            Socket socket;
+
+            {
+                std::lock_guard<std::mutex> lock(client->sendMutex);
+                socket = client->socket;
+            }
+
+            // an earlier event of the same batch could have closed the client
+            if (socket == NULL_SOCKET) return;
+
+            if (flags & EPOLLOUT)
+            {
+                bool failed = false;
+
+                {
+                    std::lock_guard<std::mutex> lock(client->sendMutex);
+
+                    if (!client->connected)
+                    {
+                        int error = 0;
+                        socklen_t errorLength = sizeof(error);
+
+                        if (getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &errorLength) < 0 || error != 0)
+                        {
+                            Log(Log::Level::ERR) << "Failed to connect, error: " << error;
+                            failed = true;
+                        }
+                        else
+                        {
+                            client->connected = true;
+
+                            Event event;
+                            event.type = Event::Type::NETWORK_CONNECT;
+                            event.networkEvent.client = client;
+                            events.push_back(std::move(event));
+                        }
+                    }
+
+                    if (!failed)
+                    {
+                        // pretend the socket is blocked so that the flush disarms the write notification when done
+                        client->waitingForWrite = true;
+                        failed = !client->flushSendBuffer();
+                    }
+                }
+
+                if (failed)
+                {
+                    closeClient(client, events);
+                    return;
+                }
+            }
+
+            if (!(flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+            {
+                return;
+            }
+
+            for (;;)
+            {
+                if (client->receiveSize == client->receiveBuffer.size())
+                {
+                    client->receiveBuffer.resize(client->receiveBuffer.size() * 2);
+                }
+
+                ssize_t size = recv(socket,
+                                    client->receiveBuffer.data() + client->receiveSize,
+                                    client->receiveBuffer.size() - client->receiveSize, 0);
+
+                if (size < 0)
+                {
+                    int error = getLastError();
+
+                    if (error == EINTR) continue;
+                    if (error == EAGAIN || error == EWOULDBLOCK) break;
+
+                    Log(Log::Level::ERR) << "Failed to receive data, error: " << error;
+                    closeClient(client, events);
+                    return;
+                }
+                else if (size == 0)
+                {
+                    closeClient(client, events);
+                    return;
+                }
+
+                client->receiveSize += static_cast<size_t>(size);
+
+                // split the stream into messages
+                size_t offset = 0;
+
+                while (client->receiveSize - offset >= sizeof(uint32_t))
+                {
+                    uint32_t messageSize = decodeUInt32Big(client->receiveBuffer.data() + offset);
+
+                    if (messageSize > Client::MAX_MESSAGE_SIZE)
+                    {
+                        Log(Log::Level::ERR) << "Message too big";
+                        closeClient(client, events);
+                        return;
+                    }
+
+                    if (client->receiveSize - offset - sizeof(uint32_t) < messageSize)
+                    {
+                        // make room for the rest of the message
+                        if (sizeof(uint32_t) + messageSize > client->receiveBuffer.size())
+                        {
+                            client->receiveBuffer.resize(sizeof(uint32_t) + messageSize);
+                        }
+
+                        break;
+                    }
+
+                    const uint8_t* message = client->receiveBuffer.data() + offset + sizeof(uint32_t);
+
+                    Event event;
+                    event.type = Event::Type::NETWORK_RECEIVE;
+                    event.networkEvent.client = client;
+                    event.networkEvent.data.assign(message, message + messageSize);
+                    events.push_back(std::move(event));
+
+                    offset += sizeof(uint32_t) + messageSize;
+                }
+
+                if (offset > 0)
+                {
+                    std::copy(client->receiveBuffer.begin() + static_cast<ptrdiff_t>(offset),
+                              client->receiveBuffer.begin() + static_cast<ptrdiff_t>(client->receiveSize),
+                              client->receiveBuffer.begin());
+                    client->receiveSize -= offset;
+                }
+            }
+#else
+            OUZEL_UNUSED(client);
+            OUZEL_UNUSED(flags);
+            OUZEL_UNUSED(events);
+#endif
+        }
+
+        void Network::closeClient(const std::shared_ptr<Client>& client, std::vector<Event>& events)
+        {
+#if OUZEL_SUPPORTS_EPOLL
+            Socket socket;
+
+            {
+                std::lock_guard<std::mutex> lock(client->sendMutex);
+                socket = client->socket;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+
+                auto clientIterator = clients.find(socket);
+                if (clientIterator != clients.end() && clientIterator->second == client) clients.erase(clientIterator);
+
+                if (client->ownDatagramSocket)
+                {
+                    clientIterator = clients.find(client->datagramSocket);
+                    if (clientIterator != clients.end() && clientIterator->second == client) clients.erase(clientIterator);
+                }
+
+                auto peerIterator = peers.find(getPeerKey(client->address, client->port));
+                if (peerIterator != peers.end() && peerIterator->second == client) peers.erase(peerIterator);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(client->sendMutex);
+
+                if (client->socket == NULL_SOCKET)
+                {
+                    return;
+                }
+
+                epoll_ctl(pollFd, EPOLL_CTL_DEL, client->socket, nullptr);
+                closeSocket(client->socket);
+                client->socket = NULL_SOCKET;
+
+                if (client->ownDatagramSocket && client->datagramSocket != NULL_SOCKET)
+                {
+                    epoll_ctl(pollFd, EPOLL_CTL_DEL, client->datagramSocket, nullptr);
+                    closeSocket(client->datagramSocket);
+                }
+
+                client->datagramSocket = NULL_SOCKET;
+                client->connected = false;
+            }
+
+            // also sent when an outgoing connection fails
+            Event event;
+            event.type = Event::Type::NETWORK_DISCONNECT;
+            event.networkEvent.client = client;
+            events.push_back(std::move(event));
+#else
+            OUZEL_UNUSED(client);
+            OUZEL_UNUSED(events);
+#endif
         }
     } // namespace network
 } // namespace ouzel
@@ -13,18 +13,29 @@ typedef int Socket;
 #define NULL_SOCKET -1
 #endif
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace ouzel
 {
+    struct Event;
+
     namespace network
     {
         const uint32_t ANY_ADDRESS = 0;
         const uint16_t ANY_PORT = 0;
 
+        class Client;
+
         class Network
         {
+            friend Client;
         public:
             Network();
             ~Network();
@@ -34,12 +45,37 @@ namespace ouzel
 
             bool init();
 
+            // accepts TCP connections and UDP datagrams on the given address and port
             bool listen(const std::string& address, uint16_t port);
+            // NETWORK_CONNECT event is sent when the connection is established
             bool connect(const std::string& address, uint16_t port);
+            // closes all the connections and stops listening
             bool disconnect();
 
         private:
+            void run();
+            bool startThread();
+            bool watch(Socket socket, uint32_t tag, bool write, bool add);
+
+            void acceptConnections(Socket socket, std::vector<Event>& events);
+            void receiveDatagrams(Socket socket, uint32_t tag, std::vector<Event>& events);
+            void handleClient(const std::shared_ptr<Client>& client, uint32_t flags, std::vector<Event>& events);
+            void closeClient(const std::shared_ptr<Client>& client, std::vector<Event>& events);
+
             Socket endpoint = NULL_SOCKET;
+            Socket datagramEndpoint = NULL_SOCKET;
+
+            int pollFd = -1;
+            int wakeFd = -1;
+
+            std::thread ioThread;
+            std::atomic<bool> running;
+
+            std::mutex clientsMutex;
+            std::unordered_map<Socket, std::shared_ptr<Client>> clients; // keyed by the stream and the datagram socket
+            std::unordered_map<uint64_t, std::shared_ptr<Client>> peers; // accepted clients keyed by the address and port
+
+            std::vector<uint8_t> datagramBuffer;
         };
     } // namespace network
 } // namespace ouzel
@@ -0,0 +1,656 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include "Replication.hpp"
+#include "math/MathUtils.hpp"
+#include "scene/Actor.hpp"
+#include "scene/Sprite.hpp"
+#include "utils/Log.hpp"
+#include "utils/OBF.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    namespace network
+    {
+        static const float POSITION_PRECISION = 64.0f; // steps per unit
+        static const float SCALE_PRECISION = 1024.0f;
+        static const uint32_t ROTATION_BITS = 10;
+        static const uint32_t ROTATION_MAX = (1 << ROTATION_BITS) - 1;
+        static const float SQRT2 = 1.41421356f;
+        static const std::vector<EntityState> NO_ENTITIES;
+
+        enum MessageType: uint8_t
+        {
+            MESSAGE_SNAPSHOT = 1,
+            MESSAGE_ACK = 2
+        };
+
+        enum MessageKey: uint32_t
+        {
+            KEY_TYPE = 0,
+            KEY_SEQUENCE = 1,
+            KEY_BASELINE = 2,
+            KEY_PAYLOAD = 3
+        };
+
+        enum FieldFlags: uint8_t
+        {
+            FIELD_POSITION = 0x01,
+            FIELD_ROTATION = 0x02,
+            FIELD_SCALE = 0x04,
+            FIELD_OPACITY = 0x08,
+            FIELD_FRAME = 0x10,
+            FIELD_HIDDEN = 0x20 // value of the hidden flag, not a change mask
+        };
+
+        static int32_t quantize(float value, float precision)
+        {
+            return static_cast<int32_t>(std::round(value * precision));
+        }
+
+        static uint32_t encodeRotation(const Quaternion& rotation)
+        {
+            float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+            float length = std::sqrt(components[0] * components[0] + components[1] * components[1] +
+                                     components[2] * components[2] + components[3] * components[3]);
+
+            if (length == 0.0f)
+            {
+                components[3] = length = 1.0f;
+            }
+
+            // the largest component is reconstructed from the other three
+            uint32_t largest = 0;
+            for (uint32_t i = 1; i < 4; ++i)
+            {
+                if (std::fabs(components[i]) > std::fabs(components[largest])) largest = i;
+            }
+
+            float scale = (components[largest] < 0.0f ? -1.0f : 1.0f) / length;
+            uint32_t result = largest;
+
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                if (i == largest) continue;
+
+                float value = (components[i] * scale * SQRT2 + 1.0f) * 0.5f;
+                int32_t quantized = static_cast<int32_t>(std::round(value * ROTATION_MAX));
+                result = (result << ROTATION_BITS) | static_cast<uint32_t>(clamp(quantized, 0, static_cast<int32_t>(ROTATION_MAX)));
+            }
+
+            return result;
+        }
+
+        static Quaternion decodeRotation(uint32_t rotation)
+        {
+            float components[4];
+            uint32_t largest = rotation >> (ROTATION_BITS * 3);
+            float sum = 0.0f;
+
+            for (int32_t i = 3; i >= 0; --i)
+            {
+                if (static_cast<uint32_t>(i) == largest) continue;
+
+                float value = static_cast<float>(rotation & ROTATION_MAX) / ROTATION_MAX;
+                components[i] = (value * 2.0f - 1.0f) / SQRT2;
+                sum += components[i] * components[i];
+                rotation >>= ROTATION_BITS;
+            }
+
+            components[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+
+            return Quaternion(components[0], components[1], components[2], components[3]);
+        }
+
+        static EntityState getDefaultState(uint32_t id)
+        {
+            EntityState state;
+            state.id = id;
+            state.rotation = encodeRotation(Quaternion::IDENTITY);
+            state.scale[0] = state.scale[1] = state.scale[2] = quantize(1.0f, SCALE_PRECISION);
+            state.opacity = 255;
+            return state;
+        }
+
+        static scene::Sprite* getSprite(scene::Actor* actor)
+        {
+            for (scene::Component* component : actor->getComponents())
+            {
+                if (component->getType() == scene::Sprite::TYPE)
+                {
+                    return static_cast<scene::Sprite*>(component);
+                }
+            }
+
+            return nullptr;
+        }
+
+        static uint8_t getChangedFields(const EntityState& a, const EntityState& b)
+        {
+            uint8_t fields = 0;
+            if (a.position[0] != b.position[0] || a.position[1] != b.position[1] || a.position[2] != b.position[2]) fields |= FIELD_POSITION;
+            if (a.rotation != b.rotation) fields |= FIELD_ROTATION;
+            if (a.scale[0] != b.scale[0] || a.scale[1] != b.scale[1] || a.scale[2] != b.scale[2]) fields |= FIELD_SCALE;
+            if (a.opacity != b.opacity) fields |= FIELD_OPACITY;
+            if (a.frame != b.frame) fields |= FIELD_FRAME;
+            return fields;
+        }
+
+        // variable length integers, 7 bits per byte
+        static void writeVarInt(std::vector<uint8_t>& buffer, uint32_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+
+            buffer.push_back(static_cast<uint8_t>(value));
+        }
+
+        static bool readVarInt(const std::vector<uint8_t>& buffer, uint32_t& offset, uint32_t& result)
+        {
+            result = 0;
+
+            for (uint32_t shift = 0; shift < 35; shift += 7)
+            {
+                if (offset >= buffer.size()) return false;
+
+                uint8_t byte = buffer[offset++];
+                result |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+
+            return false;
+        }
+
+        // small differences in either direction produce small values
+        static void writeDelta(std::vector<uint8_t>& buffer, int32_t value, int32_t base)
+        {
+            int32_t delta = static_cast<int32_t>(static_cast<uint32_t>(value) - static_cast<uint32_t>(base));
+            writeVarInt(buffer, (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31));
+        }
+
+        static bool readDelta(const std::vector<uint8_t>& buffer, uint32_t& offset, int32_t base, int32_t& result)
+        {
+            uint32_t value;
+            if (!readVarInt(buffer, offset, value)) return false;
+            uint32_t delta = (value >> 1) ^ (~(value & 1) + 1);
+            result = static_cast<int32_t>(static_cast<uint32_t>(base) + delta);
+            return true;
+        }
+
+        // writes the entities that changed since the baseline followed by the ids of the removed entities
+        static void encodeDelta(const std::vector<EntityState>& baseline, const std::vector<EntityState>& entities,
+                                std::vector<uint8_t>& buffer)
+        {
+            size_t countOffset = buffer.size();
+            uint32_t count = 0;
+            uint32_t previousId = 0;
+            writeUInt32Big(buffer, 0);
+
+            auto baselineIterator = baseline.begin();
+
+            for (const EntityState& entity : entities)
+            {
+                while (baselineIterator != baseline.end() && baselineIterator->id < entity.id) ++baselineIterator;
+
+                EntityState base = (baselineIterator != baseline.end() && baselineIterator->id == entity.id) ?
+                    *baselineIterator : getDefaultState(entity.id);
+
+                uint8_t fields = getChangedFields(entity, base);
+
+                if (!fields && entity.hidden == base.hidden) continue;
+
+                writeVarInt(buffer, entity.id - previousId);
+                buffer.push_back(fields | (entity.hidden ? FIELD_HIDDEN : 0));
+
+                if (fields & FIELD_POSITION)
+                {
+                    for (uint32_t i = 0; i < 3; ++i) writeDelta(buffer, entity.position[i], base.position[i]);
+                }
+
+                if (fields & FIELD_ROTATION) writeUInt32Big(buffer, entity.rotation);
+
+                if (fields & FIELD_SCALE)
+                {
+                    for (uint32_t i = 0; i < 3; ++i) writeDelta(buffer, entity.scale[i], base.scale[i]);
+                }
+
+                if (fields & FIELD_OPACITY) buffer.push_back(entity.opacity);
+                if (fields & FIELD_FRAME) writeVarInt(buffer, entity.frame);
+
+                previousId = entity.id;
+                ++count;
+            }
+
+            encodeUInt32Big(buffer.data() + countOffset, count);
+
+            countOffset = buffer.size();
+            count = 0;
+            previousId = 0;
+            writeUInt32Big(buffer, 0);
+
+            auto entityIterator = entities.begin();
+
+            for (const EntityState& base : baseline)
+            {
+                while (entityIterator != entities.end() && entityIterator->id < base.id) ++entityIterator;
+
+                if (entityIterator == entities.end() || entityIterator->id != base.id)
+                {
+                    writeVarInt(buffer, base.id - previousId);
+                    previousId = base.id;
+                    ++count;
+                }
+            }
+
+            encodeUInt32Big(buffer.data() + countOffset, count);
+        }
+
+        static bool decodeDelta(const std::vector<EntityState>& baseline, const std::vector<uint8_t>& buffer,
+                                std::vector<EntityState>& result)
+        {
+            result.clear();
+
+            uint32_t offset = 0;
+            uint32_t count;
+            uint32_t id = 0;
+
+            if (!readUInt32Big(buffer, offset, count)) return false;
+
+            auto baselineIterator = baseline.begin();
+
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                uint32_t idDelta;
+                uint8_t fields;
+
+                if (!readVarInt(buffer, offset, idDelta) ||
+                    (index > 0 && idDelta == 0) ||
+                    offset >= buffer.size())
+                {
+                    return false;
+                }
+
+                id += idDelta;
+                fields = buffer[offset++];
+
+                // unchanged entities are carried over from the baseline
+                while (baselineIterator != baseline.end() && baselineIterator->id < id)
+                {
+                    result.push_back(*baselineIterator++);
+                }
+
+                EntityState entity;
+
+                if (baselineIterator != baseline.end() && baselineIterator->id == id)
+                {
+                    entity = *baselineIterator++;
+                }
+                else
+                {
+                    entity = getDefaultState(id);
+                }
+
+                if (fields & FIELD_POSITION)
+                {
+                    for (uint32_t i = 0; i < 3; ++i)
+                    {
+                        if (!readDelta(buffer, offset, entity.position[i], entity.position[i])) return false;
+                    }
+                }
+
+                if ((fields & FIELD_ROTATION) && !readUInt32Big(buffer, offset, entity.rotation)) return false;
+
+                if (fields & FIELD_SCALE)
+                {
+                    for (uint32_t i = 0; i < 3; ++i)
+                    {
+                        if (!readDelta(buffer, offset, entity.scale[i], entity.scale[i])) return false;
+                    }
+                }
+
+                if (fields & FIELD_OPACITY)
+                {
+                    if (offset >= buffer.size()) return false;
+                    entity.opacity = buffer[offset++];
+                }
+
+                if ((fields & FIELD_FRAME) && !readVarInt(buffer, offset, entity.frame)) return false;
+
+                entity.hidden = (fields & FIELD_HIDDEN) != 0;
+
+                result.push_back(entity);
+            }
+
+            result.insert(result.end(), baselineIterator, baseline.end());
+
+            if (!readUInt32Big(buffer, offset, count)) return false;
+
+            id = 0;
+            auto resultIterator = result.begin();
+            auto outputIterator = result.begin();
+
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                uint32_t idDelta;
+                if (!readVarInt(buffer, offset, idDelta)) return false;
+                id += idDelta;
+
+                while (resultIterator != result.end() && resultIterator->id < id)
+                {
+                    *outputIterator++ = *resultIterator++;
+                }
+
+                if (resultIterator != result.end() && resultIterator->id == id) ++resultIterator;
+            }
+
+            outputIterator = std::copy(resultIterator, result.end(), outputIterator);
+            result.erase(outputIterator, result.end());
+
+            return offset == buffer.size();
+        }
+
+        ReplicationServer::ReplicationServer():
+            history(HISTORY_SIZE)
+        {
+        }
+
+        void ReplicationServer::addActor(uint32_t id, scene::Actor* actor)
+        {
+            auto i = std::lower_bound(actors.begin(), actors.end(), id,
+                                      [](const std::pair<uint32_t, scene::Actor*>& a, uint32_t b) { return a.first < b; });
+
+            if (i != actors.end() && i->first == id)
+            {
+                i->second = actor;
+            }
+            else
+            {
+                actors.insert(i, std::make_pair(id, actor));
+            }
+        }
+
+        void ReplicationServer::removeActor(uint32_t id)
+        {
+            auto i = std::lower_bound(actors.begin(), actors.end(), id,
+                                      [](const std::pair<uint32_t, scene::Actor*>& a, uint32_t b) { return a.first < b; });
+
+            if (i != actors.end() && i->first == id)
+            {
+                actors.erase(i);
+            }
+        }
+
+        uint32_t ReplicationServer::addPeer()
+        {
+            uint32_t peerId = nextPeerId++;
+            peers[peerId] = Peer();
+            return peerId;
+        }
+
+        void ReplicationServer::removePeer(uint32_t peerId)
+        {
+            peers.erase(peerId);
+        }
+
+        uint32_t ReplicationServer::captureSnapshot()
+        {
+            ++sequence;
+
+            Snapshot& snapshot = history[sequence % HISTORY_SIZE];
+            snapshot.valid = true;
+            snapshot.sequence = sequence;
+            snapshot.entities.resize(actors.size());
+
+            for (size_t i = 0; i < actors.size(); ++i)
+            {
+                scene::Actor* actor = actors[i].second;
+                EntityState& entity = snapshot.entities[i];
+
+                const Vector3& position = actor->getPosition();
+                const Vector3& scale = actor->getScale();
+
+                entity.id = actors[i].first;
+                entity.position[0] = quantize(position.x, POSITION_PRECISION);
+                entity.position[1] = quantize(position.y, POSITION_PRECISION);
+                entity.position[2] = quantize(position.z, POSITION_PRECISION);
+                entity.rotation = encodeRotation(actor->getRotation());
+                entity.scale[0] = quantize(scale.x, SCALE_PRECISION);
+                entity.scale[1] = quantize(scale.y, SCALE_PRECISION);
+                entity.scale[2] = quantize(scale.z, SCALE_PRECISION);
+                entity.opacity = static_cast<uint8_t>(clamp(quantize(actor->getOpacity(), 255.0f), 0, 255));
+                entity.hidden = actor->isHidden();
+
+                scene::Sprite* sprite = getSprite(actor);
+                entity.frame = sprite ? sprite->getCurrentFrame() : 0;
+            }
+
+            return sequence;
+        }
+
+        bool ReplicationServer::encodeSnapshot(uint32_t peerId, std::vector<uint8_t>& result)
+        {
+            auto peerIterator = peers.find(peerId);
+
+            if (peerIterator == peers.end())
+            {
+                Log(Log::Level::ERR) << "Invalid peer";
+                return false;
+            }
+
+            const Snapshot& snapshot = history[sequence % HISTORY_SIZE];
+
+            if (!snapshot.valid)
+            {
+                Log(Log::Level::ERR) << "No snapshot captured";
+                return false;
+            }
+
+            const Peer& peer = peerIterator->second;
+            const Snapshot* baseline = nullptr;
+
+            // fall back to a full snapshot if the acknowledged one is no longer in the history
+            if (peer.acked && sequence - peer.ackedSequence < HISTORY_SIZE)
+            {
+                const Snapshot& ackedSnapshot = history[peer.ackedSequence % HISTORY_SIZE];
+                if (ackedSnapshot.valid && ackedSnapshot.sequence == peer.ackedSequence) baseline = &ackedSnapshot;
+            }
+
+            payload.clear();
+            encodeDelta(baseline ? baseline->entities : NO_ENTITIES, snapshot.entities, payload);
+
+            obf::Value message = obf::Value::Type::OBJECT;
+            message[KEY_TYPE] = static_cast<uint8_t>(MESSAGE_SNAPSHOT);
+            message[KEY_SEQUENCE] = sequence;
+            if (baseline) message[KEY_BASELINE] = baseline->sequence;
+            message[KEY_PAYLOAD] = payload;
+
+            result.clear();
+            message.encode(result);
+
+            return true;
+        }
+
+        bool ReplicationServer::receive(uint32_t peerId, const std::vector<uint8_t>& data)
+        {
+            auto peerIterator = peers.find(peerId);
+
+            if (peerIterator == peers.end())
+            {
+                Log(Log::Level::ERR) << "Invalid peer";
+                return false;
+            }
+
+            obf::Value message;
+
+            if (!message.decode(data) ||
+                message.getType() != obf::Value::Type::OBJECT ||
+                !message[KEY_TYPE].isIntType() || message[KEY_TYPE].asUInt8() != MESSAGE_ACK ||
+                !message[KEY_SEQUENCE].isIntType())
+            {
+                Log(Log::Level::ERR) << "Invalid replication message";
+                return false;
+            }
+
+            Peer& peer = peerIterator->second;
+            uint32_t ackedSequence = message[KEY_SEQUENCE].asUInt32();
+
+            if (ackedSequence <= sequence && (!peer.acked || ackedSequence > peer.ackedSequence))
+            {
+                peer.acked = true;
+                peer.ackedSequence = ackedSequence;
+            }
+
+            return true;
+        }
+
+        ReplicationClient::ReplicationClient():
+            history(ReplicationServer::HISTORY_SIZE)
+        {
+        }
+
+        void ReplicationClient::addActor(uint32_t id, scene::Actor* actor)
+        {
+            actors[id] = actor;
+        }
+
+        void ReplicationClient::removeActor(uint32_t id)
+        {
+            actors.erase(id);
+        }
+
+        const Snapshot* ReplicationClient::getLatestSnapshot() const
+        {
+            return received ? &history[latestSequence % ReplicationServer::HISTORY_SIZE] : nullptr;
+        }
+
+        bool ReplicationClient::receive(const std::vector<uint8_t>& data, std::vector<uint8_t>& ack)
+        {
+            obf::Value message;
+
+            if (!message.decode(data) ||
+                message.getType() != obf::Value::Type::OBJECT ||
+                !message[KEY_TYPE].isIntType() || message[KEY_TYPE].asUInt8() != MESSAGE_SNAPSHOT ||
+                !message[KEY_SEQUENCE].isIntType() ||
+                (message.hasElement(KEY_BASELINE) && !message[KEY_BASELINE].isIntType()) ||
+                message[KEY_PAYLOAD].getType() != obf::Value::Type::BYTE_ARRAY)
+            {
+                Log(Log::Level::ERR) << "Invalid replication message";
+                return false;
+            }
+
+            uint32_t snapshotSequence = message[KEY_SEQUENCE].asUInt32();
+
+            // late or duplicate snapshot
+            if (received && snapshotSequence <= latestSequence)
+            {
+                return false;
+            }
+
+            const std::vector<EntityState>* baseline = &NO_ENTITIES;
+
+            if (message.hasElement(KEY_BASELINE))
+            {
+                uint32_t baselineSequence = message[KEY_BASELINE].asUInt32();
+
+                if (baselineSequence >= snapshotSequence)
+                {
+                    Log(Log::Level::ERR) << "Invalid snapshot baseline";
+                    return false;
+                }
+
+                const Snapshot& baselineSnapshot = history[baselineSequence % ReplicationServer::HISTORY_SIZE];
+
+                // the baseline was overwritten, wait for a snapshot against a newer one
+                if (!baselineSnapshot.valid || baselineSnapshot.sequence != baselineSequence)
+                {
+                    return false;
+                }
+
+                baseline = &baselineSnapshot.entities;
+            }
+
+            if (!decodeDelta(*baseline, message[KEY_PAYLOAD].asByteArray(), decoded))
+            {
+                Log(Log::Level::ERR) << "Invalid snapshot";
+                return false;
+            }
+
+            // apply before storing, as the slot of the new snapshot can hold the previous one
+            const Snapshot* previous = getLatestSnapshot();
+            apply(decoded, previous ? previous->entities : NO_ENTITIES);
+
+            Snapshot& snapshot = history[snapshotSequence % ReplicationServer::HISTORY_SIZE];
+            snapshot.entities.swap(decoded);
+            snapshot.valid = true;
+            snapshot.sequence = snapshotSequence;
+
+            received = true;
+            latestSequence = snapshotSequence;
+
+            obf::Value ackMessage = obf::Value::Type::OBJECT;
+            ackMessage[KEY_TYPE] = static_cast<uint8_t>(MESSAGE_ACK);
+            ackMessage[KEY_SEQUENCE] = snapshotSequence;
+
+            ack.clear();
+            ackMessage.encode(ack);
+
+            return true;
+        }
+
+        void ReplicationClient::apply(const std::vector<EntityState>& entities, const std::vector<EntityState>& previousEntities)
+        {
+            auto previousIterator = previousEntities.begin();
+
+            for (const EntityState& entity : entities)
+            {
+                while (previousIterator != previousEntities.end() && previousIterator->id < entity.id) ++previousIterator;
+
+                auto actorIterator = actors.find(entity.id);
+                if (actorIterator == actors.end()) continue;
+
+                scene::Actor* actor = actorIterator->second;
+
+                // only the changed properties are set to avoid needless transform updates
+                uint8_t fields = 0xFF;
+                bool hiddenChanged = true;
+
+                if (previousIterator != previousEntities.end() && previousIterator->id == entity.id)
+                {
+                    fields = getChangedFields(entity, *previousIterator);
+                    hiddenChanged = entity.hidden != previousIterator->hidden;
+                }
+
+                if (fields & FIELD_POSITION)
+                {
+                    actor->setPosition(Vector3(entity.position[0] / POSITION_PRECISION,
+                                               entity.position[1] / POSITION_PRECISION,
+                                               entity.position[2] / POSITION_PRECISION));
+                }
+
+                if (fields & FIELD_ROTATION) actor->setRotation(decodeRotation(entity.rotation));
+
+                if (fields & FIELD_SCALE)
+                {
+                    actor->setScale(Vector3(entity.scale[0] / SCALE_PRECISION,
+                                            entity.scale[1] / SCALE_PRECISION,
+                                            entity.scale[2] / SCALE_PRECISION));
+                }
+
+                if (fields & FIELD_OPACITY) actor->setOpacity(entity.opacity / 255.0f);
+                if (hiddenChanged) actor->setHidden(entity.hidden);
+
+                if (fields & FIELD_FRAME)
+                {
+                    scene::Sprite* sprite = getSprite(actor);
+                    if (sprite && !sprite->getFrames().empty()) sprite->setCurrentFrame(entity.frame);
+                }
+            }
+        }
+    } // namespace network
+} // namespace ouzel
@@ -0,0 +1,97 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ouzel
+{
+    namespace scene
+    {
+        class Actor;
+    }
+
+    namespace network
+    {
+        // quantized state of a replicated actor
+        struct EntityState
+        {
+            uint32_t id = 0;
+            int32_t position[3] = {0, 0, 0};
+            uint32_t rotation = 0; // smallest three components of the quaternion
+            int32_t scale[3] = {0, 0, 0};
+            uint8_t opacity = 0;
+            bool hidden = false;
+            uint32_t frame = 0;
+        };
+
+        struct Snapshot
+        {
+            bool valid = false;
+            uint32_t sequence = 0;
+            std::vector<EntityState> entities; // sorted by id
+        };
+
+        // captures snapshots of the actors and encodes them for each peer against the last snapshot it acknowledged
+        class ReplicationServer
+        {
+        public:
+            static const uint32_t HISTORY_SIZE = 32;
+
+            ReplicationServer();
+
+            void addActor(uint32_t id, scene::Actor* actor);
+            void removeActor(uint32_t id);
+
+            uint32_t addPeer();
+            void removePeer(uint32_t peerId);
+
+            // returns the sequence number of the new snapshot
+            uint32_t captureSnapshot();
+            bool encodeSnapshot(uint32_t peerId, std::vector<uint8_t>& result);
+            // processes the ack sent by the ReplicationClient of the peer
+            bool receive(uint32_t peerId, const std::vector<uint8_t>& data);
+
+        protected:
+            struct Peer
+            {
+                bool acked = false;
+                uint32_t ackedSequence = 0;
+            };
+
+            std::vector<std::pair<uint32_t, scene::Actor*>> actors; // sorted by id
+            std::vector<Snapshot> history;
+            uint32_t sequence = 0;
+            std::unordered_map<uint32_t, Peer> peers;
+            uint32_t nextPeerId = 0;
+            std::vector<uint8_t> payload;
+        };
+
+        // decodes the snapshots and applies them to the actors
+        class ReplicationClient
+        {
+        public:
+            ReplicationClient();
+
+            void addActor(uint32_t id, scene::Actor* actor);
+            void removeActor(uint32_t id);
+
+            // ack has to be sent back to the server if true is returned
+            bool receive(const std::vector<uint8_t>& data, std::vector<uint8_t>& ack);
+
+            const Snapshot* getLatestSnapshot() const;
+
+        protected:
+            void apply(const std::vector<EntityState>& entities, const std::vector<EntityState>& previousEntities);
+
+            std::unordered_map<uint32_t, scene::Actor*> actors;
+            std::vector<Snapshot> history;
+            bool received = false;
+            uint32_t latestSequence = 0;
+            std::vector<EntityState> decoded;
+        };
+    } // namespace network
+} // namespace ouzel
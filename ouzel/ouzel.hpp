@@ -13,6 +13,7 @@
 #include "animators/Scale.hpp"
 #include "animators/Sequence.hpp"
 #include "animators/Shake.hpp"
+#include "animators/TweenSystem.hpp"
 #include "assets/Cache.hpp"
 #include "audio/Audio.hpp"
 #include "audio/Listener.hpp"
@@ -60,6 +61,7 @@
 #include "gui/RadioButtonGroup.hpp"
 #include "gui/ScrollBar.hpp"
 #include "gui/SlideBar.hpp"
+#include "gui/TextLayout.hpp"
 #include "gui/Widget.hpp"
 #include "input/Cursor.hpp"
 #include "input/CursorResource.hpp"
@@ -68,6 +70,7 @@
 #include "localization/Localization.hpp"
 #include "math/Box2.hpp"
 #include "math/Box3.hpp"
+#include "math/Box3Array.hpp"
 #include "math/Color.hpp"
 #include "math/ConvexVolume.hpp"
 #include "math/MathUtils.hpp"
@@ -81,11 +84,15 @@
 #include "math/Vector2.hpp"
 #include "math/Vector3.hpp"
 #include "math/Vector4.hpp"
+#include "network/Channel.hpp"
+#include "network/Client.hpp"
 #include "network/Network.hpp"
+#include "network/Replication.hpp"
 #include "scene/Actor.hpp"
 #include "scene/ActorContainer.hpp"
 #include "scene/Camera.hpp"
 #include "scene/Component.hpp"
+#include "scene/InstanceBatcher.hpp"
 #include "scene/Layer.hpp"
 #include "scene/Light.hpp"
 #include "scene/ModelData.hpp"
@@ -101,4 +108,6 @@
 #include "utils/INI.hpp"
 #include "utils/Log.hpp"
 #include "utils/OBF.hpp"
+#include "utils/OBFView.hpp"
+#include "utils/OBFWriter.hpp"
 #include "utils/Utils.hpp"
@@ -2,6 +2,7 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include <atomic>
 #include "Actor.hpp"
 #include "core/Engine.hpp"
 #include "SceneManager.hpp"
@@ -14,8 +15,12 @@ namespace ouzel
 {
     namespace scene
     {
+        // actors are marked dirty from the draw workers too (SceneManager::setParallelDraw)
+        static std::atomic<uint32_t> lastRevision(0);
+
         Actor::Actor()
         {
+            markDirty();
         }
 
         Actor::~Actor()
@@ -50,16 +55,10 @@ namespace ouzel
 
             if (!worldHidden)
             {
-                Box3 boundingBox = getBoundingBox();
-
-                if (cullDisabled || (!boundingBox.isEmpty() && camera->checkVisibility(getTransform(), boundingBox)))
+                // the layer culls the whole draw queue at once and sorts only the visible actors
+                if (cullDisabled || !getBoundingBox().isEmpty())
                 {
-                    auto upperBound = std::upper_bound(drawQueue.begin(), drawQueue.end(), this,
-                                                       [](Actor* a, Actor* b) {
-                                                           return a->worldOrder > b->worldOrder;
-                                                       });
-
-                    drawQueue.insert(upperBound, this);
+                    drawQueue.push_back(this);
                 }
             }
 
@@ -78,10 +77,18 @@ namespace ouzel
                 calculateTransform();
             }
 
+            InstanceBatcher* instanceBatcher = layer ? layer->getInstanceBatcher() : nullptr;
+
             for (Component* component : components)
             {
                 if (!component->isHidden())
                 {
+                    // consecutive components with the same mesh and material are drawn with one instanced draw call
+                    if (instanceBatcher && instanceBatcher->addInstance(component, transform, opacity, camera, wireframe))
+                    {
+                        continue;
+                    }
+
                     component->draw(transform,
                                     opacity,
                                     camera->getRenderViewProjection(),
@@ -166,6 +173,8 @@ namespace ouzel
         void Actor::setOpacity(float newOpacity)
         {
             opacity = clamp(newOpacity, 0.0f, 1.0f);
+
+            markDirty();
         }
 
         void Actor::setFlipX(bool newFlipX)
@@ -185,6 +194,8 @@ namespace ouzel
         void Actor::setHidden(bool newHidden)
         {
             hidden = newHidden;
+
+            markDirty();
         }
 
         bool Actor::pointOn(const Vector2& worldPosition) const
@@ -247,6 +258,12 @@ namespace ouzel
             }
         }
 
+        void Actor::markDirty()
+        {
+            // revisions are unique across actors, so a new actor never matches a deleted one at the same address
+            revision = ++lastRevision;
+        }
+
         Vector3 Actor::getWorldPosition() const
         {
             Vector3 result = position;
@@ -277,15 +294,11 @@ namespace ouzel
 
         void Actor::calculateLocalTransform() const
         {
-            localTransform.setIdentity();
-            localTransform.translate(position);
-            localTransform *= rotation.getMatrix();
-
             Vector3 realScale = Vector3(scale.x * (flipX ? -1.0f : 1.0f),
                                         scale.y * (flipY ? -1.0f : 1.0f),
                                         scale.z);
 
-            localTransform.scale(realScale);
+            Matrix4::createTransform(position, rotation, realScale, localTransform);
 
             localTransformDirty = false;
         }
@@ -319,6 +332,8 @@ namespace ouzel
 
             component->setActor(this);
             components.push_back(component);
+
+            markDirty();
         }
 
         bool Actor::removeChildComponent(Component* component)
@@ -332,6 +347,8 @@ namespace ouzel
                 component->setActor(nullptr);
                 components.erase(componentIterator);
                 result = true;
+
+                markDirty();
             }
 
             std::vector<std::unique_ptr<Component>>::iterator ownedIterator = std::find_if(ownedComponents.begin(), ownedComponents.end(), [component](const std::unique_ptr<Component>& other) {
@@ -350,6 +367,8 @@ namespace ouzel
         {
             components.clear();
             ownedComponents.clear();
+
+            markDirty();
         }
 
         void Actor::setLayer(Layer* newLayer)
@@ -21,11 +21,13 @@ namespace ouzel
         class Camera;
         class Component;
         class Layer;
+        class TweenSystem;
 
         class Actor: public ActorContainer
         {
             friend ActorContainer;
             friend Layer;
+            friend TweenSystem;
         public:
             Actor();
             virtual ~Actor();
@@ -42,7 +44,7 @@ namespace ouzel
             virtual void setPosition(const Vector3& newPosition);
             virtual const Vector3& getPosition() const { return position; }
 
-            void setOrder(int32_t newOrder) { order = newOrder; }
+            void setOrder(int32_t newOrder) { order = newOrder; markDirty(); }
             int32_t getOrder() const { return order; }
 
             virtual void setRotation(const Quaternion& newRotation);
@@ -106,6 +108,10 @@ namespace ouzel
                 return inverseTransform;
             }
 
+            // call when something that affects the actor's drawing (except its transform) changes
+            void markDirty();
+            uint32_t getRevision() const { return revision; }
+
             Vector3 getWorldPosition() const;
             virtual int32_t getWorldOrder() const { return worldOrder; }
 
@@ -186,6 +192,7 @@ namespace ouzel
             float opacity = 1.0f;
             int32_t order = 0;
             int32_t worldOrder = 0;
+            uint32_t revision = 0;
 
             ActorContainer* parent = nullptr;
 
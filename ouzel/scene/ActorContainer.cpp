@@ -74,6 +74,7 @@ namespace ouzel
             if (i != children.end())
             {
                 std::rotate(children.begin(), i, i + 1);
+                actor->markDirty();
 
                 return true;
             }
@@ -88,6 +89,7 @@ namespace ouzel
             if (i != children.end())
             {
                 std::rotate(i, i + 1, children.end());
+                actor->markDirty();
 
                 return true;
             }
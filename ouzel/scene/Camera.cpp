@@ -136,6 +136,14 @@ namespace ouzel
             viewProjectionDirty = inverseViewProjectionDirty = true;
         }
 
+        void Camera::setProjection(const Matrix4& newProjection)
+        {
+            type = Type::CUSTOM;
+            projection = newProjection;
+
+            viewProjectionDirty = inverseViewProjectionDirty = true;
+        }
+
         const Matrix4& Camera::getViewProjection() const
         {
             if (viewProjectionDirty)
@@ -179,6 +187,12 @@ namespace ouzel
 
                 renderViewProjection = sharedEngine->getRenderer()->getDevice()->getProjectionTransform(renderTarget != nullptr) * renderViewProjection;
 
+                // extracted once here instead of for every tested box
+                frustumValid = viewProjection.getFrustum(frustum);
+
+                // 2D content is not culled by depth
+                if (frustumValid && type == Type::ORTHOGRAPHIC) frustum.planes.resize(4);
+
                 viewProjectionDirty = false;
             }
         }
@@ -205,64 +219,53 @@ namespace ouzel
                            (result.y / 2.0f + 0.5f) * viewport.size.height + viewport.position.y);
         }
 
-        bool Camera::checkVisibility(const Matrix4& boxTransform, const Box3& box) const
+        const ConvexVolume& Camera::getFrustum() const
         {
-            if (type == Type::ORTHOGRAPHIC)
+            if (viewProjectionDirty)
             {
-                // calculate center point of the box
-                Vector2 diff = box.max - box.min;
-
-                // offset the center point, so that it is relative to 0,0
-                Vector3 v3p(box.min.x + diff.x / 2.0f, box.min.y + diff.y / 2.0f, 0.0f);
-
-                // apply local transform to the center point
-                boxTransform.transformPoint(v3p);
-
-                // tranform the center to viewport's clip space
-                Vector4 clipPos;
-                getViewProjection().transformVector(Vector4(v3p.x, v3p.y, v3p.z, 1.0f), clipPos);
+                calculateViewProjection();
+            }
 
-                assert(clipPos.w != 0.0f);
+            return frustum;
+        }
 
-                // normalize position of the center point
-                Vector2 v2p((clipPos.x / clipPos.w + 1.0f) * 0.5f,
-                            (clipPos.y / clipPos.w + 1.0f) * 0.5f);
+        bool Camera::checkVisibility(const Matrix4& boxTransform, const Box3& box) const
+        {
+            if (viewProjectionDirty)
+            {
+                calculateViewProjection();
+            }
 
-                // calculate half size
-                Size2 halfSize(diff.x / 2.0f, diff.y / 2.0f);
+            if (!frustumValid || box.isEmpty()) return false;
 
-                // convert content size to world coordinates
-                Size2 halfWorldSize;
+            Vector3 center = (box.min + box.max) * 0.5f;
+            Vector3 extent = (box.max - box.min) * 0.5f;
 
-                halfWorldSize.width = std::max(fabsf(halfSize.width * boxTransform.m[0] + halfSize.height * boxTransform.m[4]),
-                                               fabsf(halfSize.width * boxTransform.m[0] - halfSize.height * boxTransform.m[4]));
-                halfWorldSize.height = std::max(fabsf(halfSize.width * boxTransform.m[1] + halfSize.height * boxTransform.m[5]),
-                                                fabsf(halfSize.width * boxTransform.m[1] - halfSize.height * boxTransform.m[5]));
+            // enclose the transformed box in a world space axis aligned box
+            const float* m = boxTransform.m;
+            Vector3 worldCenter = center;
+            boxTransform.transformPoint(worldCenter);
+            Vector3 worldExtent(fabsf(m[0]) * extent.x + fabsf(m[4]) * extent.y + fabsf(m[8]) * extent.z,
+                                fabsf(m[1]) * extent.x + fabsf(m[5]) * extent.y + fabsf(m[9]) * extent.z,
+                                fabsf(m[2]) * extent.x + fabsf(m[6]) * extent.y + fabsf(m[10]) * extent.z);
 
-                // scale half size by camera projection to get the size in clip space coordinates
-                halfWorldSize.width *= (fabsf(viewProjection.m[0]) + fabsf(viewProjection.m[4])) / 2.0f;
-                halfWorldSize.height *= (fabsf(viewProjection.m[1]) + fabsf(viewProjection.m[5])) / 2.0f;
+            return frustum.isBoxInside(worldCenter, worldExtent);
+        }
 
-                // create visible rect in clip space
-                Rectangle visibleRect(-halfWorldSize.width,
-                                      -halfWorldSize.height,
-                                      1.0f + halfWorldSize.width * 2.0f,
-                                      1.0f + halfWorldSize.height * 2.0f);
+        void Camera::checkVisibility(const Box3Array& boxes, std::vector<uint32_t>& visibility) const
+        {
+            if (viewProjectionDirty)
+            {
+                calculateViewProjection();
+            }
 
-                return visibleRect.containsPoint(v2p);
+            if (frustumValid)
+            {
+                frustum.checkBoxes(boxes, visibility);
             }
             else
             {
-                Matrix4 modelViewProjection = getViewProjection() * boxTransform;
-
-                ConvexVolume frustum;
-
-                if (!modelViewProjection.getFrustum(frustum)) return false;
-
-                //if (!frustum.isPointInside(Vector4(0.0f, 0.0f, 0.0f, 1.0f))) return false;
-                if (!frustum.isBoxInside(box)) return false;
-
-                return true;
+                visibility.assign((boxes.size() + 31) / 32, 0);
             }
         }
 
@@ -5,6 +5,8 @@
 
 #include <memory>
 #include "scene/Component.hpp"
+#include "math/Box3Array.hpp"
+#include "math/ConvexVolume.hpp"
 #include "math/MathUtils.hpp"
 #include "math/Rectangle.hpp"
 #include "graphics/Texture.hpp"
@@ -53,6 +55,7 @@ namespace ouzel
             void setFarPlane(float newFarPlane) { farPlane = newFarPlane; }
             float getFarPlane() const { return farPlane; }
 
+            void setProjection(const Matrix4& newProjection);
             const Matrix4& getProjection() const { return projection; }
             void recalculateProjection();
 
@@ -63,7 +66,12 @@ namespace ouzel
             Vector3 convertNormalizedToWorld(const Vector2& normalizedPosition) const;
             Vector2 convertWorldToNormalized(const Vector3& worldPosition) const;
 
+            // world space frustum, orthographic cameras ignore the near and far planes
+            const ConvexVolume& getFrustum() const;
+
             bool checkVisibility(const Matrix4& boxTransform, const Box3& box) const;
+            // tests world space boxes, bit i of visibility is set if box i is visible
+            void checkVisibility(const Box3Array& boxes, std::vector<uint32_t>& visibility) const;
 
             void setViewport(const Rectangle& newViewport);
             const Rectangle& getViewport() const { return viewport; }
@@ -120,6 +128,8 @@ namespace ouzel
             mutable bool viewProjectionDirty = true;
             mutable Matrix4 viewProjection;
             mutable Matrix4 renderViewProjection;
+            mutable ConvexVolume frustum;
+            mutable bool frustumValid = false;
 
             mutable bool inverseViewProjectionDirty = true;
             mutable Matrix4 inverseViewProjection;
@@ -32,6 +32,29 @@ namespace ouzel
         {
         }
 
+        bool Component::getInstance(const Matrix4&,
+                                    float,
+                                    bool,
+                                    InstanceBatcher::Key&,
+                                    graphics::InstanceData&) const
+        {
+            return false;
+        }
+
+        void Component::setBoundingBox(const Box3& newBoundingBox)
+        {
+            boundingBox = newBoundingBox;
+
+            markDirty();
+        }
+
+        void Component::setHidden(bool newHidden)
+        {
+            hidden = newHidden;
+
+            markDirty();
+        }
+
         bool Component::pointOn(const Vector2& position) const
         {
             return boundingBox.containsPoint(position);
@@ -115,5 +138,10 @@ namespace ouzel
         void Component::updateTransform()
         {
         }
+
+        void Component::markDirty()
+        {
+            if (actor) actor->markDirty();
+        }
     } // namespace scene
 } // namespace ouzel
@@ -11,6 +11,8 @@
 #include "math/Color.hpp"
 #include "math/Rectangle.hpp"
 #include "graphics/Texture.hpp"
+#include "graphics/Vertex.hpp"
+#include "scene/InstanceBatcher.hpp"
 
 namespace ouzel
 {
@@ -55,14 +57,21 @@ namespace ouzel
                               bool scissorTest,
                               const Rectangle& scissorRectangle);
 
-            virtual void setBoundingBox(const Box3& newBoundingBox) { boundingBox = newBoundingBox; }
+            // fills in the batch key and the per-instance data if the component can be drawn with instancing
+            virtual bool getInstance(const Matrix4& transformMatrix,
+                                     float opacity,
+                                     bool wireframe,
+                                     InstanceBatcher::Key& key,
+                                     graphics::InstanceData& instance) const;
+
+            virtual void setBoundingBox(const Box3& newBoundingBox);
             virtual const Box3& getBoundingBox() const { return boundingBox; }
 
             virtual bool pointOn(const Vector2& position) const;
             virtual bool shapeOverlaps(const std::vector<Vector2>& edges) const;
 
             bool isHidden() const { return hidden; }
-            void setHidden(bool newHidden) { hidden = newHidden; }
+            void setHidden(bool newHidden);
 
             Actor* getActor() const { return actor; }
             void removeFromActor();
@@ -72,6 +81,9 @@ namespace ouzel
             virtual void setLayer(Layer* newLayer);
             virtual void updateTransform();
 
+            // tells the actor that the component's appearance has changed
+            void markDirty();
+
             uint32_t type;
 
             Box3 boundingBox;
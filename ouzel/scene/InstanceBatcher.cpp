@@ -0,0 +1,162 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "InstanceBatcher.hpp"
+#include "Camera.hpp"
+#include "Component.hpp"
+#include "core/Engine.hpp"
+#include "graphics/RenderDevice.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        bool InstanceBatcher::Key::operator==(const Key& other) const
+        {
+            if (meshBuffer != other.meshBuffer ||
+                shader != other.shader ||
+                blendState != other.blendState ||
+                cullMode != other.cullMode)
+            {
+                return false;
+            }
+
+            for (uint32_t layer = 0; layer < graphics::Texture::LAYERS; ++layer)
+            {
+                if (textures[layer] != other.textures[layer]) return false;
+            }
+
+            return true;
+        }
+
+        void InstanceBatcher::begin()
+        {
+            graphics::Renderer* renderer = sharedEngine->getRenderer();
+
+            active = renderer->getDevice()->isInstancingSupported();
+
+            if (active)
+            {
+                textureShader = sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE);
+                instancedShader = sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE_INSTANCED);
+                active = textureShader && instancedShader;
+            }
+
+            usedInstanceBuffers = 0;
+        }
+
+        void InstanceBatcher::end()
+        {
+            flush();
+            active = false;
+        }
+
+        bool InstanceBatcher::addInstance(Component* component,
+                                          const Matrix4& transformMatrix,
+                                          float opacity,
+                                          Camera* newCamera,
+                                          bool newWireframe)
+        {
+            Key newKey;
+            graphics::InstanceData instance;
+
+            // only the default texture shader has an instanced variant
+            if (!active ||
+                !component->getInstance(transformMatrix, opacity, newWireframe, newKey, instance) ||
+                newKey.shader != textureShader)
+            {
+                flush();
+                return false;
+            }
+
+            if (instances.empty() ||
+                instances.size() >= MAX_INSTANCES ||
+                newCamera != camera ||
+                newWireframe != wireframe ||
+                newKey != key)
+            {
+                flush();
+
+                key = newKey;
+                camera = newCamera;
+                wireframe = newWireframe;
+
+                firstComponent = component;
+                firstTransform = transformMatrix;
+                firstOpacity = opacity;
+            }
+
+            instances.push_back(instance);
+
+            return true;
+        }
+
+        void InstanceBatcher::flush()
+        {
+            if (instances.empty()) return;
+
+            if (instances.size() == 1)
+            {
+                firstComponent->draw(firstTransform,
+                                     firstOpacity,
+                                     camera->getRenderViewProjection(),
+                                     camera->getRenderTarget(),
+                                     camera->getRenderViewport(),
+                                     camera->getDepthWrite(),
+                                     camera->getDepthTest(),
+                                     wireframe,
+                                     false,
+                                     Rectangle());
+            }
+            else
+            {
+                if (usedInstanceBuffers == instanceBuffers.size())
+                {
+                    std::shared_ptr<graphics::Buffer> instanceBuffer = std::make_shared<graphics::Buffer>();
+                    instanceBuffer->init(graphics::Buffer::Usage::VERTEX, graphics::Buffer::DYNAMIC);
+                    instanceBuffers.push_back(instanceBuffer);
+                }
+
+                const std::shared_ptr<graphics::Buffer>& instanceBuffer = instanceBuffers[usedInstanceBuffers++];
+                instanceBuffer->setData(instances.data(), static_cast<uint32_t>(instances.size() * sizeof(graphics::InstanceData)));
+
+                // the color of each instance is in the instance data
+                float colorVector[] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+                std::vector<std::vector<float>> pixelShaderConstants(1);
+                pixelShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
+
+                const Matrix4& viewProjection = camera->getRenderViewProjection();
+
+                std::vector<std::vector<float>> vertexShaderConstants(1);
+                vertexShaderConstants[0] = {std::begin(viewProjection.m), std::end(viewProjection.m)};
+
+                std::vector<std::shared_ptr<graphics::Texture>> textures(std::begin(key.textures), std::end(key.textures));
+
+                sharedEngine->getRenderer()->addDrawCommand(textures,
+                                                            instancedShader,
+                                                            pixelShaderConstants,
+                                                            vertexShaderConstants,
+                                                            key.blendState,
+                                                            key.meshBuffer,
+                                                            0,
+                                                            graphics::Renderer::DrawMode::TRIANGLE_LIST,
+                                                            0,
+                                                            camera->getRenderTarget(),
+                                                            camera->getRenderViewport(),
+                                                            camera->getDepthWrite(),
+                                                            camera->getDepthTest(),
+                                                            wireframe,
+                                                            false,
+                                                            Rectangle(),
+                                                            key.cullMode,
+                                                            instanceBuffer,
+                                                            static_cast<uint32_t>(instances.size()));
+            }
+
+            instances.clear();
+            key = Key();
+            firstComponent = nullptr;
+        }
+    } // namespace scene
+} // namespace ouzel
@@ -0,0 +1,78 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "utils/Noncopyable.hpp"
+#include "math/Matrix4.hpp"
+#include "graphics/BlendState.hpp"
+#include "graphics/Buffer.hpp"
+#include "graphics/MeshBuffer.hpp"
+#include "graphics/Renderer.hpp"
+#include "graphics/Shader.hpp"
+#include "graphics/Texture.hpp"
+#include "graphics/Vertex.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        class Camera;
+        class Component;
+
+        // Collects consecutive components that draw the same mesh with the same material
+        // and draws them with one instanced draw call, so the draw order is preserved
+        class InstanceBatcher: public Noncopyable
+        {
+        public:
+            struct Key
+            {
+                std::shared_ptr<graphics::MeshBuffer> meshBuffer;
+                std::shared_ptr<graphics::Texture> textures[graphics::Texture::LAYERS];
+                std::shared_ptr<graphics::Shader> shader;
+                std::shared_ptr<graphics::BlendState> blendState;
+                graphics::Renderer::CullMode cullMode = graphics::Renderer::CullMode::NONE;
+
+                bool operator==(const Key& other) const;
+                bool operator!=(const Key& other) const { return !(*this == other); }
+            };
+
+            static const uint32_t MAX_INSTANCES = 4096;
+
+            // instance buffers are reused from the previous frame
+            void begin();
+            void end();
+
+            bool isActive() const { return active; }
+
+            // returns false if the component has to be drawn on its own, the pending instances are drawn before returning
+            bool addInstance(Component* component,
+                             const Matrix4& transformMatrix,
+                             float opacity,
+                             Camera* newCamera,
+                             bool newWireframe);
+            void flush();
+
+        protected:
+            bool active = false;
+            std::shared_ptr<graphics::Shader> textureShader;
+            std::shared_ptr<graphics::Shader> instancedShader;
+
+            Key key;
+            Camera* camera = nullptr;
+            bool wireframe = false;
+            std::vector<graphics::InstanceData> instances;
+
+            // a batch of one is drawn by the component itself
+            Component* firstComponent = nullptr;
+            Matrix4 firstTransform;
+            float firstOpacity = 1.0f;
+
+            // every batch of a frame needs its own buffer, because the draw commands are executed after all of them are filled
+            std::vector<std::shared_ptr<graphics::Buffer>> instanceBuffers;
+            size_t usedInstanceBuffers = 0;
+        };
+    } // namespace scene
+} // namespace ouzel
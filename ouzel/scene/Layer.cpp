@@ -32,14 +32,11 @@ namespace ouzel
 
         void Layer::draw()
         {
+            instanceBatcher.begin();
+
             for (Camera* camera : cameras)
             {
-                std::vector<Actor*> drawQueue;
-
-                for (Actor* actor : children)
-                {
-                    actor->visit(drawQueue, Matrix4::IDENTITY, false, camera, 0, false);
-                }
+                cull(camera);
 
                 for (Actor* actor : drawQueue)
                 {
@@ -51,6 +48,47 @@ namespace ouzel
                     }
                 }
             }
+
+            instanceBatcher.end();
+        }
+
+        void Layer::cull(Camera* camera)
+        {
+            drawQueue.clear();
+
+            for (Actor* actor : children)
+            {
+                actor->visit(drawQueue, Matrix4::IDENTITY, false, camera, 0, false);
+            }
+
+            boundingBoxes.clear();
+            boundingBoxes.reserve(drawQueue.size());
+
+            for (Actor* actor : drawQueue)
+            {
+                boundingBoxes.add(actor->getTransform(), actor->getBoundingBox());
+            }
+
+            camera->checkVisibility(boundingBoxes, visibility);
+
+            size_t visibleCount = 0;
+
+            for (size_t i = 0; i < drawQueue.size(); ++i)
+            {
+                Actor* actor = drawQueue[i];
+
+                if (actor->isCullDisabled() || (visibility[i / 32] & (1U << (i % 32))))
+                {
+                    drawQueue[visibleCount++] = actor;
+                }
+            }
+
+            drawQueue.resize(visibleCount);
+
+            // stable, so that actors with the same order are drawn in the order they were visited
+            std::stable_sort(drawQueue.begin(), drawQueue.end(), [](Actor* a, Actor* b) {
+                return a->getWorldOrder() > b->getWorldOrder();
+            });
         }
 
         void Layer::addChildActor(Actor* actor)
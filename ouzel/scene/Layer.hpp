@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <vector>
 #include "scene/ActorContainer.hpp"
+#include "scene/InstanceBatcher.hpp"
+#include "math/Box3Array.hpp"
 #include "math/Vector2.hpp"
 
 namespace ouzel
@@ -29,6 +31,8 @@ namespace ouzel
 
             const std::vector<Camera*>& getCameras() const { return cameras; }
 
+            InstanceBatcher* getInstanceBatcher() { return &instanceBatcher; }
+
             std::pair<Actor*, ouzel::Vector3> pickActor(const Vector2& position, bool renderTargets = false) const;
             std::vector<std::pair<Actor*, ouzel::Vector3>> pickActors(const Vector2& position, bool renderTargets = false) const;
             std::vector<Actor*> pickActors(const std::vector<Vector2>& edges, bool renderTargets = false) const;
@@ -48,6 +52,9 @@ namespace ouzel
             void addLight(Light* light);
             void removeLight(Light* light);
 
+            // fills the draw queue with the actors visible to the camera, sorted by their order
+            void cull(Camera* camera);
+
             virtual void recalculateProjection();
             virtual void enter() override;
 
@@ -56,6 +63,12 @@ namespace ouzel
             std::vector<Camera*> cameras;
             std::vector<Light*> lights;
 
+            // reused between frames
+            std::vector<Actor*> drawQueue;
+            Box3Array boundingBoxes;
+            std::vector<uint32_t> visibility;
+            InstanceBatcher instanceBatcher;
+
             int32_t order = 0;
         };
     } // namespace scene
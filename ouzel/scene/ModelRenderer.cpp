@@ -1,6 +1,8 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <iterator>
 #include "ModelRenderer.hpp"
 #include "core/Engine.hpp"
 
@@ -98,5 +100,28 @@ namespace ouzel
                                                         scissorRectangle,
                                                         material->cullMode);
         }
+
+        bool ModelRenderer::getInstance(const Matrix4& transformMatrix,
+                                        float opacity,
+                                        bool wireframe,
+                                        InstanceBatcher::Key& key,
+                                        graphics::InstanceData& instance) const
+        {
+            if (!material || !meshBuffer) return false;
+
+            key.meshBuffer = meshBuffer;
+            if (wireframe) key.textures[0] = whitePixelTexture;
+            else std::copy(std::begin(material->textures), std::end(material->textures), std::begin(key.textures));
+            key.shader = material->shader;
+            key.blendState = material->blendState;
+            key.cullMode = graphics::Renderer::CullMode::NONE; // same as in draw
+
+            Color color = material->diffuseColor;
+            color.a = static_cast<uint8_t>(color.a * opacity * material->opacity + 0.5f);
+
+            instance = graphics::InstanceData(transformMatrix, color);
+
+            return true;
+        }
     } // namespace scene
 } // namespace ouzel
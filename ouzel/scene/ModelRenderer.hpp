@@ -33,6 +33,12 @@ namespace ouzel
                               bool scissorTest,
                               const Rectangle& scissorRectangle) override;
 
+            virtual bool getInstance(const Matrix4& transformMatrix,
+                                     float opacity,
+                                     bool wireframe,
+                                     InstanceBatcher::Key& key,
+                                     graphics::InstanceData& instance) const override;
+
             virtual const std::shared_ptr<graphics::Material>& getMaterial() const { return material; }
             virtual void setMaterial(const std::shared_ptr<graphics::Material>& newMaterial) { material = newMaterial; }
 
@@ -224,6 +224,7 @@ namespace ouzel
 
                     needsMeshUpdate = true;
                     needsBoundingBoxUpdate = true;
+                    markDirty();
                 }
             }
 
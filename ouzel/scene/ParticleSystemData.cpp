@@ -1,16 +1,73 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <iterator>
 #include "json.hpp"
 #include "ParticleSystemData.hpp"
 #include "core/Engine.hpp"
 #include "files/FileSystem.hpp"
 #include "utils/Log.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace scene
     {
+        static const uint8_t BINARY_MAGIC[] = {'O', 'P', 'R', 'T'};
+        static const uint32_t BINARY_VERSION = 2;
+
+        // all float and vector fields in the order they are stored in the binary format
+        static float ParticleSystemData::* const FLOAT_FIELDS[] = {
+            &ParticleSystemData::duration,
+            &ParticleSystemData::particleLifespan,
+            &ParticleSystemData::particleLifespanVariance,
+            &ParticleSystemData::speed,
+            &ParticleSystemData::speedVariance,
+            &ParticleSystemData::startParticleSize,
+            &ParticleSystemData::startParticleSizeVariance,
+            &ParticleSystemData::finishParticleSize,
+            &ParticleSystemData::finishParticleSizeVariance,
+            &ParticleSystemData::angle,
+            &ParticleSystemData::angleVariance,
+            &ParticleSystemData::startRotation,
+            &ParticleSystemData::startRotationVariance,
+            &ParticleSystemData::finishRotation,
+            &ParticleSystemData::finishRotationVariance,
+            &ParticleSystemData::rotatePerSecond,
+            &ParticleSystemData::rotatePerSecondVariance,
+            &ParticleSystemData::minRadius,
+            &ParticleSystemData::minRadiusVariance,
+            &ParticleSystemData::maxRadius,
+            &ParticleSystemData::maxRadiusVariance,
+            &ParticleSystemData::radialAcceleration,
+            &ParticleSystemData::radialAccelVariance,
+            &ParticleSystemData::tangentialAcceleration,
+            &ParticleSystemData::tangentialAccelVariance,
+            &ParticleSystemData::startColorRed,
+            &ParticleSystemData::startColorGreen,
+            &ParticleSystemData::startColorBlue,
+            &ParticleSystemData::startColorAlpha,
+            &ParticleSystemData::startColorRedVariance,
+            &ParticleSystemData::startColorGreenVariance,
+            &ParticleSystemData::startColorBlueVariance,
+            &ParticleSystemData::startColorAlphaVariance,
+            &ParticleSystemData::finishColorRed,
+            &ParticleSystemData::finishColorGreen,
+            &ParticleSystemData::finishColorBlue,
+            &ParticleSystemData::finishColorAlpha,
+            &ParticleSystemData::finishColorRedVariance,
+            &ParticleSystemData::finishColorGreenVariance,
+            &ParticleSystemData::finishColorBlueVariance,
+            &ParticleSystemData::finishColorAlphaVariance
+        };
+
+        static Vector2 ParticleSystemData::* const VECTOR_FIELDS[] = {
+            &ParticleSystemData::sourcePosition,
+            &ParticleSystemData::sourcePositionVariance,
+            &ParticleSystemData::gravity
+        };
+
         bool ParticleSystemData::init(const std::string& filename, bool mipmaps)
         {
             std::vector<uint8_t> data;
@@ -22,7 +79,49 @@ namespace ouzel
             return init(data, mipmaps);
         }
 
+        bool ParticleSystemData::isBinary(const std::vector<uint8_t>& data)
+        {
+            return data.size() >= sizeof(BINARY_MAGIC) &&
+                std::equal(std::begin(BINARY_MAGIC), std::end(BINARY_MAGIC), data.begin());
+        }
+
+        bool ParticleSystemData::compile(const std::vector<uint8_t>& data, std::vector<uint8_t>& result)
+        {
+            ParticleSystemData particleSystemData;
+            std::string textureFilename;
+
+            if (!particleSystemData.parseJSON(data, textureFilename))
+            {
+                return false;
+            }
+
+            return particleSystemData.encode(textureFilename, result);
+        }
+
         bool ParticleSystemData::init(const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            std::string textureFilename;
+
+            if (isBinary(data))
+            {
+                if (!decode(data, textureFilename))
+                {
+                    return false;
+                }
+            }
+            else if (!parseJSON(data, textureFilename))
+            {
+                return false;
+            }
+
+            texture = sharedEngine->getCache()->getTexture(textureFilename, mipmaps);
+
+            emissionRate = static_cast<float>(maxParticles) / particleLifespan;
+
+            return true;
+        }
+
+        bool ParticleSystemData::parseJSON(const std::vector<uint8_t>& data, std::string& textureFilename)
         {
             nlohmann::json document = nlohmann::json::parse(data);
 
@@ -111,9 +210,97 @@ namespace ouzel
             if (document.find("finishColorVarianceBlue") != document.end()) finishColorBlueVariance = document["finishColorVarianceBlue"].get<float>();
             if (document.find("finishColorVarianceAlpha") != document.end()) finishColorAlphaVariance = document["finishColorVarianceAlpha"].get<float>();
 
-            if (document.find("textureFileName") != document.end()) texture = sharedEngine->getCache()->getTexture(document["textureFileName"].get<std::string>(), mipmaps);
+            textureFilename = document["textureFileName"].get<std::string>();
 
-            emissionRate = static_cast<float>(maxParticles) / particleLifespan;
+            return true;
+        }
+
+        bool ParticleSystemData::encode(const std::string& textureFilename, std::vector<uint8_t>& result) const
+        {
+            result.assign(std::begin(BINARY_MAGIC), std::end(BINARY_MAGIC));
+            writeUInt32Little(result, BINARY_VERSION);
+
+            if (!writeStringLittle(result, name) ||
+                !writeStringLittle(result, textureFilename))
+            {
+                return false;
+            }
+
+            writeUInt32Little(result, blendFuncSource);
+            writeUInt32Little(result, blendFuncDestination);
+            writeUInt32Little(result, maxParticles);
+            writeUInt8(result, static_cast<uint8_t>(emitterType));
+            writeUInt8(result, static_cast<uint8_t>(positionType));
+            writeUInt8(result, absolutePosition ? 1 : 0);
+            writeUInt8(result, yCoordFlipped ? 1 : 0);
+            writeUInt8(result, rotationIsDir ? 1 : 0);
+
+            for (float ParticleSystemData::* field : FLOAT_FIELDS)
+            {
+                writeFloatLittle(result, this->*field);
+            }
+
+            for (Vector2 ParticleSystemData::* field : VECTOR_FIELDS)
+            {
+                writeFloatLittle(result, (this->*field).x);
+                writeFloatLittle(result, (this->*field).y);
+            }
+
+            return true;
+        }
+
+        bool ParticleSystemData::decode(const std::vector<uint8_t>& data, std::string& textureFilename)
+        {
+            uint32_t offset = sizeof(BINARY_MAGIC);
+
+            uint32_t version;
+            if (!readUInt32Little(data, offset, version) || version != BINARY_VERSION)
+            {
+                return false;
+            }
+
+            uint8_t emitterTypeValue;
+            uint8_t positionTypeValue;
+            uint8_t absolutePositionValue;
+            uint8_t yCoordFlippedValue;
+            uint8_t rotationIsDirValue;
+
+            if (!readStringLittle(data, offset, name) ||
+                !readStringLittle(data, offset, textureFilename) ||
+                !readUInt32Little(data, offset, blendFuncSource) ||
+                !readUInt32Little(data, offset, blendFuncDestination) ||
+                !readUInt32Little(data, offset, maxParticles) ||
+                !readUInt8(data, offset, emitterTypeValue) ||
+                !readUInt8(data, offset, positionTypeValue) ||
+                !readUInt8(data, offset, absolutePositionValue) ||
+                !readUInt8(data, offset, yCoordFlippedValue) ||
+                !readUInt8(data, offset, rotationIsDirValue))
+            {
+                return false;
+            }
+
+            if (data.size() - offset < (sizeof(FLOAT_FIELDS) / sizeof(FLOAT_FIELDS[0]) +
+                                        2 * sizeof(VECTOR_FIELDS) / sizeof(VECTOR_FIELDS[0])) * sizeof(float))
+            {
+                return false;
+            }
+
+            for (float ParticleSystemData::* field : FLOAT_FIELDS)
+            {
+                readFloatLittle(data, offset, this->*field);
+            }
+
+            for (Vector2 ParticleSystemData::* field : VECTOR_FIELDS)
+            {
+                readFloatLittle(data, offset, (this->*field).x);
+                readFloatLittle(data, offset, (this->*field).y);
+            }
+
+            emitterType = static_cast<EmitterType>(emitterTypeValue);
+            positionType = static_cast<PositionType>(positionTypeValue);
+            absolutePosition = absolutePositionValue != 0;
+            yCoordFlipped = yCoordFlippedValue != 0;
+            rotationIsDir = rotationIsDirValue != 0;
 
             return true;
         }
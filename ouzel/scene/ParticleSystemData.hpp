@@ -16,6 +16,10 @@ namespace ouzel
             bool init(const std::string& filename, bool mipmaps = true);
             bool init(const std::vector<uint8_t>& data, bool mipmaps = true);
 
+            // converts a JSON particle system to the binary format accepted by init
+            static bool compile(const std::vector<uint8_t>& data, std::vector<uint8_t>& result);
+            static bool isBinary(const std::vector<uint8_t>& data);
+
             enum class EmitterType
             {
                 GRAVITY,
@@ -107,6 +111,11 @@ namespace ouzel
             float emissionRate = 0.0f;
 
             std::shared_ptr<graphics::Texture> texture;
+
+        private:
+            bool parseJSON(const std::vector<uint8_t>& data, std::string& textureFilename);
+            bool decode(const std::vector<uint8_t>& data, std::string& textureFilename);
+            bool encode(const std::string& textureFilename, std::vector<uint8_t>& result) const;
         };
     } // namespace scene
 } // namespace ouzel
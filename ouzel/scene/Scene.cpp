@@ -38,9 +38,16 @@ namespace ouzel
                 return a->getOrder() > b->getOrder();
             });
 
-            for (Layer* layer : layers)
+            if (sceneManger)
+            {
+                sceneManger->drawLayers(layers);
+            }
+            else
             {
-                layer->draw();
+                for (Layer* layer : layers)
+                {
+                    layer->draw();
+                }
             }
         }
 
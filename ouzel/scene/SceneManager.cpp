@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "SceneManager.hpp"
 #include "Scene.hpp"
+#include "Layer.hpp"
 #include "core/Engine.hpp"
 #include "Actor.hpp"
 
@@ -11,12 +12,27 @@ namespace ouzel
 {
     namespace scene
     {
-        SceneManager::SceneManager()
+        SceneManager::SceneManager():
+            nextLayer(0)
         {
         }
 
         SceneManager::~SceneManager()
         {
+#if OUZEL_MULTITHREADED
+            {
+                std::lock_guard<std::mutex> lock(drawMutex);
+                drawThreadsRunning = false;
+            }
+
+            drawCondition.notify_all();
+
+            for (std::thread& drawThread : drawThreads)
+            {
+                if (drawThread.joinable()) drawThread.join();
+            }
+#endif
+
             for (Scene* scene : scenes)
             {
                 if (scene->entered) scene->leave();
@@ -77,5 +93,111 @@ namespace ouzel
                 scene->draw();
             }
         }
+
+        void SceneManager::drawLayers(const std::vector<Layer*>& layers)
+        {
+            graphics::RenderDevice* renderDevice = sharedEngine->getRenderer()->getDevice();
+
+            if (!recordingThreadAdded)
+            {
+                renderDevice->addRecordingThread(std::this_thread::get_id());
+                recordingThreadAdded = true;
+            }
+
+            if (commandLists.size() < layers.size()) commandLists.resize(layers.size());
+
+            currentLayers = &layers;
+            nextLayer = 0;
+
+#if OUZEL_MULTITHREADED
+            // the draw threads are started only when the layers are drawn in parallel for the first time
+            if (parallelDraw && layers.size() > 1 && !drawThreadsStarted)
+            {
+                uint32_t threadCount = std::thread::hardware_concurrency();
+                if (threadCount > MAX_DRAW_THREADS) threadCount = MAX_DRAW_THREADS;
+
+                drawThreadsRunning = true;
+
+                // the update thread records its share of the layers, the new threads wait for the next generation,
+                // so they are registered before any of them records
+                for (uint32_t i = 1; i < threadCount; ++i)
+                {
+                    drawThreads.push_back(std::thread(&SceneManager::drawMain, this));
+                    renderDevice->addRecordingThread(drawThreads.back().get_id());
+                }
+
+                drawThreadsStarted = true;
+            }
+
+            if (parallelDraw && layers.size() > 1 && !drawThreads.empty())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(drawMutex);
+                    ++drawGeneration;
+                    pendingDrawThreads = static_cast<uint32_t>(drawThreads.size());
+                }
+
+                drawCondition.notify_all();
+
+                recordLayers();
+
+                std::unique_lock<std::mutex> lock(drawMutex);
+                drawFinishedCondition.wait(lock, [this]() { return pendingDrawThreads == 0; });
+            }
+            else
+#endif
+            {
+                recordLayers();
+            }
+
+            currentLayers = nullptr;
+
+            // the command lists are submitted in the layer order, no matter which thread recorded them
+            for (size_t i = 0; i < layers.size(); ++i)
+            {
+                renderDevice->submitCommandList(commandLists[i]);
+            }
+        }
+
+        void SceneManager::recordLayers()
+        {
+            graphics::RenderDevice* renderDevice = sharedEngine->getRenderer()->getDevice();
+
+            for (;;)
+            {
+                uint32_t layerIndex = nextLayer++;
+                if (layerIndex >= currentLayers->size()) break;
+
+                renderDevice->beginCommandList(commandLists[layerIndex]);
+                (*currentLayers)[layerIndex]->draw();
+                renderDevice->endCommandList();
+            }
+        }
+
+#if OUZEL_MULTITHREADED
+        void SceneManager::drawMain()
+        {
+            sharedEngine->setCurrentThreadName("Draw");
+
+            uint32_t generation = 0;
+
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(drawMutex);
+                    drawCondition.wait(lock, [this, generation]() { return !drawThreadsRunning || drawGeneration != generation; });
+
+                    if (!drawThreadsRunning) return;
+
+                    generation = drawGeneration;
+                }
+
+                recordLayers();
+
+                std::lock_guard<std::mutex> lock(drawMutex);
+                if (--pendingDrawThreads == 0) drawFinishedCondition.notify_all();
+            }
+        }
+#endif
     } // namespace scene
 } // namespace ouzel
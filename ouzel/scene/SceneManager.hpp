@@ -3,9 +3,17 @@
 
 #pragma once
 
+#include "core/Setup.h"
+
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include "utils/Noncopyable.hpp"
+#include "animators/TweenSystem.hpp"
+#include "graphics/RenderDevice.hpp"
 
 namespace ouzel
 {
@@ -13,16 +21,25 @@ namespace ouzel
 
     namespace scene
     {
+        class Layer;
         class Scene;
 
         class SceneManager: public Noncopyable
         {
             friend Engine;
+            friend Scene;
         public:
+            static const uint32_t MAX_DRAW_THREADS = 8;
+
             virtual ~SceneManager();
 
             void draw();
 
+            // records the layers on worker threads, off by default, because components that are drawn must not
+            // modify state shared between layers (text layouts are refreshed in the update phase for this reason)
+            bool isParallelDraw() const { return parallelDraw; }
+            void setParallelDraw(bool newParallelDraw) { parallelDraw = newParallelDraw; }
+
             void setScene(Scene* scene)
             {
                 addChildScene(scene);
@@ -47,13 +64,40 @@ namespace ouzel
             }
             Scene* getScene() const { return scenes.empty() ? nullptr : scenes.back(); }
 
+            TweenSystem* getTweenSystem() { return &tweenSystem; }
+
         protected:
             virtual void addChildScene(Scene* scene);
             virtual bool removeChildScene(Scene* scene);
             SceneManager();
 
+            void drawLayers(const std::vector<Layer*>& layers);
+            void recordLayers();
+
+            // declared before the scenes, so that it outlives the animators
+            TweenSystem tweenSystem;
+
             std::vector<Scene*> scenes;
             std::vector<std::unique_ptr<Scene>> ownedScenes;
+
+            bool parallelDraw = false;
+            bool recordingThreadAdded = false;
+            const std::vector<Layer*>* currentLayers = nullptr;
+            std::vector<graphics::RenderDevice::CommandList> commandLists; // one for each layer, reused between frames
+            std::atomic<uint32_t> nextLayer;
+
+#if OUZEL_MULTITHREADED
+            void drawMain();
+
+            std::vector<std::thread> drawThreads;
+            std::mutex drawMutex;
+            std::condition_variable drawCondition;
+            std::condition_variable drawFinishedCondition;
+            uint32_t drawGeneration = 0;
+            uint32_t pendingDrawThreads = 0;
+            bool drawThreadsRunning = false;
+            bool drawThreadsStarted = false;
+#endif
         };
     } // namespace scene
 } // namespace ouzel
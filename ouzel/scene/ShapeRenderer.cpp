@@ -98,6 +98,7 @@ namespace ouzel
             vertices.clear();
 
             dirty = true;
+            markDirty();
         }
 
         bool ShapeRenderer::line(const Vector2& start, const Vector2& finish, const Color& color, float thickness)
@@ -161,6 +162,7 @@ namespace ouzel
             drawCommands.push_back(command);
 
             dirty = true;
+            markDirty();
             return true;
         }
 
@@ -284,6 +286,7 @@ namespace ouzel
             drawCommands.push_back(command);
 
             dirty = true;
+            markDirty();
             return true;
         }
 
@@ -416,6 +419,7 @@ namespace ouzel
             drawCommands.push_back(command);
 
             dirty = true;
+            markDirty();
             return true;
         }
 
@@ -490,6 +494,7 @@ namespace ouzel
             drawCommands.push_back(command);
 
             dirty = true;
+            markDirty();
             return true;
         }
 
@@ -564,6 +569,7 @@ namespace ouzel
             drawCommands.push_back(command);
 
             dirty = true;
+            markDirty();
             return true;
         }
     } // namespace scene
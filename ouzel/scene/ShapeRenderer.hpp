@@ -64,10 +64,10 @@ namespace ouzel
                        float thickness = 0.0f);
 
             virtual const std::shared_ptr<graphics::Shader>& getShader() const { return shader; }
-            virtual void setShader(const std::shared_ptr<graphics::Shader>& newShader) { shader = newShader; }
+            virtual void setShader(const std::shared_ptr<graphics::Shader>& newShader) { shader = newShader; markDirty(); }
 
             virtual const std::shared_ptr<graphics::BlendState>& getBlendState() const { return blendState; }
-            virtual void setBlendState(const std::shared_ptr<graphics::BlendState>& newBlendState)  { blendState = newBlendState; }
+            virtual void setBlendState(const std::shared_ptr<graphics::BlendState>& newBlendState)  { blendState = newBlendState; markDirty(); }
 
         protected:
             struct DrawCommand
@@ -1,6 +1,8 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <iterator>
 #include "Sprite.hpp"
 #include "core/Setup.h"
 #include "core/Engine.hpp"
@@ -240,6 +242,29 @@ namespace ouzel
             }
         }
 
+        bool Sprite::getInstance(const Matrix4& transformMatrix,
+                                 float opacity,
+                                 bool wireframe,
+                                 InstanceBatcher::Key& key,
+                                 graphics::InstanceData& instance) const
+        {
+            if (currentFrame >= frames.size() || !material) return false;
+
+            key.meshBuffer = frames[currentFrame].getMeshBuffer();
+            if (wireframe) key.textures[0] = whitePixelTexture;
+            else std::copy(std::begin(material->textures), std::end(material->textures), std::begin(key.textures));
+            key.shader = material->shader;
+            key.blendState = material->blendState;
+            key.cullMode = material->cullMode;
+
+            Color color = material->diffuseColor;
+            color.a = static_cast<uint8_t>(color.a * opacity * material->opacity + 0.5f);
+
+            instance = graphics::InstanceData(transformMatrix * offsetMatrix, color);
+
+            return true;
+        }
+
         void Sprite::setOffset(const Vector2& newOffset)
         {
             offset = newOffset;
@@ -344,6 +369,8 @@ namespace ouzel
                 size.width = size.height = 0.0f;
                 boundingBox.reset();
             }
+
+            markDirty();
         }
     } // namespace scene
 } // namespace ouzel
@@ -51,8 +51,14 @@ namespace ouzel
                               bool scissorTest,
                               const Rectangle& scissorRectangle) override;
 
+            virtual bool getInstance(const Matrix4& transformMatrix,
+                                     float opacity,
+                                     bool wireframe,
+                                     InstanceBatcher::Key& key,
+                                     graphics::InstanceData& instance) const override;
+
             virtual const std::shared_ptr<graphics::Material>& getMaterial() const { return material; }
-            virtual void setMaterial(const std::shared_ptr<graphics::Material>& newMaterial) { material = newMaterial; }
+            virtual void setMaterial(const std::shared_ptr<graphics::Material>& newMaterial) { material = newMaterial; markDirty(); }
 
             virtual const Size2& getSize() const { return size; }
 
@@ -66,6 +72,7 @@ namespace ouzel
 
             const std::vector<SpriteFrame>& getFrames() const { return frames; }
             virtual void setCurrentFrame(uint32_t frame);
+            uint32_t getCurrentFrame() const { return currentFrame; }
 
         protected:
             void updateBoundingBox();
@@ -2,14 +2,27 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include <iterator>
 #include "json.hpp"
 #include "SpriteData.hpp"
 #include "core/Engine.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace scene
     {
+        static const uint8_t BINARY_MAGIC[] = {'O', 'S', 'P', 'R'};
+        static const uint32_t BINARY_VERSION = 2;
+        // name length, frame rectangle, source size, source offset, pivot and flags
+        static const uint32_t MIN_FRAME_SIZE = sizeof(uint16_t) + 8 * sizeof(int32_t) + 2 * sizeof(float) + sizeof(uint8_t);
+
+        enum FrameFlags: uint8_t
+        {
+            FRAME_ROTATED = 0x01,
+            FRAME_MESH = 0x02
+        };
+
         bool SpriteData::init(const std::string& filename, bool mipmaps)
         {
             std::vector<uint8_t> data;
@@ -21,7 +34,114 @@ namespace ouzel
             return init(data, mipmaps);
         }
 
+        bool SpriteData::isBinary(const std::vector<uint8_t>& data)
+        {
+            return data.size() >= sizeof(BINARY_MAGIC) &&
+                std::equal(std::begin(BINARY_MAGIC), std::end(BINARY_MAGIC), data.begin());
+        }
+
+        bool SpriteData::compile(const std::vector<uint8_t>& data, std::vector<uint8_t>& result)
+        {
+            nlohmann::json document = nlohmann::json::parse(data);
+
+            if (document.find("meta") == document.end() ||
+                document.find("frames") == document.end())
+            {
+                return false;
+            }
+
+            const nlohmann::json& metaObject = document["meta"];
+            const nlohmann::json& framesArray = document["frames"];
+
+            result.assign(std::begin(BINARY_MAGIC), std::end(BINARY_MAGIC));
+            writeUInt32Little(result, BINARY_VERSION);
+            if (!writeStringLittle(result, metaObject["image"].get<std::string>()))
+            {
+                return false;
+            }
+
+            writeUInt32Little(result, static_cast<uint32_t>(framesArray.size()));
+
+            for (const nlohmann::json& frameObject : framesArray)
+            {
+                if (!writeStringLittle(result, frameObject["filename"].get<std::string>()))
+                {
+                    return false;
+                }
+
+                const nlohmann::json& frameRectangleObject = frameObject["frame"];
+                writeUInt32Little(result, static_cast<uint32_t>(frameRectangleObject["x"].get<int32_t>()));
+                writeUInt32Little(result, static_cast<uint32_t>(frameRectangleObject["y"].get<int32_t>()));
+                writeUInt32Little(result, static_cast<uint32_t>(frameRectangleObject["w"].get<int32_t>()));
+                writeUInt32Little(result, static_cast<uint32_t>(frameRectangleObject["h"].get<int32_t>()));
+
+                const nlohmann::json& sourceSizeObject = frameObject["sourceSize"];
+                writeUInt32Little(result, static_cast<uint32_t>(sourceSizeObject["w"].get<int32_t>()));
+                writeUInt32Little(result, static_cast<uint32_t>(sourceSizeObject["h"].get<int32_t>()));
+
+                const nlohmann::json& spriteSourceSizeObject = frameObject["spriteSourceSize"];
+                writeUInt32Little(result, static_cast<uint32_t>(spriteSourceSizeObject["x"].get<int32_t>()));
+                writeUInt32Little(result, static_cast<uint32_t>(spriteSourceSizeObject["y"].get<int32_t>()));
+
+                const nlohmann::json& pivotObject = frameObject["pivot"];
+                writeFloatLittle(result, pivotObject["x"].get<float>());
+                writeFloatLittle(result, pivotObject["y"].get<float>());
+
+                if (frameObject.find("vertices") != frameObject.end() &&
+                    frameObject.find("verticesUV") != frameObject.end() &&
+                    frameObject.find("triangles") != frameObject.end())
+                {
+                    writeUInt8(result, FRAME_MESH);
+
+                    std::vector<uint16_t> indices;
+
+                    for (const nlohmann::json& triangleObject : frameObject["triangles"])
+                    {
+                        for (const nlohmann::json& indexObject : triangleObject)
+                        {
+                            indices.push_back(indexObject.get<uint16_t>());
+                        }
+                    }
+
+                    // reverse the vertices, so that they are counterclockwise
+                    std::reverse(indices.begin(), indices.end());
+
+                    writeUInt32Little(result, static_cast<uint32_t>(indices.size()));
+                    for (uint16_t index : indices)
+                    {
+                        writeUInt16Little(result, index);
+                    }
+
+                    const nlohmann::json& verticesObject = frameObject["vertices"];
+                    const nlohmann::json& verticesUVObject = frameObject["verticesUV"];
+
+                    writeUInt32Little(result, static_cast<uint32_t>(verticesObject.size()));
+                    for (size_t vertexIndex = 0; vertexIndex < verticesObject.size(); ++vertexIndex)
+                    {
+                        const nlohmann::json& vertexObject = verticesObject[vertexIndex];
+                        const nlohmann::json& vertexUVObject = verticesUVObject[vertexIndex];
+
+                        writeUInt32Little(result, static_cast<uint32_t>(vertexObject[0].get<int32_t>()));
+                        writeUInt32Little(result, static_cast<uint32_t>(vertexObject[1].get<int32_t>()));
+                        writeUInt32Little(result, static_cast<uint32_t>(vertexUVObject[0].get<int32_t>()));
+                        writeUInt32Little(result, static_cast<uint32_t>(vertexUVObject[1].get<int32_t>()));
+                    }
+                }
+                else
+                {
+                    writeUInt8(result, frameObject["rotated"].get<bool>() ? FRAME_ROTATED : 0);
+                }
+            }
+
+            return true;
+        }
+
         bool SpriteData::init(const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return isBinary(data) ? decode(data, mipmaps) : parseJSON(data, mipmaps);
+        }
+
+        bool SpriteData::parseJSON(const std::vector<uint8_t>& data, bool mipmaps)
         {
             nlohmann::json document = nlohmann::json::parse(data);
 
@@ -30,7 +150,7 @@ namespace ouzel
             {
                 return false;
             }
-            
+
             const nlohmann::json& metaObject = document["meta"];
 
             texture = sharedEngine->getCache()->getTexture(metaObject["image"].get<std::string>(), false, mipmaps);
@@ -40,6 +160,7 @@ namespace ouzel
                 return false;
             }
 
+            const Size2& textureSize = texture->getSize();
             const nlohmann::json& framesArray = document["frames"];
 
             frames.reserve(framesArray.size());
@@ -76,9 +197,7 @@ namespace ouzel
                 {
                     std::vector<uint16_t> indices;
 
-                    const nlohmann::json& trianglesObject = frameObject["triangles"];
-
-                    for (const nlohmann::json& triangleObject : trianglesObject)
+                    for (const nlohmann::json& triangleObject : frameObject["triangles"])
                     {
                         for (const nlohmann::json& indexObject : triangleObject)
                         {
@@ -89,12 +208,11 @@ namespace ouzel
                     // reverse the vertices, so that they are counterclockwise
                     std::reverse(indices.begin(), indices.end());
 
-                    std::vector<graphics::VertexPCT> vertices;
-
                     const nlohmann::json& verticesObject = frameObject["vertices"];
                     const nlohmann::json& verticesUVObject = frameObject["verticesUV"];
 
-                    const Size2& textureSize = texture->getSize();
+                    std::vector<graphics::VertexPCT> vertices;
+                    vertices.reserve(verticesObject.size());
 
                     Vector2 finalOffset(-sourceSize.width * pivot.x + sourceOffset.x,
                                         -sourceSize.height * pivot.y + (sourceSize.height - frameRectangle.size.height - sourceOffset.y));
@@ -116,9 +234,119 @@ namespace ouzel
                 }
                 else
                 {
-                    bool rotated = frameObject["rotated"].get<bool>();
+                    frames.push_back(SpriteFrame(name, textureSize, frameRectangle, frameObject["rotated"].get<bool>(), sourceSize, sourceOffset, pivot));
+                }
+            }
+
+            return true;
+        }
+
+        bool SpriteData::decode(const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            uint32_t offset = sizeof(BINARY_MAGIC);
+
+            uint32_t version;
+            if (!readUInt32Little(data, offset, version) || version != BINARY_VERSION)
+            {
+                return false;
+            }
+
+            std::string image;
+            uint32_t frameCount;
+            if (!readStringLittle(data, offset, image) ||
+                !readUInt32Little(data, offset, frameCount) ||
+                (data.size() - offset) / MIN_FRAME_SIZE < frameCount)
+            {
+                return false;
+            }
+
+            texture = sharedEngine->getCache()->getTexture(image, false, mipmaps);
+
+            if (!texture)
+            {
+                return false;
+            }
+
+            const Size2& textureSize = texture->getSize();
+
+            frames.reserve(frameCount);
+
+            for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+            {
+                std::string name;
+                int32_t x, y, width, height;
+                int32_t sourceWidth, sourceHeight;
+                int32_t sourceX, sourceY;
+                float pivotX, pivotY;
+                uint8_t flags;
+
+                if (!readStringLittle(data, offset, name) ||
+                    !readInt32Little(data, offset, x) || !readInt32Little(data, offset, y) ||
+                    !readInt32Little(data, offset, width) || !readInt32Little(data, offset, height) ||
+                    !readInt32Little(data, offset, sourceWidth) || !readInt32Little(data, offset, sourceHeight) ||
+                    !readInt32Little(data, offset, sourceX) || !readInt32Little(data, offset, sourceY) ||
+                    !readFloatLittle(data, offset, pivotX) || !readFloatLittle(data, offset, pivotY) ||
+                    !readUInt8(data, offset, flags))
+                {
+                    return false;
+                }
+
+                Rectangle frameRectangle(static_cast<float>(x), static_cast<float>(y),
+                                         static_cast<float>(width), static_cast<float>(height));
+                Size2 sourceSize(static_cast<float>(sourceWidth), static_cast<float>(sourceHeight));
+                Vector2 sourceOffset(static_cast<float>(sourceX), static_cast<float>(sourceY));
+                Vector2 pivot(pivotX, pivotY);
+
+                if (flags & FRAME_MESH)
+                {
+                    uint32_t indexCount;
+                    if (!readUInt32Little(data, offset, indexCount) ||
+                        (data.size() - offset) / sizeof(uint16_t) < indexCount)
+                    {
+                        return false;
+                    }
+
+                    std::vector<uint16_t> indices(indexCount);
+
+                    for (uint16_t& index : indices)
+                    {
+                        readUInt16Little(data, offset, index);
+                    }
+
+                    uint32_t vertexCount;
+                    if (!readUInt32Little(data, offset, vertexCount) ||
+                        (data.size() - offset) / (4 * sizeof(int32_t)) < vertexCount)
+                    {
+                        return false;
+                    }
+
+                    std::vector<graphics::VertexPCT> vertices;
+                    vertices.reserve(vertexCount);
+
+                    Vector2 finalOffset(-sourceSize.width * pivot.x + sourceOffset.x,
+                                        -sourceSize.height * pivot.y + (sourceSize.height - frameRectangle.size.height - sourceOffset.y));
+
+                    for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+                    {
+                        int32_t vertexX, vertexY, vertexU, vertexV;
+                        readInt32Little(data, offset, vertexX);
+                        readInt32Little(data, offset, vertexY);
+                        readInt32Little(data, offset, vertexU);
+                        readInt32Little(data, offset, vertexV);
 
-                    frames.push_back(SpriteFrame(name, texture->getSize(), frameRectangle, rotated, sourceSize, sourceOffset, pivot));
+                        vertices.push_back(graphics::VertexPCT(Vector3(static_cast<float>(vertexX) + finalOffset.x,
+                                                                       -static_cast<float>(vertexY) - finalOffset.y,
+                                                                       0.0f),
+                                                               Color::WHITE,
+                                                               Vector2(static_cast<float>(vertexU) / textureSize.width,
+                                                                       static_cast<float>(vertexV) / textureSize.height)));
+                    }
+
+                    frames.push_back(SpriteFrame(name, indices, vertices, frameRectangle, sourceSize, sourceOffset, pivot));
+                }
+                else
+                {
+                    frames.push_back(SpriteFrame(name, textureSize, frameRectangle, (flags & FRAME_ROTATED) != 0, sourceSize, sourceOffset, pivot));
                 }
             }
 
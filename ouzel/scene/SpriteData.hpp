@@ -16,8 +16,16 @@ namespace ouzel
             bool init(const std::string& filename, bool mipmaps = true);
             bool init(const std::vector<uint8_t>& data, bool mipmaps = true);
 
+            // converts a JSON sprite sheet to the binary format accepted by init
+            static bool compile(const std::vector<uint8_t>& data, std::vector<uint8_t>& result);
+            static bool isBinary(const std::vector<uint8_t>& data);
+
             std::vector<SpriteFrame> frames;
             std::shared_ptr<graphics::Texture> texture;
+
+        private:
+            bool parseJSON(const std::vector<uint8_t>& data, bool mipmaps);
+            bool decode(const std::vector<uint8_t>& data, bool mipmaps);
         };
     } // namespace scene
 } // namespace ouzel
@@ -17,15 +17,16 @@ namespace ouzel
                                    float aFontSize,
                                    const std::string& aText,
                                    Color aColor,
-                                   const Vector2& aTextAnchor):
+                                   const Vector2& aTextAnchor,
+                                   bool aSDF):
             Component(TYPE),
             text(aText),
             fontSize(aFontSize),
             textAnchor(aTextAnchor),
             color(aColor),
-            mipmaps(aMipmaps)
+            mipmaps(aMipmaps),
+            sdf(aSDF)
         {
-            shader = sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE);
             blendState = sharedEngine->getCache()->getBlendState(graphics::BLEND_ALPHA);
             whitePixelTexture = sharedEngine->getCache()->getTexture(graphics::TEXTURE_WHITE_PIXEL);
 
@@ -36,16 +37,35 @@ namespace ouzel
             vertexBuffer->init(graphics::Buffer::Usage::VERTEX, graphics::Buffer::DYNAMIC);
 
             meshBuffer = std::make_shared<graphics::MeshBuffer>();
-            meshBuffer->init(sizeof(uint16_t), indexBuffer, graphics::VertexPCT::ATTRIBUTES, vertexBuffer);
+            meshBuffer->init(sizeof(uint32_t), indexBuffer, graphics::VertexPCT::ATTRIBUTES, vertexBuffer);
 
-            font = sharedEngine->getCache()->getFont(fontFile, mipmaps);
+            // scheduled by the font when it invalidates the glyphs
+            updateCallback.callback = std::bind(&TextRenderer::update, this, std::placeholders::_1);
+
+            font = sharedEngine->getCache()->getFont(fontFile, mipmaps, sdf);
+            if (font) font->addInvalidationCallback(&updateCallback);
+            shader = sharedEngine->getCache()->getShader((font && font->isSDF()) ? graphics::SHADER_TEXTURE_SDF : graphics::SHADER_TEXTURE);
 
             updateText();
         }
 
+        TextRenderer::~TextRenderer()
+        {
+            if (font) font->removeInvalidationCallback(&updateCallback);
+        }
+
         void TextRenderer::setFont(const std::string& fontFile)
         {
-            font = sharedEngine->getCache()->getFont(fontFile);
+            if (font) font->removeInvalidationCallback(&updateCallback);
+            font = sharedEngine->getCache()->getFont(fontFile, mipmaps, sdf);
+            if (font) font->addInvalidationCallback(&updateCallback);
+
+            // keep custom shaders
+            if (shader == sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE) ||
+                shader == sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE_SDF))
+            {
+                shader = sharedEngine->getCache()->getShader((font && font->isSDF()) ? graphics::SHADER_TEXTURE_SDF : graphics::SHADER_TEXTURE);
+            }
 
             updateText();
         }
@@ -64,6 +84,13 @@ namespace ouzel
             updateText();
         }
 
+        void TextRenderer::setMaxWidth(float newMaxWidth)
+        {
+            maxWidth = newMaxWidth;
+
+            updateText();
+        }
+
         void TextRenderer::draw(const Matrix4& transformMatrix,
                                 float opacity,
                                 const Matrix4& renderViewProjection,
@@ -88,6 +115,9 @@ namespace ouzel
 
             if (needsMeshUpdate)
             {
+                const std::vector<uint32_t>& indices = layout.getIndices();
+                const std::vector<graphics::VertexPCT>& vertices = layout.getVertices();
+
                 indexBuffer->setData(indices.data(), static_cast<uint32_t>(getVectorSize(indices)));
                 vertexBuffer->setData(vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)));
 
@@ -109,7 +139,7 @@ namespace ouzel
                                                         vertexShaderConstants,
                                                         blendState,
                                                         meshBuffer,
-                                                        static_cast<uint32_t>(indices.size()),
+                                                        static_cast<uint32_t>(layout.getIndices().size()),
                                                         graphics::Renderer::DrawMode::TRIANGLE_LIST,
                                                         0,
                                                         renderTarget,
@@ -132,20 +162,36 @@ namespace ouzel
         void TextRenderer::setColor(const Color& newColor)
         {
             color = newColor;
+
+            markDirty();
+        }
+
+        void TextRenderer::update(float)
+        {
+            updateCallback.remove();
+
+            // another text could have evicted the glyphs from the font, the layout is refreshed here and not
+            // in draw, because layers can be drawn in parallel and the font atlas is shared between them
+            if (layout.isOutdated())
+            {
+                updateText();
+            }
         }
 
         void TextRenderer::updateText()
         {
-            font->getVertices(text, Color::WHITE, fontSize, textAnchor, indices, vertices, texture);
+            layout.update(font.get(), text, fontSize, maxWidth, textAnchor, Color::WHITE);
+            texture = layout.getTexture();
             needsMeshUpdate = true;
 
+            markDirty();
+
             boundingBox.reset();
 
-            for (const graphics::VertexPCT& vertex : vertices)
+            for (const graphics::VertexPCT& vertex : layout.getVertices())
             {
                 boundingBox.insertPoint(Vector2(vertex.position.x, vertex.position.y));
             }
-
         }
     } // namespace scene
 } // namespace ouzel
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <string>
+#include "core/UpdateCallback.hpp"
 #include "scene/Component.hpp"
 #include "math/Color.hpp"
 #include "gui/BMFont.hpp"
+#include "gui/TextLayout.hpp"
 #include "graphics/BlendState.hpp"
 #include "graphics/Buffer.hpp"
 #include "graphics/MeshBuffer.hpp"
@@ -27,7 +29,9 @@ namespace ouzel
                          float aFontSize = 1.0f,
                          const std::string& aText = std::string(),
                          Color aColor = Color::WHITE,
-                         const Vector2& aTextAnchor = Vector2(0.5f, 0.5f));
+                         const Vector2& aTextAnchor = Vector2(0.5f, 0.5f),
+                         bool aSDF = false);
+            virtual ~TextRenderer();
 
             virtual void draw(const Matrix4& transformMatrix,
                               float opacity,
@@ -48,6 +52,10 @@ namespace ouzel
             virtual void setTextAnchor(const Vector2& newTextAnchor);
             virtual const Vector2& getTextAnchor() const { return textAnchor; }
 
+            // zero disables word wrapping
+            virtual void setMaxWidth(float newMaxWidth);
+            virtual float getMaxWidth() const { return maxWidth; }
+
             virtual void setText(const std::string& newText);
             virtual const std::string& getText() const { return text; }
 
@@ -55,14 +63,17 @@ namespace ouzel
             virtual void setColor(const Color& newColor);
 
             virtual const std::shared_ptr<graphics::Shader>& getShader() const { return shader; }
-            virtual void setShader(const std::shared_ptr<graphics::Shader>& newShader) { shader = newShader; }
+            virtual void setShader(const std::shared_ptr<graphics::Shader>& newShader) { shader = newShader; markDirty(); }
 
             virtual const std::shared_ptr<graphics::BlendState>& getBlendState() const { return blendState; }
-            virtual void setBlendState(const std::shared_ptr<graphics::BlendState>& newBlendState)  { blendState = newBlendState; }
+            virtual void setBlendState(const std::shared_ptr<graphics::BlendState>& newBlendState)  { blendState = newBlendState; markDirty(); }
 
         protected:
+            void update(float delta);
             void updateText();
 
+            UpdateCallback updateCallback;
+
             std::shared_ptr<graphics::Shader> shader;
             std::shared_ptr<graphics::BlendState> blendState;
 
@@ -77,13 +88,14 @@ namespace ouzel
             std::string text;
             float fontSize = 1.0f;
             Vector2 textAnchor;
+            float maxWidth = 0.0f;
 
-            std::vector<uint16_t> indices;
-            std::vector<graphics::VertexPCT> vertices;
+            TextLayout layout;
 
             Color color = Color::WHITE;
 
             bool mipmaps = true;
+            bool sdf = false;
             bool needsMeshUpdate = false;
         };
     } // namespace scene
@@ -1,60 +1,77 @@
 // Copyright (C) 2017 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <new>
 #include "OBF.hpp"
+#include "OBFView.hpp"
+#include "Log.hpp"
 #include "Utils.hpp"
 
 namespace ouzel
 {
     namespace obf
     {
-        // reading
-        static uint32_t readInt8(const std::vector<uint8_t>& buffer, uint32_t offset, uint8_t& result)
+        // sorts the elements by key, the last one of the duplicate keys is kept
+        template<class T>
+        static void sortElements(T& elements)
         {
-            if (buffer.size() - offset < sizeof(result))
+            bool sorted = true;
+
+            for (size_t i = 1; i < elements.size() && sorted; ++i)
             {
-                return 0;
+                if (!(elements[i - 1].first < elements[i].first)) sorted = false;
             }
 
-            result = *reinterpret_cast<const uint8_t*>(buffer.data() + offset);
+            if (sorted) return;
 
-            return sizeof(result);
-        }
+            std::stable_sort(elements.begin(), elements.end(),
+                             [](const typename T::value_type& a, const typename T::value_type& b) { return a.first < b.first; });
 
-        static uint32_t readInt16(const std::vector<uint8_t>& buffer, uint32_t offset, uint16_t& result)
-        {
-            if (buffer.size() - offset < sizeof(result))
+            size_t count = 0;
+
+            for (size_t i = 0; i < elements.size(); ++i)
             {
-                return 0;
+                if (count > 0 && elements[count - 1].first == elements[i].first)
+                {
+                    elements[count - 1].second = std::move(elements[i].second);
+                }
+                else
+                {
+                    if (count != i) elements[count] = std::move(elements[i]);
+                    ++count;
+                }
             }
 
-            result = decodeUInt16Big(buffer.data() + offset);
-
-            return sizeof(result);
+            elements.erase(elements.begin() + static_cast<ptrdiff_t>(count), elements.end());
         }
 
-        static uint32_t readInt32(const std::vector<uint8_t>& buffer, uint32_t offset, uint32_t& result)
+        // reading
+        static uint32_t readInt8(const std::vector<uint8_t>& buffer, uint32_t offset, uint8_t& result)
         {
             if (buffer.size() - offset < sizeof(result))
             {
                 return 0;
             }
 
-            result = decodeUInt32Big(buffer.data() + offset);
+            result = *reinterpret_cast<const uint8_t*>(buffer.data() + offset);
 
             return sizeof(result);
         }
 
-        static uint32_t readInt64(const std::vector<uint8_t>& buffer, uint32_t offset, uint64_t& result)
+        static uint32_t readInt16(const std::vector<uint8_t>& buffer, uint32_t offset, uint16_t& result)
         {
-            if (buffer.size() - offset < sizeof(result))
-            {
-                return 0;
-            }
+            return readUInt16Big(buffer, offset, result) ? sizeof(result) : 0;
+        }
 
-            result = decodeUInt64Big(buffer.data() + offset);
+        static uint32_t readInt32(const std::vector<uint8_t>& buffer, uint32_t offset, uint32_t& result)
+        {
+            return readUInt32Big(buffer, offset, result) ? sizeof(result) : 0;
+        }
 
-            return sizeof(result);
+        static uint32_t readInt64(const std::vector<uint8_t>& buffer, uint32_t offset, uint64_t& result)
+        {
+            return readUInt64Big(buffer, offset, result) ? sizeof(result) : 0;
         }
 
         static uint32_t readFloat(const std::vector<uint8_t>& buffer, uint32_t offset, float& result)
@@ -154,7 +171,7 @@ namespace ouzel
             return offset - originalOffset;
         }
 
-        static uint32_t readObject(const std::vector<uint8_t>& buffer, uint32_t offset, std::map<uint32_t, Value>& result)
+        uint32_t Value::readObject(const std::vector<uint8_t>& buffer, uint32_t offset, Object& result, uint32_t depth)
         {
             uint32_t originalOffset = offset;
 
@@ -178,23 +195,24 @@ namespace ouzel
 
                 offset += sizeof(key);
 
-                Value node;
+                // decode directly into the element
+                result.emplace_back(key, Value());
 
-                uint32_t ret = node.decode(buffer, offset);
+                uint32_t ret = result.back().second.decode(buffer, offset, depth + 1);
 
                 if (ret == 0)
                 {
                     return 0;
                 }
                 offset += ret;
-
-                result[static_cast<uint32_t>(key)] = node;
             }
 
+            sortElements(result);
+
             return offset - originalOffset;
         }
 
-        static uint32_t readArray(const std::vector<uint8_t>& buffer, uint32_t offset, std::vector<Value>& result)
+        uint32_t Value::readArray(const std::vector<uint8_t>& buffer, uint32_t offset, Array& result, uint32_t depth)
         {
             uint32_t originalOffset = offset;
 
@@ -209,8 +227,8 @@ namespace ouzel
 
             for (uint32_t i = 0; i < count; ++i)
             {
-                Value node;
-                uint32_t ret = node.decode(buffer, offset);
+                result.emplace_back();
+                uint32_t ret = result.back().decode(buffer, offset, depth + 1);
 
                 if (ret == 0)
                 {
@@ -218,14 +236,12 @@ namespace ouzel
                 }
 
                 offset += ret;
-
-                result.push_back(node);
             }
 
             return offset - originalOffset;
         }
 
-        static uint32_t readDictionary(const std::vector<uint8_t>& buffer, uint32_t offset, std::map<std::string, Value>& result)
+        uint32_t Value::readDictionary(const std::vector<uint8_t>& buffer, uint32_t offset, Dictionary& result, uint32_t depth)
         {
             uint32_t originalOffset = offset;
 
@@ -254,22 +270,20 @@ namespace ouzel
                     return 0;
                 }
 
-                std::string key(reinterpret_cast<const char*>(buffer.data() + offset), length);
+                result.emplace_back(std::string(reinterpret_cast<const char*>(buffer.data() + offset), length), Value());
                 offset += length;
 
-                Value node;
-
-                uint32_t ret = node.decode(buffer, offset);
+                uint32_t ret = result.back().second.decode(buffer, offset, depth + 1);
 
                 if (ret == 0)
                 {
                     return 0;
                 }
                 offset += ret;
-
-                result[key] = node;
             }
 
+            sortElements(result);
+
             return offset - originalOffset;
         }
 
@@ -283,33 +297,21 @@ namespace ouzel
 
         static uint32_t writeInt16(std::vector<uint8_t>& buffer, uint16_t value)
         {
-            uint8_t data[sizeof(value)];
-
-            encodeUInt16Big(data, value);
-
-            buffer.insert(buffer.end(), std::begin(data), std::end(data));
+            writeUInt16Big(buffer, value);
 
             return sizeof(value);
         }
 
         static uint32_t writeInt32(std::vector<uint8_t>& buffer, uint32_t value)
         {
-            uint8_t data[sizeof(value)];
-
-            encodeUInt32Big(data, value);
-
-            buffer.insert(buffer.end(), std::begin(data), std::end(data));
+            writeUInt32Big(buffer, value);
 
             return sizeof(value);
         }
 
         static uint32_t writeInt64(std::vector<uint8_t>& buffer, uint64_t value)
         {
-            uint8_t data[sizeof(value)];
-
-            encodeUInt64Big(data, value);
-
-            buffer.insert(buffer.end(), std::begin(data), std::end(data));
+            writeUInt64Big(buffer, value);
 
             return sizeof(value);
         }
@@ -334,13 +336,9 @@ namespace ouzel
 
         static uint32_t writeString(std::vector<uint8_t>& buffer, const std::string& value)
         {
-            uint8_t lengthData[sizeof(uint16_t)];
-
-            encodeUInt16Big(lengthData, static_cast<uint16_t>(value.length()));
+            writeUInt16Big(buffer, static_cast<uint16_t>(value.length()));
 
-            buffer.insert(buffer.end(), std::begin(lengthData), std::end(lengthData));
-
-            uint32_t size = sizeof(lengthData);
+            uint32_t size = sizeof(uint16_t);
 
             buffer.insert(buffer.end(),
                           reinterpret_cast<const uint8_t*>(value.data()),
@@ -352,13 +350,9 @@ namespace ouzel
 
         static uint32_t writeLongString(std::vector<uint8_t>& buffer, const std::string& value)
         {
-            uint8_t lengthData[sizeof(uint32_t)];
-
-            encodeUInt32Big(lengthData, static_cast<uint32_t>(value.length()));
+            writeUInt32Big(buffer, static_cast<uint32_t>(value.length()));
 
-            buffer.insert(buffer.end(), std::begin(lengthData), std::end(lengthData));
-
-            uint32_t size = sizeof(lengthData);
+            uint32_t size = sizeof(uint32_t);
 
             buffer.insert(buffer.end(),
                           reinterpret_cast<const uint8_t*>(value.data()),
@@ -370,13 +364,9 @@ namespace ouzel
 
         static uint32_t writeByteArray(std::vector<uint8_t>& buffer, const std::vector<uint8_t>& value)
         {
-            uint8_t lengthData[sizeof(uint32_t)];
-
-            encodeUInt32Big(lengthData, static_cast<uint32_t>(value.size()));
+            writeUInt32Big(buffer, static_cast<uint32_t>(value.size()));
 
-            buffer.insert(buffer.end(), std::begin(lengthData), std::end(lengthData));
-
-            uint32_t size = sizeof(lengthData);
+            uint32_t size = sizeof(uint32_t);
 
             buffer.insert(buffer.end(), value.begin(), value.end());
             size += static_cast<uint32_t>(value.size());
@@ -384,25 +374,17 @@ namespace ouzel
             return size;
         }
 
-        static uint32_t writeObject(std::vector<uint8_t>& buffer, const std::map<uint32_t, Value>& value)
+        static uint32_t writeObject(std::vector<uint8_t>& buffer, const Value::Object& value)
         {
-            uint8_t lengthData[sizeof(uint32_t)];
-
-            encodeUInt32Big(lengthData, static_cast<uint32_t>(value.size()));
-
-            buffer.insert(buffer.end(), std::begin(lengthData), std::end(lengthData));
+            writeUInt32Big(buffer, static_cast<uint32_t>(value.size()));
 
-            uint32_t size = sizeof(lengthData);
+            uint32_t size = sizeof(uint32_t);
 
             for (const auto& i : value)
             {
-                uint8_t keyData[sizeof(uint32_t)];
-
-                encodeUInt32Big(keyData, i.first);
-
-                buffer.insert(buffer.end(), std::begin(keyData), std::end(keyData));
+                writeUInt32Big(buffer, i.first);
 
-                size += sizeof(keyData);
+                size += sizeof(uint32_t);
 
                 size += i.second.encode(buffer);
             }
@@ -410,15 +392,11 @@ namespace ouzel
             return size;
         }
 
-        static uint32_t writeArray(std::vector<uint8_t>& buffer, const std::vector<Value>& value)
+        static uint32_t writeArray(std::vector<uint8_t>& buffer, const Value::Array& value)
         {
-            uint8_t lengthData[sizeof(uint32_t)];
+            writeUInt32Big(buffer, static_cast<uint32_t>(value.size()));
 
-            encodeUInt32Big(lengthData, static_cast<uint32_t>(value.size()));
-
-            buffer.insert(buffer.end(), std::begin(lengthData), std::end(lengthData));
-
-            uint32_t size = sizeof(lengthData);
+            uint32_t size = sizeof(uint32_t);
 
             for (const auto& i : value)
             {
@@ -428,25 +406,17 @@ namespace ouzel
             return size;
         }
 
-        static uint32_t writeDictionary(std::vector<uint8_t>& buffer, const std::map<std::string, Value>& value)
+        static uint32_t writeDictionary(std::vector<uint8_t>& buffer, const Value::Dictionary& value)
         {
-            uint8_t sizeData[sizeof(uint32_t)];
-
-            encodeUInt32Big(sizeData, static_cast<uint32_t>(value.size()));
-
-            buffer.insert(buffer.end(), std::begin(sizeData), std::end(sizeData));
+            writeUInt32Big(buffer, static_cast<uint32_t>(value.size()));
 
-            uint32_t size = sizeof(sizeData);
+            uint32_t size = sizeof(uint32_t);
 
             for (const auto& i : value)
             {
-                uint8_t lengthData[sizeof(uint16_t)];
+                writeUInt16Big(buffer, static_cast<uint16_t>(i.first.length()));
 
-                encodeUInt16Big(lengthData, static_cast<uint16_t>(i.first.length()));
-
-                buffer.insert(buffer.end(), std::begin(lengthData), std::end(lengthData));
-
-                size += sizeof(lengthData);
+                size += sizeof(uint16_t);
 
                 buffer.insert(buffer.end(),
                               reinterpret_cast<const uint8_t*>(i.first.data()),
@@ -460,6 +430,11 @@ namespace ouzel
         }
 
         uint32_t Value::decode(const std::vector<uint8_t>& buffer, uint32_t offset)
+        {
+            return decode(buffer, offset, 0);
+        }
+
+        uint32_t Value::decode(const std::vector<uint8_t>& buffer, uint32_t offset, uint32_t depth)
         {
             uint32_t originalOffset = offset;
 
@@ -471,18 +446,24 @@ namespace ouzel
             Marker marker = *reinterpret_cast<const Marker*>(buffer.data() + offset);
             offset += 1;
 
+            if ((marker == Marker::OBJECT || marker == Marker::ARRAY || marker == Marker::DICTIONARY) && depth >= MAX_DEPTH)
+            {
+                Log(Log::Level::ERR) << "Too many nested containers";
+                return 0;
+            }
+
             uint32_t ret = 0;
 
             switch (marker)
             {
                 case Marker::NONE:
                 {
-                    type = Type::NONE;
+                    *this = Type::NONE;
                     break;
                 }
                 case Marker::INT8:
                 {
-                    type = Type::INT;
+                    *this = Type::INT;
 
                     uint8_t int8Value;
                     if ((ret = readInt8(buffer, offset, int8Value)) == 0)
@@ -495,7 +476,7 @@ namespace ouzel
                 }
                 case Marker::INT16:
                 {
-                    type = Type::INT;
+                    *this = Type::INT;
 
                     uint16_t int16Value;
                     if ((ret = readInt16(buffer, offset, int16Value)) == 0)
@@ -508,7 +489,7 @@ namespace ouzel
                 }
                 case Marker::INT32:
                 {
-                    type = Type::INT;
+                    *this = Type::INT;
 
                     uint32_t int32Value;
                     if ((ret = readInt32(buffer, offset, int32Value)) == 0)
@@ -521,7 +502,7 @@ namespace ouzel
                 }
                 case Marker::INT64:
                 {
-                    type = Type::INT;
+                    *this = Type::INT;
 
                     if ((ret = readInt64(buffer, offset, intValue)) == 0)
                     {
@@ -531,7 +512,7 @@ namespace ouzel
                 }
                 case Marker::FLOAT:
                 {
-                    type = Type::FLOAT;
+                    *this = Type::FLOAT;
 
                     float floatValue;
                     if ((ret = readFloat(buffer, offset, floatValue)) == 0)
@@ -544,7 +525,7 @@ namespace ouzel
                 }
                 case Marker::DOUBLE:
                 {
-                    type = Type::DOUBLE;
+                    *this = Type::DOUBLE;
 
                     if ((ret = readDouble(buffer, offset, doubleValue)) == 0)
                     {
@@ -554,7 +535,7 @@ namespace ouzel
                 }
                 case Marker::STRING:
                 {
-                    type = Type::STRING;
+                    *this = Type::STRING;
 
                     if ((ret = readString(buffer, offset, stringValue)) == 0)
                     {
@@ -564,7 +545,7 @@ namespace ouzel
                 }
                 case Marker::LONG_STRING:
                 {
-                    type = Type::STRING;
+                    *this = Type::STRING;
 
                     if ((ret = readLongString(buffer, offset, stringValue)) == 0)
                     {
@@ -574,7 +555,7 @@ namespace ouzel
                 }
                 case Marker::BYTE_ARRAY:
                 {
-                    type = Type::BYTE_ARRAY;
+                    *this = Type::BYTE_ARRAY;
 
                     if ((ret = readByteArray(buffer, offset, byteArrayValue)) == 0)
                     {
@@ -584,9 +565,9 @@ namespace ouzel
                 }
                 case Marker::OBJECT:
                 {
-                    type = Type::OBJECT;
+                    *this = Type::OBJECT;
 
-                    if ((ret = readObject(buffer, offset, objectValue)) == 0)
+                    if ((ret = readObject(buffer, offset, objectValue, depth)) == 0)
                     {
                         return 0;
                     }
@@ -594,9 +575,9 @@ namespace ouzel
                 }
                 case Marker::ARRAY:
                 {
-                    type = Type::ARRAY;
+                    *this = Type::ARRAY;
 
-                    if ((ret = readArray(buffer, offset, arrayValue)) == 0)
+                    if ((ret = readArray(buffer, offset, arrayValue, depth)) == 0)
                     {
                         return 0;
                     }
@@ -604,9 +585,9 @@ namespace ouzel
                 }
                 case Marker::DICTIONARY:
                 {
-                    type = Type::DICTIONARY;
+                    *this = Type::DICTIONARY;
 
-                    if ((ret = readDictionary(buffer, offset, dictionaryValue)) == 0)
+                    if ((ret = readDictionary(buffer, offset, dictionaryValue, depth)) == 0)
                     {
                         return 0;
                     }
@@ -727,5 +708,347 @@ namespace ouzel
 
             return size;
         }
+
+        Value::Value(const std::map<uint32_t, Value>& value):
+            type(Type::OBJECT), objectValue(value.begin(), value.end())
+        {
+        }
+
+        Value::Value(const View& view):
+            Value(view, 0)
+        {
+        }
+
+        Value::Value(const View& view, uint32_t depth)
+        {
+            Type viewType = view.getType();
+
+            if ((viewType == Type::OBJECT || viewType == Type::ARRAY || viewType == Type::DICTIONARY) && depth >= MAX_DEPTH)
+            {
+                Log(Log::Level::ERR) << "Too many nested containers";
+                construct(Type::NONE);
+                return;
+            }
+
+            switch (viewType)
+            {
+                case Type::NONE:
+                    construct(Type::NONE);
+                    break;
+                case Type::INT:
+                    type = Type::INT;
+                    intValue = view.asUInt64();
+                    break;
+                case Type::FLOAT:
+                    type = Type::FLOAT;
+                    doubleValue = view.asFloat();
+                    break;
+                case Type::DOUBLE:
+                    type = Type::DOUBLE;
+                    doubleValue = view.asDouble();
+                    break;
+                case Type::STRING:
+                    type = Type::STRING;
+                    new (&stringValue) std::string(view.getStringData(), view.getStringLength());
+                    break;
+                case Type::BYTE_ARRAY:
+                    type = Type::BYTE_ARRAY;
+                    new (&byteArrayValue) std::vector<uint8_t>(view.getByteArrayData(), view.getByteArrayData() + view.getByteArraySize());
+                    break;
+                case Type::OBJECT:
+                    construct(Type::OBJECT);
+                    objectValue.reserve(view.getCount());
+                    for (View::Iterator i = view.begin(); i != view.end(); ++i)
+                    {
+                        objectValue.emplace_back(i.getKey(), Value(*i, depth + 1));
+                    }
+                    sortElements(objectValue);
+                    break;
+                case Type::ARRAY:
+                    construct(Type::ARRAY);
+                    arrayValue.reserve(view.getCount());
+                    for (View element : view)
+                    {
+                        arrayValue.push_back(Value(element, depth + 1));
+                    }
+                    break;
+                case Type::DICTIONARY:
+                    construct(Type::DICTIONARY);
+                    dictionaryValue.reserve(view.getCount());
+                    for (View::Iterator i = view.begin(); i != view.end(); ++i)
+                    {
+                        dictionaryValue.emplace_back(i.getName(), Value(*i, depth + 1));
+                    }
+                    sortElements(dictionaryValue);
+                    break;
+            }
+        }
+
+        Value::Value(const Value& other)
+        {
+            switch (other.type)
+            {
+                case Type::STRING:
+                    new (&stringValue) std::string(other.stringValue);
+                    break;
+                case Type::BYTE_ARRAY:
+                    new (&byteArrayValue) std::vector<uint8_t>(other.byteArrayValue);
+                    break;
+                case Type::OBJECT:
+                    new (&objectValue) Object(other.objectValue);
+                    break;
+                case Type::ARRAY:
+                    new (&arrayValue) Array(other.arrayValue);
+                    break;
+                case Type::DICTIONARY:
+                    new (&dictionaryValue) Dictionary(other.dictionaryValue);
+                    break;
+                default:
+                    intValue = other.intValue; // also copies the double
+                    break;
+            }
+
+            type = other.type;
+        }
+
+        Value::Value(Value&& other) noexcept
+        {
+            switch (other.type)
+            {
+                case Type::STRING:
+                    new (&stringValue) std::string(std::move(other.stringValue));
+                    break;
+                case Type::BYTE_ARRAY:
+                    new (&byteArrayValue) std::vector<uint8_t>(std::move(other.byteArrayValue));
+                    break;
+                case Type::OBJECT:
+                    new (&objectValue) Object(std::move(other.objectValue));
+                    break;
+                case Type::ARRAY:
+                    new (&arrayValue) Array(std::move(other.arrayValue));
+                    break;
+                case Type::DICTIONARY:
+                    new (&dictionaryValue) Dictionary(std::move(other.dictionaryValue));
+                    break;
+                default:
+                    intValue = other.intValue;
+                    break;
+            }
+
+            type = other.type;
+            other.destroy();
+        }
+
+        Value& Value::operator=(const Value& other)
+        {
+            if (&other != this)
+            {
+                Value copy(other);
+                *this = std::move(copy);
+            }
+
+            return *this;
+        }
+
+        Value& Value::operator=(Value&& other) noexcept
+        {
+            if (&other != this)
+            {
+                // other can be an element of this value, so it is moved out before this value is destroyed
+                Value temporary(std::move(other));
+                destroy();
+                new (this) Value(std::move(temporary));
+            }
+
+            return *this;
+        }
+
+        void Value::construct(Type newType)
+        {
+            switch (newType)
+            {
+                case Type::STRING:
+                    new (&stringValue) std::string();
+                    break;
+                case Type::BYTE_ARRAY:
+                    new (&byteArrayValue) std::vector<uint8_t>();
+                    break;
+                case Type::OBJECT:
+                    new (&objectValue) Object();
+                    break;
+                case Type::ARRAY:
+                    new (&arrayValue) Array();
+                    break;
+                case Type::DICTIONARY:
+                    new (&dictionaryValue) Dictionary();
+                    break;
+                case Type::FLOAT:
+                case Type::DOUBLE:
+                    doubleValue = 0.0;
+                    break;
+                default:
+                    intValue = 0;
+                    break;
+            }
+
+            type = newType;
+        }
+
+        void Value::destroy()
+        {
+            switch (type)
+            {
+                case Type::STRING:
+                    stringValue.~basic_string();
+                    break;
+                case Type::BYTE_ARRAY:
+                    byteArrayValue.~vector();
+                    break;
+                case Type::OBJECT:
+                    objectValue.~Object();
+                    break;
+                case Type::ARRAY:
+                    arrayValue.~Array();
+                    break;
+                case Type::DICTIONARY:
+                    dictionaryValue.~Dictionary();
+                    break;
+                default:
+                    break;
+            }
+
+            type = Type::NONE;
+            intValue = 0;
+        }
+
+        static const Value& getNoneValue()
+        {
+            static const Value noneValue;
+            return noneValue;
+        }
+
+        template<class T, class K>
+        static typename T::iterator findElement(T& elements, const K& key)
+        {
+            return std::lower_bound(elements.begin(), elements.end(), key,
+                                    [](const typename T::value_type& a, const K& b) { return a.first < b; });
+        }
+
+        template<class T, class K>
+        static typename T::const_iterator findElement(const T& elements, const K& key)
+        {
+            return std::lower_bound(elements.begin(), elements.end(), key,
+                                    [](const typename T::value_type& a, const K& b) { return a.first < b; });
+        }
+
+        const Value& Value::operator[](uint32_t key) const
+        {
+            assert(type == Type::OBJECT || type == Type::ARRAY);
+
+            if (type == Type::OBJECT)
+            {
+                auto i = findElement(objectValue, key);
+
+                if (i != objectValue.end() && i->first == key)
+                {
+                    return i->second;
+                }
+            }
+            else if (type == Type::ARRAY)
+            {
+                if (key < arrayValue.size())
+                {
+                    return arrayValue[key];
+                }
+            }
+
+            return getNoneValue();
+        }
+
+        Value& Value::operator[](uint32_t key)
+        {
+            assert(type == Type::OBJECT || type == Type::ARRAY);
+
+            if (type == Type::OBJECT)
+            {
+                auto i = findElement(objectValue, key);
+
+                if (i == objectValue.end() || i->first != key)
+                {
+                    i = objectValue.emplace(i, key, Value());
+                }
+
+                return i->second;
+            }
+            else
+            {
+                if (type != Type::ARRAY) *this = Type::ARRAY;
+                if (key >= arrayValue.size()) arrayValue.resize(key + 1);
+
+                return arrayValue[key];
+            }
+        }
+
+        const Value& Value::operator[](const std::string& key) const
+        {
+            assert(type == Type::DICTIONARY);
+
+            if (type == Type::DICTIONARY)
+            {
+                auto i = findElement(dictionaryValue, key);
+
+                if (i != dictionaryValue.end() && i->first == key)
+                {
+                    return i->second;
+                }
+            }
+
+            return getNoneValue();
+        }
+
+        Value& Value::operator[](const std::string& key)
+        {
+            assert(type == Type::DICTIONARY);
+
+            if (type != Type::DICTIONARY) *this = Type::DICTIONARY;
+
+            auto i = findElement(dictionaryValue, key);
+
+            if (i == dictionaryValue.end() || i->first != key)
+            {
+                i = dictionaryValue.emplace(i, key, Value());
+            }
+
+            return i->second;
+        }
+
+        bool Value::hasElement(uint32_t key) const
+        {
+            assert(type == Type::OBJECT || type == Type::ARRAY);
+
+            if (type == Type::OBJECT)
+            {
+                auto i = findElement(objectValue, key);
+                return i != objectValue.end() && i->first == key;
+            }
+            else if (type == Type::ARRAY)
+            {
+                return key < arrayValue.size();
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        bool Value::hasElement(const std::string& key) const
+        {
+            assert(type == Type::DICTIONARY);
+
+            if (type != Type::DICTIONARY) return false;
+
+            auto i = findElement(dictionaryValue, key);
+            return i != dictionaryValue.end() && i->first == key;
+        }
     } // namespace obf
 } // namespace ouzel
@@ -8,15 +8,21 @@
 #include <limits>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ouzel
 {
     namespace obf
     {
+        class View;
+
         class Value
         {
         public:
+            // maximum nesting of containers that the Writer writes and the Value and the View read
+            static const uint32_t MAX_DEPTH = 64;
+
             enum class Marker: uint8_t
             {
                 NONE,
@@ -47,8 +53,13 @@ namespace ouzel
                 DICTIONARY
             };
 
-            Value() {}
-            Value(Type aType): type(aType) {}
+            // elements of objects and dictionaries are kept sorted by key
+            typedef std::vector<std::pair<uint32_t, Value>> Object;
+            typedef std::vector<Value> Array;
+            typedef std::vector<std::pair<std::string, Value>> Dictionary;
+
+            Value(): intValue(0) {}
+            Value(Type aType) { construct(aType); }
             Value(uint8_t value):
                 type(Type::INT), intValue(value)
             {
@@ -71,79 +82,56 @@ namespace ouzel
                 type(Type::STRING), stringValue(value)
             {
             }
+            Value(std::string&& value):
+                type(Type::STRING), stringValue(std::move(value))
+            {
+            }
             Value(const std::vector<uint8_t>& value): type(Type::BYTE_ARRAY), byteArrayValue(value) {}
-            Value(const std::map<uint32_t, Value>& value): type(Type::OBJECT), objectValue(value) {}
+            Value(std::vector<uint8_t>&& value): type(Type::BYTE_ARRAY), byteArrayValue(std::move(value)) {}
+            Value(const std::map<uint32_t, Value>& value);
             Value(const std::vector<Value>& value): type(Type::ARRAY), arrayValue(value) {}
+            Value(std::vector<Value>&& value): type(Type::ARRAY), arrayValue(std::move(value)) {}
+            // builds the value directly from the encoded buffer
+            explicit Value(const View& view);
+
+            Value(const Value& other);
+            Value(Value&& other) noexcept;
+            ~Value() { destroy(); }
+
+            Value& operator=(const Value& other);
+            Value& operator=(Value&& other) noexcept;
 
             Value& operator=(Type newType)
             {
-                type = newType;
-
-                switch (type)
-                {
-                    case Type::NONE: // do nothing
-                        break;
-                    case Type::INT:
-                        intValue = 0;
-                        break;
-                    case Type::FLOAT:
-                    case Type::DOUBLE:
-                        doubleValue = 0.0;
-                        break;
-                    case Type::STRING:
-                        stringValue.clear();
-                        break;
-                    case Type::BYTE_ARRAY:
-                        byteArrayValue.clear();
-                        break;
-                    case Type::OBJECT:
-                        objectValue.clear();
-                        break;
-                    case Type::ARRAY:
-                        arrayValue.clear();
-                        break;
-                    case Type::DICTIONARY:
-                        dictionaryValue.clear();
-                        break;
-                }
+                destroy();
+                construct(newType);
 
                 return *this;
             }
 
             Value& operator=(uint8_t value)
             {
-                type = Type::INT;
-                intValue = value;
-
-                return *this;
+                return setInt(value);
             }
 
             Value& operator=(uint16_t value)
             {
-                type = Type::INT;
-                intValue = value;
-
-                return *this;
+                return setInt(value);
             }
 
             Value& operator=(uint32_t value)
             {
-                type = Type::INT;
-                intValue = value;
-
-                return *this;
+                return setInt(value);
             }
 
             Value& operator=(uint64_t value)
             {
-                type = Type::INT;
-                intValue = value;
-
-                return *this;
+                return setInt(value);
             }
 
             Value& operator=(float value)
             {
+                destroy();
                 type = Type::FLOAT;
                 doubleValue = value;
 
@@ -152,43 +140,20 @@ namespace ouzel
 
             Value& operator=(double value)
             {
+                destroy();
                 type = Type::DOUBLE;
                 doubleValue = value;
 
                 return *this;
             }
 
-            Value& operator=(const std::string& value)
-            {
-                type = Type::STRING;
-                stringValue = value;
-
-                return *this;
-            }
-
-            Value& operator=(const std::vector<uint8_t>& value)
-            {
-                type = Type::BYTE_ARRAY;
-                byteArrayValue = value;
-
-                return *this;
-            }
-
-            Value& operator=(const std::map<uint32_t, Value>& value)
-            {
-                type = Type::OBJECT;
-                objectValue = value;
-
-                return *this;
-            }
-
-            Value& operator=(const std::vector<Value>& value)
-            {
-                type = Type::ARRAY;
-                arrayValue = value;
-
-                return *this;
-            }
+            Value& operator=(const std::string& value) { return *this = Value(value); }
+            Value& operator=(std::string&& value) { return *this = Value(std::move(value)); }
+            Value& operator=(const std::vector<uint8_t>& value) { return *this = Value(value); }
+            Value& operator=(std::vector<uint8_t>&& value) { return *this = Value(std::move(value)); }
+            Value& operator=(const std::map<uint32_t, Value>& value) { return *this = Value(value); }
+            Value& operator=(const std::vector<Value>& value) { return *this = Value(value); }
+            Value& operator=(std::vector<Value>&& value) { return *this = Value(std::move(value)); }
 
             Type getType() const { return type; }
             bool isIntType() const { return type == Type::INT; }
@@ -198,7 +163,7 @@ namespace ouzel
             uint32_t decode(const std::vector<uint8_t>& buffer, uint32_t offset = 0);
             uint32_t encode(std::vector<uint8_t>& buffer) const;
 
-            bool operator!()
+            bool operator!() const
             {
                 switch (type)
                 {
@@ -216,6 +181,8 @@ namespace ouzel
                     case Type::DICTIONARY:
                         return false;
                 }
+
+                return false;
             }
 
             int8_t asInt8() const
@@ -302,49 +269,65 @@ namespace ouzel
                 return byteArrayValue;
             }
 
-            const std::map<uint32_t, Value>& asMap() const
+            // the elements are sorted by key and must be kept sorted if they are modified
+            Object& asMap()
             {
                 assert(type == Type::OBJECT);
 
                 return objectValue;
             }
 
-            const std::vector<Value>& asVector() const
+            const Object& asMap() const
+            {
+                assert(type == Type::OBJECT);
+
+                return objectValue;
+            }
+
+            const Array& asVector() const
             {
                 assert(type == Type::ARRAY);
 
                 return arrayValue;
             }
 
-            const std::map<std::string, Value>& asDictionary() const
+            // the elements are sorted by key and must be kept sorted if they are modified
+            Dictionary& asDictionary()
+            {
+                assert(type == Type::DICTIONARY);
+
+                return dictionaryValue;
+            }
+
+            const Dictionary& asDictionary() const
             {
                 assert(type == Type::DICTIONARY);
 
                 return dictionaryValue;
             }
 
-            std::vector<Value>::iterator begin()
+            Array::iterator begin()
             {
                 assert(type == Type::ARRAY);
 
                 return arrayValue.begin();
             }
 
-            std::vector<Value>::const_iterator begin() const
+            Array::const_iterator begin() const
             {
                 assert(type == Type::ARRAY);
 
                 return arrayValue.begin();
             }
 
-            std::vector<Value>::iterator end()
+            Array::iterator end()
             {
                 assert(type == Type::ARRAY);
 
                 return arrayValue.end();
             }
 
-            std::vector<Value>::const_iterator end() const
+            Array::const_iterator end() const
             {
                 assert(type == Type::ARRAY);
 
@@ -358,109 +341,63 @@ namespace ouzel
                 return static_cast<uint32_t>(arrayValue.size());
             }
 
-            Value operator[](uint32_t key) const
-            {
-                assert(type == Type::OBJECT || type == Type::ARRAY);
-
-                if (type == Type::OBJECT)
-                {
-                    auto i = objectValue.find(key);
-
-                    if (i != objectValue.end())
-                    {
-                        return i->second;
-                    }
-                }
-                else if (type == Type::ARRAY)
-                {
-                    if (key < arrayValue.size())
-                    {
-                        return arrayValue[key];
-                    }
-                }
+            // returns a NONE value if the element does not exist
+            const Value& operator[](uint32_t key) const;
+            const Value& operator[](const std::string& key) const;
+            // inserts the element if it does not exist, the insertion invalidates the references
+            // to the other elements of the object, the array or the dictionary
+            Value& operator[](uint32_t key);
+            Value& operator[](const std::string& key);
 
-                return Value();
-            }
+            bool hasElement(uint32_t key) const;
+            bool hasElement(const std::string& key) const;
 
-            Value& operator[](uint32_t key)
+            void append(const Value& node)
             {
-                assert(type == Type::OBJECT || type == Type::ARRAY);
-
-                if (type == Type::OBJECT)
-                {
-                    return objectValue[key];
-                }
-                else
-                {
-                    type = Type::ARRAY;
+                assert(type == Type::ARRAY);
 
-                    return arrayValue[key];
-                }
+                arrayValue.push_back(node);
             }
 
-            Value operator[](const std::string& key) const
+            void append(Value&& node)
             {
-                assert(type == Type::DICTIONARY);
-
-                auto i = dictionaryValue.find(key);
-
-                if (i != dictionaryValue.end())
-                {
-                    return i->second;
-                }
+                assert(type == Type::ARRAY);
 
-                return Value();
+                arrayValue.push_back(std::move(node));
             }
 
-            Value& operator[](const std::string& key)
-            {
-                assert(type == Type::DICTIONARY);
-
-                return dictionaryValue[key];
-            }
+        private:
+            Value(const View& view, uint32_t depth);
 
-            bool hasElement(uint32_t key) const
-            {
-                assert(type == Type::OBJECT || type == Type::ARRAY);
+            uint32_t decode(const std::vector<uint8_t>& buffer, uint32_t offset, uint32_t depth);
+            static uint32_t readObject(const std::vector<uint8_t>& buffer, uint32_t offset, Object& result, uint32_t depth);
+            static uint32_t readArray(const std::vector<uint8_t>& buffer, uint32_t offset, Array& result, uint32_t depth);
+            static uint32_t readDictionary(const std::vector<uint8_t>& buffer, uint32_t offset, Dictionary& result, uint32_t depth);
 
-                if (type == Type::OBJECT)
-                {
-                    return objectValue.find(key) != objectValue.end();
-                }
-                else if (type == Type::ARRAY)
-                {
-                    return key < arrayValue.size();
-                }
-                else
-                {
-                    return false;
-                }
-            }
+            void construct(Type newType);
+            void destroy();
 
-            bool hasElement(const std::string& key) const
+            Value& setInt(uint64_t value)
             {
-                assert(type == Type::DICTIONARY);
-
-                return dictionaryValue.find(key) != dictionaryValue.end();
-            }
+                destroy();
+                type = Type::INT;
+                intValue = value;
 
-            void append(const Value& node)
-            {
-                arrayValue.push_back(node);
+                return *this;
             }
 
-        private:
             Type type = Type::NONE;
+            // only the member of the current type is alive
             union
             {
-                uint64_t intValue = 0;
+                uint64_t intValue;
                 double doubleValue;
+                std::string stringValue;
+                std::vector<uint8_t> byteArrayValue;
+                Object objectValue;
+                Array arrayValue;
+                Dictionary dictionaryValue;
             };
-            std::string stringValue;
-            std::vector<uint8_t> byteArrayValue;
-            std::map<uint32_t, Value> objectValue;
-            std::vector<Value> arrayValue;
-            std::map<std::string, Value> dictionaryValue;
         };
     } // namespace obf
 } // namespace ouzel
@@ -0,0 +1,410 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "OBFView.hpp"
+#include "Log.hpp"
+#include "Utils.hpp"
+
+namespace ouzel
+{
+    namespace obf
+    {
+        static uint32_t getRemaining(const uint8_t* data, const uint8_t* end)
+        {
+            return static_cast<uint32_t>(end - data);
+        }
+
+        // checks that the marker is valid and that the fixed size part of the value is inside the buffer
+        static bool checkHeader(const uint8_t* data, const uint8_t* end)
+        {
+            uint32_t remaining = getRemaining(data, end);
+
+            if (remaining < 1) return false;
+
+            switch (static_cast<Value::Marker>(*data))
+            {
+                case Value::Marker::NONE: return true;
+                case Value::Marker::INT8: return remaining >= 1 + sizeof(uint8_t);
+                case Value::Marker::INT16: return remaining >= 1 + sizeof(uint16_t);
+                case Value::Marker::INT32: return remaining >= 1 + sizeof(uint32_t);
+                case Value::Marker::INT64: return remaining >= 1 + sizeof(uint64_t);
+                case Value::Marker::FLOAT: return remaining >= 1 + sizeof(float);
+                case Value::Marker::DOUBLE: return remaining >= 1 + sizeof(double);
+                case Value::Marker::STRING:
+                    return remaining >= 1 + sizeof(uint16_t) &&
+                        remaining - 1 - sizeof(uint16_t) >= decodeUInt16Big(data + 1);
+                case Value::Marker::LONG_STRING:
+                case Value::Marker::BYTE_ARRAY:
+                    return remaining >= 1 + sizeof(uint32_t) &&
+                        remaining - 1 - sizeof(uint32_t) >= decodeUInt32Big(data + 1);
+                case Value::Marker::OBJECT:
+                case Value::Marker::ARRAY:
+                case Value::Marker::DICTIONARY:
+                    return remaining >= 1 + sizeof(uint32_t);
+                default: return false;
+            }
+        }
+
+        // returns the pointer after the value or nullptr if it is malformed
+        static const uint8_t* skip(const uint8_t* data, const uint8_t* end, uint32_t depth)
+        {
+            if (depth > Value::MAX_DEPTH || !checkHeader(data, end)) return nullptr;
+
+            switch (static_cast<Value::Marker>(*data))
+            {
+                case Value::Marker::NONE: return data + 1;
+                case Value::Marker::INT8: return data + 1 + sizeof(uint8_t);
+                case Value::Marker::INT16: return data + 1 + sizeof(uint16_t);
+                case Value::Marker::INT32: return data + 1 + sizeof(uint32_t);
+                case Value::Marker::INT64: return data + 1 + sizeof(uint64_t);
+                case Value::Marker::FLOAT: return data + 1 + sizeof(float);
+                case Value::Marker::DOUBLE: return data + 1 + sizeof(double);
+                case Value::Marker::STRING: return data + 1 + sizeof(uint16_t) + decodeUInt16Big(data + 1);
+                case Value::Marker::LONG_STRING:
+                case Value::Marker::BYTE_ARRAY:
+                    return data + 1 + sizeof(uint32_t) + decodeUInt32Big(data + 1);
+                case Value::Marker::OBJECT:
+                case Value::Marker::ARRAY:
+                case Value::Marker::DICTIONARY:
+                {
+                    Value::Marker marker = static_cast<Value::Marker>(*data);
+                    uint32_t count = decodeUInt32Big(data + 1);
+                    data += 1 + sizeof(uint32_t);
+
+                    // every element takes at least a byte, so this ends at the end of the buffer
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        if (marker == Value::Marker::OBJECT)
+                        {
+                            if (getRemaining(data, end) < sizeof(uint32_t)) return nullptr;
+                            data += sizeof(uint32_t);
+                        }
+                        else if (marker == Value::Marker::DICTIONARY)
+                        {
+                            if (getRemaining(data, end) < sizeof(uint16_t)) return nullptr;
+                            uint16_t length = decodeUInt16Big(data);
+                            data += sizeof(uint16_t);
+                            if (getRemaining(data, end) < length) return nullptr;
+                            data += length;
+                        }
+
+                        if (!(data = skip(data, end, depth + 1))) return nullptr;
+                    }
+
+                    return data;
+                }
+                default: return nullptr;
+            }
+        }
+
+        View::Iterator::Iterator(Value::Marker aMarker, const uint8_t* element, const uint8_t* aEnd, uint32_t count):
+            marker(aMarker), end(aEnd), remaining(count)
+        {
+            if (remaining > 0) readElement(element);
+        }
+
+        void View::Iterator::readElement(const uint8_t* element)
+        {
+            if (marker == Value::Marker::OBJECT)
+            {
+                if (getRemaining(element, end) < sizeof(uint32_t))
+                {
+                    fail();
+                    return;
+                }
+
+                name = element;
+                nameLength = sizeof(uint32_t);
+                element += sizeof(uint32_t);
+            }
+            else if (marker == Value::Marker::DICTIONARY)
+            {
+                if (getRemaining(element, end) < sizeof(uint16_t) ||
+                    getRemaining(element + sizeof(uint16_t), end) < decodeUInt16Big(element))
+                {
+                    fail();
+                    return;
+                }
+
+                nameLength = decodeUInt16Big(element);
+                name = element + sizeof(uint16_t);
+                element += sizeof(uint16_t) + nameLength;
+            }
+
+            if (!checkHeader(element, end))
+            {
+                fail();
+                return;
+            }
+
+            value = element;
+        }
+
+        void View::Iterator::fail()
+        {
+            Log(Log::Level::ERR) << "Malformed OBF element";
+
+            remaining = 0;
+            malformed = true;
+        }
+
+        View::Iterator& View::Iterator::operator++()
+        {
+            if (remaining > 0)
+            {
+                const uint8_t* next = skip(value, end, 0);
+
+                if (--remaining > 0)
+                {
+                    if (next) readElement(next);
+                    else fail();
+                }
+            }
+
+            return *this;
+        }
+
+        uint32_t View::Iterator::getKey() const
+        {
+            assert(marker == Value::Marker::OBJECT);
+
+            return decodeUInt32Big(name);
+        }
+
+        std::string View::Iterator::getName() const
+        {
+            assert(marker == Value::Marker::DICTIONARY);
+
+            return std::string(reinterpret_cast<const char*>(name), nameLength);
+        }
+
+        View::View(const std::vector<uint8_t>& buffer, uint32_t offset):
+            View(buffer.data() + std::min(offset, static_cast<uint32_t>(buffer.size())), buffer.data() + buffer.size())
+        {
+        }
+
+        View::View(const uint8_t* aData, uint32_t aSize):
+            View(aData, aData + aSize)
+        {
+        }
+
+        View::View(const uint8_t* aData, const uint8_t* aEnd)
+        {
+            if (aData && checkHeader(aData, aEnd))
+            {
+                data = aData;
+                bufferEnd = aEnd;
+            }
+        }
+
+        Value::Type View::getType() const
+        {
+            if (!data) return Value::Type::NONE;
+
+            switch (getMarker())
+            {
+                case Value::Marker::INT8:
+                case Value::Marker::INT16:
+                case Value::Marker::INT32:
+                case Value::Marker::INT64:
+                    return Value::Type::INT;
+                case Value::Marker::FLOAT: return Value::Type::FLOAT;
+                case Value::Marker::DOUBLE: return Value::Type::DOUBLE;
+                case Value::Marker::STRING:
+                case Value::Marker::LONG_STRING:
+                    return Value::Type::STRING;
+                case Value::Marker::BYTE_ARRAY: return Value::Type::BYTE_ARRAY;
+                case Value::Marker::OBJECT: return Value::Type::OBJECT;
+                case Value::Marker::ARRAY: return Value::Type::ARRAY;
+                case Value::Marker::DICTIONARY: return Value::Type::DICTIONARY;
+                default: return Value::Type::NONE;
+            }
+        }
+
+        uint32_t View::getEncodedSize() const
+        {
+            if (!data) return 0;
+
+            const uint8_t* next = skip(data, bufferEnd, 0);
+
+            return next ? static_cast<uint32_t>(next - data) : 0;
+        }
+
+        uint64_t View::asUInt64() const
+        {
+            assert(getType() == Value::Type::INT);
+
+            switch (getMarker())
+            {
+                case Value::Marker::INT8: return data[1];
+                case Value::Marker::INT16: return decodeUInt16Big(data + 1);
+                case Value::Marker::INT32: return decodeUInt32Big(data + 1);
+                case Value::Marker::INT64: return decodeUInt64Big(data + 1);
+                default: return 0;
+            }
+        }
+
+        double View::asDouble() const
+        {
+            assert(getType() == Value::Type::FLOAT || getType() == Value::Type::DOUBLE);
+
+            switch (getMarker())
+            {
+                // floating point values are stored in the native byte order
+                case Value::Marker::FLOAT:
+                {
+                    float result;
+                    memcpy(&result, data + 1, sizeof(result));
+                    return result;
+                }
+                case Value::Marker::DOUBLE:
+                {
+                    double result;
+                    memcpy(&result, data + 1, sizeof(result));
+                    return result;
+                }
+                default: return 0.0;
+            }
+        }
+
+        std::string View::asString() const
+        {
+            return std::string(getStringData(), getStringLength());
+        }
+
+        const char* View::getStringData() const
+        {
+            assert(getType() == Value::Type::STRING);
+
+            switch (getMarker())
+            {
+                case Value::Marker::STRING: return reinterpret_cast<const char*>(data + 1 + sizeof(uint16_t));
+                case Value::Marker::LONG_STRING: return reinterpret_cast<const char*>(data + 1 + sizeof(uint32_t));
+                default: return nullptr;
+            }
+        }
+
+        uint32_t View::getStringLength() const
+        {
+            assert(getType() == Value::Type::STRING);
+
+            switch (getMarker())
+            {
+                case Value::Marker::STRING: return decodeUInt16Big(data + 1);
+                case Value::Marker::LONG_STRING: return decodeUInt32Big(data + 1);
+                default: return 0;
+            }
+        }
+
+        std::vector<uint8_t> View::asByteArray() const
+        {
+            return std::vector<uint8_t>(getByteArrayData(), getByteArrayData() + getByteArraySize());
+        }
+
+        const uint8_t* View::getByteArrayData() const
+        {
+            assert(getType() == Value::Type::BYTE_ARRAY);
+
+            return (data && getMarker() == Value::Marker::BYTE_ARRAY) ? data + 1 + sizeof(uint32_t) : nullptr;
+        }
+
+        uint32_t View::getByteArraySize() const
+        {
+            assert(getType() == Value::Type::BYTE_ARRAY);
+
+            return (data && getMarker() == Value::Marker::BYTE_ARRAY) ? decodeUInt32Big(data + 1) : 0;
+        }
+
+        uint32_t View::getCount() const
+        {
+            switch (getType())
+            {
+                case Value::Type::OBJECT:
+                case Value::Type::ARRAY:
+                case Value::Type::DICTIONARY:
+                    return decodeUInt32Big(data + 1);
+                default:
+                    return 0;
+            }
+        }
+
+        View::Iterator View::begin() const
+        {
+            switch (getType())
+            {
+                case Value::Type::OBJECT:
+                case Value::Type::ARRAY:
+                case Value::Type::DICTIONARY:
+                    return Iterator(getMarker(), data + 1 + sizeof(uint32_t), bufferEnd, decodeUInt32Big(data + 1));
+                default:
+                    return Iterator();
+            }
+        }
+
+        View View::operator[](uint32_t key) const
+        {
+            if (getType() == Value::Type::OBJECT)
+            {
+                for (Iterator i = begin(); i != end(); ++i)
+                {
+                    if (i.getKey() == key) return *i;
+                }
+            }
+            else if (getType() == Value::Type::ARRAY && key < getCount())
+            {
+                Iterator i = begin();
+
+                for (uint32_t index = 0; index < key && i != end(); ++index) ++i;
+
+                if (i != end()) return *i;
+            }
+
+            return View();
+        }
+
+        View View::operator[](const std::string& key) const
+        {
+            if (getType() == Value::Type::DICTIONARY)
+            {
+                for (Iterator i = begin(); i != end(); ++i)
+                {
+                    if (i.getNameLength() == key.length() &&
+                        memcmp(i.getNameData(), key.data(), key.length()) == 0)
+                    {
+                        return *i;
+                    }
+                }
+            }
+
+            return View();
+        }
+
+        ArrayAccessor::ArrayAccessor(const View& aArray):
+            array(aArray)
+        {
+            if (array.getType() == Value::Type::ARRAY)
+            {
+                count = array.getCount();
+                iterator = array.begin();
+            }
+        }
+
+        View ArrayAccessor::operator[](uint32_t index)
+        {
+            if (index >= count) return View();
+
+            if (index < iteratorIndex)
+            {
+                iterator = array.begin();
+                iteratorIndex = 0;
+            }
+
+            for (; iteratorIndex < index && iterator != array.end(); ++iteratorIndex) ++iterator;
+
+            return (iterator != array.end()) ? *iterator : View();
+        }
+    } // namespace obf
+} // namespace ouzel
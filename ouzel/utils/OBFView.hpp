@@ -0,0 +1,148 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "utils/OBF.hpp"
+
+namespace ouzel
+{
+    namespace obf
+    {
+        // read-only view of an encoded value, reads the buffer in place without copying or allocating
+        class View
+        {
+        public:
+            // iterates over the elements of an object, an array or a dictionary
+            class Iterator: public std::iterator<std::forward_iterator_tag, View>
+            {
+                friend View;
+            public:
+                Iterator() {}
+
+                View operator*() const { return View(value, end); }
+
+                Iterator& operator++();
+                Iterator operator++(int)
+                {
+                    Iterator result = *this;
+                    ++(*this);
+                    return result;
+                }
+
+                bool operator==(const Iterator& other) const
+                {
+                    return remaining == other.remaining && (remaining == 0 || value == other.value);
+                }
+
+                bool operator!=(const Iterator& other) const
+                {
+                    return !(*this == other);
+                }
+
+                // key of the object element
+                uint32_t getKey() const;
+                // key of the dictionary element
+                std::string getName() const;
+                const char* getNameData() const { return reinterpret_cast<const char*>(name); }
+                uint32_t getNameLength() const { return nameLength; }
+
+                // true if the iteration ended early, because an element was malformed
+                bool isMalformed() const { return malformed; }
+
+            private:
+                Iterator(Value::Marker aMarker, const uint8_t* element, const uint8_t* aEnd, uint32_t count);
+                void readElement(const uint8_t* element);
+                void fail();
+
+                Value::Marker marker = Value::Marker::NONE;
+                const uint8_t* value = nullptr;
+                const uint8_t* name = nullptr;
+                uint32_t nameLength = 0;
+                const uint8_t* end = nullptr;
+                uint32_t remaining = 0;
+                bool malformed = false;
+            };
+
+            View() {}
+            View(const std::vector<uint8_t>& buffer, uint32_t offset = 0);
+            View(const uint8_t* aData, uint32_t aSize);
+
+            bool isValid() const { return data != nullptr; }
+
+            Value::Type getType() const;
+            bool isIntType() const { return getType() == Value::Type::INT; }
+            bool isFloatType() const { return getType() == Value::Type::FLOAT || getType() == Value::Type::DOUBLE; }
+            bool isStringType() const { return getType() == Value::Type::STRING; }
+
+            // number of bytes the value occupies in the buffer, 0 if the value is malformed
+            uint32_t getEncodedSize() const;
+
+            int8_t asInt8() const { return static_cast<int8_t>(asUInt64()); }
+            uint8_t asUInt8() const { return static_cast<uint8_t>(asUInt64()); }
+            int16_t asInt16() const { return static_cast<int16_t>(asUInt64()); }
+            uint16_t asUInt16() const { return static_cast<uint16_t>(asUInt64()); }
+            int32_t asInt32() const { return static_cast<int32_t>(asUInt64()); }
+            uint32_t asUInt32() const { return static_cast<uint32_t>(asUInt64()); }
+            int64_t asInt64() const { return static_cast<int64_t>(asUInt64()); }
+            uint64_t asUInt64() const;
+            float asFloat() const { return static_cast<float>(asDouble()); }
+            double asDouble() const;
+
+            // copies the string out of the buffer
+            std::string asString() const;
+            const char* getStringData() const;
+            uint32_t getStringLength() const;
+
+            std::vector<uint8_t> asByteArray() const;
+            const uint8_t* getByteArrayData() const;
+            uint32_t getByteArraySize() const;
+
+            // number of elements of an object, an array or a dictionary, 0 for other types
+            uint32_t getCount() const;
+
+            // searches the object by key or the array by index, the result is invalid if not found or if the
+            // value is of other type, the array is scanned from the start, use ArrayAccessor for repeated indexing
+            View operator[](uint32_t key) const;
+            // searches the dictionary
+            View operator[](const std::string& key) const;
+
+            bool hasElement(uint32_t key) const { return (*this)[key].isValid(); }
+            bool hasElement(const std::string& key) const { return (*this)[key].isValid(); }
+
+            Iterator begin() const;
+            Iterator end() const { return Iterator(); }
+
+        private:
+            View(const uint8_t* aData, const uint8_t* aEnd);
+
+            Value::Marker getMarker() const { return static_cast<Value::Marker>(*data); }
+
+            const uint8_t* data = nullptr; // points to the marker
+            const uint8_t* bufferEnd = nullptr;
+        };
+
+        // indexes an array and continues from the previously found element if the index is not lower,
+        // so reading the elements in increasing order scans the array once
+        class ArrayAccessor
+        {
+        public:
+            explicit ArrayAccessor(const View& aArray);
+
+            uint32_t getCount() const { return count; }
+
+            // the result is invalid if the index is out of range or the array is malformed
+            View operator[](uint32_t index);
+
+        private:
+            View array;
+            uint32_t count = 0;
+            View::Iterator iterator;
+            uint32_t iteratorIndex = 0;
+        };
+    } // namespace obf
+} // namespace ouzel
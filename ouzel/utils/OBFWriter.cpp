@@ -0,0 +1,248 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <limits>
+#include "OBFWriter.hpp"
+#include "Log.hpp"
+#include "Utils.hpp"
+
+namespace ouzel
+{
+    namespace obf
+    {
+        Writer::Writer(std::vector<uint8_t>& aBuffer):
+            buffer(aBuffer)
+        {
+        }
+
+        bool Writer::beginValue()
+        {
+            if (depth > 0)
+            {
+                Container& container = containers[depth - 1];
+
+                if (container.marker != Value::Marker::ARRAY)
+                {
+                    if (!container.hasKey)
+                    {
+                        Log(Log::Level::ERR) << "Missing key of the element";
+                        return false;
+                    }
+
+                    container.hasKey = false;
+                }
+
+                ++container.count;
+            }
+
+            return true;
+        }
+
+        bool Writer::writeNone()
+        {
+            if (!beginValue()) return false;
+
+            buffer.push_back(static_cast<uint8_t>(Value::Marker::NONE));
+
+            return true;
+        }
+
+        bool Writer::writeInt(uint64_t value)
+        {
+            if (!beginValue()) return false;
+
+            // the same size selection as Value::encode
+            if (value > std::numeric_limits<uint32_t>::max())
+            {
+                buffer.push_back(static_cast<uint8_t>(Value::Marker::INT64));
+                writeUInt64Big(buffer, value);
+            }
+            else if (value > std::numeric_limits<uint16_t>::max())
+            {
+                buffer.push_back(static_cast<uint8_t>(Value::Marker::INT32));
+                writeUInt32Big(buffer, static_cast<uint32_t>(value));
+            }
+            else if (value > std::numeric_limits<uint8_t>::max())
+            {
+                buffer.push_back(static_cast<uint8_t>(Value::Marker::INT16));
+                writeUInt16Big(buffer, static_cast<uint16_t>(value));
+            }
+            else
+            {
+                buffer.push_back(static_cast<uint8_t>(Value::Marker::INT8));
+                buffer.push_back(static_cast<uint8_t>(value));
+            }
+
+            return true;
+        }
+
+        bool Writer::writeFloat(float value)
+        {
+            if (!beginValue()) return false;
+
+            // floating point values are stored in the native byte order
+            buffer.push_back(static_cast<uint8_t>(Value::Marker::FLOAT));
+            buffer.insert(buffer.end(),
+                          reinterpret_cast<const uint8_t*>(&value),
+                          reinterpret_cast<const uint8_t*>(&value) + sizeof(value));
+
+            return true;
+        }
+
+        bool Writer::writeDouble(double value)
+        {
+            if (!beginValue()) return false;
+
+            buffer.push_back(static_cast<uint8_t>(Value::Marker::DOUBLE));
+            buffer.insert(buffer.end(),
+                          reinterpret_cast<const uint8_t*>(&value),
+                          reinterpret_cast<const uint8_t*>(&value) + sizeof(value));
+
+            return true;
+        }
+
+        bool Writer::writeString(const char* value, uint32_t length)
+        {
+            if (!beginValue()) return false;
+
+            if (length > std::numeric_limits<uint16_t>::max())
+            {
+                buffer.push_back(static_cast<uint8_t>(Value::Marker::LONG_STRING));
+                writeUInt32Big(buffer, length);
+            }
+            else
+            {
+                buffer.push_back(static_cast<uint8_t>(Value::Marker::STRING));
+                writeUInt16Big(buffer, static_cast<uint16_t>(length));
+            }
+
+            buffer.insert(buffer.end(), value, value + length);
+
+            return true;
+        }
+
+        bool Writer::writeByteArray(const uint8_t* value, uint32_t size)
+        {
+            if (!beginValue()) return false;
+
+            buffer.push_back(static_cast<uint8_t>(Value::Marker::BYTE_ARRAY));
+            writeUInt32Big(buffer, size);
+            buffer.insert(buffer.end(), value, value + size);
+
+            return true;
+        }
+
+        bool Writer::beginContainer(Value::Marker marker)
+        {
+            if (depth >= Value::MAX_DEPTH)
+            {
+                Log(Log::Level::ERR) << "Too many nested containers";
+                return false;
+            }
+
+            if (!beginValue()) return false;
+
+            buffer.push_back(static_cast<uint8_t>(marker));
+
+            Container& container = containers[depth++];
+            container.marker = marker;
+            container.countOffset = static_cast<uint32_t>(buffer.size());
+            container.count = 0;
+            container.hasKey = false;
+
+            writeUInt32Big(buffer, 0);
+
+            return true;
+        }
+
+        bool Writer::endContainer(Value::Marker marker)
+        {
+            if (depth == 0 || containers[depth - 1].marker != marker)
+            {
+                Log(Log::Level::ERR) << "Mismatched end of container";
+                return false;
+            }
+
+            if (containers[depth - 1].hasKey)
+            {
+                Log(Log::Level::ERR) << "Missing value of the element";
+                return false;
+            }
+
+            const Container& container = containers[--depth];
+            encodeUInt32Big(buffer.data() + container.countOffset, container.count);
+
+            return true;
+        }
+
+        bool Writer::beginObject()
+        {
+            return beginContainer(Value::Marker::OBJECT);
+        }
+
+        bool Writer::endObject()
+        {
+            return endContainer(Value::Marker::OBJECT);
+        }
+
+        bool Writer::beginArray()
+        {
+            return beginContainer(Value::Marker::ARRAY);
+        }
+
+        bool Writer::endArray()
+        {
+            return endContainer(Value::Marker::ARRAY);
+        }
+
+        bool Writer::beginDictionary()
+        {
+            return beginContainer(Value::Marker::DICTIONARY);
+        }
+
+        bool Writer::endDictionary()
+        {
+            return endContainer(Value::Marker::DICTIONARY);
+        }
+
+        bool Writer::writeKey(uint32_t key)
+        {
+            if (depth == 0 || containers[depth - 1].marker != Value::Marker::OBJECT || containers[depth - 1].hasKey)
+            {
+                Log(Log::Level::ERR) << "Unexpected key";
+                return false;
+            }
+
+            containers[depth - 1].hasKey = true;
+            writeUInt32Big(buffer, key);
+
+            return true;
+        }
+
+        bool Writer::writeKey(const char* key, uint16_t length)
+        {
+            if (depth == 0 || containers[depth - 1].marker != Value::Marker::DICTIONARY || containers[depth - 1].hasKey)
+            {
+                Log(Log::Level::ERR) << "Unexpected key";
+                return false;
+            }
+
+            containers[depth - 1].hasKey = true;
+            writeUInt16Big(buffer, length);
+            buffer.insert(buffer.end(), key, key + length);
+
+            return true;
+        }
+
+        bool Writer::writeKey(const std::string& key)
+        {
+            if (key.length() > std::numeric_limits<uint16_t>::max())
+            {
+                Log(Log::Level::ERR) << "Key too long";
+                return false;
+            }
+
+            return writeKey(key.data(), static_cast<uint16_t>(key.length()));
+        }
+    } // namespace obf
+} // namespace ouzel
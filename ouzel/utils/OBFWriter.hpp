@@ -0,0 +1,65 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "utils/OBF.hpp"
+
+namespace ouzel
+{
+    namespace obf
+    {
+        // appends encoded values to the buffer without building a Value tree
+        class Writer
+        {
+        public:
+            explicit Writer(std::vector<uint8_t>& aBuffer);
+
+            bool writeNone();
+            bool writeInt(uint64_t value);
+            bool writeFloat(float value);
+            bool writeDouble(double value);
+            bool writeString(const char* value, uint32_t length);
+            bool writeString(const std::string& value) { return writeString(value.data(), static_cast<uint32_t>(value.length())); }
+            bool writeByteArray(const uint8_t* value, uint32_t size);
+            bool writeByteArray(const std::vector<uint8_t>& value) { return writeByteArray(value.data(), static_cast<uint32_t>(value.size())); }
+
+            // the element count is written when the container is ended
+            bool beginObject();
+            bool endObject();
+            bool beginArray();
+            bool endArray();
+            bool beginDictionary();
+            bool endDictionary();
+
+            // every element of an object or a dictionary must be preceded by a key
+            bool writeKey(uint32_t key);
+            bool writeKey(const char* key, uint16_t length);
+            // fails if the key is longer than 65535 bytes
+            bool writeKey(const std::string& key);
+
+            // true if all the containers were ended
+            bool isComplete() const { return depth == 0; }
+
+        private:
+            struct Container
+            {
+                Value::Marker marker;
+                uint32_t countOffset;
+                uint32_t count;
+                bool hasKey;
+            };
+
+            bool beginValue();
+            bool beginContainer(Value::Marker marker);
+            bool endContainer(Value::Marker marker);
+
+            std::vector<uint8_t>& buffer;
+            Container containers[Value::MAX_DEPTH];
+            uint32_t depth = 0;
+        };
+    } // namespace obf
+} // namespace ouzel
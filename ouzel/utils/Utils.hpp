@@ -7,6 +7,7 @@
 #include <vector>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <functional>
 #include <random>
@@ -164,6 +165,24 @@ namespace ouzel
         return static_cast<uint16_t>(result);
     };
 
+    inline float decodeFloatBig(const uint8_t* buffer)
+    {
+        uint32_t bits = decodeUInt32Big(buffer);
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+
+        return result;
+    };
+
+    inline float decodeFloatLittle(const uint8_t* buffer)
+    {
+        uint32_t bits = decodeUInt32Little(buffer);
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+
+        return result;
+    };
+
     // encoding
 
     inline void encodeInt64Big(uint8_t* buffer, int64_t value)
@@ -270,6 +289,155 @@ namespace ouzel
         buffer[0] = static_cast<uint8_t>(value);
     };
 
+    inline void encodeFloatBig(uint8_t* buffer, float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        encodeUInt32Big(buffer, bits);
+    };
+
+    inline void encodeFloatLittle(uint8_t* buffer, float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        encodeUInt32Little(buffer, bits);
+    };
+
+    // appending to and reading from byte buffers, the read functions advance the offset
+    // and return false if there is not enough data left
+
+    inline void writeUInt8(std::vector<uint8_t>& buffer, uint8_t value)
+    {
+        buffer.push_back(value);
+    }
+
+    inline void writeUInt16Little(std::vector<uint8_t>& buffer, uint16_t value)
+    {
+        uint8_t data[sizeof(value)];
+        encodeUInt16Little(data, value);
+        buffer.insert(buffer.end(), data, data + sizeof(data));
+    }
+
+    inline void writeUInt32Little(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        uint8_t data[sizeof(value)];
+        encodeUInt32Little(data, value);
+        buffer.insert(buffer.end(), data, data + sizeof(data));
+    }
+
+    inline void writeFloatLittle(std::vector<uint8_t>& buffer, float value)
+    {
+        uint8_t data[sizeof(value)];
+        encodeFloatLittle(data, value);
+        buffer.insert(buffer.end(), data, data + sizeof(data));
+    }
+
+    // the length is stored as a 16-bit integer, longer strings are not written and false is returned
+    inline bool writeStringLittle(std::vector<uint8_t>& buffer, const std::string& value)
+    {
+        if (value.length() > std::numeric_limits<uint16_t>::max()) return false;
+
+        writeUInt16Little(buffer, static_cast<uint16_t>(value.length()));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+        return true;
+    }
+
+    inline void writeUInt16Big(std::vector<uint8_t>& buffer, uint16_t value)
+    {
+        uint8_t data[sizeof(value)];
+        encodeUInt16Big(data, value);
+        buffer.insert(buffer.end(), data, data + sizeof(data));
+    }
+
+    inline void writeUInt32Big(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        uint8_t data[sizeof(value)];
+        encodeUInt32Big(data, value);
+        buffer.insert(buffer.end(), data, data + sizeof(data));
+    }
+
+    inline void writeUInt64Big(std::vector<uint8_t>& buffer, uint64_t value)
+    {
+        uint8_t data[sizeof(value)];
+        encodeUInt64Big(data, value);
+        buffer.insert(buffer.end(), data, data + sizeof(data));
+    }
+
+    inline bool readUInt8(const std::vector<uint8_t>& buffer, uint32_t& offset, uint8_t& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = buffer[offset];
+        offset += sizeof(result);
+        return true;
+    }
+
+    inline bool readUInt16Little(const std::vector<uint8_t>& buffer, uint32_t& offset, uint16_t& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = decodeUInt16Little(buffer.data() + offset);
+        offset += sizeof(result);
+        return true;
+    }
+
+    inline bool readUInt32Little(const std::vector<uint8_t>& buffer, uint32_t& offset, uint32_t& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = decodeUInt32Little(buffer.data() + offset);
+        offset += sizeof(result);
+        return true;
+    }
+
+    inline bool readInt32Little(const std::vector<uint8_t>& buffer, uint32_t& offset, int32_t& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = decodeInt32Little(buffer.data() + offset);
+        offset += sizeof(result);
+        return true;
+    }
+
+    inline bool readFloatLittle(const std::vector<uint8_t>& buffer, uint32_t& offset, float& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = decodeFloatLittle(buffer.data() + offset);
+        offset += sizeof(result);
+        return true;
+    }
+
+    inline bool readStringLittle(const std::vector<uint8_t>& buffer, uint32_t& offset, std::string& result)
+    {
+        uint32_t stringOffset = offset;
+        uint16_t length;
+        if (!readUInt16Little(buffer, stringOffset, length)) return false;
+        if (buffer.size() - stringOffset < length) return false;
+        result.assign(reinterpret_cast<const char*>(buffer.data() + stringOffset), length);
+        offset = stringOffset + length;
+        return true;
+    }
+
+    inline bool readUInt16Big(const std::vector<uint8_t>& buffer, uint32_t& offset, uint16_t& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = decodeUInt16Big(buffer.data() + offset);
+        offset += sizeof(result);
+        return true;
+    }
+
+    inline bool readUInt32Big(const std::vector<uint8_t>& buffer, uint32_t& offset, uint32_t& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = decodeUInt32Big(buffer.data() + offset);
+        offset += sizeof(result);
+        return true;
+    }
+
+    inline bool readUInt64Big(const std::vector<uint8_t>& buffer, uint32_t& offset, uint64_t& result)
+    {
+        if (offset > buffer.size() || buffer.size() - offset < sizeof(result)) return false;
+        result = decodeUInt64Big(buffer.data() + offset);
+        offset += sizeof(result);
+        return true;
+    }
+
     template<class T>
     inline std::vector<uint32_t> utf8to32(const T& text)
     {
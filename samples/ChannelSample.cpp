@@ -0,0 +1,209 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cstdlib>
+#include "ChannelSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+static const float STEP = 1.0f / 60.0f;
+static const float DRAIN_TIME = 10.0f; // time to deliver the remaining reliable messages after sending stops
+static const uint32_t LARGE_MESSAGE_INTERVAL = 50; // every n-th reliable message is split into fragments
+static const uint32_t LARGE_MESSAGE_SIZE = 3000;
+static const uint32_t MESSAGE_SIZE = 64;
+
+static float getSetting(const string& key, float defaultValue)
+{
+    string value = sharedEngine->getDefaultSettings().getValue("channel", key);
+    return value.empty() ? defaultValue : stof(value);
+}
+
+ChannelSample::ChannelSample():
+    loss(getSetting("loss", 0.1f)),
+    reorder(getSetting("reorder", 0.05f)),
+    latency(getSetting("latency", 0.1f)),
+    jitter(getSetting("jitter", 0.02f)),
+    duration(getSetting("duration", 30.0f)),
+    rate(getSetting("rate", static_cast<float>(network::Channel::DEFAULT_SEND_RATE))),
+    random(1),
+    client(bind(&ChannelSample::sendPacket, this, ref(serverLink), placeholders::_1)),
+    server(bind(&ChannelSample::sendPacket, this, ref(clientLink), placeholders::_1))
+{
+    client.setSendRate(static_cast<uint32_t>(rate));
+    server.setSendRate(static_cast<uint32_t>(rate));
+}
+
+bool ChannelSample::sendPacket(Link& link, const vector<uint8_t>& data)
+{
+    ++link.sent;
+
+    if (uniform_real_distribution<float>(0.0f, 1.0f)(random) < loss)
+    {
+        ++link.dropped;
+        return true;
+    }
+
+    Packet packet;
+    packet.deliveryTime = time + latency + uniform_real_distribution<float>(0.0f, jitter)(random);
+    packet.data = data;
+
+    // a reordered packet arrives after the packets sent during the next latency period
+    if (uniform_real_distribution<float>(0.0f, 1.0f)(random) < reorder)
+    {
+        packet.deliveryTime += latency;
+        ++link.reordered;
+    }
+
+    link.packets.push_back(packet);
+
+    return true;
+}
+
+void ChannelSample::deliver(Link& link, network::Channel& channel)
+{
+    // the packets are delivered in the order of their delivery times
+    stable_sort(link.packets.begin(), link.packets.end(), [](const Packet& a, const Packet& b) {
+        return a.deliveryTime < b.deliveryTime;
+    });
+
+    auto i = link.packets.begin();
+    for (; i != link.packets.end() && i->deliveryTime <= time; ++i)
+    {
+        if (!channel.receive(i->data))
+        {
+            Log(Log::Level::ERR) << "Failed to receive a packet";
+        }
+    }
+
+    link.packets.erase(link.packets.begin(), i);
+}
+
+vector<uint8_t> ChannelSample::createMessage(uint32_t index, bool reliable)
+{
+    vector<uint8_t> message((reliable && index % LARGE_MESSAGE_INTERVAL == 0) ? LARGE_MESSAGE_SIZE : MESSAGE_SIZE);
+
+    message[0] = reliable ? 1 : 0;
+    encodeUInt32Little(message.data() + 1, index);
+
+    for (size_t i = 5; i < message.size(); ++i)
+    {
+        message[i] = static_cast<uint8_t>(index + i);
+    }
+
+    return message;
+}
+
+bool ChannelSample::checkMessage(const vector<uint8_t>& message, uint32_t& index, bool& reliable)
+{
+    if (message.size() < 5) return false;
+
+    reliable = message[0] != 0;
+    index = decodeUInt32Little(message.data() + 1);
+
+    return message == createMessage(index, reliable);
+}
+
+// the whole run is simulated with a fixed time step
+bool ChannelSample::run()
+{
+    Log(Log::Level::INFO) << "Channel loopback: loss " << loss << ", reorder " << reorder <<
+        ", latency " << latency << " s, jitter " << jitter << " s, " << rate << " bytes/s, " << duration << " s";
+
+    uint32_t reliableSent = 0;
+    uint32_t unreliableSent = 0;
+    uint32_t reliableReceived = 0;
+    uint32_t unreliableReceived = 0;
+    uint32_t corrupted = 0;
+    uint32_t outOfOrder = 0;
+    uint64_t bytesReceived = 0;
+    float lastReliableTime = 0.0f;
+    float totalReliableLatency = 0.0f;
+    vector<float> reliableSendTimes;
+
+    vector<uint8_t> message;
+
+    while (time < duration + DRAIN_TIME)
+    {
+        if (time < duration)
+        {
+            // a reliable event and an unreliable state update every step
+            if (client.send(createMessage(reliableSent, true), true))
+            {
+                reliableSendTimes.push_back(time);
+                ++reliableSent;
+            }
+
+            if (client.send(createMessage(unreliableSent, false), false))
+                ++unreliableSent;
+        }
+        else if (reliableReceived == reliableSent)
+        {
+            break;
+        }
+
+        client.update(STEP);
+        server.update(STEP);
+
+        deliver(serverLink, server);
+        deliver(clientLink, client);
+
+        while (server.getMessage(message))
+        {
+            uint32_t index;
+            bool reliable;
+
+            bytesReceived += message.size();
+
+            if (!checkMessage(message, index, reliable))
+            {
+                ++corrupted;
+            }
+            else if (reliable)
+            {
+                if (index != reliableReceived) ++outOfOrder;
+
+                if (index < reliableSendTimes.size())
+                {
+                    totalReliableLatency += time - reliableSendTimes[index];
+                }
+
+                lastReliableTime = time;
+                ++reliableReceived;
+            }
+            else
+            {
+                ++unreliableReceived;
+            }
+        }
+
+        time += STEP;
+    }
+
+    const network::Channel::Statistics& clientStatistics = client.getStatistics();
+    const network::Channel::Statistics& serverStatistics = server.getStatistics();
+
+    Log(Log::Level::INFO) << "Link: " << serverLink.sent + clientLink.sent << " packets, " <<
+        serverLink.dropped + clientLink.dropped << " dropped, " << serverLink.reordered + clientLink.reordered << " reordered";
+    Log(Log::Level::INFO) << "Reliable: " << reliableReceived << "/" << reliableSent << " delivered, " <<
+        clientStatistics.messagesResent << " resent, average latency " <<
+        (reliableReceived ? totalReliableLatency / reliableReceived * 1000.0f : 0.0f) << " ms, last at " << lastReliableTime << " s";
+    Log(Log::Level::INFO) << "Unreliable: " << unreliableReceived << "/" << unreliableSent << " delivered (" <<
+        (unreliableSent ? 100.0f * unreliableReceived / unreliableSent : 0.0f) << "%)";
+    Log(Log::Level::INFO) << "Client: " << clientStatistics.packetsSent << " packets sent, " << clientStatistics.packetsAcked << " acked, " <<
+        clientStatistics.packetsLost << " lost, estimated RTT " << clientStatistics.rtt * 1000.0f << " ms, estimated loss " <<
+        clientStatistics.packetLoss * 100.0f << "%, " << clientStatistics.bytesSent << " bytes sent";
+    Log(Log::Level::INFO) << "Throughput: " << bytesReceived / time / 1024.0f << " KiB/s of messages delivered, " <<
+        clientStatistics.bytesSent / time / 1024.0f << " KiB/s sent by the client, " <<
+        serverStatistics.bytesSent / time / 1024.0f << " KiB/s sent by the server";
+
+    if (corrupted || outOfOrder || reliableReceived != reliableSent)
+    {
+        Log(Log::Level::ERR) << "Channel test failed: " << corrupted << " corrupted, " << outOfOrder << " out of order, " <<
+            reliableSent - reliableReceived << " reliable messages missing";
+        return false;
+    }
+
+    return true;
+}
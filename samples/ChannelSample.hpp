@@ -0,0 +1,53 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "RunOnceSample.hpp"
+
+// Loopback test of network::Channel, run with "-sample channel": two channels exchange messages over a
+// simulated link with the loss, reordering and latency from the [channel] section of settings.ini.
+// The delivery, throughput and retransmit statistics are logged and the sample exits with EXIT_FAILURE if a reliable
+// message was lost, corrupted or delivered out of order.
+class ChannelSample: public RunOnceSample
+{
+public:
+    ChannelSample();
+
+private:
+    struct Packet
+    {
+        float deliveryTime;
+        std::vector<uint8_t> data;
+    };
+
+    struct Link
+    {
+        std::vector<Packet> packets;
+        uint64_t sent = 0;
+        uint64_t dropped = 0;
+        uint64_t reordered = 0;
+    };
+
+    virtual bool run() override;
+    bool sendPacket(Link& link, const std::vector<uint8_t>& data);
+    void deliver(Link& link, ouzel::network::Channel& channel);
+
+    static std::vector<uint8_t> createMessage(uint32_t index, bool reliable);
+    static bool checkMessage(const std::vector<uint8_t>& message, uint32_t& index, bool& reliable);
+
+    float loss;
+    float reorder;
+    float latency;
+    float jitter;
+    float duration;
+    float rate;
+
+    float time = 0.0f;
+    std::mt19937 random; // fixed seed, so that runs are repeatable
+
+    Link serverLink; // packets from the client to the server
+    Link clientLink; // packets from the server to the client
+    ouzel::network::Channel client;
+    ouzel::network::Channel server;
+};
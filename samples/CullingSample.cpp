@@ -0,0 +1,86 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <chrono>
+#include "CullingSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+static const uint32_t GRID_SIZE = 100;
+static const float GRID_SPACING = 10.0f;
+static const uint32_t ITERATIONS = 100;
+
+CullingSample::CullingSample()
+{
+    camera.setType(scene::Camera::Type::PERSPECTIVE);
+    camera.setFarPlane(1000.0f);
+    cameraActor.setPosition(Vector3(0.0f, 0.0f, -400.0f));
+    cameraActor.addComponent(&camera);
+    layer.addChild(&cameraActor);
+
+    // a part of the grid is outside of the view and every fourth actor has a different order
+    for (uint32_t y = 0; y < GRID_SIZE; ++y)
+    {
+        for (uint32_t x = 0; x < GRID_SIZE; ++x)
+        {
+            components.push_back(unique_ptr<scene::Component>(new scene::Component(scene::Component::NONE)));
+            components.back()->setBoundingBox(Box3(Vector3(-2.0f, -2.0f, -2.0f), Vector3(2.0f, 2.0f, 2.0f)));
+
+            actors.push_back(unique_ptr<scene::Actor>(new scene::Actor()));
+            actors.back()->setPosition(Vector2((static_cast<float>(x) - GRID_SIZE / 2.0f) * GRID_SPACING,
+                                               (static_cast<float>(y) - GRID_SIZE / 2.0f) * GRID_SPACING));
+            actors.back()->setOrder(static_cast<int32_t>(x % 4));
+            actors.back()->addComponent(components.back().get());
+            layer.addChild(actors.back().get());
+        }
+    }
+
+    addLayer(&layer);
+}
+
+bool CullingSample::run()
+{
+    auto start = chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < ITERATIONS; ++i)
+    {
+        layer.cullActors(&camera);
+    }
+
+    float seconds = chrono::duration_cast<chrono::duration<float>>(chrono::steady_clock::now() - start).count();
+
+    const vector<scene::Actor*>& visibleActors = layer.getVisibleActors();
+
+    // compare with testing every actor separately
+    size_t expectedCount = 0;
+
+    for (const unique_ptr<scene::Actor>& actor : actors)
+    {
+        if (camera.checkVisibility(actor->getTransform(), actor->getBoundingBox())) ++expectedCount;
+    }
+
+    if (visibleActors.size() != expectedCount)
+    {
+        Log(Log::Level::ERR) << "Batched culling found " << visibleActors.size() << " visible actors instead of " << expectedCount;
+        return false;
+    }
+
+    for (size_t i = 1; i < visibleActors.size(); ++i)
+    {
+        if (visibleActors[i - 1]->getWorldOrder() < visibleActors[i]->getWorldOrder())
+        {
+            Log(Log::Level::ERR) << "Visible actors are not sorted by order";
+            return false;
+        }
+    }
+
+    // the camera actor has no bounding box, so it is not collected
+    float boxesPerSecond = static_cast<float>(actors.size()) * ITERATIONS / seconds;
+
+    Log(Log::Level::INFO) << "Culling: " << actors.size() << " actors, " << visibleActors.size() << " visible";
+    Log(Log::Level::INFO) << "Visit and cull: " << seconds * 1000000.0f / ITERATIONS << " us per frame, " <<
+        boxesPerSecond / 1000000.0f << " million culled boxes per second";
+
+    return true;
+}
@@ -0,0 +1,31 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "RunOnceSample.hpp"
+
+// Benchmark of the layer culling, run with "-sample culling_benchmark":
+// a grid of actors is culled against a perspective camera and the culled boxes per second are logged
+class CullingSample: public RunOnceSample
+{
+public:
+    CullingSample();
+
+private:
+    class CullingLayer: public ouzel::scene::Layer
+    {
+    public:
+        void cullActors(ouzel::scene::Camera* camera) { cull(camera); }
+        const std::vector<ouzel::scene::Actor*>& getVisibleActors() const { return drawQueue; }
+    };
+
+    virtual bool run() override;
+
+    CullingLayer layer;
+    ouzel::scene::Camera camera;
+    ouzel::scene::Actor cameraActor;
+
+    std::vector<std::unique_ptr<ouzel::scene::Actor>> actors;
+    std::vector<std::unique_ptr<ouzel::scene::Component>> components;
+};
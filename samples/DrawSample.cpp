@@ -0,0 +1,71 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cstdlib>
+#include "DrawSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+static const uint32_t SHAPE_COUNT = 5000;
+static const uint32_t GROUP_SIZE = 50; // consecutive shapes share the blend state
+static const uint32_t WARMUP_FRAMES = 10;
+static const uint32_t FRAME_COUNT = 300;
+
+DrawSample::DrawSample()
+{
+    updateCallback.callback = bind(&DrawSample::update, this, placeholders::_1);
+    sharedEngine->scheduleUpdate(&updateCallback);
+
+    camera.setScaleMode(scene::Camera::ScaleMode::SHOW_ALL);
+    camera.setTargetContentSize(Size2(800.0f, 600.0f));
+    cameraActor.addComponent(&camera);
+    layer.addChild(&cameraActor);
+    addLayer(&layer);
+
+    const string blendStates[] = {graphics::BLEND_ALPHA, graphics::BLEND_ADD, graphics::BLEND_MULTIPLY, graphics::BLEND_SCREEN};
+
+    for (uint32_t i = 0; i < SHAPE_COUNT; ++i)
+    {
+        shapes.push_back(unique_ptr<scene::ShapeRenderer>(new scene::ShapeRenderer()));
+        shapes.back()->rectangle(Rectangle(-4.0f, -4.0f, 8.0f, 8.0f), Color::WHITE, true);
+        shapes.back()->setBlendState(sharedEngine->getCache()->getBlendState(blendStates[(i / GROUP_SIZE) % 4]));
+
+        actors.push_back(unique_ptr<scene::Actor>(new scene::Actor()));
+        actors.back()->setPosition(Vector2(static_cast<float>(i % 100) * 8.0f - 400.0f, static_cast<float>(i / 100) * 12.0f - 300.0f));
+        actors.back()->addComponent(shapes.back().get());
+        layer.addChild(actors.back().get());
+    }
+}
+
+void DrawSample::update(float delta)
+{
+    graphics::RenderDevice* renderDevice = sharedEngine->getRenderer()->getDevice();
+
+    // the counts are of the last rendered frame
+    if (frame > WARMUP_FRAMES)
+    {
+        totalTime += delta;
+        totalDrawCalls += renderDevice->getDrawCallCount();
+        totalStateChanges += renderDevice->getStateChangeCount();
+    }
+
+    // the released blend state is deleted on the render thread together with its pipeline states
+    shared_ptr<graphics::BlendState> blendState = make_shared<graphics::BlendState>();
+    blendState->init(true,
+                     graphics::BlendState::BlendFactor::SRC_ALPHA, graphics::BlendState::BlendFactor::INV_SRC_ALPHA,
+                     graphics::BlendState::BlendOperation::ADD,
+                     graphics::BlendState::BlendFactor::ONE, graphics::BlendState::BlendFactor::ZERO,
+                     graphics::BlendState::BlendOperation::ADD);
+    shapes.front()->setBlendState(blendState);
+
+    if (++frame > WARMUP_FRAMES + FRAME_COUNT)
+    {
+        Log(Log::Level::INFO) << "Draw: " << SHAPE_COUNT << " shapes, " << FRAME_COUNT << " frames";
+        Log(Log::Level::INFO) << "Frame time: " << totalTime * 1000.0f / FRAME_COUNT << " ms, draw calls: " <<
+            totalDrawCalls / FRAME_COUNT << ", state changes: " << totalStateChanges / FRAME_COUNT << " per frame";
+
+        sharedEngine->exit(EXIT_SUCCESS);
+        updateCallback.remove();
+    }
+}
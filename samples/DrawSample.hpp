@@ -0,0 +1,30 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+// Benchmark of the draw loop, run with "-sample draw_benchmark": thousands of shapes with alternating
+// blend states are drawn, one blend state is recreated every frame, and the frame time, draw calls and
+// render state changes per frame are logged
+class DrawSample: public ouzel::scene::Scene
+{
+public:
+    DrawSample();
+
+private:
+    void update(float delta);
+
+    ouzel::scene::Layer layer;
+    ouzel::scene::Camera camera;
+    ouzel::scene::Actor cameraActor;
+
+    std::vector<std::unique_ptr<ouzel::scene::Actor>> actors;
+    std::vector<std::unique_ptr<ouzel::scene::ShapeRenderer>> shapes;
+
+    uint32_t frame = 0;
+    float totalTime = 0.0f;
+    uint64_t totalDrawCalls = 0;
+    uint64_t totalStateChanges = 0;
+
+    ouzel::UpdateCallback updateCallback;
+};
@@ -0,0 +1,345 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <chrono>
+#include "MathSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+static const size_t COUNT = 10000;
+static const uint32_t ITERATIONS = 100;
+static const float MAX_ERROR = 0.0001f;
+
+// scalar forms of the operations, the same as the engine code without SIMD support
+
+static bool invertScalar(const Matrix4& matrix, Matrix4& dst)
+{
+    const float* m = matrix.m;
+
+    float a0 = m[0] * m[5] - m[1] * m[4];
+    float a1 = m[0] * m[6] - m[2] * m[4];
+    float a2 = m[0] * m[7] - m[3] * m[4];
+    float a3 = m[1] * m[6] - m[2] * m[5];
+    float a4 = m[1] * m[7] - m[3] * m[5];
+    float a5 = m[2] * m[7] - m[3] * m[6];
+    float b0 = m[8] * m[13] - m[9] * m[12];
+    float b1 = m[8] * m[14] - m[10] * m[12];
+    float b2 = m[8] * m[15] - m[11] * m[12];
+    float b3 = m[9] * m[14] - m[10] * m[13];
+    float b4 = m[9] * m[15] - m[11] * m[13];
+    float b5 = m[10] * m[15] - m[11] * m[14];
+
+    float det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+
+    if (fabs(det) <= TOLERANCE) return false;
+
+    float inverse[16] = {
+        m[5] * b5 - m[6] * b4 + m[7] * b3,
+        -m[1] * b5 + m[2] * b4 - m[3] * b3,
+        m[13] * a5 - m[14] * a4 + m[15] * a3,
+        -m[9] * a5 + m[10] * a4 - m[11] * a3,
+
+        -m[4] * b5 + m[6] * b2 - m[7] * b1,
+        m[0] * b5 - m[2] * b2 + m[3] * b1,
+        -m[12] * a5 + m[14] * a2 - m[15] * a1,
+        m[8] * a5 - m[10] * a2 + m[11] * a1,
+
+        m[4] * b4 - m[5] * b2 + m[7] * b0,
+        -m[0] * b4 + m[1] * b2 - m[3] * b0,
+        m[12] * a4 - m[13] * a2 + m[15] * a0,
+        -m[8] * a4 + m[9] * a2 - m[11] * a0,
+
+        -m[4] * b3 + m[5] * b1 - m[6] * b0,
+        m[0] * b3 - m[1] * b1 + m[2] * b0,
+        -m[12] * a3 + m[13] * a1 - m[14] * a0,
+        m[8] * a3 - m[9] * a1 + m[10] * a0
+    };
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        dst.m[i] = inverse[i] / det;
+    }
+
+    return true;
+}
+
+static void createTransformScalar(const Vector3& translation, const Quaternion& rotation, const Vector3& scale, Matrix4& dst)
+{
+    float wx = rotation.w * rotation.x;
+    float wy = rotation.w * rotation.y;
+    float wz = rotation.w * rotation.z;
+    float xx = rotation.x * rotation.x;
+    float xy = rotation.x * rotation.y;
+    float xz = rotation.x * rotation.z;
+    float yy = rotation.y * rotation.y;
+    float yz = rotation.y * rotation.z;
+    float zz = rotation.z * rotation.z;
+
+    dst.set((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy - wz) * scale.y, 2.0f * (xz + wy) * scale.z, translation.x,
+            2.0f * (xy + wz) * scale.x, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz - wx) * scale.z, translation.y,
+            2.0f * (xz - wy) * scale.x, 2.0f * (yz + wx) * scale.y, (1.0f - 2.0f * (xx + yy)) * scale.z, translation.z,
+            0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+static void multiplyScalar(const Matrix4& m1, const Matrix4& m2, Matrix4& dst)
+{
+    for (uint32_t column = 0; column < 4; ++column)
+    {
+        for (uint32_t row = 0; row < 4; ++row)
+        {
+            dst.m[column * 4 + row] = m1.m[row] * m2.m[column * 4] +
+                m1.m[4 + row] * m2.m[column * 4 + 1] +
+                m1.m[8 + row] * m2.m[column * 4 + 2] +
+                m1.m[12 + row] * m2.m[column * 4 + 3];
+        }
+    }
+}
+
+static bool isClose(float a, float b)
+{
+    return fabs(a - b) <= MAX_ERROR * max(1.0f, max(fabs(a), fabs(b)));
+}
+
+static bool isClose(const Matrix4& a, const Matrix4& b)
+{
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        if (!isClose(a.m[i], b.m[i])) return false;
+    }
+
+    return true;
+}
+
+static bool isClose(const Vector3& a, const Vector3& b)
+{
+    return isClose(a.x, b.x) && isClose(a.y, b.y) && isClose(a.z, b.z);
+}
+
+static bool isClose(const Vector2& a, const Vector2& b)
+{
+    return isClose(a.x, b.x) && isClose(a.y, b.y);
+}
+
+// nanoseconds per element
+static float measure(const function<void()>& function)
+{
+    auto start = chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < ITERATIONS; ++i)
+    {
+        function();
+    }
+
+    return static_cast<float>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / (ITERATIONS * COUNT);
+}
+
+static void logResult(const string& name, float scalarTime, float time)
+{
+    Log(Log::Level::INFO) << name << ": scalar " << scalarTime << " ns, engine " << time << " ns, speedup " << scalarTime / time;
+}
+
+bool MathSample::run()
+{
+#if OUZEL_SUPPORTS_SSE
+    Log(Log::Level::INFO) << "Math: SSE, " << COUNT << " elements";
+#elif OUZEL_SUPPORTS_NEON64
+    Log(Log::Level::INFO) << "Math: NEON64, " << COUNT << " elements";
+#elif OUZEL_SUPPORTS_NEON
+    Log(Log::Level::INFO) << "Math: NEON, " << COUNT << " elements";
+#else
+    Log(Log::Level::INFO) << "Math: no SIMD support, " << COUNT << " elements";
+#endif
+
+    uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+    uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+
+    vector<Vector3> translations(COUNT);
+    vector<Quaternion> rotations(COUNT);
+    vector<Vector3> scales(COUNT);
+    vector<Vector3> points3(COUNT);
+    vector<Vector2> points2(COUNT);
+    vector<Box3> boxes(COUNT);
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        translations[i] = Vector3(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+        rotations[i] = Quaternion(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+        rotations[i].normalize();
+        scales[i] = Vector3(scaleDistribution(randomEngine), scaleDistribution(randomEngine), scaleDistribution(randomEngine));
+        points3[i] = Vector3(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+        points2[i] = Vector2(distribution(randomEngine), distribution(randomEngine));
+        boxes[i] = Box3(points3[i] - scales[i], points3[i] + scales[i]);
+    }
+
+    vector<Matrix4> scalarMatrices(COUNT);
+    vector<Matrix4> matrices(COUNT);
+
+    float scalarTime = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i) createTransformScalar(translations[i], rotations[i], scales[i], scalarMatrices[i]);
+    });
+    float time = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i) Matrix4::createTransform(translations[i], rotations[i], scales[i], matrices[i]);
+    });
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        if (!isClose(scalarMatrices[i], matrices[i]))
+        {
+            Log(Log::Level::ERR) << "Matrix4::createTransform differs from the scalar result";
+            return false;
+        }
+    }
+
+    logResult("TRS compose", scalarTime, time);
+
+    vector<Matrix4> scalarResults(COUNT);
+    vector<Matrix4> results(COUNT);
+
+    scalarTime = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i) invertScalar(matrices[i], scalarResults[i]);
+    });
+    time = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i) matrices[i].invert(results[i]);
+    });
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        if (!isClose(scalarResults[i], results[i]))
+        {
+            Log(Log::Level::ERR) << "Matrix4::invert differs from the scalar result";
+            return false;
+        }
+    }
+
+    logResult("Invert", scalarTime, time);
+
+    scalarTime = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i) multiplyScalar(matrices[i], matrices[COUNT - i - 1], scalarResults[i]);
+    });
+    time = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i) Matrix4::multiply(matrices[i], matrices[COUNT - i - 1], results[i]);
+    });
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        if (!isClose(scalarResults[i], results[i]))
+        {
+            Log(Log::Level::ERR) << "Matrix4::multiply differs from the scalar result";
+            return false;
+        }
+    }
+
+    logResult("Multiply", scalarTime, time);
+
+    const Matrix4& matrix = matrices.front();
+    vector<Vector3> scalarPoints3(COUNT);
+    vector<Vector3> resultPoints3(COUNT);
+
+    scalarTime = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            scalarPoints3[i].x = points3[i].x * matrix.m[0] + points3[i].y * matrix.m[4] + points3[i].z * matrix.m[8] + matrix.m[12];
+            scalarPoints3[i].y = points3[i].x * matrix.m[1] + points3[i].y * matrix.m[5] + points3[i].z * matrix.m[9] + matrix.m[13];
+            scalarPoints3[i].z = points3[i].x * matrix.m[2] + points3[i].y * matrix.m[6] + points3[i].z * matrix.m[10] + matrix.m[14];
+        }
+    });
+    time = measure([&]() {
+        matrix.transformPoints(points3.data(), resultPoints3.data(), COUNT);
+    });
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        if (!isClose(scalarPoints3[i], resultPoints3[i]))
+        {
+            Log(Log::Level::ERR) << "Matrix4::transformPoints differs from the scalar result for Vector3";
+            return false;
+        }
+    }
+
+    logResult("Transform Vector3 points", scalarTime, time);
+
+    vector<Vector2> scalarPoints2(COUNT);
+    vector<Vector2> resultPoints2(COUNT);
+
+    scalarTime = measure([&]() {
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            scalarPoints2[i].x = points2[i].x * matrix.m[0] + points2[i].y * matrix.m[4] + matrix.m[12];
+            scalarPoints2[i].y = points2[i].x * matrix.m[1] + points2[i].y * matrix.m[5] + matrix.m[13];
+        }
+    });
+    time = measure([&]() {
+        matrix.transformPoints(points2.data(), resultPoints2.data(), COUNT);
+    });
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        if (!isClose(scalarPoints2[i], resultPoints2[i]))
+        {
+            Log(Log::Level::ERR) << "Matrix4::transformPoints differs from the scalar result for Vector2";
+            return false;
+        }
+    }
+
+    logResult("Transform Vector2 points", scalarTime, time);
+
+    Box3 scalarBox3;
+    Box3 box3;
+
+    scalarTime = measure([&]() {
+        scalarBox3 = Box3();
+        for (size_t i = 0; i < COUNT; ++i) scalarBox3.merge(boxes[i]);
+    });
+    time = measure([&]() {
+        box3 = Box3();
+        box3.merge(boxes.data(), COUNT);
+    });
+
+    if (!isClose(scalarBox3.min, box3.min) || !isClose(scalarBox3.max, box3.max))
+    {
+        Log(Log::Level::ERR) << "Box3::merge differs from the scalar result";
+        return false;
+    }
+
+    logResult("Merge Box3", scalarTime, time);
+
+    scalarTime = measure([&]() {
+        scalarBox3 = Box3();
+        for (size_t i = 0; i < COUNT; ++i) scalarBox3.insertPoint(points3[i]);
+    });
+    time = measure([&]() {
+        box3 = Box3();
+        box3.insertPoints(points3.data(), COUNT);
+    });
+
+    if (!isClose(scalarBox3.min, box3.min) || !isClose(scalarBox3.max, box3.max))
+    {
+        Log(Log::Level::ERR) << "Box3::insertPoints differs from the scalar result";
+        return false;
+    }
+
+    logResult("Insert Vector3 points into Box3", scalarTime, time);
+
+    Box2 scalarBox2;
+    Box2 box2;
+
+    scalarTime = measure([&]() {
+        scalarBox2 = Box2();
+        for (size_t i = 0; i < COUNT; ++i) scalarBox2.insertPoint(points2[i]);
+    });
+    time = measure([&]() {
+        box2 = Box2();
+        box2.insertPoints(points2.data(), COUNT);
+    });
+
+    if (!isClose(scalarBox2.min, box2.min) || !isClose(scalarBox2.max, box2.max))
+    {
+        Log(Log::Level::ERR) << "Box2::insertPoints differs from the scalar result";
+        return false;
+    }
+
+    logResult("Insert Vector2 points into Box2", scalarTime, time);
+
+    return true;
+}
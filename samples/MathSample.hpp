@@ -0,0 +1,14 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "RunOnceSample.hpp"
+
+// Benchmark of the math operations that have SIMD paths, run with "-sample math_benchmark":
+// every operation is timed against its scalar form and the results are compared
+class MathSample: public RunOnceSample
+{
+private:
+    virtual bool run() override;
+};
@@ -0,0 +1,169 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cstdlib>
+#include "NetworkSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+static const uint16_t PORT = 47123;
+static const uint32_t CONNECTION_COUNT = 2;
+static const uint32_t MESSAGE_SIZE = 256 * 1024; // larger than the socket buffers, so it is sent in parts
+static const uint32_t DATAGRAM_SIZE = 1024;
+static const float RESEND_INTERVAL = 0.1f; // datagrams can be lost even on the loopback
+static const float TIMEOUT = 5.0f;
+
+static vector<uint8_t> createData(uint32_t size, uint8_t seed)
+{
+    vector<uint8_t> data(size);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+
+    return data;
+}
+
+NetworkSample::NetworkSample():
+    message(createData(MESSAGE_SIZE, 1)),
+    datagram(createData(DATAGRAM_SIZE, 2))
+{
+    eventHandler.networkHandler = bind(&NetworkSample::handleNetwork, this, placeholders::_1, placeholders::_2);
+    sharedEngine->getEventDispatcher()->addEventHandler(&eventHandler);
+
+    updateCallback.callback = bind(&NetworkSample::update, this, placeholders::_1);
+    sharedEngine->scheduleUpdate(&updateCallback);
+
+    network::Network* network = sharedEngine->getNetwork();
+
+    if (!network->listen("127.0.0.1", PORT))
+    {
+        finish(false);
+        return;
+    }
+
+    // both connections go to the same address and port
+    for (uint32_t i = 0; i < CONNECTION_COUNT; ++i)
+    {
+        if (!network->connect("127.0.0.1", PORT))
+        {
+            finish(false);
+            return;
+        }
+    }
+}
+
+bool NetworkSample::handleNetwork(Event::Type type, const NetworkEvent& event)
+{
+    if (finished) return true;
+
+    auto connectionIterator = connections.find(event.client);
+    bool outgoing = connectionIterator != connections.end();
+
+    if (type == Event::Type::NETWORK_CONNECT)
+    {
+        // outgoing connections are the ones to the listening port
+        if (event.client->getPort() == PORT)
+        {
+            connections[event.client] = Connection();
+
+            if (!event.client->send(message)) finish(false);
+        }
+    }
+    else if (type == Event::Type::NETWORK_DISCONNECT)
+    {
+        Log(Log::Level::ERR) << "Connection closed before the test finished";
+        finish(false);
+    }
+    else if (type == Event::Type::NETWORK_RECEIVE)
+    {
+        if (!outgoing)
+        {
+            if (!(event.datagram ? event.client->sendDatagram(event.data) : event.client->send(event.data)))
+            {
+                finish(false);
+            }
+        }
+        else if (event.datagram)
+        {
+            if (event.data != datagram)
+            {
+                Log(Log::Level::ERR) << "Corrupted datagram echo";
+                finish(false);
+            }
+            else if (!connectionIterator->second.messageEchoed)
+            {
+                Log(Log::Level::ERR) << "Datagram echo received on the wrong connection";
+                finish(false);
+            }
+            else if (!connectionIterator->second.datagramEchoed)
+            {
+                connectionIterator->second.datagramEchoed = true;
+
+                if (++completed == CONNECTION_COUNT) finish(true);
+            }
+        }
+        else
+        {
+            if (event.data != message || connectionIterator->second.messageEchoed)
+            {
+                Log(Log::Level::ERR) << "Corrupted message echo";
+                finish(false);
+            }
+            else
+            {
+                connectionIterator->second.messageEchoed = true;
+
+                if (!event.client->sendDatagram(datagram)) finish(false);
+            }
+        }
+    }
+
+    return true;
+}
+
+void NetworkSample::update(float delta)
+{
+    time += delta;
+
+    if (time > TIMEOUT)
+    {
+        Log(Log::Level::ERR) << "Timed out, " << completed << " of " << CONNECTION_COUNT << " connections completed";
+        finish(false);
+        return;
+    }
+
+    resendTime += delta;
+
+    if (resendTime >= RESEND_INTERVAL)
+    {
+        resendTime = 0.0f;
+
+        for (const auto& connection : connections)
+        {
+            if (connection.second.messageEchoed && !connection.second.datagramEchoed)
+            {
+                connection.first->sendDatagram(datagram);
+            }
+        }
+    }
+}
+
+void NetworkSample::finish(bool success)
+{
+    if (finished) return;
+
+    finished = true;
+
+    if (success)
+    {
+        Log(Log::Level::INFO) << "Network: " << CONNECTION_COUNT << " connections echoed a " << MESSAGE_SIZE <<
+            " byte message and a " << DATAGRAM_SIZE << " byte datagram in " << time << " s";
+    }
+
+    updateCallback.remove();
+    sharedEngine->getNetwork()->disconnect();
+    sharedEngine->exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
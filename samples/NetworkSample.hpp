@@ -0,0 +1,38 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+// Loopback test of the TCP and UDP transport, run with "-sample network": the sample listens on the loopback
+// address and opens two connections to itself. Every connection sends a message, which the server echoes,
+// and then a datagram, which the server echoes too. The sample exits with EXIT_FAILURE if an echo is
+// corrupted, arrives on the wrong connection or does not arrive before the timeout.
+class NetworkSample: public ouzel::scene::Scene
+{
+public:
+    NetworkSample();
+
+private:
+    struct Connection
+    {
+        bool messageEchoed = false;
+        bool datagramEchoed = false;
+    };
+
+    bool handleNetwork(ouzel::Event::Type type, const ouzel::NetworkEvent& event);
+    void update(float delta);
+    void finish(bool success);
+
+    ouzel::EventHandler eventHandler;
+    ouzel::UpdateCallback updateCallback;
+
+    std::vector<uint8_t> message;
+    std::vector<uint8_t> datagram;
+    // outgoing connections, the accepted ones only echo
+    std::map<std::shared_ptr<ouzel::network::Client>, Connection> connections;
+
+    float time = 0.0f;
+    float resendTime = 0.0f;
+    uint32_t completed = 0;
+    bool finished = false;
+};
@@ -0,0 +1,282 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <chrono>
+#include "OBFSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+static const uint32_t ELEMENT_COUNT = 10000;
+static const uint32_t TAG_COUNT = 16;
+static const uint32_t VERSION = 1;
+static const uint32_t ITERATIONS = 20;
+
+// the keys of objects and dictionaries are written in the sorted order, in which Value encodes them
+enum Key: uint32_t
+{
+    KEY_ID,
+    KEY_NAME,
+    KEY_TRANSFORM,
+    KEY_TAGS,
+    KEY_ATTRIBUTES
+};
+
+enum TransformKey: uint32_t
+{
+    KEY_X,
+    KEY_Y
+};
+
+static string getName(uint32_t index)
+{
+    return "element" + to_string(index);
+}
+
+// microseconds per iteration
+static float measure(const function<bool()>& function)
+{
+    auto start = chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < ITERATIONS; ++i)
+    {
+        if (!function()) return -1.0f;
+    }
+
+    return static_cast<float>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()) / ITERATIONS;
+}
+
+bool OBFSample::run()
+{
+    vector<uint8_t> valueBuffer;
+    vector<uint8_t> writerBuffer;
+
+    float valueEncodeTime = measure([&valueBuffer]() {
+        vector<obf::Value> elements;
+
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i)
+        {
+            obf::Value transform = obf::Value::Type::OBJECT;
+            transform[KEY_X] = static_cast<float>(i) * 0.5f;
+            transform[KEY_Y] = static_cast<float>(i) * 2.0f;
+
+            obf::Value tags = obf::Value::Type::ARRAY;
+            for (uint32_t tag = 0; tag < TAG_COUNT; ++tag)
+            {
+                tags.append(obf::Value(i + tag));
+            }
+
+            obf::Value attributes = obf::Value::Type::DICTIONARY;
+            attributes["health"] = i % 100;
+            attributes["speed"] = static_cast<float>(i) * 0.25f;
+
+            obf::Value element = obf::Value::Type::OBJECT;
+            element[KEY_ID] = i;
+            element[KEY_NAME] = getName(i);
+            element[KEY_TRANSFORM] = move(transform);
+            element[KEY_TAGS] = move(tags);
+            element[KEY_ATTRIBUTES] = move(attributes);
+            elements.push_back(move(element));
+        }
+
+        obf::Value root = obf::Value::Type::DICTIONARY;
+        root["elements"] = move(elements);
+        root["version"] = VERSION;
+
+        valueBuffer.clear();
+        return root.encode(valueBuffer) > 0;
+    });
+
+    float writerEncodeTime = measure([&writerBuffer]() {
+        writerBuffer.clear();
+        obf::Writer writer(writerBuffer);
+
+        writer.beginDictionary();
+        writer.writeKey("elements");
+        writer.beginArray();
+
+        for (uint32_t i = 0; i < ELEMENT_COUNT; ++i)
+        {
+            writer.beginObject();
+            writer.writeKey(KEY_ID);
+            writer.writeInt(i);
+            writer.writeKey(KEY_NAME);
+            writer.writeString(getName(i));
+
+            writer.writeKey(KEY_TRANSFORM);
+            writer.beginObject();
+            writer.writeKey(KEY_X);
+            writer.writeFloat(static_cast<float>(i) * 0.5f);
+            writer.writeKey(KEY_Y);
+            writer.writeFloat(static_cast<float>(i) * 2.0f);
+            writer.endObject();
+
+            writer.writeKey(KEY_TAGS);
+            writer.beginArray();
+            for (uint32_t tag = 0; tag < TAG_COUNT; ++tag)
+            {
+                writer.writeInt(i + tag);
+            }
+            writer.endArray();
+
+            writer.writeKey(KEY_ATTRIBUTES);
+            writer.beginDictionary();
+            writer.writeKey("health");
+            writer.writeInt(i % 100);
+            writer.writeKey("speed");
+            writer.writeFloat(static_cast<float>(i) * 0.25f);
+            writer.endDictionary();
+
+            writer.endObject();
+        }
+
+        writer.endArray();
+        writer.writeKey("version");
+        writer.writeInt(VERSION);
+
+        return writer.endDictionary() && writer.isComplete();
+    });
+
+    if (valueEncodeTime < 0.0f || writerEncodeTime < 0.0f || valueBuffer != writerBuffer)
+    {
+        Log(Log::Level::ERR) << "Value and Writer encodings differ";
+        return false;
+    }
+
+    // every reader sums the same fields, so that the results can be compared
+    double valueSum = 0.0;
+    double iteratorSum = 0.0;
+    double indexSum = 0.0;
+
+    float valueDecodeTime = measure([&valueBuffer, &valueSum]() {
+        obf::Value root;
+        if (!root.decode(valueBuffer) || root["version"].asUInt32() != VERSION) return false;
+
+        valueSum = 0.0;
+        for (const obf::Value& element : root["elements"].asVector())
+        {
+            const obf::Value& transform = element[KEY_TRANSFORM];
+            const obf::Value& attributes = element[KEY_ATTRIBUTES];
+
+            valueSum += element[KEY_ID].asUInt32() + element[KEY_NAME].asString().length() +
+                transform[KEY_X].asFloat() + transform[KEY_Y].asFloat() +
+                attributes["health"].asUInt32() + attributes["speed"].asFloat();
+
+            for (const obf::Value& tag : element[KEY_TAGS].asVector())
+            {
+                valueSum += tag.asUInt32();
+            }
+        }
+
+        return true;
+    });
+
+    float iteratorTime = measure([&valueBuffer, &iteratorSum]() {
+        obf::View root(valueBuffer);
+        if (root["version"].asUInt32() != VERSION) return false;
+
+        obf::View elements = root["elements"];
+
+        iteratorSum = 0.0;
+        obf::View::Iterator i = elements.begin();
+        for (; i != elements.end(); ++i)
+        {
+            obf::View element = *i;
+            obf::View transform = element[KEY_TRANSFORM];
+            obf::View attributes = element[KEY_ATTRIBUTES];
+
+            iteratorSum += element[KEY_ID].asUInt32() + element[KEY_NAME].getStringLength() +
+                transform[KEY_X].asFloat() + transform[KEY_Y].asFloat() +
+                attributes["health"].asUInt32() + attributes["speed"].asFloat();
+
+            obf::View tags = element[KEY_TAGS];
+            obf::View::Iterator tag = tags.begin();
+            for (; tag != tags.end(); ++tag)
+            {
+                iteratorSum += (*tag).asUInt32();
+            }
+
+            if (tag.isMalformed()) return false;
+        }
+
+        return !i.isMalformed();
+    });
+
+    float indexTime = measure([&valueBuffer, &indexSum]() {
+        obf::View root(valueBuffer);
+        if (root["version"].asUInt32() != VERSION) return false;
+
+        obf::ArrayAccessor elements(root["elements"]);
+
+        indexSum = 0.0;
+        for (uint32_t index = 0; index < elements.getCount(); ++index)
+        {
+            obf::View element = elements[index];
+            if (!element.isValid()) return false;
+
+            obf::View transform = element[KEY_TRANSFORM];
+            obf::View attributes = element[KEY_ATTRIBUTES];
+
+            indexSum += element[KEY_ID].asUInt32() + element[KEY_NAME].getStringLength() +
+                transform[KEY_X].asFloat() + transform[KEY_Y].asFloat() +
+                attributes["health"].asUInt32() + attributes["speed"].asFloat();
+
+            obf::ArrayAccessor tags(element[KEY_TAGS]);
+            for (uint32_t tag = 0; tag < tags.getCount(); ++tag)
+            {
+                obf::View value = tags[tag];
+                if (!value.isValid()) return false;
+                indexSum += value.asUInt32();
+            }
+        }
+
+        return true;
+    });
+
+    if (valueDecodeTime < 0.0f || iteratorTime < 0.0f || indexTime < 0.0f ||
+        valueSum != iteratorSum || valueSum != indexSum)
+    {
+        Log(Log::Level::ERR) << "Value and View read different data";
+        return false;
+    }
+
+    // lookups of the wrong type return an invalid view instead of asserting
+    obf::View root(valueBuffer);
+    if (root[KEY_ID].isValid() || root["elements"]["version"].isValid() || root["version"].getCount() != 0 ||
+        root["elements"].hasElement("version") || !root.hasElement("version"))
+    {
+        Log(Log::Level::ERR) << "Invalid lookups were not rejected";
+        return false;
+    }
+
+    // a truncated buffer must be reported as malformed
+    vector<uint8_t> truncated(valueBuffer.begin(), valueBuffer.begin() + valueBuffer.size() / 2);
+    obf::View truncatedElements = obf::View(truncated)["elements"];
+    obf::View::Iterator i = truncatedElements.begin();
+    while (i != truncatedElements.end()) ++i;
+
+    if (!i.isMalformed())
+    {
+        Log(Log::Level::ERR) << "Truncated data was not detected";
+        return false;
+    }
+
+    // keys that do not fit in 16 bits and keys without values are rejected
+    vector<uint8_t> invalidBuffer;
+    obf::Writer invalidWriter(invalidBuffer);
+    invalidWriter.beginDictionary();
+    if (invalidWriter.writeKey(string(70000, 'k')) ||
+        !invalidWriter.writeKey("key") ||
+        invalidWriter.endDictionary())
+    {
+        Log(Log::Level::ERR) << "Invalid Writer calls were not rejected";
+        return false;
+    }
+
+    Log(Log::Level::INFO) << "OBF: " << ELEMENT_COUNT << " objects with " << TAG_COUNT << " tags, " << valueBuffer.size() << " bytes";
+    Log(Log::Level::INFO) << "Encode: Value " << valueEncodeTime << " us, Writer " << writerEncodeTime << " us";
+    Log(Log::Level::INFO) << "Read: Value decode " << valueDecodeTime << " us, View iterator " << iteratorTime <<
+        " us, View index " << indexTime << " us";
+
+    return true;
+}
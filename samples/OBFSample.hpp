@@ -0,0 +1,15 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "RunOnceSample.hpp"
+
+// Benchmark of obf::Writer and obf::View against obf::Value, run with "-sample obf_benchmark":
+// a dictionary with a large array of nested objects, arrays and dictionaries is encoded and read back
+// with both APIs and the times are logged
+class OBFSample: public RunOnceSample
+{
+private:
+    virtual bool run() override;
+};
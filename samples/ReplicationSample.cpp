@@ -0,0 +1,105 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <chrono>
+#include "ReplicationSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+static const uint32_t ACTOR_COUNT = 1000;
+static const uint32_t SNAPSHOT_COUNT = 600; // 10 seconds at 60 snapshots per second
+static const uint32_t SNAPSHOT_RATE = 60;
+static const uint32_t ACK_LOSS_INTERVAL = 10;
+static const float POSITION_TOLERANCE = 0.05f; // positions are quantized to 1/64 units
+
+ReplicationSample::ReplicationSample()
+{
+    for (uint32_t i = 0; i < ACTOR_COUNT; ++i)
+    {
+        serverActors.push_back(unique_ptr<scene::Actor>(new scene::Actor()));
+        clientActors.push_back(unique_ptr<scene::Actor>(new scene::Actor()));
+
+        serverActors.back()->setPosition(Vector2(static_cast<float>(i % 40) * 20.0f, static_cast<float>(i / 40) * 20.0f));
+
+        server.addActor(i, serverActors.back().get());
+        client.addActor(i, clientActors.back().get());
+    }
+}
+
+bool ReplicationSample::run()
+{
+    uint32_t peerId = server.addPeer();
+
+    vector<uint8_t> data;
+    vector<uint8_t> ack;
+
+    uint64_t totalBytes = 0;
+    size_t firstSnapshotSize = 0;
+    size_t maxSnapshotSize = 0;
+    chrono::steady_clock::duration serverTime(0);
+    chrono::steady_clock::duration clientTime(0);
+
+    for (uint32_t snapshotIndex = 0; snapshotIndex < SNAPSHOT_COUNT; ++snapshotIndex)
+    {
+        // a quarter of the actors move every snapshot, every tenth one also rotates
+        for (uint32_t i = snapshotIndex % 4; i < ACTOR_COUNT; i += 4)
+        {
+            scene::Actor* actor = serverActors[i].get();
+            actor->setPosition(actor->getPosition() + Vector3(1.0f, 0.5f, 0.0f));
+            if (i % 10 == 0) actor->setRotation(static_cast<float>(snapshotIndex) * 0.01f);
+        }
+
+        auto serverStart = chrono::steady_clock::now();
+        server.captureSnapshot();
+        bool encoded = server.encodeSnapshot(peerId, data);
+        serverTime += chrono::steady_clock::now() - serverStart;
+
+        if (!encoded)
+        {
+            Log(Log::Level::ERR) << "Failed to encode snapshot " << snapshotIndex;
+            return false;
+        }
+
+        if (snapshotIndex == 0) firstSnapshotSize = data.size();
+        maxSnapshotSize = max(maxSnapshotSize, data.size());
+        totalBytes += data.size();
+
+        auto clientStart = chrono::steady_clock::now();
+        bool received = client.receive(data, ack);
+        clientTime += chrono::steady_clock::now() - clientStart;
+
+        if (!received)
+        {
+            Log(Log::Level::ERR) << "Failed to receive snapshot " << snapshotIndex;
+            return false;
+        }
+
+        if (snapshotIndex % ACK_LOSS_INTERVAL != ACK_LOSS_INTERVAL - 1 && !server.receive(peerId, ack))
+        {
+            Log(Log::Level::ERR) << "Failed to receive ack " << snapshotIndex;
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < ACTOR_COUNT; ++i)
+    {
+        if (serverActors[i]->getPosition().distance(clientActors[i]->getPosition()) > POSITION_TOLERANCE)
+        {
+            Log(Log::Level::ERR) << "Actor " << i << " was not replicated";
+            return false;
+        }
+    }
+
+    float averageSize = static_cast<float>(totalBytes) / SNAPSHOT_COUNT;
+
+    Log(Log::Level::INFO) << "Replication: " << ACTOR_COUNT << " actors, " << SNAPSHOT_COUNT << " snapshots";
+    Log(Log::Level::INFO) << "Snapshot size: first " << firstSnapshotSize << " bytes, average " << averageSize <<
+        " bytes, max " << maxSnapshotSize << " bytes, " << averageSize * SNAPSHOT_RATE / 1024.0f << " KiB/s at " << SNAPSHOT_RATE << " Hz";
+    Log(Log::Level::INFO) << "Server capture and encode: " <<
+        chrono::duration_cast<chrono::microseconds>(serverTime).count() / SNAPSHOT_COUNT << " us per snapshot";
+    Log(Log::Level::INFO) << "Client decode and apply: " <<
+        chrono::duration_cast<chrono::microseconds>(clientTime).count() / SNAPSHOT_COUNT << " us per snapshot";
+
+    return true;
+}
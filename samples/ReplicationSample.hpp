@@ -0,0 +1,24 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "RunOnceSample.hpp"
+
+// Bandwidth and CPU benchmark of the snapshot replication, run with "-sample replication_benchmark":
+// a server replicates moving actors to a client for a fixed number of snapshots, every tenth ack is
+// lost, and the snapshot sizes and the encoding and decoding times are logged
+class ReplicationSample: public RunOnceSample
+{
+public:
+    ReplicationSample();
+
+private:
+    virtual bool run() override;
+
+    std::vector<std::unique_ptr<ouzel::scene::Actor>> serverActors;
+    std::vector<std::unique_ptr<ouzel::scene::Actor>> clientActors;
+
+    ouzel::network::ReplicationServer server;
+    ouzel::network::ReplicationClient client;
+};
@@ -0,0 +1,20 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cstdlib>
+#include "RunOnceSample.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+RunOnceSample::RunOnceSample()
+{
+    updateCallback.callback = bind(&RunOnceSample::update, this, placeholders::_1);
+    sharedEngine->scheduleUpdate(&updateCallback);
+}
+
+void RunOnceSample::update(float)
+{
+    updateCallback.remove();
+    sharedEngine->exit(run() ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,20 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+// Base of the test and benchmark samples that do all their work in the first frame:
+// run is called once and the engine exits with EXIT_SUCCESS if it returns true, EXIT_FAILURE otherwise
+class RunOnceSample: public ouzel::scene::Scene
+{
+public:
+    RunOnceSample();
+
+protected:
+    virtual bool run() = 0;
+
+private:
+    void update(float delta);
+
+    ouzel::UpdateCallback updateCallback;
+};
@@ -0,0 +1,172 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cstdlib>
+#include "SoftwareRenderSample.hpp"
+#include "graphics/software/RenderDeviceSoftware.hpp"
+
+using namespace std;
+using namespace ouzel;
+
+SoftwareRenderSample::SoftwareRenderSample(bool aBenchmark):
+    benchmark(aBenchmark)
+{
+    updateCallback.callback = bind(&SoftwareRenderSample::update, this, placeholders::_1);
+    sharedEngine->scheduleUpdate(&updateCallback);
+
+    sharedEngine->getRenderer()->setClearColor(Color(32, 32, 32));
+
+    cameraActor.addComponent(&camera);
+    layer.addChild(&cameraActor);
+    addLayer(&layer);
+
+    if (benchmark)
+    {
+        // many small translucent rectangles and a few full screen ones for the fill rate
+        for (int32_t y = 0; y < 48; ++y)
+        {
+            for (int32_t x = 0; x < 64; ++x)
+            {
+                shapes.rectangle(Rectangle(static_cast<float>(x * 13 - 416), static_cast<float>(y * 13 - 312), 12.0f, 12.0f),
+                                 Color(static_cast<uint8_t>(x * 4), static_cast<uint8_t>(y * 5), 128, 192), true);
+            }
+        }
+
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            shapes.rectangle(Rectangle(-400.0f, -300.0f, 800.0f, 600.0f), Color(255, 255, 255, 16), true);
+        }
+    }
+    else
+    {
+        // the edges are on pixel boundaries of a 800x600 frame, so the expected image does not depend on the fill rule
+        shapes.rectangle(Rectangle(-300.0f, -200.0f, 200.0f, 150.0f), Color(255, 0, 0), true);
+        shapes.rectangle(Rectangle(-50.0f, -100.0f, 300.0f, 250.0f), Color(0, 255, 0), true);
+        shapes.rectangle(Rectangle(100.0f, 0.0f, 200.0f, 200.0f), Color(0, 0, 255, 128), true);
+    }
+
+    shapesActor.addComponent(&shapes);
+    layer.addChild(&shapesActor);
+}
+
+void SoftwareRenderSample::update(float delta)
+{
+    if (sharedEngine->getRenderer()->getDevice()->getDriver() != graphics::Renderer::Driver::SOFTWARE)
+    {
+        Log(Log::Level::ERR) << "This sample needs the software renderer (-graphicsDriver software)";
+        sharedEngine->exit(EXIT_FAILURE);
+        return;
+    }
+
+    ++frame;
+
+    if (benchmark)
+    {
+        // keep the rasterized primitives the same, but move them every frame
+        shapesActor.setRotation(shapesActor.getRotation().getEulerAngles().z + delta * 0.1f);
+
+        graphics::RenderDeviceSoftware* renderDevice = static_cast<graphics::RenderDeviceSoftware*>(sharedEngine->getRenderer()->getDevice());
+
+        if (frame == WARMUP_FRAMES)
+        {
+            renderDevice->resetStatistics();
+        }
+        else if (frame == WARMUP_FRAMES + BENCHMARK_FRAMES)
+        {
+            report();
+            sharedEngine->exit(EXIT_SUCCESS);
+        }
+    }
+    else if (compare())
+    {
+        sharedEngine->exit(EXIT_SUCCESS);
+    }
+    else if (frame >= MAX_WAIT_FRAMES)
+    {
+        sharedEngine->exit(EXIT_FAILURE);
+    }
+}
+
+bool SoftwareRenderSample::compare()
+{
+    graphics::RenderDeviceSoftware* renderDevice = static_cast<graphics::RenderDeviceSoftware*>(sharedEngine->getRenderer()->getDevice());
+
+    std::vector<uint8_t> pixels;
+    Size2 pixelsSize;
+
+    // the first frames may not be finished yet
+    if (!renderDevice->readPixels(pixels, pixelsSize))
+    {
+        if (frame >= MAX_WAIT_FRAMES) Log(Log::Level::ERR) << "No frame was drawn";
+        return false;
+    }
+
+    graphics::ImageDataSTB expected;
+    if (!expected.init("software_render.png"))
+    {
+        frame = MAX_WAIT_FRAMES;
+        return false;
+    }
+
+    if (expected.getSize() != pixelsSize)
+    {
+        Log(Log::Level::ERR) << "Frame size " << pixelsSize.width << "x" << pixelsSize.height <<
+            " does not match the expected size " << expected.getSize().width << "x" << expected.getSize().height;
+        frame = MAX_WAIT_FRAMES;
+        return false;
+    }
+
+    const std::vector<uint8_t>& expectedPixels = expected.getData();
+    uint32_t width = static_cast<uint32_t>(pixelsSize.width);
+    uint32_t mismatches = 0;
+
+    // alpha is not compared, because the PNG has no alpha channel
+    for (size_t i = 0; i < pixels.size(); i += 4)
+    {
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            if (abs(static_cast<int>(pixels[i + channel]) - static_cast<int>(expectedPixels[i + channel])) > TOLERANCE)
+            {
+                if (mismatches == 0)
+                {
+                    uint32_t pixel = static_cast<uint32_t>(i / 4);
+                    Log(Log::Level::ERR) << "First mismatch at " << pixel % width << ", " << pixel / width << ": " <<
+                        static_cast<int>(pixels[i]) << " " << static_cast<int>(pixels[i + 1]) << " " << static_cast<int>(pixels[i + 2]) << ", expected " <<
+                        static_cast<int>(expectedPixels[i]) << " " << static_cast<int>(expectedPixels[i + 1]) << " " << static_cast<int>(expectedPixels[i + 2]);
+                }
+
+                ++mismatches;
+                break;
+            }
+        }
+    }
+
+    if (mismatches)
+    {
+        Log(Log::Level::ERR) << mismatches << " pixels differ from software_render.png";
+        sharedEngine->getRenderer()->saveScreenshot("software_render_actual.png");
+        frame = MAX_WAIT_FRAMES;
+        return false;
+    }
+
+    Log(Log::Level::INFO) << "Software renderer output matches software_render.png";
+
+    return true;
+}
+
+void SoftwareRenderSample::report()
+{
+    graphics::RenderDeviceSoftware* renderDevice = static_cast<graphics::RenderDeviceSoftware*>(sharedEngine->getRenderer()->getDevice());
+    graphics::RenderDeviceSoftware::Statistics statistics = renderDevice->getStatistics();
+
+    Log(Log::Level::INFO) << "Software renderer: " << statistics.frameCount << " frames on " << renderDevice->getWorkerCount() << " threads, " <<
+        statistics.primitiveCount << " primitives per frame";
+    Log(Log::Level::INFO) << "Frame time: average " << statistics.averageFrameTime * 1000.0f << " ms, min " <<
+        statistics.minFrameTime * 1000.0f << " ms, max " << statistics.maxFrameTime * 1000.0f << " ms";
+
+    if (statistics.averageFrameTime > 0.0f)
+    {
+        Log(Log::Level::INFO) << "Throughput: " << 1.0f / statistics.averageFrameTime << " frames/s, " <<
+            statistics.primitiveCount / statistics.averageFrameTime << " primitives/s";
+    }
+}
@@ -0,0 +1,34 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+// Headless checks of the software renderer, run with "-graphicsDriver software":
+// "-sample software_render" compares a fixed scene with Resources/software_render.png and exits with
+// EXIT_FAILURE if they differ, "-sample software_benchmark" logs the rasterization throughput
+class SoftwareRenderSample: public ouzel::scene::Scene
+{
+public:
+    SoftwareRenderSample(bool aBenchmark);
+
+private:
+    void update(float delta);
+    bool compare();
+    void report();
+
+    static const uint32_t MAX_WAIT_FRAMES = 60;
+    static const uint32_t WARMUP_FRAMES = 10;
+    static const uint32_t BENCHMARK_FRAMES = 300;
+    static const uint8_t TOLERANCE = 2; // maximum difference of a color channel
+
+    bool benchmark;
+    uint32_t frame = 0;
+    ouzel::UpdateCallback updateCallback;
+
+    ouzel::scene::Layer layer;
+    ouzel::scene::Camera camera;
+    ouzel::scene::Actor cameraActor;
+
+    ouzel::scene::ShapeRenderer shapes;
+    ouzel::scene::Actor shapesActor;
+};
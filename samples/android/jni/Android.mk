@@ -10,6 +10,7 @@ LOCAL_C_INCLUDES += $(LOCAL_PATH)/../../../ouzel
 LOCAL_PCH := ../../Prefix.hpp
 
 LOCAL_SRC_FILES := ../../AnimationsSample.cpp \
+    ../../ChannelSample.cpp \
     ../../GUISample.cpp \
     ../../GameSample.cpp \
     ../../InputSample.cpp \
@@ -18,7 +19,15 @@ LOCAL_SRC_FILES := ../../AnimationsSample.cpp \
     ../../PerspectiveSample.cpp \
     ../../SoundSample.cpp \
     ../../SpritesSample.cpp \
-    ../../RTSample.cpp
+    ../../RTSample.cpp \
+    ../../RunOnceSample.cpp \
+    ../../NetworkSample.cpp \
+    ../../DrawSample.cpp \
+    ../../MathSample.cpp \
+    ../../CullingSample.cpp \
+    ../../OBFSample.cpp \
+    ../../ReplicationSample.cpp \
+    ../../SoftwareRenderSample.cpp
 
 LOCAL_WHOLE_STATIC_LIBRARIES := ouzel
 LOCAL_LDLIBS := -lGLESv1_CM -lGLESv2 -lEGL -llog -landroid -lOpenSLES -latomic
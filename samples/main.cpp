@@ -9,6 +9,14 @@
 #include "InputSample.hpp"
 #include "SoundSample.hpp"
 #include "PerspectiveSample.hpp"
+#include "SoftwareRenderSample.hpp"
+#include "NetworkSample.hpp"
+#include "ChannelSample.hpp"
+#include "ReplicationSample.hpp"
+#include "OBFSample.hpp"
+#include "CullingSample.hpp"
+#include "MathSample.hpp"
+#include "DrawSample.hpp"
 
 std::string DEVELOPER_NAME = "org.ouzelengine";
 std::string APPLICATION_NAME = "samples";
@@ -41,6 +49,11 @@ void ouzelMain(const std::vector<std::string>& args)
                 ouzel::Log(ouzel::Log::Level::WARN) << "No sample specified";
             }
         }
+        else if (*arg == "-graphicsDriver")
+        {
+            // handled by the engine
+            if (++arg == args.end()) break;
+        }
         else
         {
             ouzel::Log(ouzel::Log::Level::WARN) << "Invalid argument \"" << *arg << "\"";
@@ -83,6 +96,42 @@ void ouzelMain(const std::vector<std::string>& args)
         {
             currentScene.reset(new PerspectiveSample());
         }
+        else if (sample == "software_render")
+        {
+            currentScene.reset(new SoftwareRenderSample(false));
+        }
+        else if (sample == "software_benchmark")
+        {
+            currentScene.reset(new SoftwareRenderSample(true));
+        }
+        else if (sample == "network")
+        {
+            currentScene.reset(new NetworkSample());
+        }
+        else if (sample == "channel")
+        {
+            currentScene.reset(new ChannelSample());
+        }
+        else if (sample == "replication_benchmark")
+        {
+            currentScene.reset(new ReplicationSample());
+        }
+        else if (sample == "obf_benchmark")
+        {
+            currentScene.reset(new OBFSample());
+        }
+        else if (sample == "culling_benchmark")
+        {
+            currentScene.reset(new CullingSample());
+        }
+        else if (sample == "math_benchmark")
+        {
+            currentScene.reset(new MathSample());
+        }
+        else if (sample == "draw_benchmark")
+        {
+            currentScene.reset(new DrawSample());
+        }
     }
     
     if (!currentScene)
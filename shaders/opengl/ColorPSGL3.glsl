@@ -1,5 +1,8 @@
 #version 330
-uniform vec4 color;
+layout(std140) uniform PixelConstants
+{
+    vec4 color;
+};
 in vec4 exColor;
 out vec4 outColor;
 void main()
@@ -1,7 +1,10 @@
 #version 330
 in vec3 position0;
 in vec4 color0;
-uniform mat4 modelViewProj;
+layout(std140) uniform VertexConstants
+{
+    mat4 modelViewProj;
+};
 out vec4 exColor;
 void main()
 {
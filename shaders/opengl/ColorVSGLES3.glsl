@@ -2,7 +2,10 @@
 precision highp float;
 in vec3 position0;
 in vec4 color0;
-uniform mat4 modelViewProj;
+layout(std140) uniform VertexConstants
+{
+    mat4 modelViewProj;
+};
 out lowp vec4 exColor;
 void main()
 {
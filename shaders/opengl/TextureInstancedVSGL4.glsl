@@ -0,0 +1,23 @@
+#version 400
+in vec3 position0;
+in vec4 color0;
+in vec2 texCoord0;
+in vec4 texCoord1;
+in vec4 texCoord2;
+in vec4 texCoord3;
+in vec4 texCoord4;
+in vec4 color1;
+in vec4 texCoord5;
+layout(std140) uniform VertexConstants
+{
+    mat4 viewProj;
+};
+out vec4 exColor;
+out vec2 exTexCoord;
+void main()
+{
+    mat4 transform = mat4(texCoord1, texCoord2, texCoord3, texCoord4);
+    gl_Position = viewProj * transform * vec4(position0, 1.0);
+    exColor = color0 * color1;
+    exTexCoord = texCoord5.xy + texCoord0 * texCoord5.zw;
+}
@@ -1,5 +1,8 @@
 #version 330
-uniform vec4 color;
+layout(std140) uniform PixelConstants
+{
+    vec4 color;
+};
 uniform sampler2D texture0;
 in vec4 exColor;
 in vec2 exTexCoord;
@@ -1,6 +1,9 @@
 #version 300 es
 precision mediump float;
-uniform lowp vec4 color;
+layout(std140) uniform PixelConstants
+{
+    lowp vec4 color;
+};
 uniform lowp sampler2D texture0;
 in lowp vec4 exColor;
 in vec2 exTexCoord;
@@ -0,0 +1,11 @@
+precision mediump float;
+uniform lowp vec4 color;
+uniform lowp sampler2D texture0;
+varying lowp vec4 exColor;
+varying vec2 exTexCoord;
+void main()
+{
+    float value = texture2D(texture0, exTexCoord).a;
+    float alpha = smoothstep(0.45, 0.55, value);
+    gl_FragColor = vec4(exColor.rgb * color.rgb, exColor.a * color.a * alpha);
+}
@@ -0,0 +1,12 @@
+#version 120
+uniform vec4 color;
+uniform sampler2D texture0;
+varying vec4 exColor;
+varying vec2 exTexCoord;
+void main()
+{
+    float value = texture2D(texture0, exTexCoord).a;
+    float width = fwidth(value) * 0.5;
+    float alpha = smoothstep(0.5 - width, 0.5 + width, value);
+    gl_FragColor = vec4(exColor.rgb * color.rgb, exColor.a * color.a * alpha);
+}
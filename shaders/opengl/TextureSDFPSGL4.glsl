@@ -0,0 +1,16 @@
+#version 400
+layout(std140) uniform PixelConstants
+{
+    vec4 color;
+};
+uniform sampler2D texture0;
+in vec4 exColor;
+in vec2 exTexCoord;
+out vec4 outColor;
+void main()
+{
+    float value = texture(texture0, exTexCoord).a;
+    float width = fwidth(value) * 0.5;
+    float alpha = smoothstep(0.5 - width, 0.5 + width, value);
+    outColor = vec4(exColor.rgb * color.rgb, exColor.a * color.a * alpha);
+}
@@ -0,0 +1,13 @@
+#extension GL_OES_standard_derivatives : enable
+precision mediump float;
+uniform lowp vec4 color;
+uniform lowp sampler2D texture0;
+varying lowp vec4 exColor;
+varying vec2 exTexCoord;
+void main()
+{
+    float value = texture2D(texture0, exTexCoord).a;
+    float width = fwidth(value) * 0.5;
+    float alpha = smoothstep(0.5 - width, 0.5 + width, value);
+    gl_FragColor = vec4(exColor.rgb * color.rgb, exColor.a * color.a * alpha);
+}
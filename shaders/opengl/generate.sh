@@ -2,28 +2,37 @@
 xxd -i ColorPSGL2.glsl ../../ouzel/graphics/opengl/ColorPSGL2.h
 xxd -i ColorVSGL2.glsl ../../ouzel/graphics/opengl/ColorVSGL2.h
 xxd -i TexturePSGL2.glsl ../../ouzel/graphics/opengl/TexturePSGL2.h
+xxd -i TextureSDFPSGL2.glsl ../../ouzel/graphics/opengl/TextureSDFPSGL2.h
 xxd -i TextureVSGL2.glsl ../../ouzel/graphics/opengl/TextureVSGL2.h
 
 # OpenGL 3
 xxd -i ColorPSGL3.glsl ../../ouzel/graphics/opengl/ColorPSGL3.h
 xxd -i ColorVSGL3.glsl ../../ouzel/graphics/opengl/ColorVSGL3.h
 xxd -i TexturePSGL3.glsl ../../ouzel/graphics/opengl/TexturePSGL3.h
+xxd -i TextureSDFPSGL3.glsl ../../ouzel/graphics/opengl/TextureSDFPSGL3.h
 xxd -i TextureVSGL3.glsl ../../ouzel/graphics/opengl/TextureVSGL3.h
+xxd -i TextureInstancedVSGL3.glsl ../../ouzel/graphics/opengl/TextureInstancedVSGL3.h
 
 # OpenGL 4
 xxd -i ColorPSGL4.glsl ../../ouzel/graphics/opengl/ColorPSGL4.h
 xxd -i ColorVSGL4.glsl ../../ouzel/graphics/opengl/ColorVSGL4.h
 xxd -i TexturePSGL4.glsl ../../ouzel/graphics/opengl/TexturePSGL4.h
+xxd -i TextureSDFPSGL4.glsl ../../ouzel/graphics/opengl/TextureSDFPSGL4.h
 xxd -i TextureVSGL4.glsl ../../ouzel/graphics/opengl/TextureVSGL4.h
+xxd -i TextureInstancedVSGL4.glsl ../../ouzel/graphics/opengl/TextureInstancedVSGL4.h
 
 # OpenGL ES 2
 xxd -i ColorPSGLES2.glsl ../../ouzel/graphics/opengl/ColorPSGLES2.h
 xxd -i ColorVSGLES2.glsl ../../ouzel/graphics/opengl/ColorVSGLES2.h
 xxd -i TexturePSGLES2.glsl ../../ouzel/graphics/opengl/TexturePSGLES2.h
+xxd -i TextureSDFPSGLES2.glsl ../../ouzel/graphics/opengl/TextureSDFPSGLES2.h
+xxd -i TextureSDFFallbackPSGLES2.glsl ../../ouzel/graphics/opengl/TextureSDFFallbackPSGLES2.h
 xxd -i TextureVSGLES2.glsl ../../ouzel/graphics/opengl/TextureVSGLES2.h
 
 # OpenGL ES 3
 xxd -i ColorPSGLES3.glsl ../../ouzel/graphics/opengl/ColorPSGLES3.h
 xxd -i ColorVSGLES3.glsl ../../ouzel/graphics/opengl/ColorVSGLES3.h
 xxd -i TexturePSGLES3.glsl ../../ouzel/graphics/opengl/TexturePSGLES3.h
-xxd -i TextureVSGLES3.glsl ../../ouzel/graphics/opengl/TextureVSGLES3.h
\ No newline at end of file
+xxd -i TextureSDFPSGLES3.glsl ../../ouzel/graphics/opengl/TextureSDFPSGLES3.h
+xxd -i TextureVSGLES3.glsl ../../ouzel/graphics/opengl/TextureVSGLES3.h
+xxd -i TextureInstancedVSGLES3.glsl ../../ouzel/graphics/opengl/TextureInstancedVSGLES3.h
\ No newline at end of file
@@ -0,0 +1,173 @@
+// Copyright (C) 2017 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <chrono>
+#include <cstdlib>
+#include "ouzel.hpp"
+
+// Converts JSON sprite sheets and particle systems to the binary formats, so that games can ship them
+// and skip JSON parsing at load time. The output format is selected by the extension of the output file:
+//   compiler <input.json> <output.sprite|output.particle> [<input.json> <output> ...]
+// "-benchmark <input.json>" loads the file from JSON and from the binary format and logs the load times.
+
+std::string DEVELOPER_NAME = "org.ouzelengine";
+std::string APPLICATION_NAME = "compiler";
+
+static const uint32_t LOAD_ITERATIONS = 100;
+
+static bool compile(const std::string& input, const std::string& output)
+{
+    std::vector<uint8_t> data;
+    if (!ouzel::sharedEngine->getFileSystem()->readFile(input, data, false))
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> result;
+    std::string extension = ouzel::FileSystem::getExtensionPart(output);
+
+    if (extension == "sprite")
+    {
+        if (!ouzel::scene::SpriteData::compile(data, result))
+        {
+            ouzel::Log(ouzel::Log::Level::ERR) << "Failed to compile sprite sheet " << input;
+            return false;
+        }
+    }
+    else if (extension == "particle")
+    {
+        if (!ouzel::scene::ParticleSystemData::compile(data, result))
+        {
+            ouzel::Log(ouzel::Log::Level::ERR) << "Failed to compile particle system " << input;
+            return false;
+        }
+    }
+    else
+    {
+        ouzel::Log(ouzel::Log::Level::ERR) << "Unsupported output file " << output << ", use .sprite or .particle";
+        return false;
+    }
+
+    if (!ouzel::sharedEngine->getFileSystem()->writeFile(output, result))
+    {
+        ouzel::Log(ouzel::Log::Level::ERR) << "Failed to write " << output;
+        return false;
+    }
+
+    ouzel::Log(ouzel::Log::Level::INFO) << "Compiled " << input << " to " << output << " (" << data.size() << " -> " << result.size() << " bytes)";
+
+    return true;
+}
+
+template<class T>
+static bool measureLoad(const std::vector<uint8_t>& data, float& result)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < LOAD_ITERATIONS; ++i)
+    {
+        T loaded;
+        if (!loaded.init(data, false)) return false;
+    }
+
+    auto diff = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    result = static_cast<float>(diff.count()) / 1000.0f / LOAD_ITERATIONS;
+
+    return true;
+}
+
+static bool benchmark(const std::string& input)
+{
+    std::vector<uint8_t> data;
+    if (!ouzel::sharedEngine->getFileSystem()->readFile(input, data, false))
+    {
+        return false;
+    }
+
+    // the texture is loaded by the first iteration and comes from the cache after that
+    ouzel::sharedEngine->getFileSystem()->addResourcePath(ouzel::FileSystem::getDirectoryPart(input));
+
+    std::vector<uint8_t> binary;
+    float jsonTime;
+    float binaryTime;
+
+    if (ouzel::scene::SpriteData::compile(data, binary))
+    {
+        if (!measureLoad<ouzel::scene::SpriteData>(data, jsonTime) ||
+            !measureLoad<ouzel::scene::SpriteData>(binary, binaryTime))
+        {
+            ouzel::Log(ouzel::Log::Level::ERR) << "Failed to load sprite sheet " << input;
+            return false;
+        }
+    }
+    else if (ouzel::scene::ParticleSystemData::compile(data, binary))
+    {
+        if (!measureLoad<ouzel::scene::ParticleSystemData>(data, jsonTime) ||
+            !measureLoad<ouzel::scene::ParticleSystemData>(binary, binaryTime))
+        {
+            ouzel::Log(ouzel::Log::Level::ERR) << "Failed to load particle system " << input;
+            return false;
+        }
+    }
+    else
+    {
+        ouzel::Log(ouzel::Log::Level::ERR) << input << " is neither a sprite sheet nor a particle system";
+        return false;
+    }
+
+    ouzel::Log(ouzel::Log::Level::INFO) << input << ": JSON " << data.size() << " bytes, " << jsonTime << " ms per load, " <<
+        "binary " << binary.size() << " bytes, " << binaryTime << " ms per load";
+
+    return true;
+}
+
+void ouzelMain(const std::vector<std::string>& args)
+{
+    std::vector<std::string> files;
+    std::vector<std::string> benchmarkFiles;
+
+    for (auto arg = args.begin() + 1; arg != args.end(); ++arg)
+    {
+        if (*arg == "-graphicsDriver")
+        {
+            // handled by the engine
+            if (++arg == args.end()) break;
+        }
+        else if (*arg == "-benchmark")
+        {
+            if (++arg == args.end()) break;
+            benchmarkFiles.push_back(*arg);
+        }
+        else
+        {
+            files.push_back(*arg);
+        }
+    }
+
+    if ((files.empty() && benchmarkFiles.empty()) || files.size() % 2 != 0)
+    {
+        ouzel::Log(ouzel::Log::Level::ERR) << "Usage: compiler <input.json> <output.sprite|output.particle> ... [-benchmark <input.json>]";
+        ouzel::sharedEngine->exit(EXIT_FAILURE);
+        return;
+    }
+
+    for (size_t i = 0; i < files.size(); i += 2)
+    {
+        if (!compile(files[i], files[i + 1]))
+        {
+            ouzel::sharedEngine->exit(EXIT_FAILURE);
+            return;
+        }
+    }
+
+    for (const std::string& file : benchmarkFiles)
+    {
+        if (!benchmark(file))
+        {
+            ouzel::sharedEngine->exit(EXIT_FAILURE);
+            return;
+        }
+    }
+
+    ouzel::sharedEngine->exit(EXIT_SUCCESS);
+}